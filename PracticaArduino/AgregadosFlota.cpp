@@ -0,0 +1,134 @@
+/**
+ * @file AgregadosFlota.cpp
+ * @brief Implementación de los agregados de la flota
+ */
+
+#include "AgregadosFlota.h"
+#include "Instantanea.h"
+#include "TablaNombres.h"
+
+AgregadosFlota::AgregadosFlota() {
+}
+
+AgregadosFlota& AgregadosFlota::global() {
+    static AgregadosFlota flota;
+    return flota;
+}
+
+void AgregadosFlota::aplicar(ResumenFlota& resumen, const AgregadosSensor& agregados, int signo) {
+    resumen.lecturas = resumen.lecturas + signo * agregados.cantidad;
+    resumen.suma = resumen.suma + signo * agregados.suma;
+    resumen.anomalias = resumen.anomalias + signo * agregados.anomalias;
+    
+    // Un sensor sin lecturas no aporta "última lectura" ni extremos
+    if (agregados.version == 0) {
+        return;
+    }
+    
+    resumen.sensoresConDatos = resumen.sensoresConDatos + signo;
+    resumen.sumaUltimos = resumen.sumaUltimos + signo * agregados.ultimo;
+    
+    if (signo > 0) {
+        if (!resumen.hayExtremos || agregados.minimoHistorico < resumen.minimoHistorico) {
+            resumen.minimoHistorico = agregados.minimoHistorico;
+        }
+        if (!resumen.hayExtremos || agregados.maximoHistorico > resumen.maximoHistorico) {
+            resumen.maximoHistorico = agregados.maximoHistorico;
+        }
+        resumen.hayExtremos = true;
+    }
+}
+
+int AgregadosFlota::grupoDe(int id) const {
+    if (id < 0 || id >= grupoDeSensor.tamano()) {
+        return -1;
+    }
+    return grupoDeSensor[id];
+}
+
+void AgregadosFlota::actualizar(const AgregadosSensor* anterior, const AgregadosSensor& nuevo) {
+    ResumenFlota& tipo = porTipo[nuevo.tipo];
+    int grupo = grupoDe(nuevo.id);
+    
+    if (anterior == 0) {
+        tipo.sensores = tipo.sensores + 1;
+    } else {
+        aplicar(tipo, *anterior, -1);
+        if (grupo >= 0) {
+            aplicar(grupos[grupo], *anterior, -1);
+        }
+    }
+    
+    aplicar(tipo, nuevo, 1);
+    if (grupo >= 0) {
+        aplicar(grupos[grupo], nuevo, 1);
+    }
+}
+
+void AgregadosFlota::retirar(const AgregadosSensor& ultimo) {
+    ResumenFlota& tipo = porTipo[ultimo.tipo];
+    tipo.sensores = tipo.sensores - 1;
+    aplicar(tipo, ultimo, -1);
+    
+    int grupo = grupoDe(ultimo.id);
+    if (grupo >= 0) {
+        grupos[grupo].sensores = grupos[grupo].sensores - 1;
+        aplicar(grupos[grupo], ultimo, -1);
+        grupoDeSensor[ultimo.id] = -1;
+    }
+}
+
+void AgregadosFlota::asignarGrupo(const AgregadosSensor& actual, const char* etiqueta) {
+    int nombre = TablaNombres::global().internar(etiqueta);
+    grupoPorNombre.extender(nombre + 1, -1);
+    
+    if (grupoPorNombre[nombre] < 0) {
+        grupoPorNombre[nombre] = grupos.tamano();
+        grupos.agregar(ResumenFlota());
+        etiquetas.agregar(nombre);
+    }
+    
+    int nuevo = grupoPorNombre[nombre];
+    int anterior = grupoDe(actual.id);
+    if (anterior == nuevo) {
+        return;
+    }
+    
+    if (anterior >= 0) {
+        grupos[anterior].sensores = grupos[anterior].sensores - 1;
+        aplicar(grupos[anterior], actual, -1);
+    }
+    
+    grupoDeSensor.extender(actual.id + 1, -1);
+    grupoDeSensor[actual.id] = nuevo;
+    grupos[nuevo].sensores = grupos[nuevo].sensores + 1;
+    aplicar(grupos[nuevo], actual, 1);
+}
+
+const ResumenFlota& AgregadosFlota::resumenTipo(TipoSensor tipo) const {
+    return porTipo[tipo];
+}
+
+const ResumenFlota* AgregadosFlota::resumenGrupo(const char* etiqueta) const {
+    int nombre = TablaNombres::global().buscar(etiqueta);
+    
+    if (nombre < 0 || nombre >= grupoPorNombre.tamano() || grupoPorNombre[nombre] < 0) {
+        return 0;
+    }
+    
+    return &grupos[grupoPorNombre[nombre]];
+}
+
+const char* AgregadosFlota::etiquetaDe(int id) const {
+    int grupo = grupoDe(id);
+    
+    if (grupo < 0) {
+        return 0;
+    }
+    
+    return TablaNombres::global().nombre(etiquetas[grupo]);
+}
+
+int AgregadosFlota::cantidadGrupos() const {
+    return grupos.tamano();
+}
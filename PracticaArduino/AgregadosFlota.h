@@ -0,0 +1,150 @@
+/**
+ * @file AgregadosFlota.h
+ * @brief Agregados incrementales de la flota por tipo de sensor y por grupo
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef AGREGADOS_FLOTA_H
+#define AGREGADOS_FLOTA_H
+
+#include "SensorBase.h"
+#include "ArregloDinamico.h"
+
+/**
+ * @brief Resumen de un conjunto de sensores
+ */
+struct ResumenFlota {
+    int sensores;            ///< Sensores vivos en el conjunto
+    int sensoresConDatos;    ///< Sensores que recibieron al menos una lectura
+    long long lecturas;      ///< Lecturas vivas en los historiales
+    double suma;             ///< Suma de las lecturas vivas
+    double sumaUltimos;      ///< Suma de la última lectura de cada sensor
+    double minimoHistorico;  ///< Menor lectura recibida por el conjunto
+    double maximoHistorico;  ///< Mayor lectura recibida por el conjunto
+    long long anomalias;     ///< Anomalías detectadas
+    bool hayExtremos;        ///< true cuando los extremos ya tienen valor
+    
+    /**
+     * @brief Constructor con todo en cero
+     */
+    ResumenFlota() {
+        sensores = 0;
+        sensoresConDatos = 0;
+        lecturas = 0;
+        suma = 0.0;
+        sumaUltimos = 0.0;
+        minimoHistorico = 0.0;
+        maximoHistorico = 0.0;
+        anomalias = 0;
+        hayExtremos = false;
+    }
+    
+    /**
+     * @brief Promedio de todas las lecturas vivas
+     * @return Promedio (0 si no hay lecturas)
+     */
+    double promedio() const {
+        return lecturas > 0 ? suma / lecturas : 0.0;
+    }
+    
+    /**
+     * @brief Promedio de la última lectura de cada sensor
+     * @return Promedio (0 si ningún sensor tiene datos)
+     */
+    double promedioUltimos() const {
+        return sensoresConDatos > 0 ? sumaUltimos / sensoresConDatos : 0.0;
+    }
+};
+
+/**
+ * @class AgregadosFlota
+ * @brief Mantiene los resúmenes de la flota al publicar cada instantánea
+ *
+ * EstadoPublicado informa los agregados anteriores y los nuevos de un
+ * sensor; aquí se resta la contribución vieja y se suma la nueva, así que
+ * cada actualización es O(1) y consultar un resumen no recorre sensores
+ * ni historiales. Los extremos históricos no se revierten al dar de baja
+ * un sensor.
+ *
+ * Se actualiza desde el hilo escritor; no es seguro leerlo desde otro hilo.
+ */
+class AgregadosFlota {
+private:
+    ResumenFlota porTipo[SENSOR_OTRO + 1];  ///< Resumen de cada TipoSensor
+    ArregloDinamico<ResumenFlota> grupos;   ///< Resumen de cada grupo
+    ArregloDinamico<int> grupoPorNombre;    ///< ID de nombre de la etiqueta -> grupo
+    ArregloDinamico<int> etiquetas;         ///< Grupo -> ID de nombre de la etiqueta
+    ArregloDinamico<int> grupoDeSensor;     ///< ID de sensor -> grupo (-1 = ninguno)
+    
+    AgregadosFlota();
+    AgregadosFlota(const AgregadosFlota&);
+    AgregadosFlota& operator=(const AgregadosFlota&);
+    
+    /**
+     * @brief Suma (signo 1) o resta (signo -1) la contribución de un sensor
+     */
+    static void aplicar(ResumenFlota& resumen, const AgregadosSensor& agregados, int signo);
+    
+    /**
+     * @brief Grupo asignado a un sensor
+     * @return Índice del grupo o -1
+     */
+    int grupoDe(int id) const;
+    
+public:
+    /**
+     * @brief Obtiene los agregados globales del proceso
+     * @return Referencia a la instancia única
+     */
+    static AgregadosFlota& global();
+    
+    /**
+     * @brief Registra el cambio de estado de un sensor
+     * @param anterior Agregados publicados antes (0 si el sensor es nuevo)
+     * @param nuevo Agregados recién publicados
+     */
+    void actualizar(const AgregadosSensor* anterior, const AgregadosSensor& nuevo);
+    
+    /**
+     * @brief Retira un sensor destruido de todos los resúmenes
+     * @param ultimo Últimos agregados publicados por el sensor
+     */
+    void retirar(const AgregadosSensor& ultimo);
+    
+    /**
+     * @brief Mueve un sensor a un grupo (un sensor pertenece a un solo grupo)
+     * @param actual Agregados actuales del sensor
+     * @param etiqueta Nombre del grupo (se crea si no existe)
+     */
+    void asignarGrupo(const AgregadosSensor& actual, const char* etiqueta);
+    
+    /**
+     * @brief Resumen de los sensores de un tipo
+     * @param tipo Tipo de sensor
+     * @return Resumen en O(1)
+     */
+    const ResumenFlota& resumenTipo(TipoSensor tipo) const;
+    
+    /**
+     * @brief Resumen de un grupo
+     * @param etiqueta Nombre del grupo
+     * @return Resumen, o 0 si el grupo no existe
+     */
+    const ResumenFlota* resumenGrupo(const char* etiqueta) const;
+    
+    /**
+     * @brief Etiqueta del grupo de un sensor
+     * @param id ID del sensor
+     * @return Nombre del grupo, o 0 si no tiene
+     */
+    const char* etiquetaDe(int id) const;
+    
+    /**
+     * @brief Número de grupos creados
+     * @return Cantidad de grupos
+     */
+    int cantidadGrupos() const;
+};
+
+#endif // AGREGADOS_FLOTA_H
@@ -0,0 +1,214 @@
+/**
+ * @file ArregloDinamico.h
+ * @brief Arreglo contiguo genérico que crece bajo demanda
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef ARREGLO_DINAMICO_H
+#define ARREGLO_DINAMICO_H
+
+/**
+ * @class ArregloDinamico
+ * @brief Arreglo de memoria contigua con crecimiento geométrico
+ * @tparam T Tipo de los elementos (se copian por valor)
+ *
+ * Se usa para datos que se recorren completos (por ejemplo, sensores
+ * del mismo tipo), donde una lista enlazada obliga a saltar entre nodos
+ * dispersos en el heap.
+ */
+template <typename T>
+class ArregloDinamico {
+private:
+    T* datos;      ///< Bloque contiguo de elementos
+    int cantidad;  ///< Elementos ocupados
+    int capacidad; ///< Elementos reservados
+    
+    /**
+     * @brief Duplica la capacidad del arreglo
+     */
+    void crecer();
+    
+public:
+    /**
+     * @brief Constructor por defecto (arreglo vacío)
+     */
+    ArregloDinamico();
+    
+    /**
+     * @brief Destructor - libera el bloque
+     */
+    ~ArregloDinamico();
+    
+    /**
+     * @brief Constructor de copia (Regla de los Tres)
+     * @param otro Arreglo a copiar
+     */
+    ArregloDinamico(const ArregloDinamico<T>& otro);
+    
+    /**
+     * @brief Operador de asignación (Regla de los Tres)
+     * @param otro Arreglo a asignar
+     * @return Referencia a este arreglo
+     */
+    ArregloDinamico<T>& operator=(const ArregloDinamico<T>& otro);
+    
+    /**
+     * @brief Agrega un elemento al final en O(1) amortizado
+     * @param valor Elemento a agregar
+     */
+    void agregar(const T& valor);
+    
+    /**
+     * @brief Quita un elemento moviendo el último a su lugar (no conserva el orden)
+     * @param indice Posición a quitar
+     */
+    void quitarIntercambiando(int indice);
+    
+    /**
+     * @brief Extiende el arreglo hasta un tamaño mínimo
+     * @param nuevoTamano Número de elementos deseado
+     * @param relleno Valor para las posiciones nuevas
+     */
+    void extender(int nuevoTamano, const T& relleno);
+    
+    /**
+     * @brief Vacía el arreglo sin liberar la capacidad
+     */
+    void limpiar();
+    
+    /**
+     * @brief Intercambia el contenido con otro arreglo en O(1) (sin copiar)
+     * @param otro Arreglo con el que intercambiar
+     */
+    void intercambiar(ArregloDinamico<T>& otro);
+    
+    /**
+     * @brief Acceso por índice
+     * @param indice Posición del elemento
+     * @return Referencia al elemento
+     */
+    T& operator[](int indice);
+    
+    /**
+     * @brief Acceso por índice (solo lectura)
+     * @param indice Posición del elemento
+     * @return Referencia constante al elemento
+     */
+    const T& operator[](int indice) const;
+    
+    /**
+     * @brief Número de elementos
+     * @return Cantidad de elementos ocupados
+     */
+    int tamano() const;
+};
+
+template <typename T>
+ArregloDinamico<T>::ArregloDinamico() {
+    datos = 0;
+    cantidad = 0;
+    capacidad = 0;
+}
+
+template <typename T>
+ArregloDinamico<T>::~ArregloDinamico() {
+    delete[] datos;
+}
+
+template <typename T>
+ArregloDinamico<T>::ArregloDinamico(const ArregloDinamico<T>& otro) {
+    datos = 0;
+    cantidad = 0;
+    capacidad = 0;
+    
+    for (int i = 0; i < otro.cantidad; i++) {
+        agregar(otro.datos[i]);
+    }
+}
+
+template <typename T>
+ArregloDinamico<T>& ArregloDinamico<T>::operator=(const ArregloDinamico<T>& otro) {
+    if (this == &otro) {
+        return *this;
+    }
+    
+    cantidad = 0;
+    for (int i = 0; i < otro.cantidad; i++) {
+        agregar(otro.datos[i]);
+    }
+    
+    return *this;
+}
+
+template <typename T>
+void ArregloDinamico<T>::crecer() {
+    int nuevaCapacidad = (capacidad == 0) ? 8 : capacidad * 2;
+    T* nuevos = new T[nuevaCapacidad];
+    
+    for (int i = 0; i < cantidad; i++) {
+        nuevos[i] = datos[i];
+    }
+    
+    delete[] datos;
+    datos = nuevos;
+    capacidad = nuevaCapacidad;
+}
+
+template <typename T>
+void ArregloDinamico<T>::agregar(const T& valor) {
+    if (cantidad == capacidad) {
+        crecer();
+    }
+    
+    datos[cantidad] = valor;
+    cantidad = cantidad + 1;
+}
+
+template <typename T>
+void ArregloDinamico<T>::quitarIntercambiando(int indice) {
+    cantidad = cantidad - 1;
+    datos[indice] = datos[cantidad];
+}
+
+template <typename T>
+void ArregloDinamico<T>::extender(int nuevoTamano, const T& relleno) {
+    while (cantidad < nuevoTamano) {
+        agregar(relleno);
+    }
+}
+
+template <typename T>
+void ArregloDinamico<T>::limpiar() {
+    cantidad = 0;
+}
+
+template <typename T>
+void ArregloDinamico<T>::intercambiar(ArregloDinamico<T>& otro) {
+    T* datosOtro = otro.datos;
+    int cantidadOtro = otro.cantidad;
+    int capacidadOtro = otro.capacidad;
+    otro.datos = datos;
+    otro.cantidad = cantidad;
+    otro.capacidad = capacidad;
+    datos = datosOtro;
+    cantidad = cantidadOtro;
+    capacidad = capacidadOtro;
+}
+
+template <typename T>
+T& ArregloDinamico<T>::operator[](int indice) {
+    return datos[indice];
+}
+
+template <typename T>
+const T& ArregloDinamico<T>::operator[](int indice) const {
+    return datos[indice];
+}
+
+template <typename T>
+int ArregloDinamico<T>::tamano() const {
+    return cantidad;
+}
+
+#endif // ARREGLO_DINAMICO_H
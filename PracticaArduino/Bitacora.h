@@ -0,0 +1,50 @@
+/**
+ * @file Bitacora.h
+ * @brief Interruptor global de los mensajes de seguimiento
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef BITACORA_H
+#define BITACORA_H
+
+/**
+ * @class Bitacora
+ * @brief Permite silenciar los mensajes por elemento en operaciones masivas
+ *
+ * Los mensajes de creación, inserción y liberación de sensores y nodos
+ * son útiles al trabajar con pocos elementos, pero dominan el tiempo
+ * cuando se cargan o liberan cientos de miles.
+ */
+class Bitacora {
+private:
+    /**
+     * @brief Estado compartido del interruptor
+     */
+    static bool& estado() {
+        static bool activa = true;
+        return activa;
+    }
+    
+public:
+    /**
+     * @brief Indica si se deben imprimir los mensajes de seguimiento
+     * @return true si están activos
+     */
+    static bool activa() {
+        return estado();
+    }
+    
+    /**
+     * @brief Activa o silencia los mensajes de seguimiento
+     * @param valor Nuevo estado
+     * @return Estado anterior (para restaurarlo)
+     */
+    static bool activar(bool valor) {
+        bool anterior = estado();
+        estado() = valor;
+        return anterior;
+    }
+};
+
+#endif // BITACORA_H
@@ -0,0 +1,138 @@
+/**
+ * @file BuferSalida.cpp
+ * @brief Implementación del búfer de salida
+ */
+
+#include "BuferSalida.h"
+#include <charconv>
+#include <cstring>
+
+using namespace std;
+
+// Lo máximo que ocupa un número convertido (double en notación científica)
+static const int MAXIMO_NUMERO = 32;
+
+// Cabe un double en notación fija con decimales
+static const int CAPACIDAD_MINIMA = 1024;
+
+BuferSalida::BuferSalida(ostream& salida, int tamano) {
+    destino = &salida;
+    capacidad = tamano < CAPACIDAD_MINIMA ? CAPACIDAD_MINIMA : tamano;
+    datos = new char[capacidad];
+    usados = 0;
+    escritos = 0;
+}
+
+BuferSalida::~BuferSalida() {
+    vaciar();
+    delete[] datos;
+}
+
+void BuferSalida::vaciar() {
+    if (usados > 0) {
+        destino->write(datos, usados);
+        escritos = escritos + usados;
+        usados = 0;
+    }
+}
+
+void BuferSalida::reservar(int n) {
+    if (usados + n > capacidad) {
+        vaciar();
+    }
+}
+
+void BuferSalida::texto(const char* cadena, int longitud) {
+    while (longitud > 0) {
+        reservar(1);
+        int cabe = capacidad - usados;
+        int copiar = longitud < cabe ? longitud : cabe;
+        memcpy(datos + usados, cadena, copiar);
+        usados = usados + copiar;
+        cadena = cadena + copiar;
+        longitud = longitud - copiar;
+    }
+}
+
+void BuferSalida::texto(const char* cadena) {
+    texto(cadena, (int)strlen(cadena));
+}
+
+void BuferSalida::caracter(char c) {
+    reservar(1);
+    datos[usados] = c;
+    usados = usados + 1;
+}
+
+void BuferSalida::numero(long long valor) {
+    reservar(MAXIMO_NUMERO);
+    to_chars_result r = to_chars(datos + usados, datos + capacidad, valor);
+    usados = (int)(r.ptr - datos);
+}
+
+void BuferSalida::numero(int valor) {
+    numero((long long)valor);
+}
+
+void BuferSalida::numero(float valor) {
+    reservar(MAXIMO_NUMERO);
+    to_chars_result r = to_chars(datos + usados, datos + capacidad, valor);
+    usados = (int)(r.ptr - datos);
+}
+
+void BuferSalida::numero(double valor) {
+    reservar(MAXIMO_NUMERO);
+    to_chars_result r = to_chars(datos + usados, datos + capacidad, valor);
+    usados = (int)(r.ptr - datos);
+}
+
+void BuferSalida::numeroFijo(double valor, int decimales) {
+    // Un double fijo puede tener más de 300 dígitos: se deja lugar de sobra
+    reservar(MAXIMO_NUMERO + 320);
+    to_chars_result r = to_chars(datos + usados, datos + capacidad, valor, chars_format::fixed, decimales);
+    if (r.ec == errc()) {
+        usados = (int)(r.ptr - datos);
+    } else {
+        numero(valor);
+    }
+}
+
+void BuferSalida::textoJson(const char* cadena) {
+    static const char hexadecimal[] = "0123456789abcdef";
+    
+    caracter('"');
+    for (const char* c = cadena; *c != '\0'; c++) {
+        unsigned char u = (unsigned char)*c;
+        if (u == '"' || u == '\\') {
+            caracter('\\');
+            caracter((char)u);
+        } else if (u < 0x20) {
+            texto("\\u00");
+            caracter(hexadecimal[u >> 4]);
+            caracter(hexadecimal[u & 0xF]);
+        } else {
+            caracter((char)u);
+        }
+    }
+    caracter('"');
+}
+
+void BuferSalida::textoCsv(const char* cadena) {
+    if (strpbrk(cadena, ",\"\r\n") == 0) {
+        texto(cadena);
+        return;
+    }
+    
+    caracter('"');
+    for (const char* c = cadena; *c != '\0'; c++) {
+        if (*c == '"') {
+            caracter('"');
+        }
+        caracter(*c);
+    }
+    caracter('"');
+}
+
+long long BuferSalida::totalBytes() const {
+    return escritos + usados;
+}
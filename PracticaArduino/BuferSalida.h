@@ -0,0 +1,116 @@
+/**
+ * @file BuferSalida.h
+ * @brief Búfer reutilizable para escribir texto con formato numérico rápido
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef BUFER_SALIDA_H
+#define BUFER_SALIDA_H
+
+#include <ostream>
+
+/**
+ * @class BuferSalida
+ * @brief Acumula texto en un bloque propio y lo escribe de una sola vez
+ *
+ * Los números se convierten con std::to_chars: sin locale, sin flags de
+ * formato y sin reservar memoria. Los float y double salen con la
+ * representación más corta que se relee sin pérdida. Cuando el bloque se
+ * llena se escribe al destino con una sola llamada a write(), y nunca se
+ * fuerza el vaciado del flujo por línea como hace endl.
+ */
+class BuferSalida {
+private:
+    std::ostream* destino; ///< Flujo donde se vuelca el bloque
+    char* datos;           ///< Bloque reutilizable
+    int capacidad;         ///< Tamaño del bloque
+    int usados;            ///< Bytes pendientes de escribir
+    long long escritos;    ///< Bytes volcados desde la creación
+    
+    /**
+     * @brief Garantiza espacio para n bytes, volcando si hace falta
+     */
+    void reservar(int n);
+    
+    BuferSalida(const BuferSalida&);
+    BuferSalida& operator=(const BuferSalida&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param salida Flujo de destino (por ejemplo cout o un ofstream)
+     * @param tamano Bytes del bloque (64 KB por defecto)
+     */
+    BuferSalida(std::ostream& salida, int tamano = 1 << 16);
+    
+    /**
+     * @brief Destructor - vuelca lo pendiente y libera el bloque
+     */
+    ~BuferSalida();
+    
+    /**
+     * @brief Agrega una cadena terminada en '\0'
+     */
+    void texto(const char* cadena);
+    
+    /**
+     * @brief Agrega longitud bytes de una cadena
+     */
+    void texto(const char* cadena, int longitud);
+    
+    /**
+     * @brief Agrega un carácter
+     */
+    void caracter(char c);
+    
+    /**
+     * @brief Agrega un entero en base 10
+     */
+    void numero(long long valor);
+    
+    /**
+     * @brief Agrega un entero en base 10
+     */
+    void numero(int valor);
+    
+    /**
+     * @brief Agrega un float con la representación más corta exacta
+     */
+    void numero(float valor);
+    
+    /**
+     * @brief Agrega un double con la representación más corta exacta
+     */
+    void numero(double valor);
+    
+    /**
+     * @brief Agrega un double con decimales fijos
+     * @param valor Número
+     * @param decimales Dígitos tras el punto
+     */
+    void numeroFijo(double valor, int decimales);
+    
+    /**
+     * @brief Agrega una cadena JSON entre comillas, con escapes
+     */
+    void textoJson(const char* cadena);
+    
+    /**
+     * @brief Agrega un campo CSV (entre comillas solo si hace falta)
+     */
+    void textoCsv(const char* cadena);
+    
+    /**
+     * @brief Escribe lo pendiente al destino con una sola llamada
+     */
+    void vaciar();
+    
+    /**
+     * @brief Bytes producidos (volcados y pendientes)
+     * @return Total de bytes
+     */
+    long long totalBytes() const;
+};
+
+#endif // BUFER_SALIDA_H
@@ -0,0 +1,229 @@
+/**
+ * @file ClienteCarga.cpp
+ * @brief Prueba de carga del servidor de consultas (herramienta aparte)
+ *
+ * Uso: ClienteCarga [socket] [hilos] [segundos]
+ *
+ * Cada hilo abre su conexión, pide LIST una vez y luego envía AGG a
+ * sensores elegidos al azar, esperando cada respuesta. Al final imprime
+ * consultas por segundo y latencias p50/p99/p99.9/máxima.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Histograma en microsegundos; lo que pase de 100 ms cae en la última cubeta
+static const int CUBETAS_US = 100000;
+
+/**
+ * @brief Conexión bloqueante con lectura por líneas
+ */
+struct Conexion {
+    int fd;
+    char bufer[65536];
+    int inicio;
+    int fin;
+    
+    Conexion() {
+        fd = -1;
+        inicio = 0;
+        fin = 0;
+    }
+    
+    bool conectar(const char* ruta) {
+        sockaddr_un direccion;
+        memset(&direccion, 0, sizeof(direccion));
+        direccion.sun_family = AF_UNIX;
+        strncpy(direccion.sun_path, ruta, sizeof(direccion.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        return fd >= 0 && connect(fd, (sockaddr*)&direccion, sizeof(direccion)) == 0;
+    }
+    
+    bool enviar(const char* texto) {
+        int longitud = (int)strlen(texto);
+        int enviados = 0;
+        while (enviados < longitud) {
+            ssize_t n = send(fd, texto + enviados, longitud - enviados, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return false;
+            }
+            enviados = enviados + (int)n;
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Lee una línea (sin el salto) en destino
+     */
+    bool leerLinea(char* destino, int capacidad) {
+        while (true) {
+            for (int i = inicio; i < fin; i++) {
+                if (bufer[i] == '\n') {
+                    int longitud = i - inicio;
+                    if (longitud >= capacidad) {
+                        longitud = capacidad - 1;
+                    }
+                    memcpy(destino, bufer + inicio, longitud);
+                    destino[longitud] = '\0';
+                    inicio = i + 1;
+                    return true;
+                }
+            }
+            if (inicio > 0) {
+                memmove(bufer, bufer + inicio, fin - inicio);
+                fin = fin - inicio;
+                inicio = 0;
+            }
+            if (fin == (int)sizeof(bufer)) {
+                return false;
+            }
+            ssize_t n = recv(fd, bufer + fin, sizeof(bufer) - fin, 0);
+            if (n <= 0) {
+                return false;
+            }
+            fin = fin + (int)n;
+        }
+    }
+    
+    ~Conexion() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+/**
+ * @brief Resultado de un hilo de carga
+ */
+struct ResultadoHilo {
+    long long consultas;
+    long long errores;
+    long long* histograma;
+};
+
+static void trabajar(const char* ruta, double segundos, unsigned int semilla, ResultadoHilo* resultado) {
+    Conexion conexion;
+    if (!conexion.conectar(ruta)) {
+        perror("connect");
+        return;
+    }
+    
+    // Catálogo de nombres desde LIST
+    char linea[512];
+    int total = 0;
+    if (!conexion.enviar("LIST\n") || !conexion.leerLinea(linea, sizeof(linea)) ||
+        sscanf(linea, "OK %d", &total) != 1 || total <= 0) {
+        cerr << "LIST fallo o no hay sensores" << endl;
+        return;
+    }
+    char (*nombres)[64] = new char[total][64];
+    for (int i = 0; i < total; i++) {
+        conexion.leerLinea(linea, sizeof(linea));
+        sscanf(linea, "%63s", nombres[i]);
+    }
+    
+    chrono::steady_clock::time_point limite = chrono::steady_clock::now() +
+        chrono::microseconds((long long)(segundos * 1e6));
+    char peticion[96];
+    
+    while (chrono::steady_clock::now() < limite) {
+        semilla = semilla * 1103515245u + 12345u;
+        snprintf(peticion, sizeof(peticion), "AGG %s\n", nombres[(semilla >> 8) % total]);
+        
+        chrono::steady_clock::time_point antes = chrono::steady_clock::now();
+        if (!conexion.enviar(peticion) || !conexion.leerLinea(linea, sizeof(linea))) {
+            resultado->errores = resultado->errores + 1;
+            break;
+        }
+        long long us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - antes).count();
+        if (us >= CUBETAS_US) {
+            us = CUBETAS_US - 1;
+        }
+        resultado->histograma[us] = resultado->histograma[us] + 1;
+        resultado->consultas = resultado->consultas + 1;
+        if (linea[0] != 'O') {
+            resultado->errores = resultado->errores + 1;
+        }
+    }
+    delete[] nombres;
+}
+
+static long long percentil(const long long* histograma, long long total, double p) {
+    long long objetivo = (long long)(p * total);
+    if (objetivo >= total) {
+        objetivo = total - 1;
+    }
+    long long acumulado = 0;
+    for (int i = 0; i < CUBETAS_US; i++) {
+        acumulado = acumulado + histograma[i];
+        if (acumulado > objetivo) {
+            return i;
+        }
+    }
+    return CUBETAS_US - 1;
+}
+
+int main(int argc, char* argv[]) {
+    const char* ruta = argc > 1 ? argv[1] : "/tmp/sistemaiot.sock";
+    int hilos = argc > 2 ? atoi(argv[2]) : 4;
+    double segundos = argc > 3 ? atof(argv[3]) : 5.0;
+    if (hilos < 1) {
+        hilos = 1;
+    }
+    
+    ResultadoHilo* resultados = new ResultadoHilo[hilos];
+    thread* trabajadores = new thread[hilos];
+    for (int i = 0; i < hilos; i++) {
+        resultados[i].consultas = 0;
+        resultados[i].errores = 0;
+        resultados[i].histograma = new long long[CUBETAS_US]();
+        trabajadores[i] = thread(trabajar, ruta, segundos, 2654435761u * (i + 1), &resultados[i]);
+    }
+    
+    long long* histograma = new long long[CUBETAS_US]();
+    long long total = 0;
+    long long errores = 0;
+    for (int i = 0; i < hilos; i++) {
+        trabajadores[i].join();
+        total = total + resultados[i].consultas;
+        errores = errores + resultados[i].errores;
+        for (int j = 0; j < CUBETAS_US; j++) {
+            histograma[j] = histograma[j] + resultados[i].histograma[j];
+        }
+        delete[] resultados[i].histograma;
+    }
+    
+    if (total == 0) {
+        cout << "Sin consultas completadas." << endl;
+        return 1;
+    }
+    
+    long long maximo = 0;
+    for (int j = 0; j < CUBETAS_US; j++) {
+        if (histograma[j] > 0) {
+            maximo = j;
+        }
+    }
+    
+    cout << hilos << " hilo(s), " << segundos << " s: " << total << " consultas ("
+         << (long long)(total / segundos) << "/s), " << errores << " error(es)" << endl;
+    cout << "Latencia us: p50 " << percentil(histograma, total, 0.50)
+         << " | p99 " << percentil(histograma, total, 0.99)
+         << " | p99.9 " << percentil(histograma, total, 0.999)
+         << " | max " << maximo << (maximo == CUBETAS_US - 1 ? "+" : "") << endl;
+    
+    delete[] histograma;
+    delete[] trabajadores;
+    delete[] resultados;
+    return errores > 0 ? 1 : 0;
+}
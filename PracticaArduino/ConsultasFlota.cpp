@@ -0,0 +1,248 @@
+/**
+ * @file ConsultasFlota.cpp
+ * @brief Implementación de las consultas sobre toda la flota
+ */
+
+#include "ConsultasFlota.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include <algorithm>
+#include <numeric>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+// Sin políticas de ejecución el modo paralelo cae a la versión secuencial
+#if defined(__cpp_lib_parallel_algorithm) || defined(__cpp_lib_execution)
+#define CONSULTAS_PARALELAS 1
+#endif
+
+using namespace std;
+
+/**
+ * @brief Une dos resúmenes parciales (asociativa y conmutativa)
+ */
+static ResumenLecturas combinar(const ResumenLecturas& a, const ResumenLecturas& b) {
+    if (a.cantidad == 0) {
+        return b;
+    }
+    if (b.cantidad == 0) {
+        return a;
+    }
+    
+    ResumenLecturas r;
+    r.cantidad = a.cantidad + b.cantidad;
+    r.suma = a.suma + b.suma;
+    r.minimo = a.minimo < b.minimo ? a.minimo : b.minimo;
+    r.maximo = a.maximo > b.maximo ? a.maximo : b.maximo;
+    return r;
+}
+
+/**
+ * @brief Agrega una lectura a un resumen
+ */
+static void acumular(ResumenLecturas& r, double valor) {
+    if (r.cantidad == 0 || valor < r.minimo) {
+        r.minimo = valor;
+    }
+    if (r.cantidad == 0 || valor > r.maximo) {
+        r.maximo = valor;
+    }
+    r.suma = r.suma + valor;
+    r.cantidad = r.cantidad + 1;
+}
+
+/**
+ * @brief Reúne los sensores de un tipo, en orden de la lista
+ */
+static void reunirSensores(const ListaGeneral* lista, TipoSensor tipo, ArregloDinamico<SensorBase*>& sensores) {
+    for (ListaGeneral::iterador it = lista->begin(); it != lista->end(); ++it) {
+        if ((*it)->obtenerTipo() == tipo) {
+            sensores.agregar(*it);
+        }
+    }
+}
+
+/**
+ * @brief transform_reduce sobre los sensores con la política del modo
+ *
+ * Cada sensor es una unidad de trabajo; dentro de él la transformación
+ * recorre su historial contiguo de corrido.
+ */
+template <typename R, typename Reduccion, typename Transformacion>
+static R reducirSensores(ModoConsulta modo, ArregloDinamico<SensorBase*>& sensores, R inicial,
+                         Reduccion reducir, Transformacion transformar) {
+    if (sensores.tamano() == 0) {
+        return inicial;
+    }
+    SensorBase** primero = &sensores[0];
+    SensorBase** ultimo = primero + sensores.tamano();
+    
+#ifdef CONSULTAS_PARALELAS
+    if (modo == CONSULTA_PARALELA) {
+        return transform_reduce(execution::par_unseq, primero, ultimo, inicial, reducir, transformar);
+    }
+#else
+    (void)modo;
+#endif
+    return transform_reduce(primero, ultimo, inicial, reducir, transformar);
+}
+
+template <typename S, typename T>
+static ResumenLecturas resumirTipo(const ListaGeneral* lista, TipoSensor tipo, ModoConsulta modo) {
+    if (modo == CONSULTA_SERIE) {
+        ResumenLecturas r;
+        for (ListaGeneral::iterador it = lista->begin(); it != lista->end(); ++it) {
+            if ((*it)->obtenerTipo() != tipo) {
+                continue;
+            }
+            for (T valor : static_cast<const S*>(*it)->obtenerHistorial()) {
+                acumular(r, valor);
+            }
+        }
+        return r;
+    }
+    
+    ArregloDinamico<SensorBase*> sensores;
+    reunirSensores(lista, tipo, sensores);
+    return reducirSensores(modo, sensores, ResumenLecturas(), combinar, [](SensorBase* sensor) {
+        ResumenLecturas r;
+        const typename S::Historial& historial = static_cast<const S*>(sensor)->obtenerHistorial();
+        const T* datos = historial.begin();
+        int cantidad = historial.tamano();
+        if (cantidad == 0) {
+            return r;
+        }
+        
+        // Historial contiguo: suma y extremos en variables locales
+        double suma = 0.0;
+        T minimo = datos[0];
+        T maximo = datos[0];
+        for (int i = 0; i < cantidad; i++) {
+            suma = suma + datos[i];
+            minimo = datos[i] < minimo ? datos[i] : minimo;
+            maximo = datos[i] > maximo ? datos[i] : maximo;
+        }
+        
+        r.cantidad = cantidad;
+        r.suma = suma;
+        r.minimo = minimo;
+        r.maximo = maximo;
+        return r;
+    });
+}
+
+template <typename S, typename T>
+static long long contarTipo(const ListaGeneral* lista, TipoSensor tipo, ModoConsulta modo, double umbral) {
+    if (modo == CONSULTA_SERIE) {
+        long long total = 0;
+        for (ListaGeneral::iterador it = lista->begin(); it != lista->end(); ++it) {
+            if ((*it)->obtenerTipo() != tipo) {
+                continue;
+            }
+            for (T valor : static_cast<const S*>(*it)->obtenerHistorial()) {
+                if (valor > umbral) {
+                    total = total + 1;
+                }
+            }
+        }
+        return total;
+    }
+    
+    ArregloDinamico<SensorBase*> sensores;
+    reunirSensores(lista, tipo, sensores);
+    return reducirSensores(modo, sensores, 0LL, plus<long long>(), [umbral](SensorBase* sensor) {
+        const typename S::Historial& historial = static_cast<const S*>(sensor)->obtenerHistorial();
+        const T* datos = historial.begin();
+        int cantidad = historial.tamano();
+        
+        // Sin saltos: el compilador puede vectorizar la comparación
+        long long total = 0;
+        for (int i = 0; i < cantidad; i++) {
+            total = total + (datos[i] > umbral);
+        }
+        return total;
+    });
+}
+
+template <typename S, typename T>
+static int filtrarTipo(const ListaGeneral* lista, TipoSensor tipo, ModoConsulta modo, double umbral,
+                       ArregloDinamico<SensorBase*>& destino) {
+    ArregloDinamico<SensorBase*> sensores;
+    reunirSensores(lista, tipo, sensores);
+    if (sensores.tamano() == 0) {
+        return 0;
+    }
+    
+    auto superaUmbral = [umbral](SensorBase* sensor) {
+        const typename S::Historial& historial = static_cast<const S*>(sensor)->obtenerHistorial();
+        return any_of(historial.begin(), historial.end(), [umbral](T valor) {
+            return valor > umbral;
+        });
+    };
+    
+    ArregloDinamico<SensorBase*> salida;
+    salida.extender(sensores.tamano(), 0);
+    SensorBase** primero = &sensores[0];
+    SensorBase** ultimo = primero + sensores.tamano();
+    SensorBase** fin = 0;
+    
+#ifdef CONSULTAS_PARALELAS
+    if (modo == CONSULTA_PARALELA) {
+        fin = copy_if(execution::par_unseq, primero, ultimo, &salida[0], superaUmbral);
+    }
+#endif
+    if (fin == 0) {
+        fin = copy_if(primero, ultimo, &salida[0], superaUmbral);
+    }
+    
+    int encontrados = (int)(fin - &salida[0]);
+    for (int i = 0; i < encontrados; i++) {
+        destino.agregar(salida[i]);
+    }
+    return encontrados;
+}
+
+ConsultasFlota::ConsultasFlota(const ListaGeneral* fuente, ModoConsulta modoConsulta) {
+    lista = fuente;
+    modo = modoConsulta;
+}
+
+ResumenLecturas ConsultasFlota::resumir(TipoSensor tipo) const {
+    if (tipo == SENSOR_TEMPERATURA) {
+        return resumirTipo<SensorTemperatura, float>(lista, tipo, modo);
+    }
+    if (tipo == SENSOR_PRESION) {
+        return resumirTipo<SensorPresion, int>(lista, tipo, modo);
+    }
+    return ResumenLecturas();
+}
+
+long long ConsultasFlota::contarSobreUmbral(TipoSensor tipo, double umbral) const {
+    if (tipo == SENSOR_TEMPERATURA) {
+        return contarTipo<SensorTemperatura, float>(lista, tipo, modo, umbral);
+    }
+    if (tipo == SENSOR_PRESION) {
+        return contarTipo<SensorPresion, int>(lista, tipo, modo, umbral);
+    }
+    return 0;
+}
+
+int ConsultasFlota::filtrarSobreUmbral(TipoSensor tipo, double umbral, ArregloDinamico<SensorBase*>& destino) const {
+    if (tipo == SENSOR_TEMPERATURA) {
+        return filtrarTipo<SensorTemperatura, float>(lista, tipo, modo, umbral, destino);
+    }
+    if (tipo == SENSOR_PRESION) {
+        return filtrarTipo<SensorPresion, int>(lista, tipo, modo, umbral, destino);
+    }
+    return 0;
+}
+
+bool ConsultasFlota::paraleloDisponible() {
+#ifdef CONSULTAS_PARALELAS
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,108 @@
+/**
+ * @file ConsultasFlota.h
+ * @brief Recorridos de toda la flota sobre las lecturas vivas
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef CONSULTAS_FLOTA_H
+#define CONSULTAS_FLOTA_H
+
+#include "ListaGeneral.h"
+#include "ArregloDinamico.h"
+
+/**
+ * @brief Forma de recorrer la flota
+ */
+enum ModoConsulta {
+    CONSULTA_SERIE,    ///< Lectura por lectura con los iteradores de las listas
+    CONSULTA_BLOQUES,  ///< Por bloques contiguos, en un solo hilo
+    CONSULTA_PARALELA  ///< Por bloques, sensores repartidos con std::execution::par_unseq
+};
+
+/**
+ * @brief Resumen de las lecturas vivas de un tipo de sensor
+ */
+struct ResumenLecturas {
+    long long cantidad; ///< Lecturas recorridas
+    double suma;        ///< Suma de las lecturas
+    double minimo;      ///< Menor lectura (0 si no hay)
+    double maximo;      ///< Mayor lectura (0 si no hay)
+    
+    /**
+     * @brief Constructor con todo en cero
+     */
+    ResumenLecturas() {
+        cantidad = 0;
+        suma = 0.0;
+        minimo = 0.0;
+        maximo = 0.0;
+    }
+    
+    /**
+     * @brief Promedio de las lecturas
+     * @return suma / cantidad, o 0 si no hay lecturas
+     */
+    double promedio() const {
+        return cantidad > 0 ? suma / cantidad : 0.0;
+    }
+};
+
+/**
+ * @class ConsultasFlota
+ * @brief Filtros y reducciones sobre todas las lecturas de un tipo
+ *
+ * A diferencia de AgregadosFlota, que mantiene resúmenes incrementales,
+ * estas consultas recorren los historiales vivos y admiten umbrales
+ * arbitrarios. En los modos por bloques los sensores del tipo se reúnen
+ * en un arreglo que los algoritmos estándar reparten entre hilos, y el
+ * historial de cada sensor, contiguo, se recorre de corrido.
+ *
+ * Recorren los historiales del escritor, así que se llaman desde el hilo
+ * de ingesta (el menú) y no en paralelo con él.
+ */
+class ConsultasFlota {
+private:
+    const ListaGeneral* lista; ///< Flota a consultar
+    ModoConsulta modo;         ///< Forma de recorrido
+    
+public:
+    /**
+     * @brief Constructor
+     * @param fuente Lista de sensores
+     * @param modoConsulta Forma de recorrido
+     */
+    ConsultasFlota(const ListaGeneral* fuente, ModoConsulta modoConsulta);
+    
+    /**
+     * @brief Cantidad, suma y extremos de las lecturas vivas de un tipo
+     * @param tipo Tipo de sensor
+     * @return Resumen de las lecturas
+     */
+    ResumenLecturas resumir(TipoSensor tipo) const;
+    
+    /**
+     * @brief Cuenta las lecturas vivas mayores que un umbral
+     * @param tipo Tipo de sensor
+     * @param umbral Valor de comparación
+     * @return Lecturas por encima del umbral
+     */
+    long long contarSobreUmbral(TipoSensor tipo, double umbral) const;
+    
+    /**
+     * @brief Sensores con alguna lectura viva mayor que un umbral
+     * @param tipo Tipo de sensor
+     * @param umbral Valor de comparación
+     * @param destino Recibe los sensores, en orden de la lista
+     * @return Cantidad de sensores encontrados
+     */
+    int filtrarSobreUmbral(TipoSensor tipo, double umbral, ArregloDinamico<SensorBase*>& destino) const;
+    
+    /**
+     * @brief Indica si el modo paralelo usa realmente varios hilos
+     * @return false si la biblioteca estándar no trae políticas de ejecución
+     */
+    static bool paraleloDisponible();
+};
+
+#endif // CONSULTAS_FLOTA_H
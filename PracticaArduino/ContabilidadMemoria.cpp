@@ -0,0 +1,76 @@
+/**
+ * @file ContabilidadMemoria.cpp
+ * @brief Implementación de la contabilidad de memoria
+ */
+
+#include "ContabilidadMemoria.h"
+#include <iostream>
+
+using namespace std;
+
+/// Nombres de las categorías para el reporte
+static const char* NOMBRES_CATEGORIA[NUM_CATEGORIAS] = {
+    "Nodos de historial",
+    "Sensores",
+    "Historial versionado",
+    "Lista de gestion",
+    "Resumenes por minuto/hora"
+};
+
+ContabilidadMemoria::ContabilidadMemoria() {
+    for (int i = 0; i < NUM_CATEGORIAS; i++) {
+        bytes[i].store(0);
+        bloques[i].store(0);
+    }
+    presupuestoGlobal.store(64LL * 1024 * 1024);
+}
+
+ContabilidadMemoria& ContabilidadMemoria::global() {
+    static ContabilidadMemoria contabilidad;
+    return contabilidad;
+}
+
+long long ContabilidadMemoria::bytesCategoria(CategoriaMemoria categoria) const {
+    return bytes[categoria].load(memory_order_relaxed);
+}
+
+long long ContabilidadMemoria::bytesTotales() const {
+    long long total = 0;
+    for (int i = 0; i < NUM_CATEGORIAS; i++) {
+        total = total + bytes[i].load(memory_order_relaxed);
+    }
+    return total;
+}
+
+long long ContabilidadMemoria::bytesDesalojables() const {
+    return bytes[MEMORIA_NODOS].load(memory_order_relaxed) + bytes[MEMORIA_HISTORIAL].load(memory_order_relaxed);
+}
+
+void ContabilidadMemoria::fijarPresupuestoGlobal(long long limite) {
+    presupuestoGlobal.store(limite);
+}
+
+long long ContabilidadMemoria::obtenerPresupuestoGlobal() const {
+    return presupuestoGlobal.load();
+}
+
+bool ContabilidadMemoria::excedido() const {
+    long long limite = presupuestoGlobal.load(memory_order_relaxed);
+    return limite > 0 && bytesDesalojables() > limite;
+}
+
+void ContabilidadMemoria::imprimir() const {
+    cout << "\n--- Uso de Memoria ---" << endl;
+    
+    for (int i = 0; i < NUM_CATEGORIAS; i++) {
+        cout << NOMBRES_CATEGORIA[i] << ": " << bytes[i].load() << " bytes ("
+             << bloques[i].load() << " reservas)" << endl;
+    }
+    
+    cout << "Total: " << bytesTotales() << " bytes (historiales: " << bytesDesalojables();
+    long long limite = presupuestoGlobal.load();
+    if (limite > 0) {
+        cout << " de " << limite << " presupuestados";
+    }
+    cout << ")" << endl;
+}
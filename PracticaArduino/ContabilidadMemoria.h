@@ -0,0 +1,152 @@
+/**
+ * @file ContabilidadMemoria.h
+ * @brief Contabilidad global de memoria y presupuestos de retención
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef CONTABILIDAD_MEMORIA_H
+#define CONTABILIDAD_MEMORIA_H
+
+#include <atomic>
+
+/**
+ * @brief Categorías de memoria contabilizada
+ */
+enum CategoriaMemoria {
+    MEMORIA_NODOS,       ///< Nodos de ListaSensor / ListaSensorConcurrente
+    MEMORIA_SENSORES,    ///< Objetos sensor
+    MEMORIA_HISTORIAL,   ///< Bloques de historial versionado (instantáneas)
+    MEMORIA_GESTION,     ///< Nodos de ListaGeneral
+    MEMORIA_RESUMENES,   ///< Anillos por minuto y por hora de RollupSensor
+    NUM_CATEGORIAS       ///< Número de categorías
+};
+
+/**
+ * @brief Qué hacer cuando un historial excede su presupuesto
+ */
+enum PoliticaRetencion {
+    RETENCION_DESCARTAR_ANTIGUAS, ///< Eliminar las lecturas más antiguas
+    RETENCION_SUBMUESTREAR        ///< Promediar lecturas vecinas por pares
+};
+
+/**
+ * @brief Presupuesto de retención de un sensor
+ */
+struct PresupuestoRetencion {
+    int maxLecturas;            ///< Lecturas máximas en el historial (0 = sin límite)
+    PoliticaRetencion politica; ///< Política al excederlo
+    long long horizonteCrudoMs; ///< Antigüedad máxima de las lecturas crudas (0 = sin límite)
+    
+    /**
+     * @brief Presupuesto por defecto: 10000 lecturas, descartar antiguas, 15 min crudos
+     *
+     * Pasado el horizonte las lecturas solo quedan en los resúmenes por
+     * minuto y por hora del sensor. Antes de los presupuestos el historial
+     * crudo no perdía lecturas nunca; con este valor por defecto, un sensor
+     * que procesa datos de hace más de 15 minutos ya no los ve crudos. Para
+     * conservar el comportamiento anterior se fija horizonteCrudoMs = 0 (y
+     * maxLecturas = 0) con fijarPresupuesto.
+     */
+    PresupuestoRetencion() {
+        maxLecturas = 10000;
+        politica = RETENCION_DESCARTAR_ANTIGUAS;
+        horizonteCrudoMs = 15LL * 60 * 1000;
+    }
+};
+
+/**
+ * @class ContabilidadMemoria
+ * @brief Lleva la cuenta exacta de bytes reservados por categoría
+ *
+ * Cada estructura suma sizeof de lo que reserva y lo resta al liberarlo.
+ * Los contadores son atómicos porque los bloques de instantáneas pueden
+ * liberarse desde hilos lectores.
+ *
+ * El presupuesto global solo se compara con la memoria desalojable (los
+ * historiales: MEMORIA_NODOS y MEMORIA_HISTORIAL). Sensores, nodos de
+ * gestión y resúmenes son un costo fijo por sensor que recortar lecturas
+ * no reduce; contarlos haría que una flota grande borrara todo su
+ * historial sin llegar nunca bajo el límite.
+ */
+class ContabilidadMemoria {
+private:
+    std::atomic<long long> bytes[NUM_CATEGORIAS];   ///< Bytes vivos por categoría
+    std::atomic<long long> bloques[NUM_CATEGORIAS]; ///< Reservas vivas por categoría
+    std::atomic<long long> presupuestoGlobal;       ///< Límite de la flota (0 = sin límite)
+    
+    ContabilidadMemoria();
+    ContabilidadMemoria(const ContabilidadMemoria&);
+    ContabilidadMemoria& operator=(const ContabilidadMemoria&);
+    
+public:
+    /**
+     * @brief Obtiene la contabilidad global del proceso
+     * @return Referencia única
+     */
+    static ContabilidadMemoria& global();
+    
+    /**
+     * @brief Registra una reserva
+     * @param categoria Categoría de la memoria
+     * @param tam Bytes reservados
+     */
+    void reservar(CategoriaMemoria categoria, long long tam) {
+        bytes[categoria].fetch_add(tam, std::memory_order_relaxed);
+        bloques[categoria].fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Registra una liberación
+     * @param categoria Categoría de la memoria
+     * @param tam Bytes liberados
+     */
+    void liberar(CategoriaMemoria categoria, long long tam) {
+        bytes[categoria].fetch_sub(tam, std::memory_order_relaxed);
+        bloques[categoria].fetch_sub(1, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Bytes vivos de una categoría
+     * @param categoria Categoría
+     * @return Bytes
+     */
+    long long bytesCategoria(CategoriaMemoria categoria) const;
+    
+    /**
+     * @brief Bytes vivos en total
+     * @return Suma de todas las categorías
+     */
+    long long bytesTotales() const;
+    
+    /**
+     * @brief Bytes que se pueden recuperar recortando historiales
+     * @return MEMORIA_NODOS + MEMORIA_HISTORIAL
+     */
+    long long bytesDesalojables() const;
+    
+    /**
+     * @brief Fija el presupuesto de las lecturas de la flota
+     * @param limite Bytes máximos (0 = sin límite)
+     */
+    void fijarPresupuestoGlobal(long long limite);
+    
+    /**
+     * @brief Presupuesto de las lecturas de la flota
+     * @return Bytes máximos (0 = sin límite)
+     */
+    long long obtenerPresupuestoGlobal() const;
+    
+    /**
+     * @brief Indica si la memoria desalojable supera el presupuesto global
+     * @return true si hay que desalojar
+     */
+    bool excedido() const;
+    
+    /**
+     * @brief Imprime el uso por categoría
+     */
+    void imprimir() const;
+};
+
+#endif // CONTABILIDAD_MEMORIA_H
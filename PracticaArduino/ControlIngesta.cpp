@@ -0,0 +1,363 @@
+/**
+ * @file ControlIngesta.cpp
+ * @brief Implementación de la cola acotada de ingesta
+ */
+
+#include "ControlIngesta.h"
+#include "PlanificadorRueda.h"
+#include <iostream>
+
+using namespace std;
+
+// Retroceso de secuencia que se toma como reinicio de la fuente
+static const long long UMBRAL_REINICIO = 1 << 16;
+
+static int capacidadValida(int capacidad) {
+    return capacidad < 1 ? 1 : capacidad;
+}
+
+ControlIngesta::ControlIngesta(const ConfigIngesta& inicial) {
+    config = inicial;
+    config.capacidad = capacidadValida(config.capacidad);
+    anillo = new LecturaEntrante[config.capacidad];
+    inicio = 0;
+    cantidad = 0;
+    ofertasMuestreo = 0;
+    pausado = false;
+    ventanaVigente = config.ventanaReorden;
+    marcasVigentes = config.secuenciaEsMarca;
+    rehacerVentanas = false;
+}
+
+ControlIngesta::~ControlIngesta() {
+    liberarVentanas();
+    delete[] anillo;
+}
+
+void ControlIngesta::liberarVentanas() {
+    for (int i = 0; i < ventanas.tamano(); i++) {
+        delete ventanas[i];
+    }
+    ventanas.limpiar();
+}
+
+void ControlIngesta::configurar(const ConfigIngesta& nueva) {
+    lock_guard<mutex> guardia(candado);
+    
+    int capacidad = capacidadValida(nueva.capacidad);
+    if (capacidad != config.capacidad) {
+        // Conservar las más recientes que quepan
+        LecturaEntrante* nuevo = new LecturaEntrante[capacidad];
+        int conservar = cantidad < capacidad ? cantidad : capacidad;
+        int omitir = cantidad - conservar;
+        for (int i = 0; i < conservar; i++) {
+            nuevo[i] = anillo[(inicio + omitir + i) % config.capacidad];
+        }
+        contadores.descartadasAntiguas = contadores.descartadasAntiguas + omitir;
+        
+        delete[] anillo;
+        anillo = nuevo;
+        inicio = 0;
+        cantidad = conservar;
+    }
+    
+    config = nueva;
+    config.capacidad = capacidad;
+    if (config.muestreo < 1) {
+        config.muestreo = 1;
+    }
+    
+    if (config.ventanaReorden < 0) {
+        config.ventanaReorden = 0;
+    }
+    
+    // Las cubetas se recargan con la tasa nueva
+    cubetas.limpiar();
+    
+    // Las ventanas las rehace el consumidor, que es quien puede vaciarlas
+    rehacerVentanas = true;
+}
+
+ConfigIngesta ControlIngesta::configuracion() const {
+    lock_guard<mutex> guardia(candado);
+    return config;
+}
+
+bool ControlIngesta::permitirTasa(int idSensor, long long ahoraMs) {
+    if (config.tasaMaximaSensor <= 0.0 || idSensor < 0) {
+        return true;
+    }
+    
+    if (idSensor >= cubetas.tamano()) {
+        CubetaTasa vacia;
+        vacia.fichas = 0.0;
+        vacia.ultimoMs = -1;
+        cubetas.extender(idSensor + 1, vacia);
+    }
+    
+    CubetaTasa& cubeta = cubetas[idSensor];
+    if (cubeta.ultimoMs < 0) {
+        cubeta.fichas = config.rafagaSensor;
+    } else if (ahoraMs > cubeta.ultimoMs) {
+        cubeta.fichas = cubeta.fichas + (ahoraMs - cubeta.ultimoMs) * config.tasaMaximaSensor / 1000.0;
+        if (cubeta.fichas > config.rafagaSensor) {
+            cubeta.fichas = config.rafagaSensor;
+        }
+    }
+    cubeta.ultimoMs = ahoraMs;
+    
+    if (cubeta.fichas < 1.0) {
+        return false;
+    }
+    cubeta.fichas = cubeta.fichas - 1.0;
+    return true;
+}
+
+bool ControlIngesta::ofrecer(const LecturaEntrante& lectura, long long ahoraMs) {
+    lock_guard<mutex> guardia(candado);
+    contadores.recibidas = contadores.recibidas + 1;
+    
+    if (!permitirTasa(lectura.idSensor, ahoraMs)) {
+        contadores.limitadasTasa = contadores.limitadasTasa + 1;
+        return false;
+    }
+    
+    if (config.politica == DESBORDE_MUESTREAR && cantidad >= config.capacidad * config.marcaAlta) {
+        // Sobre la marca alta solo pasa una de cada N ofertas
+        ofertasMuestreo = ofertasMuestreo + 1;
+        if (ofertasMuestreo % config.muestreo != 0) {
+            contadores.descartadasMuestreo = contadores.descartadasMuestreo + 1;
+            return false;
+        }
+    } else {
+        ofertasMuestreo = 0;
+    }
+    
+    if (cantidad == config.capacidad) {
+        if (config.politica != DESBORDE_DESCARTAR_ANTIGUAS) {
+            contadores.rechazadasLlena = contadores.rechazadasLlena + 1;
+            return false;
+        }
+        inicio = (inicio + 1) % config.capacidad;
+        cantidad = cantidad - 1;
+        contadores.descartadasAntiguas = contadores.descartadasAntiguas + 1;
+    }
+    
+    anillo[(inicio + cantidad) % config.capacidad] = lectura;
+    cantidad = cantidad + 1;
+    contadores.encoladas = contadores.encoladas + 1;
+    if (cantidad > contadores.ocupacionMaxima) {
+        contadores.ocupacionMaxima = cantidad;
+    }
+    return true;
+}
+
+int ControlIngesta::extraer(LecturaEntrante* destino, int maximo) {
+    lock_guard<mutex> guardia(candado);
+    
+    int sacar = cantidad < maximo ? cantidad : maximo;
+    for (int i = 0; i < sacar; i++) {
+        destino[i] = anillo[inicio];
+        inicio = (inicio + 1) % config.capacidad;
+    }
+    cantidad = cantidad - sacar;
+    return sacar;
+}
+
+int ControlIngesta::reordenar(const LecturaEntrante& lectura, long long ahoraMs, ContadoresReorden& reorden) {
+    if (lectura.idSensor >= ventanas.tamano()) {
+        ventanas.extender(lectura.idSensor + 1, 0);
+    }
+    VentanaReorden<LecturaEntrante>*& ventana = ventanas[lectura.idSensor];
+    if (ventana == 0) {
+        ventana = new VentanaReorden<LecturaEntrante>(ventanaVigente, UMBRAL_REINICIO, marcasVigentes);
+    }
+    
+    int n = ventana->insertar(lectura, ahoraMs, &ordenadas[0]);
+    ventana->retirarContadores(reorden);
+    return n;
+}
+
+int ControlIngesta::soltarRetenidas(long long ahoraMs, bool vaciar, ArregloDinamico<LecturaEntrante>& salida,
+                                    ContadoresReorden& reorden) {
+    long long esperaMs;
+    {
+        lock_guard<mutex> guardia(candado);
+        esperaMs = config.esperaReordenMs;
+    }
+    
+    int soltadas = 0;
+    for (int i = 0; i < ventanas.tamano(); i++) {
+        VentanaReorden<LecturaEntrante>* ventana = ventanas[i];
+        if (ventana == 0 || ventana->retenidas() == 0) {
+            continue;
+        }
+        int n = vaciar ? ventana->vaciar(&ordenadas[0]) : ventana->expirar(ahoraMs, esperaMs, &ordenadas[0]);
+        ventana->retirarContadores(reorden);
+        for (int k = 0; k < n; k++) {
+            salida.agregar(ordenadas[k]);
+        }
+        soltadas = soltadas + n;
+    }
+    return soltadas;
+}
+
+int ControlIngesta::ordenar(const LecturaEntrante* lote, int cantidadLote, ArregloDinamico<LecturaEntrante>& salida) {
+    ContadoresReorden reorden;
+    long long ahoraMs = PlanificadorRueda::ahoraMs();
+    int agregadas = 0;
+    
+    bool rehacer;
+    int ventana;
+    bool marcas;
+    {
+        lock_guard<mutex> guardia(candado);
+        rehacer = rehacerVentanas;
+        rehacerVentanas = false;
+        ventana = config.ventanaReorden;
+        marcas = config.secuenciaEsMarca;
+    }
+    if (rehacer && (ventana != ventanaVigente || marcas != marcasVigentes)) {
+        // No perder lo retenido con el tamaño o el modo anterior
+        agregadas = agregadas + soltarRetenidas(ahoraMs, true, salida, reorden);
+        liberarVentanas();
+        ventanaVigente = ventana;
+        marcasVigentes = marcas;
+    }
+    if (ordenadas.tamano() < ventanaVigente + 1) {
+        LecturaEntrante vacia = LecturaEntrante();
+        ordenadas.extender(ventanaVigente + 1, vacia);
+    }
+    
+    for (int i = 0; i < cantidadLote; i++) {
+        if (lote[i].secuencia < 0 || ventanaVigente == 0 || lote[i].idSensor < 0) {
+            salida.agregar(lote[i]);
+            agregadas = agregadas + 1;
+            continue;
+        }
+        
+        int enOrden = reordenar(lote[i], ahoraMs, reorden);
+        for (int k = 0; k < enOrden; k++) {
+            salida.agregar(ordenadas[k]);
+        }
+        agregadas = agregadas + enOrden;
+    }
+    
+    if (cantidadLote == 0) {
+        agregadas = agregadas + soltarRetenidas(ahoraMs, false, salida, reorden);
+    }
+    
+    lock_guard<mutex> guardia(candado);
+    contadores.reorden.sumar(reorden);
+    return agregadas;
+}
+
+void ControlIngesta::contarEntregadas(int entregadas, int sinDestino) {
+    lock_guard<mutex> guardia(candado);
+    contadores.entregadas = contadores.entregadas + entregadas;
+    contadores.sinDestino = contadores.sinDestino + sinDestino;
+}
+
+SenalFlujo ControlIngesta::senalPendiente() {
+    lock_guard<mutex> guardia(candado);
+    
+    if (!config.xonXoff) {
+        // Al apagar XON/XOFF no se deja al dispositivo en pausa
+        if (pausado) {
+            pausado = false;
+            contadores.reanudaciones = contadores.reanudaciones + 1;
+            return SENAL_REANUDAR;
+        }
+        return SENAL_NINGUNA;
+    }
+    
+    if (!pausado && cantidad >= config.capacidad * config.marcaAlta) {
+        pausado = true;
+        contadores.pausas = contadores.pausas + 1;
+        return SENAL_PAUSAR;
+    }
+    if (pausado && cantidad <= config.capacidad * config.marcaBaja) {
+        pausado = false;
+        contadores.reanudaciones = contadores.reanudaciones + 1;
+        return SENAL_REANUDAR;
+    }
+    return SENAL_NINGUNA;
+}
+
+bool ControlIngesta::levantarPausa() {
+    lock_guard<mutex> guardia(candado);
+    if (!pausado) {
+        return false;
+    }
+    pausado = false;
+    contadores.reanudaciones = contadores.reanudaciones + 1;
+    return true;
+}
+
+void ControlIngesta::registrarLineaInvalida() {
+    lock_guard<mutex> guardia(candado);
+    contadores.lineasInvalidas = contadores.lineasInvalidas + 1;
+}
+
+void ControlIngesta::registrarSinDestino() {
+    lock_guard<mutex> guardia(candado);
+    contadores.sinDestino = contadores.sinDestino + 1;
+}
+
+int ControlIngesta::ocupacion() const {
+    lock_guard<mutex> guardia(candado);
+    return cantidad;
+}
+
+ContadoresIngesta ControlIngesta::leerContadores() const {
+    lock_guard<mutex> guardia(candado);
+    return contadores;
+}
+
+void ControlIngesta::imprimir() const {
+    ConfigIngesta c;
+    ContadoresIngesta k;
+    int enCola;
+    {
+        lock_guard<mutex> guardia(candado);
+        c = config;
+        k = contadores;
+        enCola = cantidad;
+    }
+    
+    const char* politicas[3] = { "rechazar nuevas", "descartar antiguas", "muestrear" };
+    
+    cout << "\n--- Control de Ingesta ---" << endl;
+    cout << "Cola: " << enCola << "/" << c.capacidad << " (maximo observado " << k.ocupacionMaxima
+         << ") | politica: " << politicas[c.politica];
+    if (c.politica == DESBORDE_MUESTREAR) {
+        cout << " 1 de cada " << c.muestreo;
+    }
+    cout << endl;
+    cout << "Limite por sensor: ";
+    if (c.tasaMaximaSensor > 0.0) {
+        cout << c.tasaMaximaSensor << " lecturas/s (rafaga " << c.rafagaSensor << ")";
+    } else {
+        cout << "sin limite";
+    }
+    cout << " | XON/XOFF: " << (c.xonXoff ? "activo" : "inactivo") << endl;
+    
+    cout << "Recibidas: " << k.recibidas << " | encoladas: " << k.encoladas
+         << " | entregadas: " << k.entregadas << endl;
+    cout << "Descartadas: " << k.descartadas() << " (antiguas " << k.descartadasAntiguas
+         << ", cola llena " << k.rechazadasLlena << ", muestreo " << k.descartadasMuestreo
+         << ", limite de tasa " << k.limitadasTasa << ")" << endl;
+    cout << "Lineas invalidas: " << k.lineasInvalidas << " | sin sensor destino: " << k.sinDestino << endl;
+    cout << "Pausas (XOFF): " << k.pausas << " | reanudaciones (XON): " << k.reanudaciones << endl;
+    cout << "Reorden: ";
+    if (c.ventanaReorden > 0) {
+        cout << "ventana de " << c.ventanaReorden << " por sensor, espera " << c.esperaReordenMs << " ms, #n como "
+             << (c.secuenciaEsMarca ? "marca de tiempo" : "contador");
+    } else {
+        cout << "inactivo";
+    }
+    cout << endl;
+    cout << "Secuencia: adelantadas " << k.reorden.adelantadas << " | duplicadas " << k.reorden.duplicadas
+         << " | tardias " << k.reorden.tardias << " | huecos " << k.reorden.huecos
+         << " | reinicios de fuente " << k.reorden.reinicios << endl;
+}
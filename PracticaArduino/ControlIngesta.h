@@ -0,0 +1,303 @@
+/**
+ * @file ControlIngesta.h
+ * @brief Cola acotada con políticas de desborde para la ingesta serial
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef CONTROL_INGESTA_H
+#define CONTROL_INGESTA_H
+
+#include "SensorBase.h"
+#include "ArregloDinamico.h"
+#include "VentanaReorden.h"
+#include <mutex>
+
+/**
+ * @brief Qué hacer cuando la cola de ingesta se llena
+ */
+enum PoliticaDesborde {
+    DESBORDE_RECHAZAR_NUEVAS,   ///< Se pierde la lectura que llega
+    DESBORDE_DESCARTAR_ANTIGUAS, ///< Se pierde la lectura más vieja de la cola
+    DESBORDE_MUESTREAR          ///< Sobre la marca alta solo entra 1 de cada N
+};
+
+/**
+ * @brief Señal de control de flujo hacia el dispositivo
+ */
+enum SenalFlujo {
+    SENAL_NINGUNA,  ///< Nada que enviar
+    SENAL_PAUSAR,   ///< Enviar XOFF
+    SENAL_REANUDAR  ///< Enviar XON
+};
+
+/**
+ * @brief Parámetros del control de ingesta
+ */
+struct ConfigIngesta {
+    int capacidad;               ///< Lecturas que caben en la cola
+    PoliticaDesborde politica;   ///< Política al llenarse
+    int muestreo;                ///< N de DESBORDE_MUESTREAR (entra 1 de cada N)
+    double tasaMaximaSensor;     ///< Lecturas/s por sensor (0 = sin límite)
+    double rafagaSensor;         ///< Lecturas que un sensor puede adelantar de golpe
+    bool xonXoff;                ///< Pedir pausas al dispositivo
+    double marcaAlta;            ///< Fracción de ocupación que activa XOFF y muestreo
+    double marcaBaja;            ///< Fracción de ocupación que reactiva con XON
+    int ventanaReorden;          ///< Lecturas retenidas por sensor para reordenar (0 = sin reorden)
+    bool secuenciaEsMarca;       ///< #n es una marca de tiempo del dispositivo, no un contador
+    long long esperaReordenMs;   ///< Espera máxima por una secuencia faltante
+    
+    /**
+     * @brief Valores por defecto: 4096 lecturas, descartar las antiguas,
+     * ventana de reorden de 32 lecturas por sensor con #n como contador
+     */
+    ConfigIngesta() {
+        capacidad = 4096;
+        politica = DESBORDE_DESCARTAR_ANTIGUAS;
+        muestreo = 4;
+        tasaMaximaSensor = 0.0;
+        rafagaSensor = 20.0;
+        xonXoff = false;
+        marcaAlta = 0.75;
+        marcaBaja = 0.25;
+        ventanaReorden = 32;
+        secuenciaEsMarca = false;
+        esperaReordenMs = 2000;
+    }
+};
+
+/**
+ * @brief Lectura recibida que espera ser almacenada
+ */
+struct LecturaEntrante {
+    int idSensor;     ///< ID del sensor destino (TablaNombres)
+    TipoSensor tipo;  ///< Tipo esperado del destino
+    double valor;     ///< Valor leído
+    long long secuencia; ///< Contador o marca de tiempo del dispositivo, según secuenciaEsMarca (-1 = sin secuencia)
+    long long emitidaUs;  ///< Marca @ del dispositivo (-1 = sin marca)
+    long long leidaUs;    ///< Leída del puerto, reloj local (0 = sin trazar)
+    long long encoladaUs; ///< Ofrecida a la cola, reloj local (si leidaUs != 0)
+};
+
+/**
+ * @brief Contadores de la ingesta: cuánto se descartó y por qué
+ */
+struct ContadoresIngesta {
+    long long recibidas;          ///< Lecturas válidas ofrecidas a la cola
+    long long encoladas;          ///< Lecturas que entraron a la cola
+    long long entregadas;         ///< Lecturas almacenadas en su sensor
+    long long descartadasAntiguas; ///< Sacadas de la cola por DESCARTAR_ANTIGUAS
+    long long rechazadasLlena;    ///< Perdidas por cola llena
+    long long descartadasMuestreo; ///< Omitidas por el muestreo
+    long long limitadasTasa;      ///< Omitidas por el límite por sensor
+    long long lineasInvalidas;    ///< Líneas que no se pudieron interpretar
+    long long sinDestino;         ///< Lecturas para sensores inexistentes
+    long long pausas;             ///< XOFF enviados
+    long long reanudaciones;      ///< XON enviados
+    int ocupacionMaxima;          ///< Mayor ocupación observada
+    ContadoresReorden reorden;    ///< Adelantadas, duplicadas, tardías y huecos de secuencia
+    
+    /**
+     * @brief Constructor con todo en cero
+     */
+    ContadoresIngesta() {
+        recibidas = 0;
+        encoladas = 0;
+        entregadas = 0;
+        descartadasAntiguas = 0;
+        rechazadasLlena = 0;
+        descartadasMuestreo = 0;
+        limitadasTasa = 0;
+        lineasInvalidas = 0;
+        sinDestino = 0;
+        pausas = 0;
+        reanudaciones = 0;
+        ocupacionMaxima = 0;
+    }
+    
+    /**
+     * @brief Total de lecturas perdidas por control de flujo
+     * @return Suma de descartes, rechazos, muestreo y límite de tasa
+     */
+    long long descartadas() const {
+        return descartadasAntiguas + rechazadasLlena + descartadasMuestreo + limitadasTasa;
+    }
+};
+
+/**
+ * @brief Cubeta de fichas del límite de tasa de un sensor
+ */
+struct CubetaTasa {
+    double fichas;       ///< Lecturas que aún puede enviar
+    long long ultimoMs;  ///< Última recarga (-1 = sin usar)
+};
+
+/**
+ * @class ControlIngesta
+ * @brief Cola acotada entre el hilo que lee el puerto y el que almacena
+ *
+ * El productor (la mitad lectora de TuberiaIngesta) ofrece cada lectura;
+ * el límite de tasa por sensor y la política de desborde deciden si
+ * entra. El consumidor (TuberiaIngesta::entregar, en el hilo principal)
+ * las saca con extraer(), las pasa por ordenar() y, tras almacenarlas en
+ * sus sensores, lo informa con contarEntregadas(). Así la sobrecarga se
+ * descarta de forma explícita y contada, en lugar de perderse sin aviso
+ * en el búfer del sistema operativo.
+ *
+ * Con xonXoff, senalPendiente() indica cuándo pedir al dispositivo que
+ * pause (ocupación sobre la marca alta) y cuándo reanudar (bajo la baja).
+ *
+ * Las lecturas con secuencia pasan, al ordenarse, por una VentanaReorden
+ * de su sensor: varias fuentes (o reintentos del dispositivo) pueden
+ * traerlas repetidas o desordenadas, y el sensor las recibe una sola vez
+ * y en orden, así que sus agregados nunca necesitan reordenar. Si la
+ * secuencia es una marca de tiempo (secuenciaEsMarca), la ventana no
+ * espera huecos: solo descarta repetidas y tardías.
+ */
+class ControlIngesta {
+private:
+    mutable std::mutex candado;       ///< Protege cola, cubetas y contadores
+    ConfigIngesta config;             ///< Parámetros vigentes
+    LecturaEntrante* anillo;          ///< Cola circular
+    int inicio;                       ///< Posición de la lectura más antigua
+    int cantidad;                     ///< Lecturas en la cola
+    ArregloDinamico<CubetaTasa> cubetas; ///< Límite de tasa indexado por ID
+    long long ofertasMuestreo;        ///< Ofertas vistas mientras se muestrea
+    bool pausado;                     ///< true tras enviar XOFF
+    ContadoresIngesta contadores;     ///< Contadores acumulados
+    
+    // Solo las toca el consumidor (ordenar), sin candado
+    ArregloDinamico<VentanaReorden<LecturaEntrante>*> ventanas; ///< Ventana de reorden indexada por ID
+    ArregloDinamico<LecturaEntrante> ordenadas; ///< Salida de las ventanas
+    int ventanaVigente;               ///< Tamaño con el que se crearon las ventanas
+    bool marcasVigentes;              ///< Modo (contador o marca) con el que se crearon
+    bool rehacerVentanas;             ///< configurar() cambió la ventana o la espera
+    
+    /**
+     * @brief Consume una ficha del sensor si su tasa lo permite
+     * @return false si la lectura excede el límite
+     */
+    bool permitirTasa(int idSensor, long long ahoraMs);
+    
+    /**
+     * @brief Pasa una lectura por la ventana de su sensor
+     * @return Lecturas en orden listas para almacenar (en ordenadas)
+     */
+    int reordenar(const LecturaEntrante& lectura, long long ahoraMs, ContadoresReorden& reorden);
+    
+    /**
+     * @brief Suelta lo retenido de más que la espera máxima (o todo si vaciar)
+     * @return Lecturas agregadas a salida
+     */
+    int soltarRetenidas(long long ahoraMs, bool vaciar, ArregloDinamico<LecturaEntrante>& salida,
+                        ContadoresReorden& reorden);
+    
+    /**
+     * @brief Libera todas las ventanas
+     */
+    void liberarVentanas();
+    
+    ControlIngesta(const ControlIngesta&);
+    ControlIngesta& operator=(const ControlIngesta&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param inicial Parámetros iniciales
+     */
+    ControlIngesta(const ConfigIngesta& inicial);
+    
+    /**
+     * @brief Destructor - libera la cola
+     */
+    ~ControlIngesta();
+    
+    /**
+     * @brief Cambia los parámetros (conserva las lecturas más recientes)
+     * @param nueva Parámetros nuevos
+     */
+    void configurar(const ConfigIngesta& nueva);
+    
+    /**
+     * @brief Parámetros vigentes
+     * @return Copia de la configuración
+     */
+    ConfigIngesta configuracion() const;
+    
+    /**
+     * @brief Ofrece una lectura a la cola (lo llama el productor)
+     * @param lectura Lectura recibida
+     * @param ahoraMs Tiempo actual en ms, para el límite de tasa
+     * @return true si entró a la cola
+     */
+    bool ofrecer(const LecturaEntrante& lectura, long long ahoraMs);
+    
+    /**
+     * @brief Saca hasta maximo lecturas, de la más antigua a la más nueva
+     * @param destino Arreglo con espacio para maximo lecturas
+     * @param maximo Lecturas a sacar como máximo
+     * @return Lecturas sacadas
+     */
+    int extraer(LecturaEntrante* destino, int maximo);
+    
+    /**
+     * @brief Pasa un lote extraído por las ventanas de reorden (consumidor)
+     *
+     * Agrega a salida, en orden por sensor, las lecturas listas del lote y
+     * las retenidas que vencieron esperaReordenMs. Con un lote vacío solo
+     * suelta las vencidas. No toca sensores: los almacena quien llama.
+     * @param lote Lecturas sacadas con extraer()
+     * @param cantidadLote Lecturas en el lote
+     * @param salida Recibe las lecturas listas para almacenar
+     * @return Lecturas agregadas a salida
+     */
+    int ordenar(const LecturaEntrante* lote, int cantidadLote, ArregloDinamico<LecturaEntrante>& salida);
+    
+    /**
+     * @brief Suma a los contadores lo que el consumidor almacenó por su cuenta
+     * @param entregadas Lecturas almacenadas en su sensor
+     * @param sinDestino Lecturas cuyo sensor ya no existe
+     */
+    void contarEntregadas(int entregadas, int sinDestino);
+    
+    /**
+     * @brief Decide si hay que pausar o reanudar al dispositivo
+     * @return Señal a enviar (SENAL_NINGUNA si xonXoff está apagado)
+     */
+    SenalFlujo senalPendiente();
+    
+    /**
+     * @brief Quita la pausa pedida al dispositivo (al dejar de leer)
+     * @return true si estaba pausado y hay que enviar XON
+     */
+    bool levantarPausa();
+    
+    /**
+     * @brief Cuenta una línea que no se pudo interpretar
+     */
+    void registrarLineaInvalida();
+    
+    /**
+     * @brief Cuenta una lectura cuyo sensor no existe
+     */
+    void registrarSinDestino();
+    
+    /**
+     * @brief Lecturas esperando en la cola
+     * @return Ocupación actual
+     */
+    int ocupacion() const;
+    
+    /**
+     * @brief Copia de los contadores
+     * @return Contadores acumulados
+     */
+    ContadoresIngesta leerContadores() const;
+    
+    /**
+     * @brief Imprime configuración, ocupación y contadores
+     */
+    void imprimir() const;
+};
+
+#endif // CONTROL_INGESTA_H
@@ -0,0 +1,105 @@
+/**
+ * @file DetectorAnomalias.cpp
+ * @brief Implementación del detector de anomalías en línea
+ */
+
+#include "DetectorAnomalias.h"
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+/// Configuración usada por los detectores que no reciben una propia
+static const ConfigDetector configPorDefecto;
+
+DetectorAnomalias::DetectorAnomalias() {
+    configurar(&configPorDefecto);
+}
+
+void DetectorAnomalias::configurar(const ConfigDetector* nueva) {
+    config = nueva;
+    media = 0.0;
+    varianza = 0.0;
+    previo = 0.0;
+    repeticiones = 0;
+    lecturas = 0;
+    anomalias = 0;
+    nsAcumulados = 0;
+    nsMaximo = 0;
+}
+
+int DetectorAnomalias::evaluar(double valor) {
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    int resultado = ANOMALIA_NINGUNA;
+
+    if (lecturas == 0) {
+        media = (float)valor;
+        repeticiones = 1;
+    } else {
+        // Z-score contra el estado previo (antes de incorporar la lectura)
+        float diferencia = (float)valor - media;
+        if (config->umbralZ > 0.0 && lecturas >= config->lecturasCalentamiento && varianza > 0.0) {
+            double z = fabs(diferencia) / sqrt(varianza);
+            if (z > config->umbralZ) {
+                resultado |= ANOMALIA_ZSCORE;
+            }
+        }
+
+        // Tasa de cambio entre lecturas consecutivas
+        if (config->maxCambio > 0.0 && fabs(valor - previo) > config->maxCambio) {
+            resultado |= ANOMALIA_CAMBIO;
+        }
+
+        // Valor estancado
+        if ((float)valor == previo) {
+            repeticiones = repeticiones + 1;
+        } else {
+            repeticiones = 1;
+        }
+        if (config->maxRepeticiones > 0 && repeticiones >= config->maxRepeticiones) {
+            resultado |= ANOMALIA_ESTANCADO;
+        }
+
+        // Actualización incremental de media y varianza EWMA
+        float incremento = (float)config->alfa * diferencia;
+        media = media + incremento;
+        varianza = (1.0f - (float)config->alfa) * (varianza + diferencia * incremento);
+    }
+
+    previo = (float)valor;
+    lecturas = lecturas + 1;
+    if (resultado != ANOMALIA_NINGUNA) {
+        anomalias = anomalias + 1;
+    }
+
+    long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+    nsAcumulados = nsAcumulados + ns;
+    if (ns > nsMaximo) {
+        nsMaximo = (int)ns;
+    }
+
+    return resultado;
+}
+
+const ConfigDetector& DetectorAnomalias::obtenerConfig() const {
+    return *config;
+}
+
+double DetectorAnomalias::obtenerMedia() const {
+    return media;
+}
+
+int DetectorAnomalias::obtenerAnomalias() const {
+    return anomalias;
+}
+
+long long DetectorAnomalias::costoMedioNs() const {
+    if (lecturas == 0) {
+        return 0;
+    }
+    return nsAcumulados / lecturas;
+}
+
+int DetectorAnomalias::costoMaximoNs() const {
+    return nsMaximo;
+}
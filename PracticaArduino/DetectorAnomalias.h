@@ -0,0 +1,117 @@
+/**
+ * @file DetectorAnomalias.h
+ * @brief Detector de anomalías en línea con estado O(1) por sensor
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef DETECTOR_ANOMALIAS_H
+#define DETECTOR_ANOMALIAS_H
+
+/**
+ * @brief Tipos de anomalía (se combinan como máscara de bits)
+ */
+enum TipoAnomalia {
+    ANOMALIA_NINGUNA   = 0, ///< Lectura normal
+    ANOMALIA_ZSCORE    = 1, ///< Desviación excesiva respecto a la media EWMA
+    ANOMALIA_CAMBIO    = 2, ///< Cambio demasiado brusco respecto a la lectura previa
+    ANOMALIA_ESTANCADO = 4  ///< El valor se repite demasiadas veces seguidas
+};
+
+/**
+ * @brief Parámetros del detector, configurables por tipo de sensor
+ *
+ * Un umbral en 0 desactiva la regla correspondiente. Cada tipo de sensor
+ * tiene una sola configuración compartida por todas sus instancias.
+ */
+struct ConfigDetector {
+    double alfa;               ///< Factor de suavizado EWMA (0 < alfa <= 1)
+    double umbralZ;            ///< Umbral del z-score
+    double maxCambio;          ///< Cambio máximo permitido entre lecturas consecutivas
+    int maxRepeticiones;       ///< Repeticiones consecutivas para considerar el valor estancado
+    int lecturasCalentamiento; ///< Lecturas antes de evaluar el z-score
+
+    /**
+     * @brief Constructor con valores por defecto
+     */
+    ConfigDetector() {
+        alfa = 0.1;
+        umbralZ = 3.0;
+        maxCambio = 0.0;
+        maxRepeticiones = 0;
+        lecturasCalentamiento = 5;
+    }
+};
+
+/**
+ * @class DetectorAnomalias
+ * @brief Evalúa cada lectura al momento de registrarla
+ *
+ * Mantiene media y varianza exponenciales (EWMA), la lectura previa y un
+ * contador de repeticiones, por lo que su memoria no depende del historial.
+ * También mide el costo de cada evaluación. Ocupa 48 bytes: la
+ * configuración se referencia, no se copia.
+ */
+class DetectorAnomalias {
+private:
+    const ConfigDetector* config; ///< Parámetros del tipo de sensor
+    long long nsAcumulados;       ///< Tiempo total de evaluación (ns)
+    float media;                  ///< Media EWMA
+    float varianza;               ///< Varianza EWMA
+    float previo;                 ///< Última lectura evaluada
+    int repeticiones;             ///< Repeticiones consecutivas de 'previo'
+    int lecturas;                 ///< Lecturas evaluadas
+    int anomalias;                ///< Lecturas marcadas como anómalas
+    int nsMaximo;                 ///< Peor tiempo de evaluación (ns)
+
+public:
+    /**
+     * @brief Constructor con la configuración por defecto
+     */
+    DetectorAnomalias();
+
+    /**
+     * @brief Cambia la configuración y reinicia el estado
+     * @param nueva Parámetros a aplicar (deben vivir más que el detector)
+     */
+    void configurar(const ConfigDetector* nueva);
+
+    /**
+     * @brief Evalúa una lectura y actualiza el estado
+     * @param valor Lectura recibida
+     * @return Máscara de TipoAnomalia (0 si la lectura es normal)
+     */
+    int evaluar(double valor);
+
+    /**
+     * @brief Obtiene la configuración activa
+     * @return Referencia a la configuración
+     */
+    const ConfigDetector& obtenerConfig() const;
+
+    /**
+     * @brief Media EWMA actual
+     * @return Media
+     */
+    double obtenerMedia() const;
+
+    /**
+     * @brief Número de lecturas marcadas como anómalas
+     * @return Contador de anomalías
+     */
+    int obtenerAnomalias() const;
+
+    /**
+     * @brief Costo medio por lectura evaluada
+     * @return Nanosegundos por lectura (0 si no hay lecturas)
+     */
+    long long costoMedioNs() const;
+
+    /**
+     * @brief Peor costo observado en una evaluación
+     * @return Nanosegundos
+     */
+    int costoMaximoNs() const;
+};
+
+#endif // DETECTOR_ANOMALIAS_H
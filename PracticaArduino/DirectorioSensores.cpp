@@ -0,0 +1,76 @@
+/**
+ * @file DirectorioSensores.cpp
+ * @brief Implementación del directorio de sensores
+ */
+
+#include "DirectorioSensores.h"
+
+/**
+ * @brief Hash FNV-1a de un nombre
+ */
+static unsigned int hashNombre(const char* texto) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; texto[i] != '\0'; i++) {
+        hash = (hash ^ (unsigned char)texto[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compara dos cadenas terminadas en cero
+ */
+static bool mismoNombre(const char* a, const char* b) {
+    int i = 0;
+    while (a[i] != '\0' && a[i] == b[i]) {
+        i = i + 1;
+    }
+    return a[i] == b[i];
+}
+
+void DirectorioSensores::agregar(const EntradaDirectorio& entrada) {
+    entradas.agregar(entrada);
+}
+
+void DirectorioSensores::indexar() {
+    // Potencia de dos con carga menor al 50%
+    int capacidad = 16;
+    while (capacidad < entradas.tamano() * 2) {
+        capacidad = capacidad * 2;
+    }
+    
+    tabla.limpiar();
+    tabla.extender(capacidad, -1);
+    
+    for (int i = 0; i < entradas.tamano(); i++) {
+        int ranura = (int)(hashNombre(entradas[i].nombre) & (capacidad - 1));
+        while (tabla[ranura] >= 0) {
+            ranura = (ranura + 1) & (capacidad - 1);
+        }
+        tabla[ranura] = i;
+    }
+}
+
+int DirectorioSensores::buscar(const char* nombre) const {
+    if (tabla.tamano() == 0) {
+        return -1;
+    }
+    
+    int mascara = tabla.tamano() - 1;
+    int ranura = (int)(hashNombre(nombre) & mascara);
+    while (tabla[ranura] >= 0) {
+        if (mismoNombre(entradas[tabla[ranura]].nombre, nombre)) {
+            return tabla[ranura];
+        }
+        ranura = (ranura + 1) & mascara;
+    }
+    
+    return -1;
+}
+
+int DirectorioSensores::tamano() const {
+    return entradas.tamano();
+}
+
+const EntradaDirectorio& DirectorioSensores::operator[](int indice) const {
+    return entradas[indice];
+}
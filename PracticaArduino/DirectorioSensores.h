@@ -0,0 +1,87 @@
+/**
+ * @file DirectorioSensores.h
+ * @brief Catálogo inmutable de sensores para lectores de otros hilos
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef DIRECTORIO_SENSORES_H
+#define DIRECTORIO_SENSORES_H
+
+#include "SensorBase.h"
+#include "ArregloDinamico.h"
+#include "Instantanea.h"
+#include <memory>
+
+/**
+ * @brief Sensor visto desde el directorio
+ *
+ * Solo uno de los buzones es distinto de 0, según el tipo: los sensores
+ * genéricos (SENSOR_OTRO) usan el buzón sin tipo.
+ */
+struct EntradaDirectorio {
+    const char* nombre;   ///< Nombre internado (estable mientras viva TablaNombres)
+    int id;               ///< ID del sensor
+    TipoSensor tipo;      ///< Tipo concreto
+    std::shared_ptr<const BuzonInstantanea<float> > temperatura; ///< Instantáneas si es de temperatura
+    std::shared_ptr<const BuzonInstantanea<int> > presion;       ///< Instantáneas si es de presión
+    std::shared_ptr<const BuzonGenerico> generico;               ///< Instantáneas de cualquier otro tipo
+    
+    /**
+     * @brief Entrada vacía
+     */
+    EntradaDirectorio() {
+        nombre = "";
+        id = -1;
+        tipo = SENSOR_OTRO;
+    }
+};
+
+/**
+ * @class DirectorioSensores
+ * @brief Lista de sensores con índice por nombre, publicada por ListaGeneral
+ *
+ * Se construye en el hilo principal y luego no cambia: otros hilos la
+ * recorren sin bloqueo. Como guarda los buzones de publicación y no los
+ * sensores, seguir usando un directorio viejo es seguro aunque un sensor
+ * se haya eliminado: solo se ve su última instantánea.
+ */
+class DirectorioSensores {
+private:
+    ArregloDinamico<EntradaDirectorio> entradas; ///< Sensores en orden de la lista
+    ArregloDinamico<int> tabla;                  ///< Hash abierto: índice de entrada o -1
+    
+public:
+    /**
+     * @brief Agrega un sensor (antes de indexar)
+     * @param entrada Sensor a agregar
+     */
+    void agregar(const EntradaDirectorio& entrada);
+    
+    /**
+     * @brief Construye el índice por nombre; se llama una vez al final
+     */
+    void indexar();
+    
+    /**
+     * @brief Busca un sensor por nombre
+     * @param nombre Nombre a buscar
+     * @return Índice de la entrada o -1
+     */
+    int buscar(const char* nombre) const;
+    
+    /**
+     * @brief Número de sensores
+     * @return Cantidad de entradas
+     */
+    int tamano() const;
+    
+    /**
+     * @brief Acceso a una entrada
+     * @param indice Posición
+     * @return Entrada
+     */
+    const EntradaDirectorio& operator[](int indice) const;
+};
+
+#endif // DIRECTORIO_SENSORES_H
@@ -0,0 +1,329 @@
+/**
+ * @file EjecutorEtapas.h
+ * @brief Corrutinas de etapa, ejecutor cooperativo y canales de lotes
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef EJECUTOR_ETAPAS_H
+#define EJECUTOR_ETAPAS_H
+
+#include "ArregloDinamico.h"
+#include <coroutine>
+#include <exception>
+
+/**
+ * @class TareaEtapa
+ * @brief Corrutina de una etapa: arranca suspendida y la reanuda el ejecutor
+ *
+ * El objeto es dueño de la corrutina y la destruye al destruirse, aunque
+ * siga suspendida esperando un lote.
+ */
+class TareaEtapa {
+public:
+    /**
+     * @brief Estado de la corrutina que exige el lenguaje
+     */
+    struct promise_type {
+        TareaEtapa get_return_object() {
+            return TareaEtapa(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        
+        std::suspend_always initial_suspend() noexcept {
+            return std::suspend_always();
+        }
+        
+        std::suspend_always final_suspend() noexcept {
+            return std::suspend_always();
+        }
+        
+        void return_void() {
+        }
+        
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+    
+private:
+    std::coroutine_handle<promise_type> corrutina; ///< Corrutina de la etapa
+    
+    explicit TareaEtapa(std::coroutine_handle<promise_type> propia) {
+        corrutina = propia;
+    }
+    
+    TareaEtapa(const TareaEtapa&);
+    TareaEtapa& operator=(const TareaEtapa&);
+    
+public:
+    /**
+     * @brief Destructor - destruye la corrutina
+     */
+    ~TareaEtapa() {
+        if (corrutina) {
+            corrutina.destroy();
+        }
+    }
+    
+    /**
+     * @brief Handle para entregarlo al ejecutor
+     * @return Handle de la corrutina
+     */
+    std::coroutine_handle<> handle() const {
+        return corrutina;
+    }
+    
+    /**
+     * @brief Indica si la etapa terminó (co_return)
+     * @return true si llegó al final
+     */
+    bool terminada() const {
+        return corrutina.done();
+    }
+};
+
+/**
+ * @class EjecutorEtapas
+ * @brief Reanuda por turnos las etapas listas, en un solo hilo
+ *
+ * No hay hilos ni candados: una etapa corre hasta que espera un lote
+ * (o entrega uno) y entonces el ejecutor pasa a la siguiente lista. Las
+ * etapas que corren en hilos distintos usan ejecutores distintos.
+ *
+ * Una etapa que bloquea (leer del puerto) espera con inactivo() a que las
+ * demás terminen su lote, para no retenerlo mientras ella espera.
+ */
+class EjecutorEtapas {
+private:
+    ArregloDinamico<std::coroutine_handle<> > listas; ///< Etapas por reanudar
+    ArregloDinamico<std::coroutine_handle<> > turno;  ///< Las que corren en esta vuelta
+    ArregloDinamico<std::coroutine_handle<> > ociosas; ///< Esperan a que no haya otra lista
+    
+    EjecutorEtapas(const EjecutorEtapas&);
+    EjecutorEtapas& operator=(const EjecutorEtapas&);
+    
+public:
+    /**
+     * @brief Espera de inactivo(): vuelve cuando ninguna otra etapa está lista
+     */
+    struct EsperaInactividad {
+        EjecutorEtapas* ejecutor; ///< Ejecutor de la etapa
+        
+        bool await_ready() const {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> etapa) {
+            ejecutor->ociosas.agregar(etapa);
+        }
+        
+        void await_resume() {
+        }
+    };
+    
+    /**
+     * @brief Constructor (sin etapas)
+     */
+    EjecutorEtapas() {
+    }
+    
+    /**
+     * @brief Marca una etapa como lista para reanudarse
+     * @param etapa Handle de la corrutina
+     */
+    void programar(std::coroutine_handle<> etapa) {
+        listas.agregar(etapa);
+    }
+    
+    /**
+     * @brief Cede el turno hasta que las demás etapas esperen (co_await ejecutor.inactivo())
+     * @return Espera a la que aplicar co_await
+     */
+    EsperaInactividad inactivo() {
+        EsperaInactividad espera;
+        espera.ejecutor = this;
+        return espera;
+    }
+    
+    /**
+     * @brief Reanuda etapas, en orden de llegada, hasta que ninguna esté lista
+     *
+     * Las ociosas se reanudan cuando no queda ninguna otra.
+     */
+    void ejecutar() {
+        while (listas.tamano() > 0 || ociosas.tamano() > 0) {
+            if (listas.tamano() == 0) {
+                listas.intercambiar(ociosas);
+            }
+            // Las que se programen mientras tanto esperan a la próxima vuelta
+            turno.limpiar();
+            turno.intercambiar(listas);
+            for (int i = 0; i < turno.tamano(); i++) {
+                if (!turno[i].done()) {
+                    turno[i].resume();
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @class CanalLotes
+ * @brief Paso de lotes entre dos etapas del mismo ejecutor
+ * @tparam T Tipo de los elementos del lote
+ *
+ * Cabe un lote a la vez. enviar() intercambia el arreglo del productor
+ * con el del canal (sin copiar elementos), deja al productor con un
+ * arreglo vacío que conserva su capacidad y le cede el turno al
+ * consumidor. Así cada etapa trabaja sobre lotes enteros y se puede
+ * reemplazar o fusionar sin tocar a las demás.
+ */
+template <typename T>
+class CanalLotes {
+private:
+    EjecutorEtapas* ejecutor;            ///< Ejecutor de ambas etapas
+    ArregloDinamico<T> lote;             ///< Lote en tránsito
+    bool lleno;                          ///< true si lote espera al consumidor
+    bool cerrado;                        ///< El productor terminó
+    std::coroutine_handle<> productor;   ///< Productor esperando lugar
+    std::coroutine_handle<> consumidor;  ///< Consumidor esperando un lote
+    
+    /**
+     * @brief Deja el lote del productor en el canal y despierta al consumidor
+     */
+    void depositar(ArregloDinamico<T>& origen);
+    
+    CanalLotes(const CanalLotes&);
+    CanalLotes& operator=(const CanalLotes&);
+    
+public:
+    /**
+     * @brief Espera de enviar(): siempre cede el turno
+     */
+    struct Envio {
+        CanalLotes* canal;            ///< Canal de destino
+        ArregloDinamico<T>* origen;   ///< Lote del productor
+        bool depositado;              ///< true si ya quedó en el canal
+        
+        bool await_ready() const {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> etapa) {
+            if (!canal->lleno) {
+                canal->depositar(*origen);
+                depositado = true;
+                canal->ejecutor->programar(etapa);
+            } else {
+                canal->productor = etapa;
+            }
+        }
+        
+        void await_resume() {
+            if (!depositado) {
+                canal->depositar(*origen);
+            }
+        }
+    };
+    
+    /**
+     * @brief Espera de recibir(): devuelve false si el canal se cerró vacío
+     */
+    struct Recepcion {
+        CanalLotes* canal;            ///< Canal de origen
+        ArregloDinamico<T>* destino;  ///< Recibe el lote
+        
+        bool await_ready() const {
+            return canal->lleno || canal->cerrado;
+        }
+        
+        void await_suspend(std::coroutine_handle<> etapa) {
+            canal->consumidor = etapa;
+        }
+        
+        bool await_resume() {
+            if (!canal->lleno) {
+                return false;
+            }
+            destino->limpiar();
+            destino->intercambiar(canal->lote);
+            canal->lleno = false;
+            if (canal->productor) {
+                canal->ejecutor->programar(canal->productor);
+                canal->productor = std::coroutine_handle<>();
+            }
+            return true;
+        }
+    };
+    
+    /**
+     * @brief Constructor
+     * @param propio Ejecutor donde corren el productor y el consumidor
+     */
+    explicit CanalLotes(EjecutorEtapas* propio);
+    
+    /**
+     * @brief Entrega un lote (co_await canal.enviar(lote))
+     * @param origen Lote a entregar; queda vacío
+     * @return Espera a la que aplicar co_await
+     */
+    Envio enviar(ArregloDinamico<T>& origen);
+    
+    /**
+     * @brief Recibe el próximo lote (co_await canal.recibir(lote))
+     * @param destino Se reemplaza por el lote recibido
+     * @return Espera cuyo resultado es false si no habrá más lotes
+     */
+    Recepcion recibir(ArregloDinamico<T>& destino);
+    
+    /**
+     * @brief El productor no enviará más lotes
+     */
+    void cerrar();
+};
+
+template <typename T>
+CanalLotes<T>::CanalLotes(EjecutorEtapas* propio) {
+    ejecutor = propio;
+    lleno = false;
+    cerrado = false;
+}
+
+template <typename T>
+void CanalLotes<T>::depositar(ArregloDinamico<T>& origen) {
+    lote.limpiar();
+    lote.intercambiar(origen);
+    lleno = true;
+    if (consumidor) {
+        ejecutor->programar(consumidor);
+        consumidor = std::coroutine_handle<>();
+    }
+}
+
+template <typename T>
+typename CanalLotes<T>::Envio CanalLotes<T>::enviar(ArregloDinamico<T>& origen) {
+    Envio envio;
+    envio.canal = this;
+    envio.origen = &origen;
+    envio.depositado = false;
+    return envio;
+}
+
+template <typename T>
+typename CanalLotes<T>::Recepcion CanalLotes<T>::recibir(ArregloDinamico<T>& destino) {
+    Recepcion recepcion;
+    recepcion.canal = this;
+    recepcion.destino = &destino;
+    return recepcion;
+}
+
+template <typename T>
+void CanalLotes<T>::cerrar() {
+    cerrado = true;
+    if (consumidor) {
+        ejecutor->programar(consumidor);
+        consumidor = std::coroutine_handle<>();
+    }
+}
+
+#endif // EJECUTOR_ETAPAS_H
@@ -0,0 +1,504 @@
+/**
+ * @file ExportadorColumnar.cpp
+ * @brief Implementación de la exportación y lectura columnar
+ */
+
+#include "ExportadorColumnar.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "TablaNombres.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <memory>
+#include <climits>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+    #include <limits.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+static_assert(sizeof(CabeceraColumnar) == 48, "La cabecera columnar debe medir 48 bytes");
+
+static const char MAGIA_COLUMNAR[8] = { 'S', 'I', 'O', 'T', 'C', 'O', 'L', '1' };
+static const char CEROS[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/**
+ * @brief Relleno necesario para alinear un tamaño a 8 bytes
+ */
+static long long relleno8(long long bytes) {
+    return (8 - (bytes % 8)) % 8;
+}
+
+/**
+ * @brief Trozo de memoria a escribir tal cual
+ */
+struct BloqueSalida {
+    const void* datos; ///< Inicio
+    long long bytes;   ///< Longitud
+};
+
+/**
+ * @brief Agrega los ceros que alinean a 8 una sección de 'bytes' bytes
+ */
+static void agregarRelleno(ArregloDinamico<BloqueSalida>& bloques, long long bytes) {
+    long long relleno = relleno8(bytes);
+    if (relleno > 0) {
+        BloqueSalida bloque;
+        bloque.datos = CEROS;
+        bloque.bytes = relleno;
+        bloques.agregar(bloque);
+    }
+}
+
+/**
+ * @brief Agrega un bloque y su relleno a la lista de salida
+ */
+static void agregarBloque(ArregloDinamico<BloqueSalida>& bloques, const void* datos, long long bytes) {
+    if (bytes > 0) {
+        BloqueSalida bloque;
+        bloque.datos = datos;
+        bloque.bytes = bytes;
+        bloques.agregar(bloque);
+    }
+    agregarRelleno(bloques, bytes);
+}
+
+/**
+ * @brief Escribe todos los bloques en orden
+ * @return true si se escribió todo
+ */
+static bool escribirBloques(const char* ruta, const ArregloDinamico<BloqueSalida>& bloques) {
+#ifdef _WIN32
+    ofstream archivo(ruta, ios::binary | ios::trunc);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    for (int i = 0; i < bloques.tamano(); i++) {
+        archivo.write((const char*)bloques[i].datos, bloques[i].bytes);
+    }
+    return archivo.good();
+#else
+    int fd = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    // writev acepta a lo sumo IOV_MAX entradas por llamada
+    const int MAX_ENTRADAS = IOV_MAX < 1024 ? IOV_MAX : 1024;
+    struct iovec entradas[1024];
+    int siguiente = 0;
+    long long desfase = 0; // Bytes ya escritos del bloque 'siguiente'
+    bool correcto = true;
+    
+    while (correcto && siguiente < bloques.tamano()) {
+        int n = 0;
+        for (int i = siguiente; i < bloques.tamano() && n < MAX_ENTRADAS; i++) {
+            long long saltar = (i == siguiente) ? desfase : 0;
+            entradas[n].iov_base = (char*)bloques[i].datos + saltar;
+            entradas[n].iov_len = (size_t)(bloques[i].bytes - saltar);
+            n = n + 1;
+        }
+        
+        ssize_t escritos = writev(fd, entradas, n);
+        if (escritos < 0) {
+            correcto = false;
+            break;
+        }
+        
+        // Avanzar sobre lo escrito (writev puede escribir parcialmente)
+        long long resto = escritos;
+        while (resto > 0 && siguiente < bloques.tamano()) {
+            long long pendiente = bloques[siguiente].bytes - desfase;
+            if (resto >= pendiente) {
+                resto = resto - pendiente;
+                siguiente = siguiente + 1;
+                desfase = 0;
+            } else {
+                desfase = desfase + resto;
+                resto = 0;
+            }
+        }
+    }
+    
+    if (close(fd) != 0) {
+        correcto = false;
+    }
+    return correcto;
+#endif
+}
+
+long long ExportadorColumnar::exportar(const ListaGeneral& lista, const char* ruta) {
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    
+    // Instantáneas: fijan el estado exportado y mantienen vivos sus bloques
+    ArregloDinamico<AgregadosSensor> temp;
+    ArregloDinamico<AgregadosSensor> pres;
+    ArregloDinamico<AgregadosSensor> otros;
+    lista.consultarPorTipo(SENSOR_TEMPERATURA, temp);
+    lista.consultarPorTipo(SENSOR_PRESION, pres);
+    lista.consultarPorTipo(SENSOR_OTRO, otros);
+    
+    int n = temp.tamano() + pres.tamano() + otros.tamano();
+    ArregloDinamico<shared_ptr<const InstantaneaSensor<float> > > instTemp;
+    ArregloDinamico<shared_ptr<const InstantaneaSensor<int> > > instPres;
+    for (int i = 0; i < temp.tamano(); i++) {
+        instTemp.agregar(((SensorTemperatura*)lista.buscarPorId(temp[i].id))->obtenerInstantanea());
+    }
+    for (int i = 0; i < pres.tamano(); i++) {
+        instPres.agregar(((SensorPresion*)lista.buscarPorId(pres[i].id))->obtenerInstantanea());
+    }
+    
+    // Genéricos: agregados y lecturas de una misma instantánea, ya en double
+    ArregloDinamico<double> columnaOtras;
+    ArregloDinamico<long long> cantidadOtras;
+    for (int i = 0; i < otros.tamano(); i++) {
+        shared_ptr<const BuzonGenerico> buzon = lista.buscarPorId(otros[i].id)->compartirBuzonGenerico();
+        int antes = columnaOtras.tamano();
+        if (buzon) {
+            buzon->copiarLecturas(otros[i], columnaOtras);
+        }
+        cantidadOtras.agregar(columnaOtras.tamano() - antes);
+    }
+    
+    // Columnas de agregados
+    ArregloDinamico<int> tipos;
+    ArregloDinamico<int> anomalias;
+    ArregloDinamico<int> largos;
+    ArregloDinamico<long long> cantidades;
+    ArregloDinamico<long long> desplazamientos;
+    ArregloDinamico<double> sumas;
+    ArregloDinamico<double> promedios;
+    ArregloDinamico<double> minimos;
+    ArregloDinamico<double> maximos;
+    ArregloDinamico<double> resultados;
+    ArregloDinamico<char> nombres;
+    
+    long long lecturasTemp = 0;
+    long long lecturasPres = 0;
+    long long lecturasOtras = 0;
+    
+    for (int i = 0; i < n; i++) {
+        bool esTemp = i < temp.tamano();
+        bool esPres = !esTemp && i < temp.tamano() + pres.tamano();
+        const AgregadosSensor* agregados;
+        long long cantidad;
+        long long desplazamiento;
+        if (esTemp) {
+            agregados = &instTemp[i]->agregados;
+            cantidad = instTemp[i]->historial.tamano();
+            desplazamiento = lecturasTemp;
+            lecturasTemp = lecturasTemp + cantidad;
+        } else if (esPres) {
+            agregados = &instPres[i - temp.tamano()]->agregados;
+            cantidad = instPres[i - temp.tamano()]->historial.tamano();
+            desplazamiento = lecturasPres;
+            lecturasPres = lecturasPres + cantidad;
+        } else {
+            int k = i - temp.tamano() - pres.tamano();
+            agregados = &otros[k];
+            cantidad = cantidadOtras[k];
+            desplazamiento = lecturasOtras;
+            lecturasOtras = lecturasOtras + cantidad;
+        }
+        const AgregadosSensor& a = *agregados;
+        
+        tipos.agregar(a.tipo);
+        anomalias.agregar(a.anomalias);
+        cantidades.agregar(cantidad);
+        desplazamientos.agregar(desplazamiento);
+        sumas.agregar(a.suma);
+        promedios.agregar(a.promedio);
+        minimos.agregar(a.minimoHistorico);
+        maximos.agregar(a.maximoHistorico);
+        resultados.agregar(a.ultimoResultado);
+        
+        const char* nombre = TablaNombres::global().nombre(a.id);
+        int largo = 0;
+        while (nombre[largo] != '\0') {
+            nombres.agregar(nombre[largo]);
+            largo = largo + 1;
+        }
+        largos.agregar(largo);
+    }
+    
+    CabeceraColumnar cabecera;
+    for (int i = 0; i < 8; i++) {
+        cabecera.magia[i] = MAGIA_COLUMNAR[i];
+    }
+    cabecera.version = 2;
+    cabecera.sensores = n;
+    cabecera.lecturasTemperatura = lecturasTemp;
+    cabecera.lecturasPresion = lecturasPres;
+    cabecera.bytesNombres = nombres.tamano();
+    cabecera.lecturasOtras = lecturasOtras;
+    
+    // Lista de bloques: columnas pequeñas y luego los historiales en su sitio
+    ArregloDinamico<BloqueSalida> bloques;
+    agregarBloque(bloques, &cabecera, sizeof(cabecera));
+    if (n > 0) {
+        agregarBloque(bloques, &tipos[0], n * sizeof(int));
+        agregarBloque(bloques, &anomalias[0], n * sizeof(int));
+        agregarBloque(bloques, &largos[0], n * sizeof(int));
+        agregarBloque(bloques, &cantidades[0], n * sizeof(long long));
+        agregarBloque(bloques, &desplazamientos[0], n * sizeof(long long));
+        agregarBloque(bloques, &sumas[0], n * sizeof(double));
+        agregarBloque(bloques, &promedios[0], n * sizeof(double));
+        agregarBloque(bloques, &minimos[0], n * sizeof(double));
+        agregarBloque(bloques, &maximos[0], n * sizeof(double));
+        agregarBloque(bloques, &resultados[0], n * sizeof(double));
+    }
+    if (nombres.tamano() > 0) {
+        agregarBloque(bloques, &nombres[0], nombres.tamano());
+    }
+    
+    for (int i = 0; i < instTemp.tamano(); i++) {
+        const VistaHistorial<float>& h = instTemp[i]->historial;
+        if (h.tamano() > 0) {
+            BloqueSalida bloque;
+            bloque.datos = h.datos();
+            bloque.bytes = (long long)h.tamano() * sizeof(float);
+            bloques.agregar(bloque);
+        }
+    }
+    agregarRelleno(bloques, lecturasTemp * sizeof(float));
+    
+    for (int i = 0; i < instPres.tamano(); i++) {
+        const VistaHistorial<int>& h = instPres[i]->historial;
+        if (h.tamano() > 0) {
+            BloqueSalida bloque;
+            bloque.datos = h.datos();
+            bloque.bytes = (long long)h.tamano() * sizeof(int);
+            bloques.agregar(bloque);
+        }
+    }
+    agregarRelleno(bloques, lecturasPres * sizeof(int));
+    
+    if (lecturasOtras > 0) {
+        agregarBloque(bloques, &columnaOtras[0], lecturasOtras * sizeof(double));
+    }
+    
+    if (!escribirBloques(ruta, bloques)) {
+        cout << "[Exportacion] No se pudo escribir " << ruta << endl;
+        return -1;
+    }
+    
+    long long ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - inicio).count();
+    long long total = lecturasTemp + lecturasPres + lecturasOtras;
+    cout << "[Exportacion] " << n << " sensor(es), " << total
+         << " lectura(s) en " << ruta << " (" << ms << " ms)." << endl;
+    
+    return total;
+}
+
+LectorColumnar::LectorColumnar() {
+    base = 0;
+    tam = 0;
+    cabecera = 0;
+}
+
+LectorColumnar::~LectorColumnar() {
+    cerrar();
+}
+
+void LectorColumnar::cerrar() {
+    if (base != 0) {
+#ifdef _WIN32
+        delete[] base;
+#else
+        munmap(base, tam);
+#endif
+    }
+    base = 0;
+    tam = 0;
+    cabecera = 0;
+    inicioNombre.limpiar();
+}
+
+bool LectorColumnar::abrir(const char* ruta) {
+    cerrar();
+    
+#ifdef _WIN32
+    ifstream archivo(ruta, ios::binary | ios::ate);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    tam = (long long)archivo.tellg();
+    base = new char[tam > 0 ? tam : 1];
+    archivo.seekg(0);
+    archivo.read(base, tam);
+#else
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(CabeceraColumnar)) {
+        close(fd);
+        return false;
+    }
+    tam = info.st_size;
+    void* mapa = mmap(0, tam, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        tam = 0;
+        return false;
+    }
+    base = (char*)mapa;
+#endif
+    
+    if (tam < (long long)sizeof(CabeceraColumnar)) {
+        cerrar();
+        return false;
+    }
+    
+    cabecera = (const CabeceraColumnar*)base;
+    for (int i = 0; i < 8; i++) {
+        if (cabecera->magia[i] != MAGIA_COLUMNAR[i]) {
+            cerrar();
+            return false;
+        }
+    }
+    if (cabecera->version != 1 && cabecera->version != 2) {
+        cerrar();
+        return false;
+    }
+    
+    // Largos imposibles antes de multiplicarlos (evita desbordes en pos)
+    if (cabecera->sensores > (unsigned int)INT_MAX ||
+        cabecera->lecturasTemperatura < 0 || cabecera->lecturasTemperatura > tam ||
+        cabecera->lecturasPresion < 0 || cabecera->lecturasPresion > tam ||
+        cabecera->bytesNombres < 0 || cabecera->bytesNombres > tam ||
+        cabecera->lecturasOtras < 0 || cabecera->lecturasOtras > tam ||
+        (cabecera->version == 1 && cabecera->lecturasOtras != 0)) {
+        cerrar();
+        return false;
+    }
+    
+    // Ubicar cada columna siguiendo el orden del formato
+    long long n = cabecera->sensores;
+    long long pos = sizeof(CabeceraColumnar);
+    long long col32 = n * 4 + relleno8(n * 4);
+    long long col64 = n * 8;
+    
+    tipos = (const int*)(base + pos);            pos = pos + col32;
+    anomaliasCol = (const int*)(base + pos);     pos = pos + col32;
+    largos = (const int*)(base + pos);           pos = pos + col32;
+    cantidades = (const long long*)(base + pos); pos = pos + col64;
+    desplazamientos = (const long long*)(base + pos); pos = pos + col64;
+    sumas = (const double*)(base + pos);         pos = pos + col64;
+    promedios = (const double*)(base + pos);     pos = pos + col64;
+    minimos = (const double*)(base + pos);       pos = pos + col64;
+    maximos = (const double*)(base + pos);       pos = pos + col64;
+    resultados = (const double*)(base + pos);    pos = pos + col64;
+    nombres = base + pos;
+    pos = pos + cabecera->bytesNombres + relleno8(cabecera->bytesNombres);
+    temperaturas = (const float*)(base + pos);
+    pos = pos + cabecera->lecturasTemperatura * 4 + relleno8(cabecera->lecturasTemperatura * 4);
+    presiones = (const int*)(base + pos);
+    pos = pos + cabecera->lecturasPresion * 4;
+    if (cabecera->lecturasOtras > 0) {
+        pos = pos + relleno8(cabecera->lecturasPresion * 4);
+    }
+    otras = (const double*)(base + pos);
+    pos = pos + cabecera->lecturasOtras * 8;
+    
+    if (pos > tam) {
+        cerrar();
+        return false;
+    }
+    
+    // Cada sensor debe apuntar dentro de sus columnas: los accesores no
+    // vuelven a comprobarlo
+    long long acumulado = 0;
+    for (int i = 0; i < n; i++) {
+        long long limite;
+        switch (tipos[i]) {
+            case SENSOR_TEMPERATURA:
+                limite = cabecera->lecturasTemperatura;
+                break;
+            case SENSOR_PRESION:
+                limite = cabecera->lecturasPresion;
+                break;
+            default:
+                limite = cabecera->lecturasOtras;
+                break;
+        }
+        
+        bool valido = largos[i] >= 0 && largos[i] <= cabecera->bytesNombres - acumulado &&
+                      cantidades[i] >= 0 && cantidades[i] <= INT_MAX &&
+                      desplazamientos[i] >= 0 && desplazamientos[i] <= limite &&
+                      cantidades[i] <= limite - desplazamientos[i];
+        if (!valido) {
+            cerrar();
+            return false;
+        }
+        
+        inicioNombre.agregar(acumulado);
+        acumulado = acumulado + largos[i];
+    }
+    
+    return true;
+}
+
+int LectorColumnar::sensores() const {
+    return cabecera == 0 ? 0 : (int)cabecera->sensores;
+}
+
+void LectorColumnar::nombre(int i, char* destino, int tamDestino) const {
+    int largo = largos[i] < tamDestino - 1 ? largos[i] : tamDestino - 1;
+    for (int c = 0; c < largo; c++) {
+        destino[c] = nombres[inicioNombre[i] + c];
+    }
+    destino[largo] = '\0';
+}
+
+TipoSensor LectorColumnar::tipo(int i) const {
+    return (TipoSensor)tipos[i];
+}
+
+long long LectorColumnar::cantidad(int i) const {
+    return cantidades[i];
+}
+
+AgregadosSensor LectorColumnar::agregados(int i) const {
+    AgregadosSensor a;
+    a.tipo = tipo(i);
+    a.cantidad = (int)cantidades[i];
+    a.suma = sumas[i];
+    a.promedio = promedios[i];
+    a.minimoHistorico = minimos[i];
+    a.maximoHistorico = maximos[i];
+    a.ultimoResultado = resultados[i];
+    a.anomalias = anomaliasCol[i];
+    return a;
+}
+
+const float* LectorColumnar::lecturasTemperatura(int i) const {
+    if (tipos[i] != SENSOR_TEMPERATURA) {
+        return 0;
+    }
+    return temperaturas + desplazamientos[i];
+}
+
+const int* LectorColumnar::lecturasPresion(int i) const {
+    if (tipos[i] != SENSOR_PRESION) {
+        return 0;
+    }
+    return presiones + desplazamientos[i];
+}
+
+const double* LectorColumnar::lecturasOtras(int i) const {
+    if (tipos[i] == SENSOR_TEMPERATURA || tipos[i] == SENSOR_PRESION) {
+        return 0;
+    }
+    return otras + desplazamientos[i];
+}
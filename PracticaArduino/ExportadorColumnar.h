@@ -0,0 +1,188 @@
+/**
+ * @file ExportadorColumnar.h
+ * @brief Exportación binaria por columnas de historiales y agregados
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ *
+ * Formato del archivo (little-endian, todas las secciones alineadas a 8):
+ *
+ *   CabeceraColumnar (48 bytes)
+ *   int32   tipo[N]              TipoSensor de cada sensor
+ *   int32   anomalias[N]
+ *   int32   largoNombre[N]
+ *   int64   cantidad[N]          Lecturas exportadas de cada sensor
+ *   int64   desplazamiento[N]    Primera lectura del sensor en su columna
+ *   float64 suma[N]
+ *   float64 promedio[N]
+ *   float64 minimoHistorico[N]
+ *   float64 maximoHistorico[N]
+ *   float64 ultimoResultado[N]
+ *   char    nombres[bytesNombres] Nombres concatenados, sin terminador
+ *   float32 temperaturas[lecturasTemperatura]
+ *   int32   presiones[lecturasPresion]
+ *   float64 otras[lecturasOtras]  (desde la versión 2)
+ *
+ * Las columnas int32 y float32 se rellenan con ceros hasta múltiplo de 8
+ * bytes. Las lecturas de un sensor de temperatura están en
+ * temperaturas[desplazamiento[i] .. desplazamiento[i] + cantidad[i]);
+ * las de presión, en presiones, y las de cualquier otro tipo (sensores
+ * genéricos), convertidas a double, en otras. Un archivo de la versión 1
+ * es uno de la 2 sin sensores genéricos (lecturasOtras era reservado = 0).
+ */
+
+#ifndef EXPORTADOR_COLUMNAR_H
+#define EXPORTADOR_COLUMNAR_H
+
+#include "ListaGeneral.h"
+
+/**
+ * @brief Cabecera del archivo columnar
+ */
+struct CabeceraColumnar {
+    char magia[8];                 ///< "SIOTCOL1"
+    unsigned int version;          ///< Versión del formato (2)
+    unsigned int sensores;         ///< N
+    long long lecturasTemperatura; ///< Largo de la columna temperaturas
+    long long lecturasPresion;     ///< Largo de la columna presiones
+    long long bytesNombres;        ///< Bytes de nombres (sin relleno)
+    long long lecturasOtras;       ///< Largo de la columna otras (0 en la versión 1)
+};
+
+/**
+ * @class ExportadorColumnar
+ * @brief Escribe el estado de una ListaGeneral en formato columnar
+ *
+ * Las lecturas de temperatura y presión se escriben directamente desde
+ * el bloque contiguo de la última instantánea de cada sensor (una
+ * entrada de writev por sensor), sin formatear valor por valor ni
+ * copiarlos. Las instantáneas se mantienen vivas hasta terminar, así que
+ * la ingesta puede continuar. Las de los sensores genéricos se copian a
+ * double desde su buzón sin tipo.
+ */
+class ExportadorColumnar {
+public:
+    /**
+     * @brief Exporta todos los sensores de la lista
+     * @param lista Lista a exportar
+     * @param ruta Archivo destino (se sobrescribe)
+     * @return Lecturas exportadas, o -1 si no se pudo escribir
+     */
+    static long long exportar(const ListaGeneral& lista, const char* ruta);
+};
+
+/**
+ * @class LectorColumnar
+ * @brief Lee un archivo columnar sin copiar las columnas
+ *
+ * El archivo se proyecta en memoria; los accesores devuelven punteros a
+ * las columnas dentro de la proyección.
+ */
+class LectorColumnar {
+private:
+    char* base;                 ///< Inicio del archivo en memoria
+    long long tam;              ///< Tamaño del archivo
+    const CabeceraColumnar* cabecera; ///< Cabecera validada
+    const int* tipos;           ///< Columna tipo
+    const int* anomaliasCol;    ///< Columna anomalias
+    const int* largos;          ///< Columna largoNombre
+    const long long* cantidades;    ///< Columna cantidad
+    const long long* desplazamientos; ///< Columna desplazamiento
+    const double* sumas;        ///< Columna suma
+    const double* promedios;    ///< Columna promedio
+    const double* minimos;      ///< Columna minimoHistorico
+    const double* maximos;      ///< Columna maximoHistorico
+    const double* resultados;   ///< Columna ultimoResultado
+    const char* nombres;        ///< Nombres concatenados
+    const float* temperaturas;  ///< Lecturas de temperatura
+    const int* presiones;       ///< Lecturas de presión
+    const double* otras;        ///< Lecturas de los demás tipos
+    ArregloDinamico<long long> inicioNombre; ///< Posición del nombre de cada sensor
+    
+    /**
+     * @brief Libera la proyección
+     */
+    void cerrar();
+    
+    LectorColumnar(const LectorColumnar&);
+    LectorColumnar& operator=(const LectorColumnar&);
+    
+public:
+    /**
+     * @brief Constructor (sin archivo abierto)
+     */
+    LectorColumnar();
+    
+    /**
+     * @brief Destructor - libera la proyección
+     */
+    ~LectorColumnar();
+    
+    /**
+     * @brief Abre y valida un archivo columnar
+     *
+     * Además de la cabecera y el tamaño total comprueba cada sensor:
+     * largos y cantidades no negativos, nombres dentro de bytesNombres y
+     * desplazamiento + cantidad dentro de la columna de su tipo.
+     * @param ruta Ruta del archivo
+     * @return true si el archivo es válido
+     */
+    bool abrir(const char* ruta);
+    
+    /**
+     * @brief Número de sensores
+     * @return N
+     */
+    int sensores() const;
+    
+    /**
+     * @brief Copia el nombre de un sensor
+     * @param i Índice del sensor
+     * @param destino Buffer de salida
+     * @param tamDestino Tamaño del buffer
+     */
+    void nombre(int i, char* destino, int tamDestino) const;
+    
+    /**
+     * @brief Tipo de un sensor
+     * @param i Índice del sensor
+     * @return TipoSensor
+     */
+    TipoSensor tipo(int i) const;
+    
+    /**
+     * @brief Lecturas exportadas de un sensor
+     * @param i Índice del sensor
+     * @return Cantidad
+     */
+    long long cantidad(int i) const;
+    
+    /**
+     * @brief Agregados exportados de un sensor
+     * @param i Índice del sensor
+     * @return Agregados (id, versión y última lectura no se exportan)
+     */
+    AgregadosSensor agregados(int i) const;
+    
+    /**
+     * @brief Lecturas de un sensor de temperatura
+     * @param i Índice del sensor
+     * @return Puntero a cantidad(i) lecturas, o 0 si no es de temperatura
+     */
+    const float* lecturasTemperatura(int i) const;
+    
+    /**
+     * @brief Lecturas de un sensor de presión
+     * @param i Índice del sensor
+     * @return Puntero a cantidad(i) lecturas, o 0 si no es de presión
+     */
+    const int* lecturasPresion(int i) const;
+    
+    /**
+     * @brief Lecturas de un sensor de otro tipo (genérico)
+     * @param i Índice del sensor
+     * @return Puntero a cantidad(i) lecturas, o 0 si es de temperatura o presión
+     */
+    const double* lecturasOtras(int i) const;
+};
+
+#endif // EXPORTADOR_COLUMNAR_H
@@ -0,0 +1,143 @@
+/**
+ * @file GestorEpocas.cpp
+ * @brief Implementación de la recuperación de memoria basada en épocas
+ */
+
+#include "GestorEpocas.h"
+
+using namespace std;
+
+/**
+ * @brief Registro del hilo actual; lo devuelve cuando el hilo termina
+ */
+struct EnlaceHilo {
+    RegistroHilo* registro; ///< Registro tomado (0 si el hilo aún no participó)
+    
+    EnlaceHilo() {
+        registro = 0;
+    }
+    
+    ~EnlaceHilo() {
+        if (registro != 0) {
+            registro->epoca.store(GestorEpocas::INACTIVO);
+            registro->ocupado.store(false, memory_order_release);
+        }
+    }
+};
+
+/// Registro del hilo actual
+static thread_local EnlaceHilo enlaceDelHilo;
+
+GestorEpocas::GestorEpocas() {
+    epocaGlobal.store(0);
+    registros.store(0);
+    cantidadRegistros.store(0);
+}
+
+GestorEpocas::~GestorEpocas() {
+    for (int e = 0; e < 3; e++) {
+        for (int i = 0; i < limbo[e].tamano(); i++) {
+            limbo[e][i].liberar(limbo[e][i].puntero);
+        }
+    }
+    
+    RegistroHilo* actual = registros.load();
+    while (actual != 0) {
+        RegistroHilo* siguiente = actual->siguiente;
+        delete actual;
+        actual = siguiente;
+    }
+}
+
+GestorEpocas& GestorEpocas::global() {
+    static GestorEpocas gestor;
+    return gestor;
+}
+
+RegistroHilo* GestorEpocas::adquirirRegistro() {
+    // Primero un registro que haya dejado un hilo terminado
+    for (RegistroHilo* r = registros.load(memory_order_acquire); r != 0; r = r->siguiente) {
+        bool libre = false;
+        if (r->ocupado.compare_exchange_strong(libre, true)) {
+            r->anidamiento = 0;
+            return r;
+        }
+    }
+    
+    RegistroHilo* nuevo = new RegistroHilo();
+    nuevo->epoca.store(INACTIVO);
+    nuevo->ocupado.store(true);
+    nuevo->anidamiento = 0;
+    nuevo->siguiente = registros.load(memory_order_relaxed);
+    while (!registros.compare_exchange_weak(nuevo->siguiente, nuevo, memory_order_acq_rel)) {
+        // 'siguiente' se actualiza con la cabeza vigente; reintentar
+    }
+    cantidadRegistros.fetch_add(1);
+    return nuevo;
+}
+
+RegistroHilo* GestorEpocas::registroHilo() {
+    if (enlaceDelHilo.registro == 0) {
+        enlaceDelHilo.registro = adquirirRegistro();
+    }
+    return enlaceDelHilo.registro;
+}
+
+void GestorEpocas::entrar() {
+    RegistroHilo* registro = registroHilo();
+    
+    if (registro->anidamiento == 0) {
+        // seq_cst: el anuncio debe ser visible antes de leer cualquier nodo
+        registro->epoca.store(epocaGlobal.load());
+    }
+    registro->anidamiento = registro->anidamiento + 1;
+}
+
+void GestorEpocas::salir() {
+    RegistroHilo* registro = registroHilo();
+    
+    registro->anidamiento = registro->anidamiento - 1;
+    if (registro->anidamiento == 0) {
+        registro->epoca.store(INACTIVO, memory_order_release);
+    }
+}
+
+void GestorEpocas::intentarAvanzar() {
+    unsigned long actual = epocaGlobal.load();
+    
+    for (RegistroHilo* r = registros.load(memory_order_acquire); r != 0; r = r->siguiente) {
+        unsigned long local = r->epoca.load();
+        if (local != INACTIVO && local != actual) {
+            return; // Un lector sigue en una época anterior
+        }
+    }
+    
+    epocaGlobal.store(actual + 1);
+    
+    // Lo retirado en (actual - 1) ya no es visible para nadie
+    ArregloDinamico<BloqueRetirado>& seguro = limbo[(actual + 2) % 3];
+    for (int i = 0; i < seguro.tamano(); i++) {
+        seguro[i].liberar(seguro[i].puntero);
+    }
+    seguro.limpiar();
+}
+
+void GestorEpocas::retirar(void* puntero, void (*liberar)(void*)) {
+    lock_guard<mutex> candado(mutexRetirados);
+    
+    BloqueRetirado bloque;
+    bloque.puntero = puntero;
+    bloque.liberar = liberar;
+    limbo[epocaGlobal.load() % 3].agregar(bloque);
+    
+    intentarAvanzar();
+}
+
+int GestorEpocas::pendientes() {
+    lock_guard<mutex> candado(mutexRetirados);
+    return limbo[0].tamano() + limbo[1].tamano() + limbo[2].tamano();
+}
+
+int GestorEpocas::hilosRegistrados() const {
+    return cantidadRegistros.load();
+}
@@ -0,0 +1,154 @@
+/**
+ * @file GestorEpocas.h
+ * @brief Recuperación de memoria basada en épocas para estructuras sin bloqueo
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef GESTOR_EPOCAS_H
+#define GESTOR_EPOCAS_H
+
+#include "ArregloDinamico.h"
+#include <atomic>
+#include <mutex>
+
+/**
+ * @brief Bloque retirado: memoria que se liberará cuando ningún lector la vea
+ */
+struct BloqueRetirado {
+    void* puntero;              ///< Memoria retirada
+    void (*liberar)(void*);     ///< Función que la libera con el tipo correcto
+};
+
+/**
+ * @brief Registro de un hilo participante
+ *
+ * Los registros forman una lista que solo crece; cuando un hilo termina,
+ * su registro queda libre y lo reutiliza el siguiente hilo que llegue.
+ */
+struct RegistroHilo {
+    std::atomic<unsigned long> epoca; ///< Época anunciada (INACTIVO fuera de sección)
+    std::atomic<bool> ocupado;        ///< Lo usa un hilo vivo
+    int anidamiento;                  ///< Guardias anidadas (solo lo toca su hilo)
+    RegistroHilo* siguiente;          ///< Siguiente registro de la lista
+};
+
+/**
+ * @class GestorEpocas
+ * @brief Libera nodos desenlazados solo cuando ningún lector puede tenerlos
+ *
+ * Cada hilo lector anuncia la época global al entrar a una sección de
+ * lectura (GuardiaEpoca). Un nodo retirado en la época e se libera cuando
+ * la época global llega a e + 2, lo que garantiza que todos los lectores
+ * activos entraron después de que el nodo fue desenlazado.
+ *
+ * Lo retirado se guarda en una lista por época (módulo 3): avanzar la
+ * época libera una lista entera sin revisar nodo por nodo.
+ *
+ * No hay un máximo de hilos: cada uno toma un registro en su primer uso
+ * y lo devuelve al terminar, así que el número de registros es el de
+ * hilos vivos a la vez, no el de hilos que alguna vez participaron.
+ */
+class GestorEpocas {
+public:
+    static const unsigned long INACTIVO = ~0UL; ///< Marca de hilo fuera de sección
+    
+private:
+    std::atomic<unsigned long> epocaGlobal;   ///< Época actual
+    std::atomic<RegistroHilo*> registros;     ///< Lista de registros de hilos
+    std::atomic<int> cantidadRegistros;       ///< Registros creados
+    
+    std::mutex mutexRetirados;                ///< Protege las listas de retirados
+    ArregloDinamico<BloqueRetirado> limbo[3]; ///< Retirados por época (módulo 3)
+    
+    /**
+     * @brief Intenta avanzar la época y libera lo que ya es seguro
+     *
+     * Se llama con mutexRetirados tomado.
+     */
+    void intentarAvanzar();
+    
+    /**
+     * @brief Toma un registro libre o crea uno nuevo
+     * @return Registro ocupado por el hilo actual
+     */
+    RegistroHilo* adquirirRegistro();
+    
+    GestorEpocas();
+    GestorEpocas(const GestorEpocas&);
+    GestorEpocas& operator=(const GestorEpocas&);
+    
+public:
+    /**
+     * @brief Destructor - libera todo lo pendiente
+     */
+    ~GestorEpocas();
+    
+    /**
+     * @brief Obtiene el gestor global del proceso
+     * @return Referencia al gestor único
+     */
+    static GestorEpocas& global();
+    
+    /**
+     * @brief Registro del hilo actual (se asigna en el primer uso)
+     * @return Registro del hilo, válido hasta que el hilo termine
+     */
+    RegistroHilo* registroHilo();
+    
+    /**
+     * @brief Marca el inicio de una sección de lectura del hilo actual
+     */
+    void entrar();
+    
+    /**
+     * @brief Marca el fin de una sección de lectura del hilo actual
+     */
+    void salir();
+    
+    /**
+     * @brief Retira memoria ya desenlazada de la estructura
+     * @param puntero Memoria a liberar más adelante
+     * @param liberar Función de liberación
+     */
+    void retirar(void* puntero, void (*liberar)(void*));
+    
+    /**
+     * @brief Número de bloques retirados que aún no se liberan
+     * @return Bloques pendientes
+     */
+    int pendientes();
+    
+    /**
+     * @brief Registros de hilo creados hasta ahora
+     * @return Máximo de hilos que participaron a la vez
+     */
+    int hilosRegistrados() const;
+};
+
+/**
+ * @class GuardiaEpoca
+ * @brief Sección de lectura RAII: protege los nodos visitados mientras exista
+ */
+class GuardiaEpoca {
+public:
+    /**
+     * @brief Entra a la sección de lectura
+     */
+    GuardiaEpoca() {
+        GestorEpocas::global().entrar();
+    }
+    
+    /**
+     * @brief Sale de la sección de lectura
+     */
+    ~GuardiaEpoca() {
+        GestorEpocas::global().salir();
+    }
+    
+private:
+    GuardiaEpoca(const GuardiaEpoca&);
+    GuardiaEpoca& operator=(const GuardiaEpoca&);
+};
+
+#endif // GESTOR_EPOCAS_H
\ No newline at end of file
@@ -0,0 +1,449 @@
+/**
+ * @file ImportadorCapturas.cpp
+ * @brief Implementación de la importación paralela de capturas
+ */
+
+#include "ImportadorCapturas.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "PlanificadorRueda.h"
+#include "Bitacora.h"
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <chrono>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * @brief Lecturas de un trozo destinadas a un mismo sensor
+ */
+struct GrupoTrozo {
+    const char* nombre;  ///< Nombre dentro del archivo (0 = sensor por defecto)
+    int longitud;        ///< Longitud del nombre
+    bool temperatura;    ///< true para TEMP, false para PRES
+    int inicio;          ///< Primera lectura del grupo en TrozoCaptura::valores
+    int cantidad;        ///< Lecturas del grupo
+};
+
+/**
+ * @brief Resultado de interpretar un trozo del archivo
+ */
+struct TrozoCaptura {
+    const char* inicio;              ///< Primer byte del trozo
+    const char* fin;                 ///< Un byte después del último
+    ArregloDinamico<GrupoTrozo> grupos; ///< Sensores del trozo, por primera aparición
+    ArregloDinamico<double> valores;    ///< Lecturas ordenadas por grupo (estable)
+    long long descartadas;           ///< Líneas inválidas del trozo
+};
+
+/**
+ * @brief Hash FNV-1a de la clave de un grupo
+ */
+static unsigned int hashGrupo(const char* nombre, int longitud, bool temperatura) {
+    unsigned int hash = temperatura ? 2166136261u : 2166136261u ^ 0x9e3779b9u;
+    for (int i = 0; i < longitud; i++) {
+        hash = (hash ^ (unsigned char)nombre[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compara la clave de un grupo
+ */
+static bool mismoGrupo(const GrupoTrozo& grupo, const char* nombre, int longitud, bool temperatura) {
+    if (grupo.temperatura != temperatura || grupo.longitud != longitud) {
+        return false;
+    }
+    for (int i = 0; i < longitud; i++) {
+        if (grupo.nombre[i] != nombre[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Interpreta un número decimal sin pasar por la configuración regional
+ * @return true si había al menos un dígito
+ */
+static bool interpretarValor(const char* p, const char* fin, double& valor) {
+    bool negativo = false;
+    if (p < fin && (*p == '-' || *p == '+')) {
+        negativo = (*p == '-');
+        p = p + 1;
+    }
+    
+    double entero = 0.0;
+    double fraccion = 0.0;
+    double divisor = 1.0;
+    bool hayDigitos = false;
+    
+    while (p < fin && *p >= '0' && *p <= '9') {
+        entero = entero * 10.0 + (*p - '0');
+        hayDigitos = true;
+        p = p + 1;
+    }
+    if (p < fin && *p == '.') {
+        p = p + 1;
+        while (p < fin && *p >= '0' && *p <= '9') {
+            fraccion = fraccion * 10.0 + (*p - '0');
+            divisor = divisor * 10.0;
+            hayDigitos = true;
+            p = p + 1;
+        }
+    }
+    
+    valor = entero + fraccion / divisor;
+    if (negativo) {
+        valor = -valor;
+    }
+    return hayDigitos;
+}
+
+/**
+ * @brief Interpreta un trozo y agrupa sus lecturas por sensor
+ *
+ * Se ejecuta en un hilo propio: solo toca memoria del trozo.
+ */
+static void interpretarTrozo(TrozoCaptura* trozo) {
+    ArregloDinamico<int> lineaGrupo;   // Grupo de cada lectura, en orden
+    ArregloDinamico<double> enOrden;   // Lecturas en orden de archivo
+    ArregloDinamico<int> tabla;        // Hash abierto: índice de grupo o -1
+    tabla.extender(64, -1);
+    trozo->descartadas = 0;
+    
+    const char* p = trozo->inicio;
+    while (p < trozo->fin) {
+        const char* linea = p;
+        while (p < trozo->fin && *p != '\n') {
+            p = p + 1;
+        }
+        const char* finLinea = p;
+        p = p + 1;
+        
+        if (finLinea > linea && finLinea[-1] == '\r') {
+            finLinea = finLinea - 1;
+        }
+        if (finLinea == linea) {
+            continue;
+        }
+        
+        // TIPO:valor o TIPO:nombre:valor
+        const char* dosPuntos = linea;
+        while (dosPuntos < finLinea && *dosPuntos != ':') {
+            dosPuntos = dosPuntos + 1;
+        }
+        int largoTipo = (int)(dosPuntos - linea);
+        bool temperatura;
+        if (largoTipo == 4 && linea[0] == 'T' && linea[1] == 'E' && linea[2] == 'M' && linea[3] == 'P') {
+            temperatura = true;
+        } else if (largoTipo == 4 && linea[0] == 'P' && linea[1] == 'R' && linea[2] == 'E' && linea[3] == 'S') {
+            temperatura = false;
+        } else {
+            trozo->descartadas = trozo->descartadas + 1;
+            continue;
+        }
+        
+        const char* resto = dosPuntos + 1;
+        const char* segundo = resto;
+        while (segundo < finLinea && *segundo != ':') {
+            segundo = segundo + 1;
+        }
+        
+        const char* nombre = 0;
+        int longitud = 0;
+        if (segundo < finLinea) {
+            nombre = resto;
+            longitud = (int)(segundo - resto);
+            resto = segundo + 1;
+        }
+        
+        double valor;
+        if (!interpretarValor(resto, finLinea, valor)) {
+            trozo->descartadas = trozo->descartadas + 1;
+            continue;
+        }
+        
+        // Buscar o crear el grupo del sensor
+        int mascara = tabla.tamano() - 1;
+        int ranura = (int)(hashGrupo(nombre, longitud, temperatura) & mascara);
+        while (tabla[ranura] >= 0 && !mismoGrupo(trozo->grupos[tabla[ranura]], nombre, longitud, temperatura)) {
+            ranura = (ranura + 1) & mascara;
+        }
+        
+        if (tabla[ranura] < 0) {
+            GrupoTrozo grupo;
+            grupo.nombre = nombre;
+            grupo.longitud = longitud;
+            grupo.temperatura = temperatura;
+            grupo.inicio = 0;
+            grupo.cantidad = 0;
+            tabla[ranura] = trozo->grupos.tamano();
+            trozo->grupos.agregar(grupo);
+            
+            // Mantener la carga por debajo del 50%
+            if (trozo->grupos.tamano() * 2 > tabla.tamano()) {
+                int nuevoTam = tabla.tamano() * 2;
+                tabla.limpiar();
+                tabla.extender(nuevoTam, -1);
+                for (int g = 0; g < trozo->grupos.tamano(); g++) {
+                    const GrupoTrozo& otro = trozo->grupos[g];
+                    int r = (int)(hashGrupo(otro.nombre, otro.longitud, otro.temperatura) & (nuevoTam - 1));
+                    while (tabla[r] >= 0) {
+                        r = (r + 1) & (nuevoTam - 1);
+                    }
+                    tabla[r] = g;
+                }
+                ranura = -1;
+            }
+        }
+        
+        int indice = ranura >= 0 ? tabla[ranura] : trozo->grupos.tamano() - 1;
+        trozo->grupos[indice].cantidad = trozo->grupos[indice].cantidad + 1;
+        lineaGrupo.agregar(indice);
+        enOrden.agregar(valor);
+    }
+    
+    // Ordenamiento por conteo, estable: cada grupo conserva el orden del archivo
+    int acumulado = 0;
+    for (int g = 0; g < trozo->grupos.tamano(); g++) {
+        trozo->grupos[g].inicio = acumulado;
+        acumulado = acumulado + trozo->grupos[g].cantidad;
+    }
+    
+    ArregloDinamico<int> siguiente;
+    for (int g = 0; g < trozo->grupos.tamano(); g++) {
+        siguiente.agregar(trozo->grupos[g].inicio);
+    }
+    
+    trozo->valores.extender(enOrden.tamano(), 0.0);
+    for (int i = 0; i < enOrden.tamano(); i++) {
+        int g = lineaGrupo[i];
+        trozo->valores[siguiente[g]] = enOrden[i];
+        siguiente[g] = siguiente[g] + 1;
+    }
+}
+
+ImportadorCapturas::ImportadorCapturas(ListaGeneral* destino, SensorBase* temperatura, SensorBase* presion,
+                                       PlanificadorRueda* planificadorDestino) {
+    lista = destino;
+    temperaturaDefecto = temperatura;
+    presionDefecto = presion;
+    planificador = planificadorDestino;
+    // Sin marcas de tiempo en la captura, el horizonte crudo no significa nada
+    presupuesto.horizonteCrudoMs = 0;
+}
+
+void ImportadorCapturas::fijarPresupuesto(const PresupuestoRetencion& nuevo) {
+    presupuesto = nuevo;
+}
+
+bool ImportadorCapturas::importar(const char* ruta, int hilos, ResultadoImportacion& resultado) {
+    resultado.bytes = 0;
+    resultado.lecturas = 0;
+    resultado.descartadas = 0;
+    resultado.sensoresCreados = 0;
+    resultado.hilos = 0;
+    resultado.msLectura = 0;
+    resultado.msInterpretacion = 0;
+    resultado.msFusion = 0;
+    
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    
+    // 1. Proyectar el archivo en memoria
+    const char* datos = 0;
+    long long tam = 0;
+#ifdef _WIN32
+    ifstream archivo(ruta, ios::binary | ios::ate);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    tam = (long long)archivo.tellg();
+    char* copia = new char[tam > 0 ? tam : 1];
+    archivo.seekg(0);
+    archivo.read(copia, tam);
+    datos = copia;
+#else
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    tam = info.st_size;
+    void* mapa = 0;
+    if (tam > 0) {
+        mapa = mmap(0, tam, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        madvise(mapa, tam, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    datos = (const char*)mapa;
+#endif
+    resultado.bytes = tam;
+    
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    
+    // 2. Dividir en trozos alineados a fin de línea
+    if (hilos <= 0) {
+        hilos = (int)thread::hardware_concurrency();
+    }
+    if (hilos <= 0) {
+        hilos = 1;
+    }
+    if (tam < 1024 * 1024) {
+        hilos = 1; // No compensa crear hilos para archivos pequeños
+    }
+    resultado.hilos = hilos;
+    
+    TrozoCaptura* trozos = new TrozoCaptura[hilos];
+    const char* cursor = datos;
+    const char* finDatos = datos + tam;
+    for (int i = 0; i < hilos; i++) {
+        const char* corte = (i == hilos - 1) ? finDatos : datos + (tam / hilos) * (i + 1);
+        if (corte < cursor) {
+            corte = cursor;
+        }
+        while (corte < finDatos && corte > datos && corte[-1] != '\n') {
+            corte = corte + 1;
+        }
+        trozos[i].inicio = cursor;
+        trozos[i].fin = corte;
+        cursor = corte;
+    }
+    
+    // 3. Interpretar en paralelo
+    thread* trabajadores = new thread[hilos];
+    for (int i = 1; i < hilos; i++) {
+        trabajadores[i] = thread(interpretarTrozo, &trozos[i]);
+    }
+    interpretarTrozo(&trozos[0]);
+    for (int i = 1; i < hilos; i++) {
+        trabajadores[i].join();
+    }
+    delete[] trabajadores;
+    
+    chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+    
+    // 4. Fusionar por sensor, en el orden de los trozos
+    const int LOTE_MAXIMO = 8192;
+    float* loteFloat = new float[LOTE_MAXIMO];
+    int* loteInt = new int[LOTE_MAXIMO];
+    char nombre[50];
+    bool bitacora = Bitacora::activar(false);
+    lista->iniciarCargaMasiva();
+    
+    for (int i = 0; i < hilos; i++) {
+        TrozoCaptura& trozo = trozos[i];
+        resultado.descartadas = resultado.descartadas + trozo.descartadas;
+        
+        for (int g = 0; g < trozo.grupos.tamano(); g++) {
+            const GrupoTrozo& grupo = trozo.grupos[g];
+            SensorBase* sensor = grupo.temperatura ? temperaturaDefecto : presionDefecto;
+            
+            if (grupo.nombre != 0) {
+                int largo = grupo.longitud < 49 ? grupo.longitud : 49;
+                for (int c = 0; c < largo; c++) {
+                    nombre[c] = grupo.nombre[c];
+                }
+                nombre[largo] = '\0';
+                
+                sensor = lista->buscar(nombre);
+                if (sensor == 0) {
+                    if (grupo.temperatura) {
+                        sensor = new SensorTemperatura(nombre);
+                    } else {
+                        sensor = new SensorPresion(nombre);
+                    }
+                    sensor->fijarPresupuesto(presupuesto);
+                    lista->insertar(sensor);
+                    if (planificador != 0) {
+                        planificador->programar(sensor, sensor->periodoProcesamientoMs());
+                    }
+                    resultado.sensoresCreados = resultado.sensoresCreados + 1;
+                }
+            }
+            
+            TipoSensor esperado = grupo.temperatura ? SENSOR_TEMPERATURA : SENSOR_PRESION;
+            if (sensor == 0 || sensor->obtenerTipo() != esperado) {
+                resultado.descartadas = resultado.descartadas + grupo.cantidad;
+                continue;
+            }
+            
+            const double* valores = &trozo.valores[0] + grupo.inicio;
+            for (int hecho = 0; hecho < grupo.cantidad; hecho = hecho + LOTE_MAXIMO) {
+                int n = grupo.cantidad - hecho;
+                if (n > LOTE_MAXIMO) {
+                    n = LOTE_MAXIMO;
+                }
+                
+                if (grupo.temperatura) {
+                    for (int k = 0; k < n; k++) {
+                        loteFloat[k] = (float)valores[hecho + k];
+                    }
+                    ((SensorTemperatura*)sensor)->registrarLote(loteFloat, n);
+                } else {
+                    for (int k = 0; k < n; k++) {
+                        loteInt[k] = (int)valores[hecho + k];
+                    }
+                    ((SensorPresion*)sensor)->registrarLote(loteInt, n);
+                }
+            }
+            resultado.lecturas = resultado.lecturas + grupo.cantidad;
+        }
+    }
+    
+    lista->terminarCargaMasiva();
+    Bitacora::activar(bitacora);
+    delete[] loteFloat;
+    delete[] loteInt;
+    delete[] trozos;
+    
+#ifdef _WIN32
+    delete[] copia;
+#else
+    if (mapa != 0) {
+        munmap(mapa, tam);
+    }
+#endif
+    
+    chrono::steady_clock::time_point t3 = chrono::steady_clock::now();
+    resultado.msLectura = chrono::duration_cast<chrono::milliseconds>(t1 - t0).count();
+    resultado.msInterpretacion = chrono::duration_cast<chrono::milliseconds>(t2 - t1).count();
+    resultado.msFusion = chrono::duration_cast<chrono::milliseconds>(t3 - t2).count();
+    
+    return true;
+}
+
+void ImportadorCapturas::imprimir(const ResultadoImportacion& resultado) {
+    long long msTotal = resultado.msLectura + resultado.msInterpretacion + resultado.msFusion;
+    
+    cout << "\n--- Importacion de Captura ---" << endl;
+    cout << "Bytes: " << resultado.bytes << " | Lecturas: " << resultado.lecturas
+         << " | Descartadas: " << resultado.descartadas
+         << " | Sensores creados: " << resultado.sensoresCreados << endl;
+    cout << "Hilos: " << resultado.hilos << " | Mapeo: " << resultado.msLectura
+         << " ms | Interpretacion: " << resultado.msInterpretacion
+         << " ms | Fusion: " << resultado.msFusion << " ms" << endl;
+    
+    if (resultado.msInterpretacion > 0 && msTotal > 0) {
+        cout << "Interpretacion: " << (resultado.bytes / 1000 / resultado.msInterpretacion)
+             << " MB/s | Total: " << (resultado.bytes / 1000 / msTotal) << " MB/s" << endl;
+    }
+}
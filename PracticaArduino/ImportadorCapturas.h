@@ -0,0 +1,91 @@
+/**
+ * @file ImportadorCapturas.h
+ * @brief Importación masiva y paralela de capturas del puerto serial
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef IMPORTADOR_CAPTURAS_H
+#define IMPORTADOR_CAPTURAS_H
+
+#include "ListaGeneral.h"
+
+/**
+ * @brief Tiempos y contadores de una importación
+ */
+struct ResultadoImportacion {
+    long long bytes;         ///< Tamaño del archivo
+    long long lecturas;      ///< Lecturas importadas
+    long long descartadas;   ///< Líneas que no se pudieron interpretar
+    int sensoresCreados;     ///< Sensores nuevos creados por nombre
+    int hilos;               ///< Hilos usados para interpretar
+    long long msLectura;     ///< Mapeo del archivo
+    long long msInterpretacion; ///< Interpretación paralela de los trozos
+    long long msFusion;      ///< Inserción por lotes en los sensores
+};
+
+/**
+ * @class ImportadorCapturas
+ * @brief Carga capturas grabadas del Arduino en ListaGeneral
+ *
+ * Cada línea sigue el protocolo del puerto serial: TEMP:valor o
+ * PRES:valor van a los sensores por defecto, y TEMP:nombre:valor o
+ * PRES:nombre:valor a un sensor con nombre (se crea si no existe).
+ *
+ * El archivo se proyecta en memoria y se divide en trozos alineados a
+ * fin de línea; cada hilo interpreta un trozo y agrupa sus lecturas por
+ * sensor. Después, en un solo hilo y en el orden de los trozos, cada
+ * grupo se inserta con registrarLote, de modo que cada sensor recibe sus
+ * lecturas en el orden del archivo.
+ *
+ * Las líneas de una captura no traen la hora en que se tomaron: todas
+ * quedan en el minuto de la importación. Con el horizonte crudo por
+ * defecto (15 min) se perderían todas juntas un cuarto de hora después,
+ * así que los sensores que crea la importación reciben su propio
+ * presupuesto, sin horizonte salvo que se fije otro.
+ */
+class ImportadorCapturas {
+private:
+    ListaGeneral* lista;           ///< Lista destino
+    SensorBase* temperaturaDefecto; ///< Destino de TEMP:valor
+    SensorBase* presionDefecto;     ///< Destino de PRES:valor
+    PlanificadorRueda* planificador; ///< Donde se programan los sensores creados
+    PresupuestoRetencion presupuesto; ///< Retención de los sensores creados
+    
+public:
+    /**
+     * @brief Constructor
+     * @param destino Lista donde se registran las lecturas
+     * @param temperatura Sensor para las líneas TEMP sin nombre (puede ser 0)
+     * @param presion Sensor para las líneas PRES sin nombre (puede ser 0)
+     * @param planificadorDestino Planificador de los sensores nuevos (puede ser 0)
+     */
+    ImportadorCapturas(ListaGeneral* destino, SensorBase* temperatura, SensorBase* presion,
+                       PlanificadorRueda* planificadorDestino);
+    
+    /**
+     * @brief Presupuesto de retención para los sensores que cree la importación
+     *
+     * Por defecto el de PresupuestoRetencion sin horizonte crudo. Los
+     * sensores que ya existían conservan el suyo.
+     * @param nuevo Límite, política y horizonte
+     */
+    void fijarPresupuesto(const PresupuestoRetencion& nuevo);
+    
+    /**
+     * @brief Importa un archivo de captura
+     * @param ruta Ruta del archivo
+     * @param hilos Hilos de interpretación (0 = uno por núcleo)
+     * @param resultado Tiempos y contadores de la importación
+     * @return true si el archivo se pudo leer
+     */
+    bool importar(const char* ruta, int hilos, ResultadoImportacion& resultado);
+    
+    /**
+     * @brief Imprime el resumen de una importación
+     * @param resultado Resultado a mostrar
+     */
+    static void imprimir(const ResultadoImportacion& resultado);
+};
+
+#endif // IMPORTADOR_CAPTURAS_H
@@ -0,0 +1,684 @@
+/**
+ * @file Instantanea.h
+ * @brief Instantáneas consistentes del estado de un sensor para lectores concurrentes
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef INSTANTANEA_H
+#define INSTANTANEA_H
+
+#include "SensorBase.h"
+#include "ContabilidadMemoria.h"
+#include "AgregadosFlota.h"
+#include "ArregloDinamico.h"
+#include <memory>
+
+/**
+ * @brief Agregados de un sensor en un instante dado
+ */
+struct AgregadosSensor {
+    int id;                  ///< ID del sensor en TablaNombres
+    TipoSensor tipo;         ///< Tipo concreto del sensor
+    unsigned int version;    ///< Versión de los datos (lecturas registradas)
+    int cantidad;            ///< Lecturas vivas en el historial
+    double suma;             ///< Suma de las lecturas vivas
+    double promedio;         ///< Promedio de las lecturas vivas
+    double minimoHistorico;  ///< Menor lectura recibida desde la creación
+    double maximoHistorico;  ///< Mayor lectura recibida desde la creación
+    double ultimo;           ///< Última lectura recibida
+    double ultimoResultado;  ///< Resultado del último procesarLectura
+    int anomalias;           ///< Anomalías detectadas
+    
+    /**
+     * @brief Constructor con todo en cero
+     */
+    AgregadosSensor() {
+        id = -1;
+        tipo = SENSOR_OTRO;
+        version = 0;
+        cantidad = 0;
+        suma = 0.0;
+        promedio = 0.0;
+        minimoHistorico = 0.0;
+        maximoHistorico = 0.0;
+        ultimo = 0.0;
+        ultimoResultado = 0.0;
+        anomalias = 0;
+    }
+};
+
+/**
+ * @brief Bloque contiguo de lecturas compartido entre versiones
+ * @tparam T Tipo de las lecturas
+ */
+template <typename T>
+struct AlmacenHistorial {
+    T* valores;     ///< Lecturas
+    int capacidad;  ///< Tamaño del bloque
+    
+    /**
+     * @brief Reserva el bloque
+     * @param cap Capacidad en lecturas
+     */
+    AlmacenHistorial(int cap) {
+        valores = new T[cap];
+        capacidad = cap;
+        ContabilidadMemoria::global().reservar(MEMORIA_HISTORIAL, bytesUsados());
+    }
+    
+    /**
+     * @brief Libera el bloque
+     */
+    ~AlmacenHistorial() {
+        ContabilidadMemoria::global().liberar(MEMORIA_HISTORIAL, bytesUsados());
+        delete[] valores;
+    }
+    
+    /**
+     * @brief Bytes que ocupa el bloque
+     * @return Tamaño del objeto más el arreglo de lecturas
+     */
+    long long bytesUsados() const {
+        return (long long)sizeof(AlmacenHistorial<T>) + (long long)capacidad * sizeof(T);
+    }
+    
+private:
+    AlmacenHistorial(const AlmacenHistorial<T>&);
+    AlmacenHistorial<T>& operator=(const AlmacenHistorial<T>&);
+};
+
+/**
+ * @class VistaHistorial
+ * @brief Vista inmutable de un rango del historial en un instante dado
+ * @tparam T Tipo de las lecturas
+ *
+ * Copiarla es O(1): comparte el bloque, que sigue vivo mientras alguna
+ * vista lo use.
+ */
+template <typename T>
+class VistaHistorial {
+private:
+    std::shared_ptr<const AlmacenHistorial<T> > almacen; ///< Bloque compartido
+    int inicio; ///< Primera lectura visible
+    int fin;    ///< Una después de la última visible
+    
+public:
+    /**
+     * @brief Vista vacía
+     */
+    VistaHistorial() {
+        inicio = 0;
+        fin = 0;
+    }
+    
+    /**
+     * @brief Vista sobre un rango de un bloque
+     */
+    VistaHistorial(const std::shared_ptr<const AlmacenHistorial<T> >& bloque, int ini, int f) {
+        almacen = bloque;
+        inicio = ini;
+        fin = f;
+    }
+    
+    /**
+     * @brief Número de lecturas visibles
+     * @return Tamaño de la vista
+     */
+    int tamano() const {
+        return fin - inicio;
+    }
+    
+    /**
+     * @brief Lectura en orden de llegada
+     * @param indice Posición (0 = la más antigua visible)
+     * @return Valor de la lectura
+     */
+    T operator[](int indice) const {
+        return almacen->valores[inicio + indice];
+    }
+    
+    /**
+     * @brief Acceso contiguo a las lecturas visibles
+     * @return Puntero a la más antigua (0 si la vista está vacía)
+     */
+    const T* datos() const {
+        if (almacen.get() == 0) {
+            return 0;
+        }
+        return almacen->valores + inicio;
+    }
+};
+
+/**
+ * @class HistorialVersionado
+ * @brief Historial del escritor que produce vistas en O(1)
+ * @tparam T Tipo de las lecturas
+ *
+ * Las lecturas se agregan al final de un bloque contiguo. Las vistas ya
+ * publicadas solo leen posiciones anteriores a su 'fin', así que escribir
+ * después de él no las afecta. Cuando el bloque se llena, o se elimina una
+ * lectura intermedia mientras alguna vista lo comparte, se copia a un
+ * bloque nuevo (copia en escritura) y las vistas antiguas conservan el
+ * suyo. Si ninguna vista lo comparte, la eliminación se hace en el sitio.
+ *
+ * Es el único almacén de lecturas del sensor: el escritor lo recorre con
+ * begin()/end() y los lectores reciben vistas del mismo bloque.
+ */
+template <typename T>
+class HistorialVersionado {
+private:
+    std::shared_ptr<AlmacenHistorial<T> > almacen; ///< Bloque actual
+    int inicio; ///< Primera lectura viva
+    int fin;    ///< Una después de la última
+    
+    /**
+     * @brief Copia las lecturas vivas a un bloque nuevo
+     * @param omitir Posición absoluta a excluir (-1 para ninguna)
+     */
+    void reubicar(int omitir) {
+        int vivas = fin - inicio;
+        int capacidad = vivas * 2;
+        if (capacidad < 16) {
+            capacidad = 16;
+        }
+        
+        std::shared_ptr<AlmacenHistorial<T> > nuevo(new AlmacenHistorial<T>(capacidad));
+        int j = 0;
+        for (int i = inicio; i < fin; i++) {
+            if (i != omitir) {
+                nuevo->valores[j] = almacen->valores[i];
+                j = j + 1;
+            }
+        }
+        
+        almacen = nuevo;
+        inicio = 0;
+        fin = j;
+    }
+    
+public:
+    /**
+     * @brief Historial vacío
+     */
+    HistorialVersionado() {
+        inicio = 0;
+        fin = 0;
+    }
+    
+    /**
+     * @brief Agrega una lectura al final (O(1) amortizado)
+     * @param valor Lectura
+     */
+    void agregar(T valor) {
+        if (almacen.get() == 0 || fin == almacen->capacidad) {
+            reubicar(-1);
+        }
+        almacen->valores[fin] = valor;
+        fin = fin + 1;
+    }
+    
+    /**
+     * @brief Descarta la lectura más antigua en O(1) amortizado
+     *
+     * Si queda vivo menos de un cuarto del bloque se pasa a uno más
+     * chico, para que desalojar lecturas libere memoria de verdad.
+     */
+    void eliminarPrimero() {
+        if (inicio < fin) {
+            inicio = inicio + 1;
+        }
+        if (almacen.get() != 0 && almacen->capacidad > 16 && (fin - inicio) * 4 < almacen->capacidad) {
+            reubicar(-1);
+        }
+    }
+    
+    /**
+     * @brief Reduce el historial promediando pares consecutivos (como ListaSensor)
+     * @return Nueva suma de las lecturas
+     */
+    double submuestrear() {
+        int vivas = fin - inicio;
+        int capacidad = vivas;
+        if (capacidad < 16) {
+            capacidad = 16;
+        }
+        
+        std::shared_ptr<AlmacenHistorial<T> > nuevo(new AlmacenHistorial<T>(capacidad));
+        double suma = 0.0;
+        int j = 0;
+        for (int i = inicio; i < fin; i = i + 2) {
+            T valor = almacen->valores[i];
+            if (i + 1 < fin) {
+                valor = (valor + almacen->valores[i + 1]) / 2;
+            }
+            nuevo->valores[j] = valor;
+            suma = suma + valor;
+            j = j + 1;
+        }
+        
+        almacen = nuevo;
+        inicio = 0;
+        fin = j;
+        return suma;
+    }
+    
+    /**
+     * @brief Bytes del bloque actual
+     * @return Bytes (0 si aún no hay bloque)
+     */
+    long long bytesUsados() const {
+        if (almacen.get() == 0) {
+            return 0;
+        }
+        return almacen->bytesUsados();
+    }
+    
+    /**
+     * @brief Posición de la primera aparición de la lectura más baja
+     * @return Posición (0 = la más antigua), -1 si está vacío
+     */
+    int posicionMinimo() const {
+        if (inicio == fin) {
+            return -1;
+        }
+        int minimo = inicio;
+        for (int i = inicio + 1; i < fin; i++) {
+            if (almacen->valores[i] < almacen->valores[minimo]) {
+                minimo = i;
+            }
+        }
+        return minimo - inicio;
+    }
+    
+    /**
+     * @brief Elimina la lectura de una posición
+     *
+     * Si una vista publicada comparte el bloque se copia una sola vez; las
+     * eliminaciones siguientes, hasta la próxima publicación, son en el sitio.
+     * @param posicion Posición (0 = la más antigua)
+     * @return Valor eliminado
+     */
+    T eliminarEn(int posicion) {
+        int absoluta = inicio + posicion;
+        T valor = almacen->valores[absoluta];
+        if (almacen.use_count() > 1) {
+            reubicar(absoluta);
+            return valor;
+        }
+        for (int i = absoluta; i + 1 < fin; i++) {
+            almacen->valores[i] = almacen->valores[i + 1];
+        }
+        fin = fin - 1;
+        return valor;
+    }
+    
+    /**
+     * @brief Lectura más antigua
+     * @return Valor (el historial no debe estar vacío)
+     */
+    T primero() const {
+        return almacen->valores[inicio];
+    }
+    
+    /**
+     * @brief Inicio de las lecturas vivas, contiguas y en orden de llegada
+     * @return Puntero a la más antigua
+     */
+    const T* begin() const {
+        return almacen.get() == 0 ? 0 : almacen->valores + inicio;
+    }
+    
+    /**
+     * @brief Una posición después de la lectura más reciente
+     * @return Puntero final
+     */
+    const T* end() const {
+        return almacen.get() == 0 ? 0 : almacen->valores + fin;
+    }
+    
+    /**
+     * @brief Número de lecturas vivas
+     * @return Tamaño del historial
+     */
+    int tamano() const {
+        return fin - inicio;
+    }
+    
+    /**
+     * @brief Vista inmutable del estado actual
+     * @return Vista que comparte el bloque
+     */
+    VistaHistorial<T> vista() const {
+        return VistaHistorial<T>(almacen, inicio, fin);
+    }
+};
+
+/**
+ * @brief Estado de un sensor en un instante: agregados e historial
+ * @tparam T Tipo de las lecturas
+ */
+template <typename T>
+struct InstantaneaSensor {
+    AgregadosSensor agregados;   ///< Agregados en el instante
+    VistaHistorial<T> historial; ///< Historial en el instante
+};
+
+/**
+ * @brief Buzón de instantáneas visto sin conocer el tipo de las lecturas
+ *
+ * Lo usan quienes no pueden nombrar T: los sensores genéricos
+ * (SENSOR_OTRO) en el directorio, el punto de control y la exportación.
+ * Ambas lecturas toman una sola instantánea, seguras entre hilos.
+ */
+struct BuzonGenerico {
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~BuzonGenerico() {
+    }
+    
+    /**
+     * @brief Agregados de la última instantánea
+     * @param destino Donde se copian
+     * @return false si aún no se publicó ninguna
+     */
+    virtual bool leerAgregados(AgregadosSensor& destino) const = 0;
+    
+    /**
+     * @brief Agregados e historial de la última instantánea
+     * @param agregados Donde se copian los agregados
+     * @param lecturas Las lecturas se agregan al final, convertidas a double
+     * @return false si aún no se publicó ninguna
+     */
+    virtual bool copiarLecturas(AgregadosSensor& agregados, ArregloDinamico<double>& lecturas) const = 0;
+};
+
+/**
+ * @brief Punto de publicación de las instantáneas de un sensor
+ * @tparam T Tipo de las lecturas
+ *
+ * Vive aparte del sensor y se comparte por shared_ptr: quien lo conserve
+ * (por ejemplo el directorio del servidor de consultas) puede seguir
+ * leyendo la última instantánea aunque el sensor se haya eliminado.
+ */
+template <typename T>
+struct BuzonInstantanea : public BuzonGenerico {
+    std::shared_ptr<const InstantaneaSensor<T> > publicada; ///< Última instantánea
+    
+    /**
+     * @brief Lee la última instantánea (seguro entre hilos)
+     * @return Instantánea inmutable (vacía si aún no se publicó)
+     */
+    std::shared_ptr<const InstantaneaSensor<T> > leer() const {
+        return std::atomic_load(&publicada);
+    }
+    
+    /**
+     * @brief Agregados de la última instantánea (ver BuzonGenerico)
+     */
+    bool leerAgregados(AgregadosSensor& destino) const {
+        std::shared_ptr<const InstantaneaSensor<T> > foto = leer();
+        if (!foto) {
+            return false;
+        }
+        destino = foto->agregados;
+        return true;
+    }
+    
+    /**
+     * @brief Agregados e historial convertido a double (ver BuzonGenerico)
+     */
+    bool copiarLecturas(AgregadosSensor& agregados, ArregloDinamico<double>& lecturas) const {
+        std::shared_ptr<const InstantaneaSensor<T> > foto = leer();
+        if (!foto) {
+            return false;
+        }
+        agregados = foto->agregados;
+        for (int i = 0; i < foto->historial.tamano(); i++) {
+            lecturas.agregar((double)foto->historial[i]);
+        }
+        return true;
+    }
+};
+
+/**
+ * @class EstadoPublicado
+ * @brief Mantiene el estado del sensor y lo publica como instantánea inmutable
+ * @tparam T Tipo de las lecturas
+ *
+ * El hilo escritor (ingesta/procesamiento) modifica el estado y, al
+ * terminar una operación completa, publica una instantánea nueva con
+ * publicarPendiente(); cualquier hilo puede leer la última publicada con
+ * leer() en O(1), sin esperar al escritor ni ver estados a medias.
+ *
+ * Los cambios sueltos (una lectura, un desalojo) solo dejan el estado
+ * pendiente: publicar cuesta una reserva y un atomic_store, y se paga
+ * una vez por lote o por procesamiento, no una vez por lectura.
+ *
+ * Cada publicación actualiza también los resúmenes de AgregadosFlota.
+ */
+template <typename T>
+class EstadoPublicado {
+private:
+    HistorialVersionado<T> historial; ///< Historial del escritor
+    AgregadosSensor agregados;        ///< Agregados del escritor
+    std::shared_ptr<BuzonInstantanea<T> > buzon; ///< Donde se publica la última instantánea
+    bool pendiente;                   ///< Hay cambios sin publicar
+    
+    /**
+     * @brief Publica el estado actual como instantánea nueva
+     */
+    void publicar() {
+        agregados.cantidad = historial.tamano();
+        if (agregados.cantidad > 0) {
+            agregados.promedio = agregados.suma / agregados.cantidad;
+        } else {
+            agregados.promedio = 0.0;
+        }
+        
+        InstantaneaSensor<T>* nueva = new InstantaneaSensor<T>();
+        nueva->agregados = agregados;
+        nueva->historial = historial.vista();
+        
+        // Solo el escritor reemplaza publicada: leerla aquí no compite
+        const std::shared_ptr<const InstantaneaSensor<T> >& anterior = buzon->publicada;
+        AgregadosFlota::global().actualizar(anterior ? &anterior->agregados : 0, agregados);
+        
+        std::shared_ptr<const InstantaneaSensor<T> > puntero(nueva);
+        std::atomic_store(&buzon->publicada, puntero);
+        pendiente = false;
+    }
+    
+    EstadoPublicado(const EstadoPublicado&);
+    EstadoPublicado& operator=(const EstadoPublicado&);
+    
+public:
+    /**
+     * @brief Constructor (el estado se publica en iniciar)
+     */
+    EstadoPublicado() : buzon(new BuzonInstantanea<T>()) {
+        pendiente = false;
+    }
+    
+    /**
+     * @brief Destructor - retira el sensor de los agregados de la flota
+     *
+     * El buzón sobrevive mientras otro lo comparta, con la última
+     * instantánea publicada.
+     */
+    ~EstadoPublicado() {
+        if (buzon->publicada) {
+            AgregadosFlota::global().retirar(buzon->publicada->agregados);
+        }
+    }
+    
+    /**
+     * @brief Inicializa la identidad del sensor y publica el estado vacío
+     * @param id ID del sensor
+     * @param tipo Tipo concreto
+     */
+    void iniciar(int id, TipoSensor tipo) {
+        agregados.id = id;
+        agregados.tipo = tipo;
+        publicar();
+    }
+    
+    /**
+     * @brief Registra una lectura nueva
+     * @param valor Lectura
+     * @param version Versión del sensor tras la lectura
+     * @param anomalias Anomalías detectadas hasta ahora
+     */
+    void registrar(T valor, unsigned int version, int anomalias) {
+        historial.agregar(valor);
+        
+        if (agregados.version == 0 || valor < agregados.minimoHistorico) {
+            agregados.minimoHistorico = valor;
+        }
+        if (agregados.version == 0 || valor > agregados.maximoHistorico) {
+            agregados.maximoHistorico = valor;
+        }
+        
+        agregados.version = version;
+        agregados.suma = agregados.suma + valor;
+        agregados.ultimo = valor;
+        agregados.anomalias = anomalias;
+        pendiente = true;
+    }
+    
+    /**
+     * @brief Registra un lote de lecturas (queda pendiente de publicar)
+     * @param valores Lecturas en orden de llegada
+     * @param cantidad Número de lecturas
+     * @param version Versión del sensor tras el lote
+     * @param anomalias Anomalías detectadas hasta ahora
+     */
+    void registrarLote(const T* valores, int cantidad, unsigned int version, int anomalias) {
+        if (cantidad <= 0) {
+            return;
+        }
+        
+        for (int i = 0; i < cantidad; i++) {
+            T valor = valores[i];
+            historial.agregar(valor);
+            
+            if ((agregados.version == 0 && i == 0) || valor < agregados.minimoHistorico) {
+                agregados.minimoHistorico = valor;
+            }
+            if ((agregados.version == 0 && i == 0) || valor > agregados.maximoHistorico) {
+                agregados.maximoHistorico = valor;
+            }
+            agregados.suma = agregados.suma + valor;
+        }
+        
+        agregados.version = version;
+        agregados.ultimo = valores[cantidad - 1];
+        agregados.anomalias = anomalias;
+        pendiente = true;
+    }
+    
+    /**
+     * @brief Elimina la primera aparición de la lectura más baja
+     * @return Valor eliminado (el historial no debe estar vacío)
+     */
+    T eliminarMinimo() {
+        T valor = historial.eliminarEn(historial.posicionMinimo());
+        // Sin lecturas la suma vuelve a ser exacta
+        agregados.suma = historial.tamano() == 0 ? 0.0 : agregados.suma - valor;
+        pendiente = true;
+        return valor;
+    }
+    
+    /**
+     * @brief Desaloja la lectura más antigua
+     * @return Valor desalojado (el historial no debe estar vacío)
+     */
+    T eliminarPrimero() {
+        T valor = historial.primero();
+        historial.eliminarPrimero();
+        agregados.suma = historial.tamano() == 0 ? 0.0 : agregados.suma - valor;
+        pendiente = true;
+        return valor;
+    }
+    
+    /**
+     * @brief Refleja un submuestreo del historial
+     */
+    void submuestrear() {
+        agregados.suma = historial.submuestrear();
+        pendiente = true;
+    }
+    
+    /**
+     * @brief Bytes del historial versionado del escritor
+     * @return Bytes
+     */
+    long long bytesUsados() const {
+        return historial.bytesUsados();
+    }
+    
+    /**
+     * @brief Lecturas vivas
+     * @return Tamaño del historial
+     */
+    int cantidad() const {
+        return historial.tamano();
+    }
+    
+    /**
+     * @brief Promedio de las lecturas vivas en O(1)
+     * @return Promedio (0 si no hay lecturas)
+     */
+    double promedio() const {
+        int vivas = historial.tamano();
+        return vivas == 0 ? 0.0 : agregados.suma / vivas;
+    }
+    
+    /**
+     * @brief Historial del escritor (solo desde su hilo)
+     * @return Referencia al historial
+     */
+    const HistorialVersionado<T>& historialVivo() const {
+        return historial;
+    }
+    
+    /**
+     * @brief Guarda el resultado del último procesamiento
+     * @param resultado Valor calculado por procesarLectura
+     */
+    void fijarResultado(double resultado) {
+        agregados.ultimoResultado = resultado;
+        pendiente = true;
+    }
+    
+    /**
+     * @brief Publica el estado si cambió desde la última publicación
+     * @return true si se publicó una instantánea nueva
+     */
+    bool publicarPendiente() {
+        if (!pendiente) {
+            return false;
+        }
+        publicar();
+        return true;
+    }
+    
+    /**
+     * @brief Obtiene la última instantánea publicada (seguro entre hilos)
+     * @return Instantánea inmutable
+     */
+    std::shared_ptr<const InstantaneaSensor<T> > leer() const {
+        return buzon->leer();
+    }
+    
+    /**
+     * @brief Comparte el buzón de publicación
+     * @return Buzón que sobrevive al sensor mientras alguien lo conserve
+     */
+    std::shared_ptr<const BuzonInstantanea<T> > compartirBuzon() const {
+        return buzon;
+    }
+};
+
+#endif // INSTANTANEA_H
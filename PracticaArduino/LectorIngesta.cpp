@@ -0,0 +1,94 @@
+/**
+ * @file LectorIngesta.cpp
+ * @brief Implementación del hilo lector de la ingesta serial
+ */
+
+#include "LectorIngesta.h"
+#include <iostream>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+using namespace std;
+
+LectorIngesta::LectorIngesta(SerialReader* puerto, TuberiaIngesta* etapas)
+    : activo(false) {
+    serial = puerto;
+    tuberia = etapas;
+    sondeo = false;
+    cpu = -1;
+}
+
+LectorIngesta::~LectorIngesta() {
+    detener();
+}
+
+void LectorIngesta::configurarLatencia(bool girar, int cpuLector) {
+    if (activo.load()) {
+        return;
+    }
+    sondeo = girar;
+    cpu = cpuLector;
+}
+
+void LectorIngesta::iniciar() {
+    if (activo.load() || serial == 0 || !serial->estaConectado()) {
+        return;
+    }
+    activo.store(true);
+    hilo = std::thread(&LectorIngesta::bucle, this);
+}
+
+void LectorIngesta::detener() {
+    if (!activo.load()) {
+        return;
+    }
+    activo.store(false);
+    if (hilo.joinable()) {
+        hilo.join();
+    }
+    
+    // No dejar al dispositivo en pausa al salir
+    if (tuberia->cola()->levantarPausa()) {
+        serial->enviarByte(SerialReader::CARACTER_XON);
+    }
+}
+
+bool LectorIngesta::estaActivo() const {
+    return activo.load();
+}
+
+int LectorIngesta::interpretar(const char* linea, const DirectorioSensores& directorio, LecturaEntrante& lectura) {
+    LecturaAnalizada analizada;
+    if (!TuberiaIngesta::analizar(linea, analizada)) {
+        return -1;
+    }
+    return TuberiaIngesta::enrutar(analizada, directorio, lectura) ? 1 : 0;
+}
+
+bool LectorIngesta::fijarHiloActual(int numeroCpu) {
+    if (numeroCpu < 0 || numeroCpu >= (int)thread::hardware_concurrency()) {
+        return false;
+    }
+#ifdef _WIN32
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << numeroCpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(numeroCpu, &conjunto);
+    return pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto) == 0;
+#else
+    // macOS no permite fijar hilos a un núcleo
+    return false;
+#endif
+}
+
+void LectorIngesta::bucle() {
+    if (cpu >= 0 && !fijarHiloActual(cpu)) {
+        cout << "[Advertencia] No se pudo fijar el lector a la CPU " << cpu << endl;
+    }
+    
+    tuberia->leerPuerto(serial, activo, sondeo);
+}
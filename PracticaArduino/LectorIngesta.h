@@ -0,0 +1,114 @@
+/**
+ * @file LectorIngesta.h
+ * @brief Hilo que lee el puerto serial y alimenta ControlIngesta
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef LECTOR_INGESTA_H
+#define LECTOR_INGESTA_H
+
+#include "SerialReader.h"
+#include "ControlIngesta.h"
+#include "DirectorioSensores.h"
+#include "TuberiaIngesta.h"
+#include <atomic>
+#include <thread>
+
+/**
+ * @class LectorIngesta
+ * @brief Lee el puerto sin depender del menú y encola cada lectura
+ *
+ * Formatos aceptados (una lectura por línea):
+ *   TEMP:valor, PRES:valor           -> sensores T-001 y P-105
+ *   TEMP:nombre:valor, PRES:nombre:valor
+ *
+ * Cualquiera admite al final #secuencia (TEMP:T-001:23.5#118): un
+ * contador por sensor, con el que ControlIngesta descarta repetidas y
+ * reordena, o una marca de tiempo creciente si así se configura
+ * (ConfigIngesta::secuenciaEsMarca). Tras ella
+ * puede venir @marca (TEMP:23.5#118@40213377), la hora de emisión en us
+ * del dispositivo, que solo usa TrazaLatencia.
+ *
+ * El hilo corre la mitad lectora de TuberiaIngesta (leer, enmarcar,
+ * interpretar y enrutar). Los nombres se resuelven con el directorio
+ * publicado por ListaGeneral, que se puede leer desde este hilo. Tras cada
+ * lectura del puerto (o cada espera de ~100 ms sin datos) se envía
+ * XON/XOFF si ControlIngesta lo pide.
+ *
+ * En modo de sondeo (puerto abierto con VMIN = VTIME = 0) el hilo no
+ * duerme entre lecturas: gira sobre el puerto, fijado a su CPU, y cede
+ * el procesador solo si otro hilo lo necesita. Cuesta un núcleo a cambio
+ * de no esperar al planificador del sistema en cada línea.
+ */
+class LectorIngesta {
+private:
+    SerialReader* serial;       ///< Puerto a leer (no se libera aquí)
+    TuberiaIngesta* tuberia;    ///< Etapas que corren en el hilo
+    std::thread hilo;           ///< Hilo lector
+    std::atomic<bool> activo;   ///< false pide al hilo que termine
+    bool sondeo;                ///< Girar sobre el puerto sin dormir
+    int cpu;                    ///< CPU del hilo lector (-1 = sin fijar)
+    
+    /**
+     * @brief Bucle del hilo lector
+     */
+    void bucle();
+    
+    LectorIngesta(const LectorIngesta&);
+    LectorIngesta& operator=(const LectorIngesta&);
+    
+public:
+    /**
+     * @brief Constructor (no arranca el hilo)
+     * @param puerto Puerto serial ya abierto
+     * @param etapas Tubería cuya mitad lectora corre en el hilo
+     */
+    LectorIngesta(SerialReader* puerto, TuberiaIngesta* etapas);
+    
+    /**
+     * @brief Destructor - detiene el hilo si sigue activo
+     */
+    ~LectorIngesta();
+    
+    /**
+     * @brief Elige el modo del hilo (antes de iniciar)
+     * @param girar true para leer por sondeo, sin dormir
+     * @param cpuLector CPU donde fijar el hilo lector (-1 = sin fijar)
+     */
+    void configurarLatencia(bool girar, int cpuLector);
+    
+    /**
+     * @brief Arranca el hilo lector
+     */
+    void iniciar();
+    
+    /**
+     * @brief Detiene el hilo y, si el dispositivo quedó pausado, envía XON
+     */
+    void detener();
+    
+    /**
+     * @brief Indica si el hilo está leyendo
+     * @return true si está activo
+     */
+    bool estaActivo() const;
+    
+    /**
+     * @brief Interpreta una línea recibida (interpretar y enrutar de la tubería)
+     * @param linea Texto sin salto de línea
+     * @param directorio Directorio donde buscar el sensor
+     * @param lectura Recibe la lectura interpretada
+     * @return 1 si es válida, 0 si el sensor no existe, -1 si la línea es inválida
+     */
+    static int interpretar(const char* linea, const DirectorioSensores& directorio, LecturaEntrante& lectura);
+    
+    /**
+     * @brief Fija el hilo que llama a una CPU
+     * @param numeroCpu CPU destino (desde 0)
+     * @return false si no existe o la plataforma no lo permite
+     */
+    static bool fijarHiloActual(int numeroCpu);
+};
+
+#endif // LECTOR_INGESTA_H
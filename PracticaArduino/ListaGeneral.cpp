@@ -1,112 +1,808 @@
-/**
- * @file ListaGeneral.cpp
- * @brief Implementación de la lista de gestión polimórfica
- */
-
-#include "ListaGeneral.h"
-#include <iostream>
-
-using namespace std;
-
-ListaGeneral::ListaGeneral() {
-    cabeza = 0;
-}
-
-ListaGeneral::~ListaGeneral() {
-    cout << "\n--- Liberacion de Memoria en Cascada ---" << endl;
-    
-    NodoGeneral* actual = cabeza;
-    while (actual != 0) {
-        NodoGeneral* siguiente = actual->siguiente;
-        
-        cout << "[Destructor General] Liberando Nodo: " << actual->sensor->obtenerNombre() << endl;
-        
-        // IMPORTANTE: Esto llama al destructor virtual, que invoca
-        // el destructor correcto de la clase derivada
-        delete actual->sensor;
-        
-        delete actual;
-        actual = siguiente;
-    }
-    
-    cout << "Sistema cerrado. Memoria limpia." << endl;
-}
-
-void ListaGeneral::insertar(SensorBase* sensor) {
-    NodoGeneral* nuevoNodo = new NodoGeneral(sensor);
-    
-    if (cabeza == 0) {
-        cabeza = nuevoNodo;
-        return;
-    }
-    
-    // Buscar el último nodo
-    NodoGeneral* actual = cabeza;
-    while (actual->siguiente != 0) {
-        actual = actual->siguiente;
-    }
-    
-    actual->siguiente = nuevoNodo;
-}
-
-SensorBase* ListaGeneral::buscar(const char* nombreBuscar) const {
-    NodoGeneral* actual = cabeza;
-    
-    while (actual != 0) {
-        const char* nombreActual = actual->sensor->obtenerNombre();
-        
-        // Comparar cadenas manualmente
-        bool iguales = true;
-        int i = 0;
-        while (nombreActual[i] != '\0' || nombreBuscar[i] != '\0') {
-            if (nombreActual[i] != nombreBuscar[i]) {
-                iguales = false;
-                break;
-            }
-            i++;
-        }
-        
-        if (iguales) {
-            return actual->sensor;
-        }
-        
-        actual = actual->siguiente;
-    }
-    
-    return 0;
-}
-
-void ListaGeneral::procesarTodos() {
-    cout << "\n--- Ejecutando Polimorfismo ---" << endl;
-    
-    NodoGeneral* actual = cabeza;
-    while (actual != 0) {
-        // POLIMORFISMO: Llama al método correcto según el tipo real
-        actual->sensor->procesarLectura();
-        cout << endl;
-        actual = actual->siguiente;
-    }
-}
-
-void ListaGeneral::imprimirTodos() const {
-    cout << "\n--- Lista de Sensores Registrados ---" << endl;
-    
-    if (cabeza == 0) {
-        cout << "No hay sensores registrados." << endl;
-        return;
-    }
-    
-    NodoGeneral* actual = cabeza;
-    int contador = 1;
-    while (actual != 0) {
-        cout << contador << ". ";
-        actual->sensor->imprimirInfo();
-        cout << endl;
-        contador = contador + 1;
-        actual = actual->siguiente;
-    }
-}
-
-bool ListaGeneral::estaVacia() const {
-    return cabeza == 0;
+/**
+ * @file ListaGeneral.cpp
+ * @brief Implementación de la lista de gestión polimórfica
+ */
+
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "SensorGenerico.h"
+#include "TablaNombres.h"
+#include "RegistroCambios.h"
+#include "PlanificadorRueda.h"
+#include "Bitacora.h"
+#include "RenderizadorReporte.h"
+#include "TrazaLatencia.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+ListaGeneral::ListaGeneral() {
+    cabeza = 0;
+    cola = 0;
+    cierreRapido = false;
+    cargasMasivas = 0;
+    directorioPendiente = false;
+    publicarDirectorio();
+}
+
+ListaGeneral::~ListaGeneral() {
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    
+    if (cierreRapido) {
+        // El proceso termina: la memoria vuelve al sistema operativo en bloque
+        cout << "\n[Cierre rapido] " << cantidadSensores() << " sensor(es) sin liberacion individual ("
+             << ContabilidadMemoria::global().bytesTotales() << " bytes)." << endl;
+        return;
+    }
+    
+    cout << "\n--- Liberacion de Memoria en Cascada ---" << endl;
+    bool bitacora = Bitacora::activa();
+    
+    NodoGeneral* actual = cabeza;
+    while (actual != 0) {
+        NodoGeneral* siguiente = actual->siguiente;
+        
+        if (bitacora) {
+            cout << "[Destructor General] Liberando Nodo: " << actual->sensor->obtenerNombre() << endl;
+        }
+        
+        // IMPORTANTE: Esto llama al destructor virtual, que invoca
+        // el destructor correcto de la clase derivada
+        delete actual->sensor;
+        
+        delete actual;
+        actual = siguiente;
+    }
+    
+    long long ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - inicio).count();
+    cout << "Sistema cerrado. Memoria limpia (" << ms << " ms)." << endl;
+}
+
+void ListaGeneral::fijarCierreRapido(bool activo) {
+    cierreRapido = activo;
+}
+
+/**
+ * @brief Escribe las lecturas de una instantánea separadas por espacios
+ */
+template <typename T>
+static void escribirLecturas(ofstream& archivo, const VistaHistorial<T>& historial) {
+    for (int i = 0; i < historial.tamano(); i++) {
+        if (i > 0) {
+            archivo << ' ';
+        }
+        archivo << historial[i];
+    }
+}
+
+int ListaGeneral::guardarPuntoControl(const char* ruta) const {
+    ofstream archivo(ruta);
+    
+    if (!archivo.is_open()) {
+        cout << "[Punto de control] No se pudo escribir " << ruta << endl;
+        return -1;
+    }
+    
+    // 9 dígitos significativos: un float se relee sin pérdida
+    archivo.precision(9);
+    archivo << "# tipo,nombre,grupo,lecturas" << '\n';
+    int guardados = 0;
+    
+    NodoGeneral* actual = cabeza;
+    while (actual != 0) {
+        SensorBase* sensor = actual->sensor;
+        const char* grupo = AgregadosFlota::global().etiquetaDe(sensor->obtenerId());
+        if (grupo == 0) {
+            grupo = "";
+        }
+        
+        switch (actual->tipo) {
+            case SENSOR_TEMPERATURA:
+                archivo << "TEMP," << sensor->obtenerNombre() << ',' << grupo << ',';
+                escribirLecturas(archivo, ((SensorTemperatura*)sensor)->obtenerInstantanea()->historial);
+                archivo << '\n';
+                guardados = guardados + 1;
+                break;
+            case SENSOR_PRESION:
+                archivo << "PRES," << sensor->obtenerNombre() << ',' << grupo << ',';
+                escribirLecturas(archivo, ((SensorPresion*)sensor)->obtenerInstantanea()->historial);
+                archivo << '\n';
+                guardados = guardados + 1;
+                break;
+            default: {
+                // Genéricos: lecturas del buzón sin tipo, con la etiqueta del sensor
+                shared_ptr<const BuzonGenerico> buzon = sensor->compartirBuzonGenerico();
+                AgregadosSensor agregados;
+                ArregloDinamico<double> lecturas;
+                if (!buzon || !buzon->copiarLecturas(agregados, lecturas)) {
+                    break;
+                }
+                archivo << sensor->etiquetaTipo() << ',' << sensor->obtenerNombre() << ',' << grupo << ',';
+                for (int i = 0; i < lecturas.tamano(); i++) {
+                    if (i > 0) {
+                        archivo << ' ';
+                    }
+                    archivo << lecturas[i];
+                }
+                archivo << '\n';
+                guardados = guardados + 1;
+                break;
+            }
+        }
+        
+        actual = actual->siguiente;
+    }
+    
+    archivo.close();
+    cout << "[Punto de control] " << guardados << " sensor(es) guardado(s) en " << ruta << endl;
+    return guardados;
+}
+
+bool ListaGeneral::insertar(SensorBase* sensor) {
+    int id = sensor->obtenerId();
+    
+    // El ID identifica al sensor en el registro de cambios y en la flota
+    if (nodoPorId(id) != 0) {
+        return false;
+    }
+    
+    NodoGeneral* nuevoNodo = new NodoGeneral(sensor);
+    nuevoNodo->tipo = sensor->obtenerTipo();
+    
+    // Registrar el sensor en el grupo de su tipo concreto
+    switch (nuevoNodo->tipo) {
+        case SENSOR_TEMPERATURA:
+            nuevoNodo->indiceGrupo = temperaturas.tamano();
+            temperaturas.agregar((SensorTemperatura*)sensor);
+            break;
+        case SENSOR_PRESION:
+            nuevoNodo->indiceGrupo = presiones.tamano();
+            presiones.agregar((SensorPresion*)sensor);
+            break;
+        default:
+            nuevoNodo->indiceGrupo = otros.tamano();
+            otros.agregar(sensor);
+            break;
+    }
+    
+    porId.extender(id + 1, 0);
+    porId[id] = nuevoNodo;
+    
+    // Enlazar al final sin recorrer la lista
+    if (cola == 0) {
+        cabeza = nuevoNodo;
+    } else {
+        cola->siguiente = nuevoNodo;
+        nuevoNodo->anterior = cola;
+    }
+    cola = nuevoNodo;
+    
+    directorioPendiente = true;
+    return true;
+}
+
+NodoGeneral* ListaGeneral::nodoPorId(int id) const {
+    if (id < 0 || id >= porId.tamano()) {
+        return 0;
+    }
+    
+    return porId[id];
+}
+
+void ListaGeneral::quitarDeGrupo(NodoGeneral* nodo) {
+    int indice = nodo->indiceGrupo;
+    SensorBase* movido = 0;
+    
+    switch (nodo->tipo) {
+        case SENSOR_TEMPERATURA:
+            temperaturas.quitarIntercambiando(indice);
+            if (indice < temperaturas.tamano()) {
+                movido = temperaturas[indice];
+            }
+            break;
+        case SENSOR_PRESION:
+            presiones.quitarIntercambiando(indice);
+            if (indice < presiones.tamano()) {
+                movido = presiones[indice];
+            }
+            break;
+        default:
+            otros.quitarIntercambiando(indice);
+            if (indice < otros.tamano()) {
+                movido = otros[indice];
+            }
+            break;
+    }
+    
+    // El último del grupo ocupa ahora la posición liberada
+    if (movido != 0) {
+        porId[movido->obtenerId()]->indiceGrupo = indice;
+    }
+}
+
+bool ListaGeneral::eliminarPorId(int id, PlanificadorRueda* planificador) {
+    NodoGeneral* nodo = nodoPorId(id);
+    
+    if (nodo == 0) {
+        return false;
+    }
+    
+    if (planificador != 0) {
+        planificador->cancelar(id);
+    }
+    RegistroCambios::global().desmarcar(id);
+    
+    quitarDeGrupo(nodo);
+    porId[id] = 0;
+    
+    if (nodo->anterior != 0) {
+        nodo->anterior->siguiente = nodo->siguiente;
+    } else {
+        cabeza = nodo->siguiente;
+    }
+    if (nodo->siguiente != 0) {
+        nodo->siguiente->anterior = nodo->anterior;
+    } else {
+        cola = nodo->anterior;
+    }
+    
+    // El destructor virtual libera el historial del sensor; el directorio
+    // viejo solo conserva su buzón, no el sensor
+    delete nodo->sensor;
+    delete nodo;
+    
+    directorioPendiente = true;
+    return true;
+}
+
+bool ListaGeneral::eliminar(const char* nombre, PlanificadorRueda* planificador) {
+    int id = TablaNombres::global().buscar(nombre);
+    
+    if (id < 0) {
+        return false;
+    }
+    
+    return eliminarPorId(id, planificador);
+}
+
+/**
+ * @brief Copia un campo de una línea de manifiesto hasta la coma o el fin
+ * @param linea Posición actual en la línea (avanza tras la coma)
+ * @param destino Buffer de salida
+ * @param tam Tamaño del buffer
+ */
+static void leerCampo(const char*& linea, char* destino, int tam) {
+    int i = 0;
+    while (*linea != '\0' && *linea != ',' && *linea != '\r') {
+        if (i < tam - 1) {
+            destino[i] = *linea;
+            i = i + 1;
+        }
+        linea = linea + 1;
+    }
+    destino[i] = '\0';
+    
+    if (*linea == ',') {
+        linea = linea + 1;
+    }
+}
+
+/**
+ * @brief Indica si tras el cursor solo quedan espacios (o el \r de una línea CRLF)
+ */
+static bool soloEspacios(const char* cursor) {
+    while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') {
+        cursor = cursor + 1;
+    }
+    return *cursor == '\0';
+}
+
+int ListaGeneral::cargarManifiesto(const char* ruta, PlanificadorRueda* planificador) {
+    ifstream archivo(ruta);
+    
+    if (!archivo.is_open()) {
+        cout << "[Manifiesto] No se pudo abrir " << ruta << endl;
+        return -1;
+    }
+    
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    bool bitacora = Bitacora::activar(false);
+    iniciarCargaMasiva();
+    
+    // Una línea de punto de control lleva todas las lecturas del sensor:
+    // sin límite de largo, crece lo que haga falta
+    string linea;
+    long long numeroLinea = 0;
+    char tipo[16];
+    char nombre[50];
+    char grupo[50];
+    int creados = 0;
+    int omitidos = 0;
+    int incompletos = 0;
+    long long primeraIncompleta = 0;
+    
+    while (getline(archivo, linea)) {
+        numeroLinea = numeroLinea + 1;
+        if (linea.empty() || linea[0] == '#' || linea[0] == '\r') {
+            continue;
+        }
+        
+        const char* cursor = linea.c_str();
+        leerCampo(cursor, tipo, 16);
+        leerCampo(cursor, nombre, 50);
+        leerCampo(cursor, grupo, 50);
+        
+        // Un nombre repetido no debe construir un segundo sensor con el mismo ID
+        if (nombre[0] == '\0' || buscar(nombre) != 0) {
+            omitidos = omitidos + 1;
+            continue;
+        }
+        
+        SensorBase* sensor = 0;
+        if (strcmp(tipo, "TEMP") == 0) {
+            SensorTemperatura* temp = new SensorTemperatura(nombre);
+            char* fin = 0;
+            for (double v = strtod(cursor, &fin); fin != cursor; v = strtod(cursor, &fin)) {
+                temp->registrarLectura((float)v);
+                cursor = fin;
+            }
+            sensor = temp;
+        } else if (strcmp(tipo, "PRES") == 0) {
+            SensorPresion* pres = new SensorPresion(nombre);
+            char* fin = 0;
+            for (long v = strtol(cursor, &fin, 10); fin != cursor; v = strtol(cursor, &fin, 10)) {
+                pres->registrarLectura((int)v);
+                cursor = fin;
+            }
+            sensor = pres;
+        } else if (strcmp(tipo, "VIB") == 0) {
+            // Lo guardado ya pasó el diezmado: se restaura sin las etapas de entrada
+            SensorVibracion* vib = new SensorVibracion(nombre);
+            char* fin = 0;
+            for (long v = strtol(cursor, &fin, 10); fin != cursor; v = strtol(cursor, &fin, 10)) {
+                vib->restaurarLectura((int)v);
+                cursor = fin;
+            }
+            sensor = vib;
+        } else {
+            omitidos = omitidos + 1;
+            continue;
+        }
+        
+        // Las lecturas se cortan en el primer valor que no es número: el
+        // sensor se crea con las anteriores y la carga se informa parcial
+        if (!soloEspacios(cursor)) {
+            incompletos = incompletos + 1;
+            if (primeraIncompleta == 0) {
+                primeraIncompleta = numeroLinea;
+            }
+        }
+        
+        insertar(sensor);
+        if (grupo[0] != '\0') {
+            asignarGrupo(nombre, grupo);
+        }
+        if (planificador != 0) {
+            planificador->programar(sensor, sensor->periodoProcesamientoMs());
+        }
+        creados = creados + 1;
+    }
+    
+    // getline solo se detiene antes del final por un error de lectura
+    bool parcial = !archivo.eof();
+    
+    terminarCargaMasiva();
+    Bitacora::activar(bitacora);
+    
+    long long ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - inicio).count();
+    cout << "[Manifiesto] " << creados << " sensor(es) aprovisionado(s) en " << ms << " ms";
+    if (omitidos > 0) {
+        cout << " (" << omitidos << " linea(s) omitida(s))";
+    }
+    cout << "." << endl;
+    if (parcial) {
+        cout << "[Manifiesto] Carga PARCIAL: la lectura de " << ruta << " fallo tras la linea "
+             << numeroLinea << "; el resto del archivo no se cargo." << endl;
+    }
+    if (incompletos > 0) {
+        cout << "[Manifiesto] Carga PARCIAL: " << incompletos << " sensor(es) con una lectura no valida (primera en la linea "
+             << primeraIncompleta << "); solo se cargaron las lecturas anteriores a ella." << endl;
+    }
+    
+    return creados;
+}
+
+void ListaGeneral::publicarDirectorio() {
+    DirectorioSensores* nuevo = new DirectorioSensores();
+    
+    NodoGeneral* actual = cabeza;
+    while (actual != 0) {
+        SensorBase* sensor = actual->sensor;
+        EntradaDirectorio entrada;
+        entrada.nombre = sensor->obtenerNombre();
+        entrada.id = sensor->obtenerId();
+        entrada.tipo = actual->tipo;
+        
+        switch (entrada.tipo) {
+            case SENSOR_TEMPERATURA:
+                entrada.temperatura = ((SensorTemperatura*)sensor)->compartirBuzon();
+                break;
+            case SENSOR_PRESION:
+                entrada.presion = ((SensorPresion*)sensor)->compartirBuzon();
+                break;
+            default:
+                entrada.generico = sensor->compartirBuzonGenerico();
+                break;
+        }
+        
+        nuevo->agregar(entrada);
+        actual = actual->siguiente;
+    }
+    
+    nuevo->indexar();
+    
+    shared_ptr<const DirectorioSensores> puntero(nuevo);
+    atomic_store(&directorio, puntero);
+    directorioPendiente = false;
+}
+
+bool ListaGeneral::publicar() {
+    if (cargasMasivas > 0) {
+        return false;
+    }
+    
+    // Solo los sensores con lecturas nuevas pueden tener instantánea pendiente
+    RegistroCambios& cambios = RegistroCambios::global();
+    bool publicado = false;
+    for (int t = 0; t < RegistroCambios::TIPOS; t++) {
+        TipoSensor tipo = (TipoSensor)t;
+        for (int i = 0; i < cambios.cantidadPendientes(tipo); i++) {
+            SensorBase* sensor = buscarPorId(cambios.pendiente(tipo, i));
+            if (sensor != 0 && sensor->publicarEstado()) {
+                publicado = true;
+            }
+        }
+    }
+    
+    if (directorioPendiente) {
+        publicarDirectorio();
+        publicado = true;
+    }
+    return publicado;
+}
+
+void ListaGeneral::iniciarCargaMasiva() {
+    cargasMasivas = cargasMasivas + 1;
+}
+
+void ListaGeneral::terminarCargaMasiva() {
+    cargasMasivas = cargasMasivas - 1;
+    publicar();
+}
+
+shared_ptr<const DirectorioSensores> ListaGeneral::leerDirectorio() const {
+    return atomic_load(&directorio);
+}
+
+int ListaGeneral::cantidadSensores() const {
+    return temperaturas.tamano() + presiones.tamano() + otros.tamano();
+}
+
+SensorBase* ListaGeneral::buscar(const char* nombreBuscar) const {
+    int id = TablaNombres::global().buscar(nombreBuscar);
+    
+    if (id < 0) {
+        return 0;
+    }
+    
+    return buscarPorId(id);
+}
+
+SensorBase* ListaGeneral::buscarPorId(int id) const {
+    NodoGeneral* nodo = nodoPorId(id);
+    
+    if (nodo == 0) {
+        return 0;
+    }
+    
+    return nodo->sensor;
+}
+
+void ListaGeneral::despachar(SensorBase* sensor, TipoSensor tipo) {
+    // Llamada calificada: el tipo ya se conoce y se llama directo, sin pasar
+    // por la vtable. procesarLectura está en su .cpp, así que no se expande
+    // en línea (salvo con LTO); se ahorra la llamada indirecta, no el cuerpo
+    switch (tipo) {
+        case SENSOR_TEMPERATURA:
+            ((SensorTemperatura*)sensor)->SensorTemperatura::procesarLectura();
+            break;
+        case SENSOR_PRESION:
+            ((SensorPresion*)sensor)->SensorPresion::procesarLectura();
+            break;
+        default:
+            // POLIMORFISMO: Llama al método correcto según el tipo real
+            sensor->procesarLectura();
+            break;
+    }
+    
+    // Las lecturas trazadas de este sensor acaban de procesarse
+    TrazaLatencia& traza = TrazaLatencia::global();
+    if (traza.estaActiva()) {
+        traza.procesado(sensor->obtenerId());
+    }
+}
+
+void ListaGeneral::procesarTodos() {
+    cout << "\n--- Ejecutando Polimorfismo ---" << '\n';
+    
+    RegistroCambios& cambios = RegistroCambios::global();
+    int procesados = 0;
+    
+    // Un tipo por pasada: dentro de ella la rama de despachar es siempre la misma
+    for (int t = 0; t < RegistroCambios::TIPOS; t++) {
+        TipoSensor tipo = (TipoSensor)t;
+        for (int i = 0; i < cambios.cantidadPendientes(tipo); i++) {
+            int id = cambios.pendiente(tipo, i);
+            SensorBase* sensor = buscarPorId(id);
+            
+            // Otro sensor de otra lista, o ya procesado por el planificador
+            if (sensor == 0 || !cambios.estaMarcado(id)) {
+                continue;
+            }
+            
+            despachar(sensor, tipo);
+            cout << '\n';
+            procesados = procesados + 1;
+        }
+    }
+    
+    cambios.limpiar();
+    
+    int total = cantidadSensores();
+    cout << "[Sistema] " << procesados << " sensor(es) procesado(s), "
+         << (total - procesados) << " sin cambios (resultado en cache)." << endl;
+}
+
+bool ListaGeneral::procesarSensor(SensorBase* sensor) {
+    RegistroCambios& cambios = RegistroCambios::global();
+    NodoGeneral* nodo = nodoPorId(sensor->obtenerId());
+    
+    if (nodo == 0 || !cambios.estaMarcado(sensor->obtenerId())) {
+        return false;
+    }
+    
+    despachar(sensor, nodo->tipo);
+    cambios.desmarcar(sensor->obtenerId());
+    return true;
+}
+
+void ListaGeneral::tomarInstantanea(ArregloDinamico<AgregadosSensor>& destino) const {
+    NodoGeneral* actual = cabeza;
+    while (actual != 0) {
+        destino.agregar(actual->sensor->obtenerAgregados());
+        actual = actual->siguiente;
+    }
+}
+
+bool ListaGeneral::consultarSensor(const char* nombre, AgregadosSensor& destino) const {
+    SensorBase* sensor = buscar(nombre);
+    
+    if (sensor == 0) {
+        return false;
+    }
+    
+    destino = sensor->obtenerAgregados();
+    return true;
+}
+
+int ListaGeneral::consultarPorTipo(TipoSensor tipo, ArregloDinamico<AgregadosSensor>& destino) const {
+    int antes = destino.tamano();
+    
+    switch (tipo) {
+        case SENSOR_TEMPERATURA:
+            for (int i = 0; i < temperaturas.tamano(); i++) {
+                destino.agregar(temperaturas[i]->obtenerAgregados());
+            }
+            break;
+        case SENSOR_PRESION:
+            for (int i = 0; i < presiones.tamano(); i++) {
+                destino.agregar(presiones[i]->obtenerAgregados());
+            }
+            break;
+        default:
+            for (int i = 0; i < otros.tamano(); i++) {
+                destino.agregar(otros[i]->obtenerAgregados());
+            }
+            break;
+    }
+    
+    return destino.tamano() - antes;
+}
+
+ResumenFlota ListaGeneral::resumenPorTipo(TipoSensor tipo) const {
+    return AgregadosFlota::global().resumenTipo(tipo);
+}
+
+bool ListaGeneral::resumenPorGrupo(const char* grupo, ResumenFlota& destino) const {
+    const ResumenFlota* resumen = AgregadosFlota::global().resumenGrupo(grupo);
+    
+    if (resumen == 0) {
+        return false;
+    }
+    
+    destino = *resumen;
+    return true;
+}
+
+bool ListaGeneral::asignarGrupo(const char* nombre, const char* grupo) {
+    SensorBase* sensor = buscar(nombre);
+    
+    if (sensor == 0) {
+        return false;
+    }
+    
+    AgregadosFlota::global().asignarGrupo(sensor->obtenerAgregados(), grupo);
+    return true;
+}
+
+void ListaGeneral::imprimirFlota() const {
+    const char* nombres[] = { "Temperatura", "Presion", "Otros" };
+    
+    cout << "\n--- Resumen de la Flota ---" << endl;
+    for (int tipo = SENSOR_TEMPERATURA; tipo <= SENSOR_OTRO; tipo++) {
+        ResumenFlota resumen = resumenPorTipo((TipoSensor)tipo);
+        if (resumen.sensores == 0) {
+            continue;
+        }
+        
+        cout << nombres[tipo] << ": " << resumen.sensores << " sensor(es), "
+             << resumen.lecturas << " lectura(s), promedio " << resumen.promedio()
+             << ", promedio de ultimas " << resumen.promedioUltimos() << endl;
+        if (resumen.hayExtremos) {
+            cout << "  Min historico: " << resumen.minimoHistorico
+                 << " | Max historico: " << resumen.maximoHistorico
+                 << " | Anomalias: " << resumen.anomalias << endl;
+        }
+    }
+}
+
+/**
+ * @brief Sensor candidato a desalojo y sus lecturas vivas
+ */
+struct CandidatoDesalojo {
+    int lecturas;       ///< Lecturas en el historial
+    SensorBase* sensor; ///< Sensor a recortar
+};
+
+/**
+ * @brief Baja un candidato hasta su lugar en el montículo máximo por lecturas
+ */
+static void bajarCandidato(ArregloDinamico<CandidatoDesalojo>& monticulo, int indice) {
+    int n = monticulo.tamano();
+    while (true) {
+        int mayor = indice;
+        int izquierdo = 2 * indice + 1;
+        int derecho = izquierdo + 1;
+        if (izquierdo < n && monticulo[izquierdo].lecturas > monticulo[mayor].lecturas) {
+            mayor = izquierdo;
+        }
+        if (derecho < n && monticulo[derecho].lecturas > monticulo[mayor].lecturas) {
+            mayor = derecho;
+        }
+        if (mayor == indice) {
+            return;
+        }
+        CandidatoDesalojo temp = monticulo[mayor];
+        monticulo[mayor] = monticulo[indice];
+        monticulo[indice] = temp;
+        indice = mayor;
+    }
+}
+
+int ListaGeneral::aplicarPresupuestoGlobal() {
+    ContabilidadMemoria& memoria = ContabilidadMemoria::global();
+    
+    // Lo habitual es no exceder: no recorrer la flota en cada pasada
+    if (!memoria.excedido()) {
+        return 0;
+    }
+    
+    // Montículo de los sensores con lecturas, construido una vez en O(n)
+    ArregloDinamico<CandidatoDesalojo> monticulo;
+    NodoGeneral* actual = cabeza;
+    while (actual != 0) {
+        CandidatoDesalojo candidato;
+        candidato.lecturas = actual->sensor->obtenerAgregados().cantidad;
+        candidato.sensor = actual->sensor;
+        if (candidato.lecturas > 0) {
+            monticulo.agregar(candidato);
+        }
+        actual = actual->siguiente;
+    }
+    for (int i = monticulo.tamano() / 2 - 1; i >= 0; i--) {
+        bajarCandidato(monticulo, i);
+    }
+    
+    int eliminadas = 0;
+    int sinAvance = 0;
+    long long bytesAntes = memoria.bytesDesalojables();
+    
+    // Sin avance tras una vuelta por todos los candidatos, recortar no
+    // libera memoria (bloques retenidos por lectores): no seguir borrando
+    while (memoria.excedido() && monticulo.tamano() > 0 && sinAvance <= monticulo.tamano()) {
+        CandidatoDesalojo& mayor = monticulo[0];
+        
+        // Recortar un 10% (al menos una lectura) del sensor con más lecturas
+        int recorte = mayor.lecturas / 10;
+        if (recorte < 1) {
+            recorte = 1;
+        }
+        int quitadas = mayor.sensor->recortarHistorial(recorte);
+        eliminadas = eliminadas + quitadas;
+        mayor.lecturas = mayor.lecturas - quitadas;
+        
+        if (quitadas == 0 || mayor.lecturas <= 0) {
+            monticulo.quitarIntercambiando(0);
+        }
+        if (monticulo.tamano() > 0) {
+            bajarCandidato(monticulo, 0);
+        }
+        
+        long long bytesAhora = memoria.bytesDesalojables();
+        sinAvance = (bytesAhora < bytesAntes) ? 0 : sinAvance + 1;
+        bytesAntes = bytesAhora;
+    }
+    
+    if (eliminadas > 0) {
+        cout << "[Memoria] Presupuesto global excedido: " << eliminadas << " lectura(s) desalojada(s)." << endl;
+    }
+    
+    return eliminadas;
+}
+
+void ListaGeneral::imprimirMemoria() const {
+    ContabilidadMemoria::global().imprimir();
+    
+    cout << "Por sensor:" << endl;
+    NodoGeneral* actual = cabeza;
+    while (actual != 0) {
+        cout << "  " << actual->sensor->obtenerNombre() << ": "
+             << actual->sensor->bytesUsados() << " bytes" << endl;
+        actual = actual->siguiente;
+    }
+}
+
+void ListaGeneral::imprimirTodos() const {
+    cout << "\n--- Lista de Sensores Registrados ---" << '\n';
+    
+    if (cabeza == 0) {
+        cout << "No hay sensores registrados." << endl;
+        return;
+    }
+    
+    // Un solo búfer para toda la flota: sin vaciar cout por cada línea
+    {
+        BuferSalida salida(cout);
+        RenderizadorReporte reporte(salida, OpcionesReporte());
+        reporte.sensores(*this);
+    }
+    cout.flush();
+}
+
+ListaGeneral::iterador ListaGeneral::begin() const {
+    return iterador(cabeza);
+}
+
+ListaGeneral::iterador ListaGeneral::end() const {
+    return iterador();
+}
+
+bool ListaGeneral::estaVacia() const {
+    return cabeza == 0;
 }
\ No newline at end of file
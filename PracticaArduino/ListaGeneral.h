@@ -1,82 +1,416 @@
-/**
- * @file ListaGeneral.h
- * @brief Lista enlazada NO genérica para gestión polimórfica de sensores
- * @author Juan Francisco Ortega Pulido
- * @date 2025
- */
-
-#ifndef LISTA_GENERAL_H
-#define LISTA_GENERAL_H
-
-#include "SensorBase.h"
-
-/**
- * @brief Nodo para la lista de gestión de sensores
- */
-struct NodoGeneral {
-    SensorBase* sensor;      ///< Puntero a la clase base (polimorfismo)
-    NodoGeneral* siguiente;  ///< Puntero al siguiente nodo
-    
-    /**
-     * @brief Constructor del nodo
-     * @param s Puntero al sensor
-     */
-    NodoGeneral(SensorBase* s) {
-        sensor = s;
-        siguiente = 0;
-    }
-};
-
-/**
- * @class ListaGeneral
- * @brief Lista enlazada para gestionar todos los sensores del sistema
- * 
- * Esta lista almacena punteros a SensorBase*, permitiendo gestionar
- * diferentes tipos de sensores de manera polimórfica.
- */
-class ListaGeneral {
-private:
-    NodoGeneral* cabeza; ///< Primer nodo de la lista
-    
-public:
-    /**
-     * @brief Constructor por defecto
-     */
-    ListaGeneral();
-    
-    /**
-     * @brief Destructor - libera memoria de nodos Y sensores
-     */
-    ~ListaGeneral();
-    
-    /**
-     * @brief Inserta un sensor al final de la lista
-     * @param sensor Puntero al sensor a insertar
-     */
-    void insertar(SensorBase* sensor);
-    
-    /**
-     * @brief Busca un sensor por su nombre
-     * @param nombreBuscar Nombre del sensor a buscar
-     * @return Puntero al sensor encontrado o 0 si no existe
-     */
-    SensorBase* buscar(const char* nombreBuscar) const;
-    
-    /**
-     * @brief Procesa todos los sensores de la lista (llama procesarLectura)
-     */
-    void procesarTodos();
-    
-    /**
-     * @brief Imprime información de todos los sensores
-     */
-    void imprimirTodos() const;
-    
-    /**
-     * @brief Verifica si la lista está vacía
-     * @return true si está vacía, false en caso contrario
-     */
-    bool estaVacia() const;
-};
-
+/**
+ * @file ListaGeneral.h
+ * @brief Lista enlazada NO genérica para gestión polimórfica de sensores
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef LISTA_GENERAL_H
+#define LISTA_GENERAL_H
+
+#include "SensorBase.h"
+#include "ArregloDinamico.h"
+#include "Instantanea.h"
+#include "ContabilidadMemoria.h"
+#include "AgregadosFlota.h"
+#include "DirectorioSensores.h"
+#include <memory>
+#include <iterator>
+#include <cstddef>
+
+class SensorTemperatura;
+class SensorPresion;
+class PlanificadorRueda;
+
+/**
+ * @brief Nodo para la lista de gestión de sensores
+ */
+struct NodoGeneral {
+    SensorBase* sensor;      ///< Puntero a la clase base (polimorfismo)
+    NodoGeneral* siguiente;  ///< Puntero al siguiente nodo
+    NodoGeneral* anterior;   ///< Puntero al nodo previo (baja en O(1))
+    int indiceGrupo;         ///< Posición del sensor en el arreglo de su tipo
+    TipoSensor tipo;         ///< Tipo concreto, consultado una vez al insertar
+    
+    /**
+     * @brief Constructor del nodo
+     * @param s Puntero al sensor
+     */
+    NodoGeneral(SensorBase* s) {
+        sensor = s;
+        tipo = SENSOR_OTRO;
+        siguiente = 0;
+        anterior = 0;
+        indiceGrupo = -1;
+        ContabilidadMemoria::global().reservar(MEMORIA_GESTION, sizeof(NodoGeneral));
+    }
+    
+    /**
+     * @brief Destructor del nodo (descuenta su memoria)
+     */
+    ~NodoGeneral() {
+        ContabilidadMemoria::global().liberar(MEMORIA_GESTION, sizeof(NodoGeneral));
+    }
+};
+
+/**
+ * @class ListaGeneral
+ * @brief Lista enlazada para gestionar todos los sensores del sistema
+ * 
+ * Esta lista almacena punteros a SensorBase*, permitiendo gestionar
+ * diferentes tipos de sensores de manera polimórfica.
+ *
+ * Además de la lista enlazada, cada sensor se registra en un arreglo
+ * contiguo de su tipo concreto, y el nodo recuerda ese tipo. procesarTodos
+ * recorre la lista de pendientes de cada tipo por separado y llama
+ * directamente a la implementación de la clase, sin despacho virtual ni
+ * obtenerTipo() por sensor; los tipos desconocidos se procesan
+ * polimórficamente.
+ *
+ * Las búsquedas por nombre se resuelven con el ID de TablaNombres, que
+ * indexa directamente el arreglo porId. Con el puntero a la cola y el
+ * enlace al nodo previo, insertar y dar de baja un sensor son O(1).
+ *
+ * Las consultas devuelven estructuras en lugar de imprimir; los resúmenes
+ * por tipo y por grupo salen de AgregadosFlota en O(1).
+ *
+ * begin/end recorren los sensores en orden de inserción con un iterador
+ * de avance, utilizable con los algoritmos estándar.
+ */
+class ListaGeneral {
+private:
+    NodoGeneral* cabeza; ///< Primer nodo de la lista
+    NodoGeneral* cola;   ///< Último nodo de la lista
+    bool cierreRapido;   ///< true: el destructor no libera sensor por sensor
+    int cargasMasivas;   ///< Cargas masivas en curso (difieren el directorio)
+    bool directorioPendiente; ///< Hubo altas o bajas aún no publicadas
+    std::shared_ptr<const DirectorioSensores> directorio; ///< Catálogo para otros hilos
+    ArregloDinamico<SensorTemperatura*> temperaturas; ///< Grupo de sensores de temperatura
+    ArregloDinamico<SensorPresion*> presiones;        ///< Grupo de sensores de presión
+    ArregloDinamico<SensorBase*> otros;               ///< Sensores de otros tipos
+    ArregloDinamico<NodoGeneral*> porId;              ///< Índice: ID de nombre -> nodo
+    
+    /**
+     * @brief Llama a procesarLectura con despacho directo según el tipo
+     * @param sensor Sensor a procesar
+     * @param tipo Tipo concreto del sensor (el de su nodo)
+     */
+    void despachar(SensorBase* sensor, TipoSensor tipo);
+    
+    /**
+     * @brief Quita un nodo del arreglo de su tipo intercambiando con el último
+     * @param nodo Nodo a quitar
+     */
+    void quitarDeGrupo(NodoGeneral* nodo);
+    
+    /**
+     * @brief Nodo de un sensor a partir de su ID
+     * @return Nodo o 0 si no existe
+     */
+    NodoGeneral* nodoPorId(int id) const;
+    
+    /**
+     * @brief Reconstruye y publica el directorio (O(sensores))
+     */
+    void publicarDirectorio();
+    
+public:
+    /**
+     * @brief Constructor por defecto
+     */
+    ListaGeneral();
+    
+    /**
+     * @brief Destructor - libera memoria de nodos Y sensores
+     *
+     * En modo de cierre rápido no recorre los sensores: el proceso está
+     * terminando y el sistema operativo recupera toda su memoria de una
+     * vez, sin millones de delete ni mensajes por nodo.
+     */
+    ~ListaGeneral();
+    
+    /**
+     * @brief Activa el cierre rápido para cuando el proceso va a terminar
+     *
+     * Solo debe activarse justo antes de salir: la lista deja de liberar
+     * sus sensores.
+     * @param activo true para omitir la liberación individual
+     */
+    void fijarCierreRapido(bool activo);
+    
+    /**
+     * @brief Guarda un punto de control que cargarManifiesto puede restaurar
+     *
+     * Cada sensor se escribe como TIPO,NOMBRE,GRUPO,LECTURAS con las
+     * lecturas vivas de su última instantánea separadas por espacios.
+     * TIPO es etiquetaTipo(); los genéricos se leen por su buzón sin tipo.
+     * @param ruta Ruta del archivo
+     * @return Sensores guardados, o -1 si no se pudo escribir
+     */
+    int guardarPuntoControl(const char* ruta) const;
+    
+    /**
+     * @brief Inserta un sensor al final de la lista en O(1)
+     *
+     * El ID del nombre identifica al sensor en todo el sistema, así que
+     * se rechaza un nombre ya registrado; en ese caso el llamador conserva
+     * la propiedad del sensor.
+     * @param sensor Puntero al sensor a insertar
+     * @return true si se insertó, false si el nombre ya existía
+     */
+    bool insertar(SensorBase* sensor);
+    
+    /**
+     * @brief Da de baja un sensor en O(1) y libera el sensor y su historial
+     * @param id ID del sensor en TablaNombres
+     * @param planificador Planificador del que se cancela su tarea (puede ser 0)
+     * @return true si el sensor existía
+     */
+    bool eliminarPorId(int id, PlanificadorRueda* planificador);
+    
+    /**
+     * @brief Da de baja un sensor por nombre
+     * @param nombre Nombre del sensor
+     * @param planificador Planificador del que se cancela su tarea (puede ser 0)
+     * @return true si el sensor existía
+     */
+    bool eliminar(const char* nombre, PlanificadorRueda* planificador);
+    
+    /**
+     * @brief Aprovisiona sensores desde un archivo de manifiesto
+     *
+     * Cada línea tiene la forma TIPO,NOMBRE[,GRUPO[,LECTURAS]] con TIPO =
+     * TEMP, PRES o VIB y LECTURAS separadas por espacios (así se restaura
+     * un punto de control); las líneas vacías y las que empiezan con '#' se
+     * ignoran. Los nombres ya registrados y los tipos desconocidos se
+     * omiten. Las líneas no tienen largo máximo. Los mensajes por sensor se
+     * silencian durante la carga. La carga se avisa parcial si la lectura
+     * del archivo falla a mitad (los sensores ya creados se conservan) o si
+     * una lectura no es un número (el sensor queda con las anteriores).
+     * @param ruta Ruta del archivo
+     * @param planificador Planificador donde programar los sensores nuevos (puede ser 0)
+     * @return Sensores creados, o -1 si no se pudo abrir el archivo
+     */
+    int cargarManifiesto(const char* ruta, PlanificadorRueda* planificador);
+    
+    /**
+     * @brief Publica el directorio y las instantáneas que quedaron pendientes
+     *
+     * insertar y eliminarPorId solo marcan el directorio como pendiente;
+     * el ciclo principal llama a este método una vez por iteración, así
+     * crear sensores de uno en uno cuesta O(1) y la reconstrucción O(n)
+     * se paga a lo sumo una vez por pasada. Lo mismo con las lecturas
+     * sueltas: se publica una instantánea por sensor modificado, no una
+     * por lectura. No hace nada durante una carga masiva.
+     * @return true si se publicó algo
+     */
+    bool publicar();
+    
+    /**
+     * @brief Difiere la publicación del directorio hasta terminarCargaMasiva
+     *
+     * Ni siquiera publicar() lo reconstruye mientras dure la carga. Las
+     * llamadas pueden anidarse.
+     */
+    void iniciarCargaMasiva();
+    
+    /**
+     * @brief Termina una carga masiva y publica el directorio pendiente
+     */
+    void terminarCargaMasiva();
+    
+    /**
+     * @brief Último directorio publicado (seguro desde cualquier hilo)
+     *
+     * Refleja las altas y bajas a partir del siguiente publicar() (o del
+     * fin de la carga masiva en curso).
+     * @return Directorio inmutable
+     */
+    std::shared_ptr<const DirectorioSensores> leerDirectorio() const;
+    
+    /**
+     * @brief Número de sensores registrados
+     * @return Cantidad de sensores
+     */
+    int cantidadSensores() const;
+    
+    /**
+     * @brief Busca un sensor por su nombre
+     * @param nombreBuscar Nombre del sensor a buscar
+     * @return Puntero al sensor encontrado o 0 si no existe
+     */
+    SensorBase* buscar(const char* nombreBuscar) const;
+    
+    /**
+     * @brief Busca un sensor por el ID de su nombre en O(1)
+     * @param id ID asignado por TablaNombres
+     * @return Puntero al sensor encontrado o 0 si no existe
+     */
+    SensorBase* buscarPorId(int id) const;
+    
+    /**
+     * @brief Procesa los sensores con lecturas nuevas (llama procesarLectura)
+     *
+     * Solo recorre las listas de trabajo de RegistroCambios, un tipo tras
+     * otro, así que el costo es proporcional a los sensores modificados.
+     * Los sensores sin cambios conservan su resultado en caché
+     * (obtenerUltimoResultado).
+     */
+    void procesarTodos();
+    
+    /**
+     * @brief Procesa un sensor si tiene lecturas nuevas
+     *
+     * Lo usa el planificador para atender la cadencia de cada sensor.
+     * @param sensor Sensor a procesar
+     * @return true si se recalculó, false si se conserva el resultado en caché
+     */
+    bool procesarSensor(SensorBase* sensor);
+    
+    /**
+     * @brief Copia los agregados publicados de todos los sensores
+     *
+     * Cada sensor aporta su última instantánea, leída en O(1) sin
+     * bloquear la ingesta.
+     * @param destino Arreglo donde se agregan los resultados
+     */
+    void tomarInstantanea(ArregloDinamico<AgregadosSensor>& destino) const;
+    
+    /**
+     * @brief Agregados publicados de un sensor
+     * @param nombre Nombre del sensor
+     * @param destino Donde se copian los agregados
+     * @return true si el sensor existe
+     */
+    bool consultarSensor(const char* nombre, AgregadosSensor& destino) const;
+    
+    /**
+     * @brief Agregados de todos los sensores de un tipo
+     * @param tipo Tipo de sensor
+     * @param destino Arreglo donde se agregan los resultados
+     * @return Sensores agregados al destino
+     */
+    int consultarPorTipo(TipoSensor tipo, ArregloDinamico<AgregadosSensor>& destino) const;
+    
+    /**
+     * @brief Resumen de la flota de un tipo en O(1)
+     * @param tipo Tipo de sensor
+     * @return Resumen mantenido al ingerir
+     */
+    ResumenFlota resumenPorTipo(TipoSensor tipo) const;
+    
+    /**
+     * @brief Resumen de un grupo en O(1)
+     * @param grupo Etiqueta del grupo
+     * @param destino Donde se copia el resumen
+     * @return true si el grupo existe
+     */
+    bool resumenPorGrupo(const char* grupo, ResumenFlota& destino) const;
+    
+    /**
+     * @brief Asigna un sensor a un grupo definido por el usuario
+     * @param nombre Nombre del sensor
+     * @param grupo Etiqueta del grupo (se crea si no existe)
+     * @return true si el sensor existe
+     */
+    bool asignarGrupo(const char* nombre, const char* grupo);
+    
+    /**
+     * @brief Imprime el resumen de la flota por tipo
+     */
+    void imprimirFlota() const;
+    
+    /**
+     * @brief Desaloja lecturas hasta cumplir el presupuesto global de memoria
+     *
+     * Recorta un 10% del sensor con más lecturas, elegido de un montículo,
+     * aplicando su política de retención, hasta cumplir el presupuesto.
+     * Si no se excede no recorre la flota. Se detiene si recortar deja de
+     * liberar memoria (por ejemplo, bloques retenidos por lectores).
+     * @return Lecturas eliminadas
+     */
+    int aplicarPresupuestoGlobal();
+    
+    /**
+     * @brief Imprime el uso de memoria global y por sensor
+     */
+    void imprimirMemoria() const;
+    
+    /**
+     * @brief Imprime información de todos los sensores
+     */
+    void imprimirTodos() const;
+    
+    /**
+     * @class iterador
+     * @brief Iterador de avance sobre los sensores de la lista
+     */
+    class iterador {
+    private:
+        const NodoGeneral* nodo; ///< Nodo actual (0 = fin)
+        
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef SensorBase* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef SensorBase* const* pointer;
+        typedef SensorBase* const& reference;
+        
+        iterador() {
+            nodo = 0;
+        }
+        
+        iterador(const NodoGeneral* inicial) {
+            nodo = inicial;
+        }
+        
+        reference operator*() const {
+            return nodo->sensor;
+        }
+        
+        pointer operator->() const {
+            return &nodo->sensor;
+        }
+        
+        iterador& operator++() {
+            nodo = nodo->siguiente;
+            return *this;
+        }
+        
+        iterador operator++(int) {
+            iterador copia = *this;
+            nodo = nodo->siguiente;
+            return copia;
+        }
+        
+        bool operator==(const iterador& otro) const {
+            return nodo == otro.nodo;
+        }
+        
+        bool operator!=(const iterador& otro) const {
+            return nodo != otro.nodo;
+        }
+    };
+    
+    typedef iterador const_iterator;
+    
+    /**
+     * @brief Iterador al primer sensor
+     * @return Iterador inicial
+     */
+    iterador begin() const;
+    
+    /**
+     * @brief Iterador después del último sensor
+     * @return Iterador final
+     */
+    iterador end() const;
+    
+    /**
+     * @brief Verifica si la lista está vacía
+     * @return true si está vacía, false en caso contrario
+     */
+    bool estaVacia() const;
+};
+
 #endif // LISTA_GENERAL_H
\ No newline at end of file
@@ -1,288 +1,594 @@
-/**
- * @file ListaSensor.h
- * @brief Lista enlazada simple genérica para almacenar lecturas de sensores
- * @author Juan Francisco Ortega Pulido
- * @date 2025
- */
-
-#ifndef LISTA_SENSOR_H
-#define LISTA_SENSOR_H
-
-#include <iostream>
-using namespace std;
-
-/**
- * @brief Nodo genérico para la lista enlazada
- * @tparam T Tipo de dato que almacena el nodo
- */
-template <typename T>
-struct Nodo {
-    T dato;              ///< Dato almacenado en el nodo
-    Nodo<T>* siguiente;  ///< Puntero al siguiente nodo
-    
-    /**
-     * @brief Constructor del nodo
-     * @param valor Valor a almacenar en el nodo
-     */
-    Nodo(T valor) {
-        dato = valor;
-        siguiente = 0; // Usamos 0 en lugar de nullptr (más básico)
-    }
-};
-
-/**
- * @class ListaSensor
- * @brief Lista enlazada simple genérica para almacenar lecturas
- * @tparam T Tipo de dato de las lecturas (int, float, double, etc.)
- */
-template <typename T>
-class ListaSensor {
-private:
-    Nodo<T>* cabeza; ///< Puntero al primer nodo de la lista
-    
-public:
-    /**
-     * @brief Constructor por defecto
-     */
-    ListaSensor();
-    
-    /**
-     * @brief Destructor - libera toda la memoria de los nodos
-     */
-    ~ListaSensor();
-    
-    /**
-     * @brief Constructor de copia (Regla de los Tres)
-     * @param otra Lista a copiar
-     */
-    ListaSensor(const ListaSensor<T>& otra);
-    
-    /**
-     * @brief Operador de asignación (Regla de los Tres)
-     * @param otra Lista a asignar
-     * @return Referencia a esta lista
-     */
-    ListaSensor<T>& operator=(const ListaSensor<T>& otra);
-    
-    /**
-     * @brief Inserta un elemento al final de la lista
-     * @param valor Valor a insertar
-     */
-    void insertar(T valor);
-    
-    /**
-     * @brief Calcula el promedio de todos los elementos
-     * @return Promedio de tipo T
-     */
-    T calcularPromedio() const;
-    
-    /**
-     * @brief Encuentra y elimina el valor más bajo de la lista
-     * @return El valor más bajo encontrado
-     */
-    T eliminarMinimo();
-    
-    /**
-     * @brief Cuenta cuántos elementos hay en la lista
-     * @return Número de elementos
-     */
-    int contarElementos() const;
-    
-    /**
-     * @brief Verifica si la lista está vacía
-     * @return true si está vacía, false en caso contrario
-     */
-    bool estaVacia() const;
-    
-    /**
-     * @brief Imprime todos los elementos de la lista
-     */
-    void imprimir() const;
-};
-
-template <typename T>
-ListaSensor<T>::ListaSensor() {
-    cabeza = 0;
-}
-
-template <typename T>
-ListaSensor<T>::~ListaSensor() {
-    cout << "  [Destructor ListaSensor] Liberando lista interna..." << endl;
-    
-    Nodo<T>* actual = cabeza;
-    while (actual != 0) {
-        Nodo<T>* siguiente = actual->siguiente;
-        cout << "    [Log] Nodo<T> " << actual->dato << " liberado." << endl;
-        delete actual;
-        actual = siguiente;
-    }
-}
-
-template <typename T>
-ListaSensor<T>::ListaSensor(const ListaSensor<T>& otra) {
-    cabeza = 0;
-    
-    if (otra.cabeza == 0) {
-        return;
-    }
-    
-    // Copiar primer nodo
-    cabeza = new Nodo<T>(otra.cabeza->dato);
-    
-    // Copiar resto de nodos
-    Nodo<T>* actualOtra = otra.cabeza->siguiente;
-    Nodo<T>* actualEsta = cabeza;
-    
-    while (actualOtra != 0) {
-        actualEsta->siguiente = new Nodo<T>(actualOtra->dato);
-        actualEsta = actualEsta->siguiente;
-        actualOtra = actualOtra->siguiente;
-    }
-}
-
-template <typename T>
-ListaSensor<T>& ListaSensor<T>::operator=(const ListaSensor<T>& otra) {
-    if (this == &otra) {
-        return *this;
-    }
-    
-    // Liberar memoria actual
-    Nodo<T>* actual = cabeza;
-    while (actual != 0) {
-        Nodo<T>* siguiente = actual->siguiente;
-        delete actual;
-        actual = siguiente;
-    }
-    
-    // Copiar nueva lista
-    cabeza = 0;
-    
-    if (otra.cabeza == 0) {
-        return *this;
-    }
-    
-    cabeza = new Nodo<T>(otra.cabeza->dato);
-    Nodo<T>* actualOtra = otra.cabeza->siguiente;
-    Nodo<T>* actualEsta = cabeza;
-    
-    while (actualOtra != 0) {
-        actualEsta->siguiente = new Nodo<T>(actualOtra->dato);
-        actualEsta = actualEsta->siguiente;
-        actualOtra = actualOtra->siguiente;
-    }
-    
-    return *this;
-}
-
-template <typename T>
-void ListaSensor<T>::insertar(T valor) {
-    Nodo<T>* nuevoNodo = new Nodo<T>(valor);
-    
-    cout << "[Log] Insertando Nodo<T> con valor: " << valor << endl;
-    
-    if (cabeza == 0) {
-        cabeza = nuevoNodo;
-        return;
-    }
-    
-    // Buscar el último nodo
-    Nodo<T>* actual = cabeza;
-    while (actual->siguiente != 0) {
-        actual = actual->siguiente;
-    }
-    
-    actual->siguiente = nuevoNodo;
-}
-
-template <typename T>
-T ListaSensor<T>::calcularPromedio() const {
-    if (cabeza == 0) {
-        return 0;
-    }
-    
-    T suma = 0;
-    int contador = 0;
-    
-    Nodo<T>* actual = cabeza;
-    while (actual != 0) {
-        suma = suma + actual->dato;
-        contador = contador + 1;
-        actual = actual->siguiente;
-    }
-    
-    return suma / contador;
-}
-
-template <typename T>
-T ListaSensor<T>::eliminarMinimo() {
-    if (cabeza == 0) {
-        return 0;
-    }
-    
-    // Buscar el mínimo
-    T minimo = cabeza->dato;
-    Nodo<T>* actual = cabeza;
-    
-    while (actual != 0) {
-        if (actual->dato < minimo) {
-            minimo = actual->dato;
-        }
-        actual = actual->siguiente;
-    }
-    
-    // Eliminar el nodo con el valor mínimo
-    if (cabeza->dato == minimo) {
-        Nodo<T>* temp = cabeza;
-        cabeza = cabeza->siguiente;
-        delete temp;
-        return minimo;
-    }
-    
-    actual = cabeza;
-    while (actual->siguiente != 0) {
-        if (actual->siguiente->dato == minimo) {
-            Nodo<T>* temp = actual->siguiente;
-            actual->siguiente = temp->siguiente;
-            delete temp;
-            return minimo;
-        }
-        actual = actual->siguiente;
-    }
-    
-    return minimo;
-}
-
-template <typename T>
-int ListaSensor<T>::contarElementos() const {
-    int contador = 0;
-    Nodo<T>* actual = cabeza;
-    
-    while (actual != 0) {
-        contador = contador + 1;
-        actual = actual->siguiente;
-    }
-    
-    return contador;
-}
-
-template <typename T>
-bool ListaSensor<T>::estaVacia() const {
-    return cabeza == 0;
-}
-
-template <typename T>
-void ListaSensor<T>::imprimir() const {
-    Nodo<T>* actual = cabeza;
-    
-    cout << "[ ";
-    while (actual != 0) {
-        cout << actual->dato;
-        if (actual->siguiente != 0) {
-            cout << ", ";
-        }
-        actual = actual->siguiente;
-    }
-    cout << " ]" << endl;
-}
-
-#endif // LISTA_SENSOR_H
\ No newline at end of file
+/**
+ * @file ListaSensor.h
+ * @brief Lista enlazada simple genérica para almacenar lecturas de sensores
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef LISTA_SENSOR_H
+#define LISTA_SENSOR_H
+
+#include "ContabilidadMemoria.h"
+#include "Bitacora.h"
+#include "BuferSalida.h"
+#include <iostream>
+#include <iterator>
+#include <cstddef>
+using namespace std;
+
+/**
+ * @brief Lecturas de tipo T que caben en una línea de caché de 64 bytes
+ * @tparam T Tipo de dato de las lecturas
+ *
+ * Es el tamaño de bloque recomendado para el modo desenrollado de
+ * ListaSensor (16 lecturas para float o int).
+ */
+template <typename T>
+struct BloqueLineaCache {
+    enum { LECTURAS = (sizeof(T) >= 64) ? 1 : (int)(64 / sizeof(T)) };
+};
+
+/**
+ * @brief Nodo genérico para la lista enlazada
+ * @tparam T Tipo de dato que almacena el nodo
+ * @tparam N Lecturas por nodo (1 = un nodo por lectura)
+ *
+ * Las lecturas vivas del bloque son datos[inicio, fin). Los índices son
+ * unsigned short para que, con N = 1 y lecturas de 4 bytes, ocupen el
+ * relleno que ya existía junto al puntero y el nodo siga midiendo 16 bytes.
+ */
+template <typename T, int N>
+struct Nodo {
+    static_assert(N >= 1 && N <= 65535, "N debe caber en los indices del bloque");
+    
+    T datos[N];                ///< Bloque de lecturas
+    unsigned short inicio;     ///< Primera lectura viva del bloque
+    unsigned short fin;        ///< Una después de la última viva
+    Nodo<T, N>* siguiente;     ///< Puntero al siguiente nodo
+    
+    /**
+     * @brief Constructor del nodo vacío
+     */
+    Nodo() {
+        inicio = 0;
+        fin = 0;
+        siguiente = 0; // Usamos 0 en lugar de nullptr (más básico)
+        ContabilidadMemoria::global().reservar(MEMORIA_NODOS, sizeof(Nodo<T, N>));
+    }
+    
+    /**
+     * @brief Destructor del nodo (descuenta su memoria)
+     */
+    ~Nodo() {
+        ContabilidadMemoria::global().liberar(MEMORIA_NODOS, sizeof(Nodo<T, N>));
+    }
+};
+
+/**
+ * @class ListaSensor
+ * @brief Lista enlazada simple genérica para almacenar lecturas
+ * @tparam T Tipo de dato de las lecturas (int, float, double, etc.)
+ * @tparam N Lecturas por nodo
+ *
+ * Además de la cabeza guarda la cola, el número de elementos y la suma
+ * acumulada (en double), por lo que insertar, contar y promediar son O(1).
+ *
+ * Con N = 1 es la lista clásica de un nodo por lectura. Con N > 1 la
+ * lista queda desenrollada: cada nodo guarda un bloque de hasta N
+ * lecturas, lo que divide entre N las reservas y los punteros y hace que
+ * los recorridos lean memoria contigua. El crecimiento sigue sin límite y
+ * insertar sigue siendo O(1).
+ *
+ * Se recorre con iteradores de avance (begin/end), compatibles con los
+ * algoritmos estándar, o bloque a bloque con recorrerBloques, que entrega
+ * cada tramo contiguo de lecturas de una vez.
+ */
+template <typename T, int N = 1>
+class ListaSensor {
+private:
+    Nodo<T, N>* cabeza; ///< Puntero al primer nodo de la lista
+    Nodo<T, N>* cola;   ///< Puntero al último nodo de la lista
+    int cantidad;       ///< Número de elementos
+    int nodos;          ///< Número de nodos reservados
+    double suma;        ///< Suma acumulada (double: sin desvío con float ni truncado con int)
+    
+    /**
+     * @brief Copia los elementos de otra lista al final de esta
+     * @param otra Lista origen
+     */
+    void copiarDesde(const ListaSensor<T, N>& otra);
+    
+    /**
+     * @brief Libera todos los nodos y deja la lista vacía
+     */
+    void liberarNodos();
+    
+    /**
+     * @brief Quita un nodo ya vacío de la cadena
+     * @param anterior Nodo previo (0 si es la cabeza)
+     * @param nodo Nodo a liberar
+     */
+    void desenlazar(Nodo<T, N>* anterior, Nodo<T, N>* nodo);
+    
+public:
+    /**
+     * @brief Constructor por defecto
+     */
+    ListaSensor();
+    
+    /**
+     * @brief Destructor - libera toda la memoria de los nodos
+     */
+    ~ListaSensor();
+    
+    /**
+     * @brief Constructor de copia (Regla de los Tres)
+     * @param otra Lista a copiar
+     */
+    ListaSensor(const ListaSensor<T, N>& otra);
+    
+    /**
+     * @brief Operador de asignación (Regla de los Tres)
+     * @param otra Lista a asignar
+     * @return Referencia a esta lista
+     */
+    ListaSensor<T, N>& operator=(const ListaSensor<T, N>& otra);
+
+    /**
+     * @class iterador
+     * @brief Iterador de avance de solo lectura sobre las lecturas
+     */
+    class iterador {
+    private:
+        const Nodo<T, N>* nodo; ///< Nodo actual (0 = fin)
+        int posicion;           ///< Índice dentro del bloque del nodo
+        
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+        
+        iterador() {
+            nodo = 0;
+            posicion = 0;
+        }
+        
+        iterador(const Nodo<T, N>* inicial) {
+            nodo = inicial;
+            posicion = (inicial != 0) ? inicial->inicio : 0;
+        }
+        
+        reference operator*() const {
+            return nodo->datos[posicion];
+        }
+        
+        pointer operator->() const {
+            return &nodo->datos[posicion];
+        }
+        
+        iterador& operator++() {
+            posicion = posicion + 1;
+            if (posicion >= nodo->fin) {
+                nodo = nodo->siguiente;
+                posicion = (nodo != 0) ? nodo->inicio : 0;
+            }
+            return *this;
+        }
+        
+        iterador operator++(int) {
+            iterador copia = *this;
+            ++(*this);
+            return copia;
+        }
+        
+        bool operator==(const iterador& otro) const {
+            return nodo == otro.nodo && posicion == otro.posicion;
+        }
+        
+        bool operator!=(const iterador& otro) const {
+            return !(*this == otro);
+        }
+    };
+    
+    typedef iterador const_iterator;
+    
+    /**
+     * @brief Iterador a la lectura más antigua
+     * @return Iterador inicial
+     */
+    iterador begin() const;
+    
+    /**
+     * @brief Iterador una posición después de la más reciente
+     * @return Iterador final
+     */
+    iterador end() const;
+    
+    /**
+     * @brief Recorre las lecturas por tramos contiguos, en orden
+     * @tparam F Función invocable como f(const T* datos, int cantidad)
+     * @param funcion Se llama una vez por bloque no vacío
+     *
+     * Con N = 1 cada tramo tiene una sola lectura.
+     */
+    template <typename F>
+    void recorrerBloques(F funcion) const;
+    
+    /**
+     * @brief Número de tramos contiguos que entrega recorrerBloques
+     * @return Nodos de la lista
+     */
+    int contarBloques() const;
+    
+    /**
+     * @brief Inserta un elemento al final de la lista
+     * @param valor Valor a insertar
+     */
+    void insertar(T valor);
+    
+    /**
+     * @brief Calcula el promedio de todos los elementos en O(1)
+     * @return Promedio (sin truncar, aunque T sea entero)
+     */
+    double calcularPromedio() const;
+    
+    /**
+     * @brief Encuentra y elimina el valor más bajo de la lista
+     * @return El valor más bajo encontrado
+     */
+    T eliminarMinimo();
+    
+    /**
+     * @brief Elimina la lectura más antigua en O(1)
+     * @return El valor eliminado (0 si la lista está vacía)
+     */
+    T eliminarPrimero();
+    
+    /**
+     * @brief Reduce la lista a la mitad promediando pares consecutivos
+     *
+     * Si el número de elementos es impar, el último se conserva tal cual.
+     */
+    void submuestrear();
+    
+    /**
+     * @brief Bytes ocupados por los nodos de la lista
+     * @return nodos * sizeof(Nodo<T, N>)
+     */
+    long long bytesUsados() const;
+    
+    /**
+     * @brief Cuenta cuántos elementos hay en la lista
+     * @return Número de elementos
+     */
+    int contarElementos() const;
+    
+    /**
+     * @brief Verifica si la lista está vacía
+     * @return true si está vacía, false en caso contrario
+     */
+    bool estaVacia() const;
+    
+    /**
+     * @brief Imprime todos los elementos de la lista
+     */
+    void imprimir() const;
+};
+
+template <typename T, int N>
+ListaSensor<T, N>::ListaSensor() {
+    cabeza = 0;
+    cola = 0;
+    cantidad = 0;
+    nodos = 0;
+    suma = 0.0;
+}
+
+template <typename T, int N>
+ListaSensor<T, N>::~ListaSensor() {
+    if (Bitacora::activa()) {
+        cout << "  [Destructor ListaSensor] Liberando lista interna..." << endl;
+        
+        Nodo<T, N>* actual = cabeza;
+        while (actual != 0) {
+            for (int i = actual->inicio; i < actual->fin; i++) {
+                cout << "    [Log] Nodo<T> " << actual->datos[i] << " liberado." << endl;
+            }
+            actual = actual->siguiente;
+        }
+    }
+    
+    liberarNodos();
+}
+
+template <typename T, int N>
+ListaSensor<T, N>::ListaSensor(const ListaSensor<T, N>& otra) {
+    cabeza = 0;
+    cola = 0;
+    cantidad = 0;
+    nodos = 0;
+    suma = 0.0;
+    
+    copiarDesde(otra);
+}
+
+template <typename T, int N>
+ListaSensor<T, N>& ListaSensor<T, N>::operator=(const ListaSensor<T, N>& otra) {
+    if (this == &otra) {
+        return *this;
+    }
+    
+    // Liberar memoria actual y copiar nueva lista
+    liberarNodos();
+    copiarDesde(otra);
+    
+    return *this;
+}
+
+template <typename T, int N>
+void ListaSensor<T, N>::liberarNodos() {
+    Nodo<T, N>* actual = cabeza;
+    while (actual != 0) {
+        Nodo<T, N>* siguiente = actual->siguiente;
+        delete actual;
+        actual = siguiente;
+    }
+    
+    cabeza = 0;
+    cola = 0;
+    cantidad = 0;
+    nodos = 0;
+    suma = 0.0;
+}
+
+template <typename T, int N>
+void ListaSensor<T, N>::copiarDesde(const ListaSensor<T, N>& otra) {
+    // insertar compacta: los bloques de la copia quedan llenos
+    Nodo<T, N>* actualOtra = otra.cabeza;
+    while (actualOtra != 0) {
+        for (int i = actualOtra->inicio; i < actualOtra->fin; i++) {
+            insertar(actualOtra->datos[i]);
+        }
+        actualOtra = actualOtra->siguiente;
+    }
+    
+    // Conservar la suma exacta del original
+    suma = otra.suma;
+}
+
+template <typename T, int N>
+void ListaSensor<T, N>::desenlazar(Nodo<T, N>* anterior, Nodo<T, N>* nodo) {
+    if (anterior == 0) {
+        cabeza = nodo->siguiente;
+    } else {
+        anterior->siguiente = nodo->siguiente;
+    }
+    if (nodo == cola) {
+        cola = anterior;
+    }
+    delete nodo;
+    nodos = nodos - 1;
+}
+
+template <typename T, int N>
+void ListaSensor<T, N>::insertar(T valor) {
+    if (Bitacora::activa()) {
+        cout << "[Log] Insertando Nodo<T> con valor: " << valor << endl;
+    }
+    
+    cantidad = cantidad + 1;
+    suma = suma + valor;
+    
+    // Solo se reserva un nodo cuando el bloque de la cola está lleno
+    if (cola == 0 || cola->fin == N) {
+        Nodo<T, N>* nuevoNodo = new Nodo<T, N>();
+        nodos = nodos + 1;
+        
+        if (cabeza == 0) {
+            cabeza = nuevoNodo;
+        } else {
+            // La cola evita recorrer la lista completa
+            cola->siguiente = nuevoNodo;
+        }
+        cola = nuevoNodo;
+    }
+    
+    cola->datos[cola->fin] = valor;
+    cola->fin = cola->fin + 1;
+}
+
+template <typename T, int N>
+double ListaSensor<T, N>::calcularPromedio() const {
+    if (cabeza == 0) {
+        return 0.0;
+    }
+    
+    return suma / cantidad;
+}
+
+template <typename T, int N>
+T ListaSensor<T, N>::eliminarMinimo() {
+    if (cabeza == 0) {
+        return 0;
+    }
+    
+    // Buscar la primera aparición del mínimo (recorrido contiguo por bloque)
+    Nodo<T, N>* nodoMinimo = cabeza;
+    Nodo<T, N>* anteriorMinimo = 0;
+    int posicionMinimo = cabeza->inicio;
+    T minimo = cabeza->datos[cabeza->inicio];
+    
+    Nodo<T, N>* anterior = 0;
+    Nodo<T, N>* actual = cabeza;
+    while (actual != 0) {
+        for (int i = actual->inicio; i < actual->fin; i++) {
+            if (actual->datos[i] < minimo) {
+                minimo = actual->datos[i];
+                nodoMinimo = actual;
+                anteriorMinimo = anterior;
+                posicionMinimo = i;
+            }
+        }
+        anterior = actual;
+        actual = actual->siguiente;
+    }
+    
+    cantidad = cantidad - 1;
+    // Sin elementos la suma vuelve a ser exacta
+    suma = (cantidad == 0) ? 0.0 : suma - minimo;
+    
+    // Cerrar el hueco dentro del bloque; si queda vacío se libera
+    for (int i = posicionMinimo; i + 1 < nodoMinimo->fin; i++) {
+        nodoMinimo->datos[i] = nodoMinimo->datos[i + 1];
+    }
+    nodoMinimo->fin = nodoMinimo->fin - 1;
+    if (nodoMinimo->inicio == nodoMinimo->fin) {
+        desenlazar(anteriorMinimo, nodoMinimo);
+    }
+    
+    return minimo;
+}
+
+template <typename T, int N>
+T ListaSensor<T, N>::eliminarPrimero() {
+    if (cabeza == 0) {
+        return 0;
+    }
+    
+    T valor = cabeza->datos[cabeza->inicio];
+    cabeza->inicio = cabeza->inicio + 1;
+    if (cabeza->inicio == cabeza->fin) {
+        desenlazar(0, cabeza);
+    }
+    
+    cantidad = cantidad - 1;
+    suma = (cantidad == 0) ? 0.0 : suma - valor;
+    return valor;
+}
+
+template <typename T, int N>
+void ListaSensor<T, N>::submuestrear() {
+    if (cabeza == 0) {
+        return;
+    }
+    
+    // Se compacta en el sitio: el par k se escribe en la posición física k,
+    // que nunca adelanta a las lecturas que faltan por leer
+    Nodo<T, N>* lectura = cabeza;
+    int posLectura = cabeza->inicio;
+    Nodo<T, N>* escritura = cabeza;
+    int posEscritura = 0;
+    
+    suma = 0.0;
+    cantidad = 0;
+    
+    while (lectura != 0) {
+        T valor = lectura->datos[posLectura];
+        
+        // Avanzar al siguiente elemento vivo
+        posLectura = posLectura + 1;
+        while (lectura != 0 && posLectura >= lectura->fin) {
+            lectura = lectura->siguiente;
+            posLectura = (lectura != 0) ? lectura->inicio : 0;
+        }
+        
+        if (lectura != 0) {
+            // Fusionar el par en un solo valor
+            valor = (valor + lectura->datos[posLectura]) / 2;
+            posLectura = posLectura + 1;
+            while (lectura != 0 && posLectura >= lectura->fin) {
+                lectura = lectura->siguiente;
+                posLectura = (lectura != 0) ? lectura->inicio : 0;
+            }
+        }
+        
+        if (posEscritura == N) {
+            // El lector ya salió de este bloque: se puede fijar lleno
+            escritura->inicio = 0;
+            escritura->fin = N;
+            escritura = escritura->siguiente;
+            posEscritura = 0;
+        }
+        escritura->datos[posEscritura] = valor;
+        posEscritura = posEscritura + 1;
+        
+        suma = suma + valor;
+        cantidad = cantidad + 1;
+    }
+    
+    // Cerrar el último bloque escrito y liberar los que sobran
+    escritura->inicio = 0;
+    escritura->fin = posEscritura;
+    
+    Nodo<T, N>* sobrante = escritura->siguiente;
+    escritura->siguiente = 0;
+    cola = escritura;
+    while (sobrante != 0) {
+        Nodo<T, N>* siguiente = sobrante->siguiente;
+        delete sobrante;
+        nodos = nodos - 1;
+        sobrante = siguiente;
+    }
+}
+
+template <typename T, int N>
+long long ListaSensor<T, N>::bytesUsados() const {
+    return (long long)nodos * sizeof(Nodo<T, N>);
+}
+
+template <typename T, int N>
+int ListaSensor<T, N>::contarElementos() const {
+    return cantidad;
+}
+
+template <typename T, int N>
+bool ListaSensor<T, N>::estaVacia() const {
+    return cabeza == 0;
+}
+
+template <typename T, int N>
+typename ListaSensor<T, N>::iterador ListaSensor<T, N>::begin() const {
+    // Los nodos nunca quedan vacíos, así que la cabeza es la primera lectura
+    return iterador(cabeza);
+}
+
+template <typename T, int N>
+typename ListaSensor<T, N>::iterador ListaSensor<T, N>::end() const {
+    return iterador();
+}
+
+template <typename T, int N>
+template <typename F>
+void ListaSensor<T, N>::recorrerBloques(F funcion) const {
+    Nodo<T, N>* actual = cabeza;
+    while (actual != 0) {
+        funcion(actual->datos + actual->inicio, actual->fin - actual->inicio);
+        actual = actual->siguiente;
+    }
+}
+
+template <typename T, int N>
+int ListaSensor<T, N>::contarBloques() const {
+    return nodos;
+}
+
+template <typename T, int N>
+void ListaSensor<T, N>::imprimir() const {
+    // Todo se formatea en un búfer y se escribe de una vez
+    BuferSalida salida(cout);
+    bool primero = true;
+    
+    salida.texto("[ ");
+    for (iterador it = begin(); it != end(); ++it) {
+        if (!primero) {
+            salida.texto(", ");
+        }
+        salida.numero(*it);
+        primero = false;
+    }
+    salida.texto(" ]\n");
+}
+
+#endif // LISTA_SENSOR_H
@@ -0,0 +1,355 @@
+/**
+ * @file ListaSensorConcurrente.h
+ * @brief Variante concurrente de ListaSensor con inserción sin bloqueo
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef LISTA_SENSOR_CONCURRENTE_H
+#define LISTA_SENSOR_CONCURRENTE_H
+
+#include "GestorEpocas.h"
+#include "ContabilidadMemoria.h"
+#include <atomic>
+#include <mutex>
+#include <iostream>
+using namespace std;
+
+/**
+ * @brief Nodo de la lista concurrente
+ * @tparam T Tipo de dato que almacena el nodo
+ */
+template <typename T>
+struct NodoConcurrente {
+    T dato;                                  ///< Dato almacenado en el nodo
+    atomic<NodoConcurrente<T>*> siguiente;   ///< Puntero al siguiente nodo
+    atomic<bool> eliminado;                  ///< Borrado lógico pendiente de desenlazar
+    
+    /**
+     * @brief Constructor del nodo
+     * @param valor Valor a almacenar en el nodo
+     */
+    NodoConcurrente(T valor) {
+        dato = valor;
+        siguiente.store(0, memory_order_relaxed);
+        eliminado.store(false, memory_order_relaxed);
+        ContabilidadMemoria::global().reservar(MEMORIA_NODOS, sizeof(NodoConcurrente<T>));
+    }
+    
+    /**
+     * @brief Destructor del nodo (descuenta su memoria)
+     */
+    ~NodoConcurrente() {
+        ContabilidadMemoria::global().liberar(MEMORIA_NODOS, sizeof(NodoConcurrente<T>));
+    }
+    
+    /**
+     * @brief Libera un nodo retirado (usado por GestorEpocas)
+     * @param puntero Nodo a liberar
+     */
+    static void liberar(void* puntero) {
+        delete (NodoConcurrente<T>*)puntero;
+    }
+};
+
+/**
+ * @class ListaSensorConcurrente
+ * @brief Lista de lecturas para varios productores y lectores simultáneos
+ * @tparam T Tipo de dato de las lecturas
+ *
+ * - insertar: sin espera (wait-free). Cada productor intercambia la cola
+ *   atómicamente y después enlaza el nodo anterior con el suyo.
+ * - Lectores (promedio, conteo, recorrido): sin bloqueo; recorren bajo
+ *   una GuardiaEpoca y omiten nodos con borrado lógico.
+ * - eliminarMinimo / eliminarPrimero: se serializan entre sí con un
+ *   mutex, sin detener a productores ni lectores. El nodo eliminado se
+ *   desenlaza en el momento usando el predecesor que dejó el propio
+ *   recorrido, siempre que ya tenga sucesor (así ningún productor lo
+ *   está enlazando). Si era la cola, queda con borrado lógico y el
+ *   siguiente recorrido que pase por él lo desenlaza: nunca hay más de
+ *   uno así, de modo que eliminarPrimero es O(1) y no hay pasadas de
+ *   purga. Los nodos desenlazados van a la lista de su época en
+ *   GestorEpocas, que los libera cuando ningún lector puede verlos.
+ * - La suma se lleva en double aunque T sea entero, igual que el
+ *   promedio de ListaSensor.
+ */
+template <typename T>
+class ListaSensorConcurrente {
+private:
+    NodoConcurrente<T>* centinela;        ///< Nodo ficticio anterior al primero
+    atomic<NodoConcurrente<T>*> cola;     ///< Último nodo insertado
+    atomic<int> cantidad;                 ///< Elementos vivos
+    atomic<double> suma;                  ///< Suma de los elementos vivos
+    mutex mutexEliminacion;               ///< Serializa las eliminaciones
+    
+    /**
+     * @brief Suma atómica (atomic<double> no tiene fetch_add antes de C++20)
+     * @param delta Valor a sumar
+     */
+    void acumular(double delta);
+    
+    /**
+     * @brief Quita 'nodo' de la lista y lo retira a GestorEpocas
+     * @param previo Nodo enlazado justo antes de 'nodo'
+     * @param nodo Nodo con borrado lógico y sucesor no nulo
+     * @param siguiente Sucesor de 'nodo'
+     *
+     * Se llama con mutexEliminacion tomado.
+     */
+    void desenlazar(NodoConcurrente<T>* previo, NodoConcurrente<T>* nodo, NodoConcurrente<T>* siguiente);
+    
+    ListaSensorConcurrente(const ListaSensorConcurrente<T>&);
+    ListaSensorConcurrente<T>& operator=(const ListaSensorConcurrente<T>&);
+    
+public:
+    /**
+     * @brief Constructor por defecto
+     */
+    ListaSensorConcurrente();
+    
+    /**
+     * @brief Destructor - no debe haber hilos usando la lista
+     */
+    ~ListaSensorConcurrente();
+    
+    /**
+     * @brief Inserta un elemento al final (sin espera, seguro entre hilos)
+     * @param valor Valor a insertar
+     */
+    void insertar(T valor);
+    
+    /**
+     * @brief Promedio de los elementos vivos en O(1)
+     * @return Promedio como double
+     */
+    double calcularPromedio() const;
+    
+    /**
+     * @brief Suma de los elementos vivos
+     * @return Suma como double
+     */
+    double calcularSuma() const;
+    
+    /**
+     * @brief Elimina el valor más bajo
+     * @return El valor eliminado (0 si la lista está vacía)
+     */
+    T eliminarMinimo();
+    
+    /**
+     * @brief Elimina la lectura más antigua (desalojo)
+     * @return true si había una lectura que eliminar
+     */
+    bool eliminarPrimero();
+    
+    /**
+     * @brief Número de elementos vivos
+     * @return Número de elementos
+     */
+    int contarElementos() const;
+    
+    /**
+     * @brief Verifica si la lista está vacía
+     * @return true si está vacía
+     */
+    bool estaVacia() const;
+    
+    /**
+     * @brief Recorre los elementos vivos en orden de inserción
+     * @param visitar Función llamada con cada valor
+     * @param contexto Dato adicional para la función
+     * @return Número de elementos visitados
+     */
+    int recorrer(void (*visitar)(T valor, void* contexto), void* contexto) const;
+    
+    /**
+     * @brief Imprime todos los elementos de la lista
+     */
+    void imprimir() const;
+};
+
+template <typename T>
+ListaSensorConcurrente<T>::ListaSensorConcurrente() {
+    centinela = new NodoConcurrente<T>(T());
+    cola.store(centinela);
+    cantidad.store(0);
+    suma.store(0.0);
+}
+
+template <typename T>
+ListaSensorConcurrente<T>::~ListaSensorConcurrente() {
+    NodoConcurrente<T>* actual = centinela;
+    while (actual != 0) {
+        NodoConcurrente<T>* siguiente = actual->siguiente.load(memory_order_relaxed);
+        delete actual;
+        actual = siguiente;
+    }
+}
+
+template <typename T>
+void ListaSensorConcurrente<T>::acumular(double delta) {
+    double esperado = suma.load(memory_order_relaxed);
+    while (!suma.compare_exchange_weak(esperado, esperado + delta)) {
+        // 'esperado' se actualiza con el valor vigente; reintentar
+    }
+}
+
+template <typename T>
+void ListaSensorConcurrente<T>::insertar(T valor) {
+    NodoConcurrente<T>* nuevoNodo = new NodoConcurrente<T>(valor);
+    
+    // Reservar la posición final y enlazarla: dos operaciones sin ciclo
+    NodoConcurrente<T>* anterior = cola.exchange(nuevoNodo, memory_order_acq_rel);
+    anterior->siguiente.store(nuevoNodo, memory_order_release);
+    
+    cantidad.fetch_add(1);
+    acumular((double)valor);
+}
+
+template <typename T>
+double ListaSensorConcurrente<T>::calcularPromedio() const {
+    int n = cantidad.load();
+    if (n <= 0) {
+        return 0.0;
+    }
+    return suma.load() / n;
+}
+
+template <typename T>
+double ListaSensorConcurrente<T>::calcularSuma() const {
+    return suma.load();
+}
+
+template <typename T>
+void ListaSensorConcurrente<T>::desenlazar(NodoConcurrente<T>* previo, NodoConcurrente<T>* nodo, NodoConcurrente<T>* siguiente) {
+    // Con sucesor, ningún productor volverá a escribir en 'nodo'
+    previo->siguiente.store(siguiente, memory_order_release);
+    GestorEpocas::global().retirar(nodo, &NodoConcurrente<T>::liberar);
+}
+
+template <typename T>
+T ListaSensorConcurrente<T>::eliminarMinimo() {
+    lock_guard<mutex> candado(mutexEliminacion);
+    GuardiaEpoca guardia;
+    
+    NodoConcurrente<T>* minimo = 0;
+    NodoConcurrente<T>* previoMinimo = 0;
+    NodoConcurrente<T>* previo = centinela;
+    NodoConcurrente<T>* actual = centinela->siguiente.load(memory_order_acquire);
+    
+    while (actual != 0) {
+        NodoConcurrente<T>* siguiente = actual->siguiente.load(memory_order_acquire);
+        
+        if (actual->eliminado.load()) {
+            // Una cola eliminada antes que ya recibió sucesor
+            if (siguiente != 0) {
+                desenlazar(previo, actual, siguiente);
+                actual = siguiente;
+                continue;
+            }
+        } else if (minimo == 0 || actual->dato < minimo->dato) {
+            minimo = actual;
+            previoMinimo = previo;
+        }
+        
+        previo = actual;
+        actual = siguiente;
+    }
+    
+    if (minimo == 0) {
+        return 0;
+    }
+    
+    T valor = minimo->dato;
+    minimo->eliminado.store(true);
+    cantidad.fetch_sub(1);
+    acumular(-(double)valor);
+    
+    NodoConcurrente<T>* siguiente = minimo->siguiente.load(memory_order_acquire);
+    if (siguiente != 0) {
+        desenlazar(previoMinimo, minimo, siguiente);
+    }
+    return valor;
+}
+
+template <typename T>
+bool ListaSensorConcurrente<T>::eliminarPrimero() {
+    lock_guard<mutex> candado(mutexEliminacion);
+    GuardiaEpoca guardia;
+    
+    // Como mucho se salta un nodo: la cola que quedó eliminada
+    NodoConcurrente<T>* actual = centinela->siguiente.load(memory_order_acquire);
+    while (actual != 0 && actual->eliminado.load()) {
+        NodoConcurrente<T>* siguiente = actual->siguiente.load(memory_order_acquire);
+        if (siguiente == 0) {
+            return false;
+        }
+        desenlazar(centinela, actual, siguiente);
+        actual = siguiente;
+    }
+    
+    if (actual == 0) {
+        return false;
+    }
+    
+    actual->eliminado.store(true);
+    cantidad.fetch_sub(1);
+    acumular(-(double)actual->dato);
+    
+    NodoConcurrente<T>* siguiente = actual->siguiente.load(memory_order_acquire);
+    if (siguiente != 0) {
+        desenlazar(centinela, actual, siguiente);
+    }
+    return true;
+}
+
+template <typename T>
+int ListaSensorConcurrente<T>::contarElementos() const {
+    return cantidad.load();
+}
+
+template <typename T>
+bool ListaSensorConcurrente<T>::estaVacia() const {
+    return cantidad.load() == 0;
+}
+
+template <typename T>
+int ListaSensorConcurrente<T>::recorrer(void (*visitar)(T valor, void* contexto), void* contexto) const {
+    GuardiaEpoca guardia;
+    int visitados = 0;
+    
+    NodoConcurrente<T>* actual = centinela->siguiente.load(memory_order_acquire);
+    while (actual != 0) {
+        if (!actual->eliminado.load(memory_order_relaxed)) {
+            visitar(actual->dato, contexto);
+            visitados = visitados + 1;
+        }
+        actual = actual->siguiente.load(memory_order_acquire);
+    }
+    
+    return visitados;
+}
+
+/**
+ * @brief Auxiliar de imprimir: escribe un valor separado por comas
+ */
+template <typename T>
+void imprimirValorConcurrente(T valor, void* contexto) {
+    bool* primero = (bool*)contexto;
+    if (!*primero) {
+        cout << ", ";
+    }
+    cout << valor;
+    *primero = false;
+}
+
+template <typename T>
+void ListaSensorConcurrente<T>::imprimir() const {
+    bool primero = true;
+    
+    cout << "[ ";
+    recorrer(&imprimirValorConcurrente<T>, &primero);
+    cout << " ]" << endl;
+}
+
+#endif // LISTA_SENSOR_CONCURRENTE_H
@@ -0,0 +1,201 @@
+/**
+ * @file PlanificadorRueda.cpp
+ * @brief Implementación de la rueda de temporizadores jerárquica
+ */
+
+#include "PlanificadorRueda.h"
+#include "ListaGeneral.h"
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+PlanificadorRueda::PlanificadorRueda(ListaGeneral* listaSensores, long long ahoraMs) {
+    for (int n = 0; n < NIVELES; n++) {
+        for (int r = 0; r < RANURAS; r++) {
+            ranuras[n][r] = 0;
+        }
+    }
+    
+    tickActual = ahoraMs;
+    lista = listaSensores;
+    disparos = 0;
+    ejecuciones = 0;
+    jitterTotalMs = 0;
+    jitterMaximoMs = 0;
+    plazosPerdidos = 0;
+}
+
+PlanificadorRueda::~PlanificadorRueda() {
+    for (int i = 0; i < porId.tamano(); i++) {
+        delete porId[i];
+    }
+}
+
+long long PlanificadorRueda::ahoraMs() {
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PlanificadorRueda::colocar(TareaPlanificada* tarea, long long minimo) {
+    long long efectivo = tarea->vencimiento;
+    if (efectivo < minimo) {
+        efectivo = minimo;
+    }
+    
+    // Elegir el nivel cuyo alcance cubre el plazo
+    long long delta = efectivo - tickActual;
+    long long alcance = RANURAS;
+    int nivel = 0;
+    while (nivel < NIVELES - 1 && delta >= alcance) {
+        alcance = alcance * RANURAS;
+        nivel = nivel + 1;
+    }
+    
+    // Plazos más allá del último nivel esperan en su ranura más lejana
+    if (delta >= alcance) {
+        efectivo = tickActual + alcance - 1;
+    }
+    
+    int indice = (int)((efectivo >> (nivel * BITS_NIVEL)) & (RANURAS - 1));
+    TareaPlanificada** cabeza = &ranuras[nivel][indice];
+    
+    tarea->ranura = cabeza;
+    tarea->anterior = 0;
+    tarea->siguiente = *cabeza;
+    if (*cabeza != 0) {
+        (*cabeza)->anterior = tarea;
+    }
+    *cabeza = tarea;
+}
+
+void PlanificadorRueda::quitar(TareaPlanificada* tarea) {
+    if (tarea->ranura == 0) {
+        return;
+    }
+    
+    if (tarea->anterior != 0) {
+        tarea->anterior->siguiente = tarea->siguiente;
+    } else {
+        *(tarea->ranura) = tarea->siguiente;
+    }
+    
+    if (tarea->siguiente != 0) {
+        tarea->siguiente->anterior = tarea->anterior;
+    }
+    
+    tarea->ranura = 0;
+    tarea->anterior = 0;
+    tarea->siguiente = 0;
+}
+
+void PlanificadorRueda::cascada(int nivel) {
+    int indice = (int)((tickActual >> (nivel * BITS_NIVEL)) & (RANURAS - 1));
+    TareaPlanificada* actual = ranuras[nivel][indice];
+    ranuras[nivel][indice] = 0;
+    
+    while (actual != 0) {
+        TareaPlanificada* siguiente = actual->siguiente;
+        colocar(actual, tickActual);
+        actual = siguiente;
+    }
+}
+
+void PlanificadorRueda::procesarTick(long long ahoraMs) {
+    // Al completar una vuelta de un nivel se baja la ranura del siguiente
+    int nivel = 1;
+    long long mascara = RANURAS - 1;
+    while (nivel < NIVELES && (tickActual & mascara) == 0) {
+        cascada(nivel);
+        mascara = (mascara << BITS_NIVEL) | (RANURAS - 1);
+        nivel = nivel + 1;
+    }
+    
+    int indice = (int)(tickActual & (RANURAS - 1));
+    TareaPlanificada* actual = ranuras[0][indice];
+    ranuras[0][indice] = 0;
+    
+    while (actual != 0) {
+        TareaPlanificada* siguiente = actual->siguiente;
+        actual->ranura = 0;
+        
+        if (actual->vencimiento > tickActual) {
+            // Plazo recortado al alcance de la rueda: aún no vence
+            colocar(actual, tickActual + 1);
+            actual = siguiente;
+            continue;
+        }
+        
+        long long retraso = ahoraMs - actual->vencimiento;
+        disparos = disparos + 1;
+        jitterTotalMs = jitterTotalMs + retraso;
+        if (retraso > jitterMaximoMs) {
+            jitterMaximoMs = retraso;
+        }
+        
+        if (lista->procesarSensor(actual->sensor)) {
+            ejecuciones = ejecuciones + 1;
+        }
+        
+        // Siguiente plazo; los periodos que ya pasaron cuentan como perdidos
+        actual->vencimiento = actual->vencimiento + actual->periodoMs;
+        while (actual->vencimiento <= ahoraMs) {
+            actual->vencimiento = actual->vencimiento + actual->periodoMs;
+            plazosPerdidos = plazosPerdidos + 1;
+        }
+        colocar(actual, tickActual + 1);
+        
+        actual = siguiente;
+    }
+}
+
+void PlanificadorRueda::programar(SensorBase* sensor, int periodoMs) {
+    if (periodoMs < 1) {
+        periodoMs = 1;
+    }
+    
+    int id = sensor->obtenerId();
+    porId.extender(id + 1, 0);
+    
+    TareaPlanificada* tarea = porId[id];
+    if (tarea == 0) {
+        tarea = new TareaPlanificada(sensor, periodoMs);
+        porId[id] = tarea;
+    } else {
+        quitar(tarea);
+        tarea->sensor = sensor;
+        tarea->periodoMs = periodoMs;
+    }
+    
+    tarea->vencimiento = tickActual + periodoMs;
+    colocar(tarea, tickActual + 1);
+}
+
+void PlanificadorRueda::cancelar(int id) {
+    if (id < 0 || id >= porId.tamano() || porId[id] == 0) {
+        return;
+    }
+    
+    quitar(porId[id]);
+    delete porId[id];
+    porId[id] = 0;
+}
+
+void PlanificadorRueda::avanzar(long long ahoraMs) {
+    while (tickActual < ahoraMs) {
+        tickActual = tickActual + 1;
+        procesarTick(ahoraMs);
+    }
+}
+
+void PlanificadorRueda::imprimirMetricas() const {
+    cout << "\n--- Metricas del Planificador ---" << endl;
+    cout << "Plazos atendidos: " << disparos << " (" << ejecuciones << " con datos nuevos)" << endl;
+    
+    if (disparos > 0) {
+        cout << "Jitter medio: " << (jitterTotalMs / disparos) << " ms, maximo: "
+             << jitterMaximoMs << " ms" << endl;
+    }
+    
+    cout << "Plazos perdidos: " << plazosPerdidos << endl;
+}
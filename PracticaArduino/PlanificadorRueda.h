@@ -0,0 +1,143 @@
+/**
+ * @file PlanificadorRueda.h
+ * @brief Rueda de temporizadores jerárquica para procesar sensores por plazo
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef PLANIFICADOR_RUEDA_H
+#define PLANIFICADOR_RUEDA_H
+
+#include "SensorBase.h"
+#include "ArregloDinamico.h"
+
+class ListaGeneral;
+
+/**
+ * @brief Entrada de la rueda: un sensor y su cadencia de procesamiento
+ */
+struct TareaPlanificada {
+    SensorBase* sensor;           ///< Sensor a procesar
+    int periodoMs;                ///< Cadencia en milisegundos
+    long long vencimiento;        ///< Próximo plazo (ms)
+    TareaPlanificada* anterior;   ///< Anterior en la ranura
+    TareaPlanificada* siguiente;  ///< Siguiente en la ranura
+    TareaPlanificada** ranura;    ///< Cabeza de la ranura que la contiene (0 si ninguna)
+    
+    /**
+     * @brief Constructor de la tarea
+     * @param s Sensor a procesar
+     * @param periodo Cadencia en milisegundos
+     */
+    TareaPlanificada(SensorBase* s, int periodo) {
+        sensor = s;
+        periodoMs = periodo;
+        vencimiento = 0;
+        anterior = 0;
+        siguiente = 0;
+        ranura = 0;
+    }
+};
+
+/**
+ * @class PlanificadorRueda
+ * @brief Dispara procesarLectura de cada sensor según su propia cadencia
+ *
+ * Rueda jerárquica de 4 niveles con 64 ranuras cada uno y resolución de
+ * 1 ms (alcance de ~4.6 horas). Programar y cancelar son O(1): cada
+ * ranura es una lista doblemente enlazada de tareas. Al girar un nivel
+ * completo, las tareas del nivel superior se redistribuyen (cascada).
+ *
+ * Registra el retraso (jitter) de cada disparo respecto a su plazo y los
+ * plazos perdidos, es decir, periodos completos que pasaron sin disparo.
+ */
+class PlanificadorRueda {
+private:
+    static const int NIVELES = 4;      ///< Niveles de la rueda
+    static const int BITS_NIVEL = 6;   ///< log2 de las ranuras por nivel
+    static const int RANURAS = 64;     ///< Ranuras por nivel
+    
+    TareaPlanificada* ranuras[NIVELES][RANURAS]; ///< Listas de tareas por ranura
+    long long tickActual;                        ///< Último milisegundo procesado
+    ArregloDinamico<TareaPlanificada*> porId;    ///< Tarea de cada sensor (por ID)
+    ListaGeneral* lista;                         ///< Lista que procesa los sensores
+    
+    long long disparos;        ///< Plazos atendidos
+    long long ejecuciones;     ///< Disparos con datos nuevos (se recalculó)
+    long long jitterTotalMs;   ///< Suma de retrasos
+    long long jitterMaximoMs;  ///< Peor retraso
+    long long plazosPerdidos;  ///< Periodos que vencieron sin disparo
+    
+    /**
+     * @brief Inserta una tarea en la ranura que corresponde a su plazo
+     * @param tarea Tarea a colocar
+     * @param minimo Primer tick en el que puede dispararse
+     */
+    void colocar(TareaPlanificada* tarea, long long minimo);
+    
+    /**
+     * @brief Saca una tarea de su ranura
+     * @param tarea Tarea a quitar
+     */
+    void quitar(TareaPlanificada* tarea);
+    
+    /**
+     * @brief Redistribuye la ranura actual de un nivel en los inferiores
+     * @param nivel Nivel a redistribuir (1 .. NIVELES-1)
+     */
+    void cascada(int nivel);
+    
+    /**
+     * @brief Atiende un milisegundo de la rueda
+     * @param ahoraMs Tiempo real actual (para medir el retraso)
+     */
+    void procesarTick(long long ahoraMs);
+    
+    PlanificadorRueda(const PlanificadorRueda&);
+    PlanificadorRueda& operator=(const PlanificadorRueda&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param listaSensores Lista encargada de procesar cada sensor
+     * @param ahoraMs Tiempo inicial en milisegundos
+     */
+    PlanificadorRueda(ListaGeneral* listaSensores, long long ahoraMs);
+    
+    /**
+     * @brief Destructor - libera las tareas (no los sensores)
+     */
+    ~PlanificadorRueda();
+    
+    /**
+     * @brief Programa (o reprograma) un sensor con la cadencia dada
+     * @param sensor Sensor a procesar periódicamente
+     * @param periodoMs Cadencia en milisegundos (mínimo 1)
+     */
+    void programar(SensorBase* sensor, int periodoMs);
+    
+    /**
+     * @brief Deja de procesar un sensor
+     * @param id ID del sensor
+     */
+    void cancelar(int id);
+    
+    /**
+     * @brief Avanza la rueda hasta el tiempo indicado disparando los plazos vencidos
+     * @param ahoraMs Tiempo actual en milisegundos
+     */
+    void avanzar(long long ahoraMs);
+    
+    /**
+     * @brief Imprime las métricas de jitter y plazos perdidos
+     */
+    void imprimirMetricas() const;
+    
+    /**
+     * @brief Tiempo monotónico actual en milisegundos
+     * @return Milisegundos desde un origen arbitrario
+     */
+    static long long ahoraMs();
+};
+
+#endif // PLANIFICADOR_RUEDA_H
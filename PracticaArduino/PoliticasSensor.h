@@ -0,0 +1,482 @@
+/**
+ * @file PoliticasSensor.h
+ * @brief Políticas de almacenamiento y etapas de procesamiento para SensorGenerico
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef POLITICAS_SENSOR_H
+#define POLITICAS_SENSOR_H
+
+#include "ListaSensor.h"
+#include <iostream>
+
+/*
+ * Almacenamiento
+ *
+ * Un almacén guarda las lecturas vivas del sensor, en orden de llegada.
+ * Ofrece: insertar(valor, desalojado), contar(), estaVacia(), promedio(),
+ * eliminarMinimo(), eliminarPrimero(), submuestrear() y bytesUsados()
+ * (solo la memoria fuera del sensor).
+ */
+
+/**
+ * @class AlmacenBloques
+ * @brief Historial sin límite en bloques de una línea de caché
+ * @tparam T Tipo de las lecturas
+ *
+ * Es la ListaSensor desenrollada de siempre; además lleva la suma en
+ * double para que el promedio de enteros no se trunque.
+ */
+template <typename T>
+class AlmacenBloques {
+public:
+    /**
+     * @brief Lista subyacente
+     */
+    typedef ListaSensor<T, BloqueLineaCache<T>::LECTURAS> Historial;
+    
+private:
+    Historial lista; ///< Lecturas en bloques
+    double suma;     ///< Suma de las lecturas vivas
+    
+public:
+    /**
+     * @brief Constructor (almacén vacío)
+     */
+    AlmacenBloques() {
+        suma = 0.0;
+    }
+    
+    /**
+     * @brief Agrega una lectura al final (nunca desaloja)
+     * @param valor Lectura
+     * @param desalojado No se modifica
+     * @return false
+     */
+    bool insertar(T valor, T& desalojado) {
+        (void)desalojado;
+        lista.insertar(valor);
+        suma = suma + valor;
+        return false;
+    }
+    
+    /**
+     * @brief Lecturas vivas
+     */
+    int contar() const {
+        return lista.contarElementos();
+    }
+    
+    /**
+     * @brief Indica si no hay lecturas
+     */
+    bool estaVacia() const {
+        return lista.estaVacia();
+    }
+    
+    /**
+     * @brief Promedio de las lecturas vivas en O(1)
+     * @return Promedio (0 si está vacío)
+     */
+    double promedio() const {
+        return lista.estaVacia() ? 0.0 : suma / lista.contarElementos();
+    }
+    
+    /**
+     * @brief Quita la lectura más baja
+     */
+    T eliminarMinimo() {
+        T valor = lista.eliminarMinimo();
+        suma = suma - valor;
+        return valor;
+    }
+    
+    /**
+     * @brief Quita la lectura más antigua
+     */
+    T eliminarPrimero() {
+        T valor = lista.eliminarPrimero();
+        suma = suma - valor;
+        return valor;
+    }
+    
+    /**
+     * @brief Fusiona las lecturas por pares (la suma se recalcula)
+     */
+    void submuestrear() {
+        lista.submuestrear();
+        double total = 0.0;
+        lista.recorrerBloques([&total](const T* valores, int cantidad) {
+            for (int i = 0; i < cantidad; i++) {
+                total = total + valores[i];
+            }
+        });
+        suma = total;
+    }
+    
+    /**
+     * @brief Memoria de los bloques (fuera del sensor)
+     */
+    long long bytesUsados() const {
+        return lista.bytesUsados();
+    }
+    
+    /**
+     * @brief Lista subyacente (solo lectura)
+     * @return Referencia a la lista
+     */
+    const Historial& historial() const {
+        return lista;
+    }
+};
+
+/**
+ * @class AlmacenAnillo
+ * @brief Conserva solo las últimas N lecturas, dentro del propio sensor
+ * @tparam T Tipo de las lecturas
+ * @tparam N Lecturas que caben
+ *
+ * Para señales rápidas donde solo interesa la ventana reciente: no
+ * reserva memoria por lectura y la lectura N+1 desaloja la más antigua.
+ */
+template <typename T, int N>
+class AlmacenAnillo {
+    static_assert(N >= 1, "El anillo necesita al menos una lectura");
+    
+private:
+    T datos[N];   ///< Lecturas (circular)
+    int inicio;   ///< Posición de la más antigua
+    int cantidad; ///< Lecturas vivas
+    double suma;  ///< Suma de las lecturas vivas
+    
+    /**
+     * @brief Posición física de la i-ésima lectura viva
+     */
+    int posicion(int i) const {
+        return (inicio + i) % N;
+    }
+    
+public:
+    /**
+     * @brief Constructor (anillo vacío)
+     */
+    AlmacenAnillo() {
+        inicio = 0;
+        cantidad = 0;
+        suma = 0.0;
+    }
+    
+    /**
+     * @brief Agrega una lectura; si el anillo está lleno desaloja la más antigua
+     * @param valor Lectura
+     * @param desalojado Recibe la lectura desalojada
+     * @return true si hubo desalojo
+     */
+    bool insertar(T valor, T& desalojado) {
+        if (cantidad < N) {
+            datos[posicion(cantidad)] = valor;
+            cantidad = cantidad + 1;
+            suma = suma + valor;
+            return false;
+        }
+        desalojado = datos[inicio];
+        datos[inicio] = valor;
+        inicio = (inicio + 1) % N;
+        suma = suma + valor - desalojado;
+        return true;
+    }
+    
+    /**
+     * @brief Lecturas vivas
+     */
+    int contar() const {
+        return cantidad;
+    }
+    
+    /**
+     * @brief Indica si no hay lecturas
+     */
+    bool estaVacia() const {
+        return cantidad == 0;
+    }
+    
+    /**
+     * @brief Promedio de las lecturas vivas en O(1)
+     */
+    double promedio() const {
+        return cantidad == 0 ? 0.0 : suma / cantidad;
+    }
+    
+    /**
+     * @brief Quita la menor lectura conservando el orden de las demás
+     * @return Valor eliminado
+     */
+    T eliminarMinimo() {
+        int minimo = 0;
+        for (int i = 1; i < cantidad; i++) {
+            if (datos[posicion(i)] < datos[posicion(minimo)]) {
+                minimo = i;
+            }
+        }
+        
+        T valor = datos[posicion(minimo)];
+        for (int i = minimo; i + 1 < cantidad; i++) {
+            datos[posicion(i)] = datos[posicion(i + 1)];
+        }
+        cantidad = cantidad - 1;
+        suma = suma - valor;
+        return valor;
+    }
+    
+    /**
+     * @brief Quita la lectura más antigua
+     */
+    T eliminarPrimero() {
+        T valor = datos[inicio];
+        inicio = (inicio + 1) % N;
+        cantidad = cantidad - 1;
+        suma = suma - valor;
+        return valor;
+    }
+    
+    /**
+     * @brief Fusiona las lecturas por pares y deja el anillo desde 0
+     */
+    void submuestrear() {
+        T compactados[N];
+        int nuevos = 0;
+        suma = 0.0;
+        for (int i = 0; i < cantidad; i = i + 2) {
+            T valor = datos[posicion(i)];
+            if (i + 1 < cantidad) {
+                valor = (valor + datos[posicion(i + 1)]) / 2;
+            }
+            compactados[nuevos] = valor;
+            nuevos = nuevos + 1;
+            suma = suma + valor;
+        }
+        for (int i = 0; i < nuevos; i++) {
+            datos[i] = compactados[i];
+        }
+        inicio = 0;
+        cantidad = nuevos;
+    }
+    
+    /**
+     * @brief Memoria fuera del sensor
+     * @return 0: el anillo vive dentro del sensor
+     */
+    long long bytesUsados() const {
+        return 0;
+    }
+};
+
+/*
+ * Etapas de procesamiento
+ *
+ * Cada etapa puede filtrar o transformar las lecturas al llegar
+ * (entrada, devuelve false para descartarla) y participar en
+ * procesarLectura (procesar, que recibe el sensor y el resultado en
+ * curso). Las etapas heredan de EtapaNula lo que no necesitan; todo se
+ * resuelve en compilación, sin llamadas virtuales.
+ */
+
+/**
+ * @brief Etapa que no hace nada (base de las demás)
+ */
+struct EtapaNula {
+    template <typename T>
+    bool entrada(T& valor) {
+        (void)valor;
+        return true;
+    }
+    
+    template <typename S>
+    void procesar(S& sensor, double& resultado) {
+        (void)sensor;
+        (void)resultado;
+    }
+};
+
+/**
+ * @brief Conserva una de cada N lecturas (la primera de cada grupo)
+ * @tparam N Factor de diezmado
+ */
+template <int N>
+struct Diezmar : EtapaNula {
+    static_assert(N >= 1, "El factor de diezmado debe ser positivo");
+    
+    int vistas; ///< Lecturas recibidas
+    
+    Diezmar() {
+        vistas = 0;
+    }
+    
+    template <typename T>
+    bool entrada(T& valor) {
+        (void)valor;
+        bool conservar = (vistas % N == 0);
+        vistas = vistas + 1;
+        return conservar;
+    }
+    
+    static const char* nombre() {
+        return "diezmar";
+    }
+};
+
+/**
+ * @brief Satura cada lectura al rango físico del sensor
+ * @tparam MINIMO Menor valor aceptado
+ * @tparam MAXIMO Mayor valor aceptado
+ */
+template <long long MINIMO, long long MAXIMO>
+struct Acotar : EtapaNula {
+    static_assert(MINIMO <= MAXIMO, "Rango invalido");
+    
+    template <typename T>
+    bool entrada(T& valor) {
+        if (valor < (T)MINIMO) {
+            valor = (T)MINIMO;
+        } else if (valor > (T)MAXIMO) {
+            valor = (T)MAXIMO;
+        }
+        return true;
+    }
+    
+    static const char* nombre() {
+        return "acotar";
+    }
+};
+
+/**
+ * @brief Elimina la lectura más baja del historial (si queda más de una)
+ */
+struct RecortarMinimo : EtapaNula {
+    template <typename S>
+    void procesar(S& sensor, double& resultado) {
+        (void)resultado;
+        if (sensor.cantidadLecturas() > 1) {
+            sensor.descartarMinimo();
+        }
+    }
+    
+    static const char* nombre() {
+        return "recortar minimo";
+    }
+};
+
+/**
+ * @brief El resultado pasa a ser el promedio del historial
+ */
+struct Promedio : EtapaNula {
+    template <typename S>
+    void procesar(S& sensor, double& resultado) {
+        if (sensor.cantidadLecturas() > 0) {
+            resultado = sensor.promedioLecturas();
+        }
+    }
+    
+    static const char* nombre() {
+        return "promedio";
+    }
+};
+
+/**
+ * @brief Suaviza el resultado entre procesamientos sucesivos (EWMA)
+ * @tparam NUMERADOR Numerador de alfa
+ * @tparam DENOMINADOR Denominador de alfa (alfa = NUMERADOR / DENOMINADOR)
+ *
+ * Alfa va como fracción porque un double no puede ser parámetro de plantilla.
+ */
+template <int NUMERADOR, int DENOMINADOR>
+struct SuavizadoExponencial : EtapaNula {
+    static_assert(NUMERADOR > 0 && NUMERADOR <= DENOMINADOR, "Alfa debe estar en (0, 1]");
+    
+    bool iniciado;    ///< Ya hay un valor suavizado
+    double suavizado; ///< Último valor suavizado
+    
+    SuavizadoExponencial() {
+        iniciado = false;
+        suavizado = 0.0;
+    }
+    
+    template <typename S>
+    void procesar(S& sensor, double& resultado) {
+        (void)sensor;
+        if (!iniciado) {
+            suavizado = resultado;
+            iniciado = true;
+        } else {
+            suavizado = suavizado + (resultado - suavizado) * NUMERADOR / DENOMINADOR;
+        }
+        resultado = suavizado;
+    }
+    
+    static const char* nombre() {
+        return "EWMA";
+    }
+};
+
+/**
+ * @brief Composición de etapas, aplicadas en el orden dado
+ *
+ * Se define por recursión: cada nivel guarda su etapa y el resto de la
+ * cadena, de modo que el compilador ve la secuencia completa y la expande
+ * en línea. Una misma etapa puede aparecer más de una vez.
+ */
+template <typename... Etapas>
+struct CadenaEtapas;
+
+template <>
+struct CadenaEtapas<> {
+    template <typename T>
+    bool entrada(T& valor) {
+        (void)valor;
+        return true;
+    }
+    
+    template <typename S>
+    void procesar(S& sensor, double& resultado) {
+        (void)sensor;
+        (void)resultado;
+    }
+    
+    static void imprimirNombres() {
+    }
+};
+
+template <typename Primera, typename... Resto>
+struct CadenaEtapas<Primera, Resto...> {
+    Primera etapa;                ///< Etapa de este nivel
+    CadenaEtapas<Resto...> resto; ///< Etapas siguientes
+    
+    /**
+     * @brief Pasa la lectura por las etapas hasta que una la descarte
+     * @return false si alguna la descartó
+     */
+    template <typename T>
+    bool entrada(T& valor) {
+        return etapa.entrada(valor) && resto.entrada(valor);
+    }
+    
+    template <typename S>
+    void procesar(S& sensor, double& resultado) {
+        etapa.procesar(sensor, resultado);
+        resto.procesar(sensor, resultado);
+    }
+    
+    /**
+     * @brief Imprime los nombres de las etapas separados por flechas
+     */
+    static void imprimirNombres() {
+        std::cout << Primera::nombre();
+        if (sizeof...(Resto) > 0) {
+            std::cout << " -> ";
+        }
+        CadenaEtapas<Resto...>::imprimirNombres();
+    }
+};
+
+#endif // POLITICAS_SENSOR_H
@@ -0,0 +1,800 @@
+/**
+ * @file PruebasRendimiento.cpp
+ * @brief Implementación de las pruebas de rendimiento
+ */
+
+#include "PruebasRendimiento.h"
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "ListaSensor.h"
+#include "ListaSensorConcurrente.h"
+#include "LectorIngesta.h"
+#include "ImportadorCapturas.h"
+#include "ConsultasFlota.h"
+#include "RegistroCambios.h"
+#include "Bitacora.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+// Intentos por carga: se conserva el más rápido
+static const int INTENTOS = 3;
+
+/**
+ * @brief Nanosegundos transcurridos desde inicio
+ */
+static double nanosegundosDesde(chrono::steady_clock::time_point inicio) {
+    return (double)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+}
+
+/**
+ * @brief Presupuesto sin límites: mide la estructura, no el recorte
+ */
+static PresupuestoRetencion sinLimite() {
+    PresupuestoRetencion presupuesto;
+    presupuesto.maxLecturas = 0;
+    presupuesto.horizonteCrudoMs = 0;
+    return presupuesto;
+}
+
+PruebasRendimiento::PruebasRendimiento() {
+    cantidad = 0;
+}
+
+void PruebasRendimiento::anotar(const char* nombre, double nsPorOperacion, long long operaciones) {
+    if (cantidad == (int)(sizeof(mediciones) / sizeof(mediciones[0]))) {
+        return;
+    }
+    strncpy(mediciones[cantidad].nombre, nombre, sizeof(mediciones[cantidad].nombre) - 1);
+    mediciones[cantidad].nombre[sizeof(mediciones[cantidad].nombre) - 1] = '\0';
+    mediciones[cantidad].nsPorOperacion = nsPorOperacion;
+    mediciones[cantidad].operaciones = operaciones;
+    cantidad = cantidad + 1;
+}
+
+double PruebasRendimiento::medido(const char* nombre) const {
+    for (int i = 0; i < cantidad; i++) {
+        if (strcmp(mediciones[i].nombre, nombre) == 0) {
+            return mediciones[i].nsPorOperacion;
+        }
+    }
+    return -1.0;
+}
+
+void PruebasRendimiento::medirIngesta(int lecturas, const char* nombre) {
+    double mejor = -1.0;
+    
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        SensorTemperatura sensor("RENDIMIENTO-INGESTA");
+        sensor.fijarPresupuesto(sinLimite());
+        
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        for (int i = 0; i < lecturas; i++) {
+            sensor.registrarLectura(20.0f + (i % 1000) / 100.0f);
+        }
+        sensor.publicarEstado();
+        double ns = nanosegundosDesde(inicio) / lecturas;
+        if (mejor < 0 || ns < mejor) {
+            mejor = ns;
+        }
+    }
+    anotar(nombre, mejor, lecturas);
+}
+
+/**
+ * @brief Lee sin parar la última instantánea y recorre su historial
+ */
+static void reportar(const SensorTemperatura* sensor, const atomic<bool>* seguir, atomic<long long>* reportes) {
+    double suma = 0.0;
+    while (seguir->load(memory_order_relaxed)) {
+        shared_ptr<const InstantaneaSensor<float> > instantanea = sensor->obtenerInstantanea();
+        for (int i = 0; i < instantanea->historial.tamano(); i++) {
+            suma = suma + instantanea->historial[i];
+        }
+        reportes->fetch_add(1, memory_order_relaxed);
+    }
+    // Que el recorrido no se elimine por no usarse
+    if (suma < 0) {
+        cout << suma << endl;
+    }
+}
+
+void PruebasRendimiento::medirIngestaConReportes() {
+    const int LOTE = 64;
+    const int LOTES = 4000;
+    const int RETENIDAS = 4096;
+    float valores[LOTE];
+    long long* latencias = new long long[LOTES];
+    
+    double mejor = -1.0;
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        // Régimen estable: historial lleno, cada lote desaloja otras tantas
+        SensorTemperatura sensor("RENDIMIENTO-REPORTES");
+        PresupuestoRetencion presupuesto = sinLimite();
+        presupuesto.maxLecturas = RETENIDAS;
+        sensor.fijarPresupuesto(presupuesto);
+        for (int i = 0; i < RETENIDAS; i++) {
+            valores[i % LOTE] = 20.0f + (i % 1000) / 100.0f;
+            if (i % LOTE == LOTE - 1) {
+                sensor.registrarLote(valores, LOTE);
+            }
+        }
+        
+        atomic<bool> seguir(true);
+        atomic<long long> reportes(0);
+        thread reportero(reportar, &sensor, &seguir, &reportes);
+        while (reportes.load() == 0) {
+            this_thread::yield();
+        }
+        
+        for (int lote = 0; lote < LOTES; lote++) {
+            for (int i = 0; i < LOTE; i++) {
+                valores[i] = 20.0f + ((lote * LOTE + i) % 1000) / 100.0f;
+            }
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            sensor.registrarLote(valores, LOTE);
+            latencias[lote] = (long long)nanosegundosDesde(inicio);
+        }
+        
+        seguir.store(false);
+        reportero.join();
+        
+        sort(latencias, latencias + LOTES);
+        double ns = (double)latencias[LOTES * 99 / 100] / LOTE;
+        if (mejor < 0 || ns < mejor) {
+            mejor = ns;
+        }
+    }
+    
+    delete[] latencias;
+    anotar("ingesta_p99_rep", mejor, (long long)LOTES * LOTE);
+}
+
+void PruebasRendimiento::medirProcesamiento() {
+    const int SENSORES = 10000;
+    const int LECTURAS = 16;
+    char nombre[32];
+    
+    ListaGeneral lista;
+    lista.iniciarCargaMasiva();
+    for (int i = 0; i < SENSORES; i++) {
+        snprintf(nombre, sizeof(nombre), "RENDIMIENTO-P%05d", i);
+        lista.insertar(new SensorTemperatura(nombre));
+    }
+    lista.terminarCargaMasiva();
+    
+    double mejor = -1.0;
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        // Dejar a todos con datos nuevos (fuera de la medición)
+        for (ListaGeneral::iterador it = lista.begin(); it != lista.end(); ++it) {
+            SensorTemperatura* sensor = (SensorTemperatura*)*it;
+            for (int k = 0; k < LECTURAS; k++) {
+                sensor->registrarLectura(20.0f + k);
+            }
+        }
+        
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        lista.procesarTodos();
+        double ns = nanosegundosDesde(inicio) / SENSORES;
+        if (mejor < 0 || ns < mejor) {
+            mejor = ns;
+        }
+    }
+    anotar("procesar_10k", mejor, SENSORES);
+}
+
+void PruebasRendimiento::medirDespacho() {
+    const int SENSORES = 10000;
+    const int LECTURAS = 16;
+    char nombre[32];
+    
+    ListaGeneral lista;
+    lista.iniciarCargaMasiva();
+    for (int i = 0; i < SENSORES; i++) {
+        snprintf(nombre, sizeof(nombre), "RENDIMIENTO-D%05d", i);
+        if (i % 2 == 0) {
+            lista.insertar(new SensorTemperatura(nombre));
+        } else {
+            lista.insertar(new SensorPresion(nombre));
+        }
+    }
+    lista.terminarCargaMasiva();
+    
+    double mejorTipos = -1.0;
+    double mejorVirtual = -1.0;
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        // Misma preparación para las dos variantes (fuera de la medición)
+        for (int variante = 0; variante < 2; variante++) {
+            for (ListaGeneral::iterador it = lista.begin(); it != lista.end(); ++it) {
+                SensorBase* sensor = *it;
+                for (int k = 0; k < LECTURAS; k++) {
+                    if (sensor->obtenerTipo() == SENSOR_TEMPERATURA) {
+                        ((SensorTemperatura*)sensor)->registrarLectura(20.0f + k);
+                    } else {
+                        ((SensorPresion*)sensor)->registrarLectura(1000 + k);
+                    }
+                }
+            }
+            
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            if (variante == 0) {
+                lista.procesarTodos();
+            } else {
+                for (ListaGeneral::iterador it = lista.begin(); it != lista.end(); ++it) {
+                    (*it)->procesarLectura();
+                }
+            }
+            double ns = nanosegundosDesde(inicio) / SENSORES;
+            double& mejor = (variante == 0) ? mejorTipos : mejorVirtual;
+            if (mejor < 0 || ns < mejor) {
+                mejor = ns;
+            }
+            
+            // El recorrido virtual no desmarca: que no quede nada pendiente
+            RegistroCambios::global().limpiar();
+        }
+    }
+    anotar("proc_tipo_10k", mejorTipos, SENSORES);
+    anotar("proc_virtual_10k", mejorVirtual, SENSORES);
+}
+
+void PruebasRendimiento::medirFlota(int sensores, const char* insercion, const char* busqueda, const char* liberacion) {
+    char nombre[32];
+    SensorBase** creados = new SensorBase*[sensores];
+    double mejorInsercion = -1.0;
+    double mejorBusqueda = -1.0;
+    double mejorLiberacion = -1.0;
+    
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        // Los sensores se crean fuera de la medición: solo cuenta la lista
+        for (int i = 0; i < sensores; i++) {
+            snprintf(nombre, sizeof(nombre), "RENDIMIENTO-F%06d", i);
+            creados[i] = new SensorTemperatura(nombre);
+        }
+        
+        ListaGeneral* lista = new ListaGeneral();
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        lista->iniciarCargaMasiva();
+        for (int i = 0; i < sensores; i++) {
+            lista->insertar(creados[i]);
+        }
+        lista->terminarCargaMasiva();
+        double ns = nanosegundosDesde(inicio) / sensores;
+        if (mejorInsercion < 0 || ns < mejorInsercion) {
+            mejorInsercion = ns;
+        }
+        
+        // Mismo número de búsquedas en ambas escalas, repartidas por toda la lista
+        const int BUSQUEDAS = 200000;
+        int encontrados = 0;
+        inicio = chrono::steady_clock::now();
+        for (int i = 0; i < BUSQUEDAS; i++) {
+            snprintf(nombre, sizeof(nombre), "RENDIMIENTO-F%06d", (int)((i * 7919LL) % sensores));
+            if (lista->buscar(nombre) != 0) {
+                encontrados = encontrados + 1;
+            }
+        }
+        ns = nanosegundosDesde(inicio) / BUSQUEDAS;
+        if (encontrados == BUSQUEDAS && (mejorBusqueda < 0 || ns < mejorBusqueda)) {
+            mejorBusqueda = ns;
+        }
+        
+        inicio = chrono::steady_clock::now();
+        delete lista;
+        ns = nanosegundosDesde(inicio) / sensores;
+        if (mejorLiberacion < 0 || ns < mejorLiberacion) {
+            mejorLiberacion = ns;
+        }
+    }
+    
+    delete[] creados;
+    anotar(insercion, mejorInsercion, sensores);
+    anotar(busqueda, mejorBusqueda, 200000);
+    anotar(liberacion, mejorLiberacion, sensores);
+}
+
+void PruebasRendimiento::medirAltasBajas(int sensores, const char* altas, const char* bajas) {
+    char nombre[32];
+    SensorBase** creados = new SensorBase*[sensores];
+    int* ids = new int[sensores];
+    double mejorAltas = -1.0;
+    double mejorBajas = -1.0;
+    
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        for (int i = 0; i < sensores; i++) {
+            snprintf(nombre, sizeof(nombre), "RENDIMIENTO-A%06d", i);
+            creados[i] = new SensorTemperatura(nombre);
+            ids[i] = creados[i]->obtenerId();
+        }
+        
+        ListaGeneral lista;
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        for (int i = 0; i < sensores; i++) {
+            lista.insertar(creados[i]);
+        }
+        lista.publicar();
+        double ns = nanosegundosDesde(inicio) / sensores;
+        if (lista.leerDirectorio()->tamano() == sensores && (mejorAltas < 0 || ns < mejorAltas)) {
+            mejorAltas = ns;
+        }
+        
+        // Bajas en orden de alta: el costo por baja a 100k no se dispara
+        // por fallos de caché, solo si eliminarPorId deja de ser O(1)
+        int eliminados = 0;
+        inicio = chrono::steady_clock::now();
+        for (int i = 0; i < sensores; i++) {
+            if (lista.eliminarPorId(ids[i], 0)) {
+                eliminados = eliminados + 1;
+            }
+        }
+        lista.publicar();
+        ns = nanosegundosDesde(inicio) / sensores;
+        if (eliminados == sensores && (mejorBajas < 0 || ns < mejorBajas)) {
+            mejorBajas = ns;
+        }
+    }
+    
+    delete[] ids;
+    delete[] creados;
+    anotar(altas, mejorAltas, sensores);
+    anotar(bajas, mejorBajas, sensores);
+}
+
+void PruebasRendimiento::medirInterpretacion() {
+    const int SENSORES = 1000;
+    const int LINEAS = 1000000;
+    char nombre[32];
+    
+    ListaGeneral lista;
+    lista.iniciarCargaMasiva();
+    for (int i = 0; i < SENSORES; i++) {
+        snprintf(nombre, sizeof(nombre), "RENDIMIENTO-L%04d", i);
+        lista.insertar(new SensorTemperatura(nombre));
+    }
+    lista.terminarCargaMasiva();
+    shared_ptr<const DirectorioSensores> directorio = lista.leerDirectorio();
+    
+    // Las líneas se arman antes: solo se mide interpretar
+    const int DISTINTAS = 4096;
+    char (*lineas)[64] = new char[DISTINTAS][64];
+    for (int i = 0; i < DISTINTAS; i++) {
+        snprintf(lineas[i], sizeof(lineas[i]), "TEMP:RENDIMIENTO-L%04d:%d.%d#%d", i % SENSORES, 20 + i % 15, i % 10, i);
+    }
+    
+    double mejor = -1.0;
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        LecturaEntrante lectura;
+        int validas = 0;
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        for (int i = 0; i < LINEAS; i++) {
+            if (LectorIngesta::interpretar(lineas[i % DISTINTAS], *directorio, lectura) > 0) {
+                validas = validas + 1;
+            }
+        }
+        double ns = nanosegundosDesde(inicio) / LINEAS;
+        if (validas == LINEAS && (mejor < 0 || ns < mejor)) {
+            mejor = ns;
+        }
+    }
+    
+    delete[] lineas;
+    anotar("interpretar_1m", mejor, LINEAS);
+}
+
+void PruebasRendimiento::medirImportacion() {
+    const int SENSORES = 1000;
+    const int LINEAS = 1000000;
+    const char* RUTA = "rendimiento_captura.txt";
+    
+    // La captura se escribe antes: se mide mapear, interpretar y fusionar
+    ofstream captura(RUTA, ios::trunc);
+    char linea[64];
+    for (int i = 0; i < LINEAS; i++) {
+        int sensor = (int)((i * 7919LL) % SENSORES);
+        if (sensor % 2 == 0) {
+            snprintf(linea, sizeof(linea), "TEMP:RENDIMIENTO-I%04d:%d.%d\n", sensor, 20 + i % 15, i % 10);
+        } else {
+            snprintf(linea, sizeof(linea), "PRES:RENDIMIENTO-I%04d:%d\n", sensor, 1000 + i % 50);
+        }
+        captura << linea;
+    }
+    captura.close();
+    
+    double mejor = -1.0;
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        ListaGeneral lista;
+        ImportadorCapturas importador(&lista, 0, 0, 0);
+        ResultadoImportacion resultado;
+        
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        bool leido = importador.importar(RUTA, 0, resultado);
+        double ns = nanosegundosDesde(inicio) / LINEAS;
+        if (leido && resultado.lecturas == LINEAS && (mejor < 0 || ns < mejor)) {
+            mejor = ns;
+        }
+    }
+    
+    remove(RUTA);
+    anotar("importar_1m", mejor, LINEAS);
+}
+
+void PruebasRendimiento::medirManifiesto(int sensores, const char* nombre) {
+    const char* RUTA = "rendimiento_manifiesto.txt";
+    
+    ofstream manifiesto(RUTA, ios::trunc);
+    manifiesto << "# TIPO,NOMBRE,GRUPO,LECTURAS\n";
+    char linea[160];
+    for (int i = 0; i < sensores; i++) {
+        if (i % 2 == 0) {
+            snprintf(linea, sizeof(linea), "TEMP,RENDIMIENTO-M%06d,ZONA-%02d,20.5 21 21.5 22 22.5 23 23.5 24\n", i, i % 64);
+        } else {
+            snprintf(linea, sizeof(linea), "PRES,RENDIMIENTO-M%06d,ZONA-%02d,1000 1001 1002 1003 1004 1005 1006 1007\n", i, i % 64);
+        }
+        manifiesto << linea;
+    }
+    manifiesto.close();
+    
+    double mejor = -1.0;
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        ListaGeneral lista;
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        int creados = lista.cargarManifiesto(RUTA, 0);
+        double ns = nanosegundosDesde(inicio) / sensores;
+        if (creados == sensores && (mejor < 0 || ns < mejor)) {
+            mejor = ns;
+        }
+    }
+    
+    remove(RUTA);
+    anotar(nombre, mejor, sensores);
+}
+
+void PruebasRendimiento::medirCierre(int lecturasPorSensor, const char* liberacion, const char* rapido) {
+    const int SENSORES = 1000;
+    const int LOTE = 256;
+    char nombre[32];
+    float valores[LOTE];
+    for (int i = 0; i < LOTE; i++) {
+        valores[i] = 20.0f + (i % 100) / 10.0f;
+    }
+    SensorTemperatura** creados = new SensorTemperatura*[SENSORES];
+    double mejorLiberacion = -1.0;
+    double mejorRapido = -1.0;
+    
+    for (int intento = 0; intento < 2 * INTENTOS; intento++) {
+        bool cierreRapido = (intento % 2 == 1);
+        ListaGeneral* lista = new ListaGeneral();
+        lista->iniciarCargaMasiva();
+        for (int i = 0; i < SENSORES; i++) {
+            snprintf(nombre, sizeof(nombre), "RENDIMIENTO-C%04d", i);
+            creados[i] = new SensorTemperatura(nombre);
+            creados[i]->fijarPresupuesto(sinLimite());
+            for (int k = 0; k < lecturasPorSensor; k += LOTE) {
+                creados[i]->registrarLote(valores, min(LOTE, lecturasPorSensor - k));
+            }
+            lista->insertar(creados[i]);
+        }
+        lista->terminarCargaMasiva();
+        lista->fijarCierreRapido(cierreRapido);
+        
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        delete lista;
+        double ns = nanosegundosDesde(inicio);
+        
+        if (cierreRapido) {
+            // Aquí el proceso no termina: los sensores se liberan fuera de
+            // la medición (solo quedan los nodos de la lista, pocos bytes)
+            for (int i = 0; i < SENSORES; i++) {
+                delete creados[i];
+            }
+            ns = ns / SENSORES;
+            if (mejorRapido < 0 || ns < mejorRapido) {
+                mejorRapido = ns;
+            }
+        } else {
+            ns = ns / ((double)SENSORES * lecturasPorSensor);
+            if (mejorLiberacion < 0 || ns < mejorLiberacion) {
+                mejorLiberacion = ns;
+            }
+        }
+    }
+    
+    delete[] creados;
+    anotar(liberacion, mejorLiberacion, (long long)SENSORES * lecturasPorSensor);
+    anotar(rapido, mejorRapido, SENSORES);
+}
+
+/**
+ * @brief Llena una ListaSensor y la recorre con iteradores
+ * @param insercion Mejor ns por lectura al insertar (entrada y salida)
+ * @param recorrido Mejor ns por lectura al recorrer (entrada y salida)
+ * @return Bytes de nodos por lectura
+ */
+template <int N>
+static double medirLista(int lecturas, double& insercion, double& recorrido) {
+    double bytes = 0.0;
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        ListaSensor<float, N> lista;
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        for (int i = 0; i < lecturas; i++) {
+            lista.insertar(20.0f + (i % 1000) / 100.0f);
+        }
+        double ns = nanosegundosDesde(inicio) / lecturas;
+        if (insercion < 0 || ns < insercion) {
+            insercion = ns;
+        }
+        
+        double suma = 0.0;
+        int vistas = 0;
+        inicio = chrono::steady_clock::now();
+        for (typename ListaSensor<float, N>::iterador it = lista.begin(); it != lista.end(); ++it) {
+            suma = suma + *it;
+            vistas = vistas + 1;
+        }
+        ns = nanosegundosDesde(inicio) / lecturas;
+        // La suma se compara para que el recorrido no se elimine
+        if (vistas == lecturas && suma > 0 && (recorrido < 0 || ns < recorrido)) {
+            recorrido = ns;
+        }
+        bytes = (double)lista.bytesUsados() / lecturas;
+    }
+    return bytes;
+}
+
+void PruebasRendimiento::medirListas() {
+    const int LECTURAS = 1000000;
+    double insercionClasica = -1.0;
+    double recorridoClasica = -1.0;
+    double insercionDesenrollada = -1.0;
+    double recorridoDesenrollada = -1.0;
+    
+    double bytesClasica = medirLista<1>(LECTURAS, insercionClasica, recorridoClasica);
+    double bytesDesenrollada = medirLista<BloqueLineaCache<float>::LECTURAS>(LECTURAS, insercionDesenrollada,
+                                                                             recorridoDesenrollada);
+    
+    anotar("lista_clas_1m", insercionClasica, LECTURAS);
+    anotar("lista_des_1m", insercionDesenrollada, LECTURAS);
+    anotar("recorrer_clas_1m", recorridoClasica, LECTURAS);
+    anotar("recorrer_des_1m", recorridoDesenrollada, LECTURAS);
+    anotar("bytes_lista_clas", bytesClasica, LECTURAS);
+    anotar("bytes_lista_des", bytesDesenrollada, LECTURAS);
+}
+
+void PruebasRendimiento::medirConsultas() {
+    const int SENSORES = 1000;
+    const int LECTURAS = 1000;
+    const long long TOTAL = (long long)SENSORES * LECTURAS;
+    char nombre[32];
+    float valores[LECTURAS];
+    for (int i = 0; i < LECTURAS; i++) {
+        valores[i] = 20.0f + (i % 100) / 10.0f;
+    }
+    
+    ListaGeneral lista;
+    lista.iniciarCargaMasiva();
+    for (int i = 0; i < SENSORES; i++) {
+        snprintf(nombre, sizeof(nombre), "RENDIMIENTO-Q%04d", i);
+        SensorTemperatura* sensor = new SensorTemperatura(nombre);
+        sensor->fijarPresupuesto(sinLimite());
+        sensor->registrarLote(valores, LECTURAS);
+        lista.insertar(sensor);
+    }
+    lista.terminarCargaMasiva();
+    
+    const ModoConsulta MODOS[3] = { CONSULTA_SERIE, CONSULTA_BLOQUES, CONSULTA_PARALELA };
+    const char* NOMBRES[3] = { "consulta_serie", "consulta_bloques", "consulta_par" };
+    double mejor[3] = { -1.0, -1.0, -1.0 };
+    long long esperado = -1;
+    
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        for (int m = 0; m < 3; m++) {
+            ConsultasFlota consultas(&lista, MODOS[m]);
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            ResumenLecturas resumen = consultas.resumir(SENSOR_TEMPERATURA);
+            long long sobre = consultas.contarSobreUmbral(SENSOR_TEMPERATURA, 25.0);
+            double ns = nanosegundosDesde(inicio) / TOTAL;
+            
+            // Todos los modos deben ver las mismas lecturas
+            if (esperado < 0) {
+                esperado = sobre;
+            }
+            if (resumen.cantidad == TOTAL && sobre == esperado && (mejor[m] < 0 || ns < mejor[m])) {
+                mejor[m] = ns;
+            }
+        }
+    }
+    
+    for (int m = 0; m < 3; m++) {
+        anotar(NOMBRES[m], mejor[m], TOTAL);
+    }
+}
+
+/**
+ * @brief Productor de medirConcurrencia: inserta su parte en la lista compartida
+ */
+static void producir(ListaSensorConcurrente<float>* lista, int inserciones, const atomic<bool>* salida) {
+    while (!salida->load()) {
+        this_thread::yield();
+    }
+    for (int i = 0; i < inserciones; i++) {
+        lista->insertar(20.0f + (i % 1000) / 100.0f);
+    }
+}
+
+void PruebasRendimiento::medirConcurrencia(int productores, const char* nombre) {
+    const int INSERCIONES = 1000000;
+    int porProductor = INSERCIONES / productores;
+    thread* hilos = new thread[productores];
+    
+    double mejor = -1.0;
+    for (int intento = 0; intento < INTENTOS; intento++) {
+        ListaSensorConcurrente<float> lista;
+        atomic<bool> salida(false);
+        for (int p = 0; p < productores; p++) {
+            hilos[p] = thread(producir, &lista, porProductor, &salida);
+        }
+        
+        // Se mide desde que todos arrancan juntos hasta que el último termina
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        salida.store(true);
+        for (int p = 0; p < productores; p++) {
+            hilos[p].join();
+        }
+        double ns = nanosegundosDesde(inicio) / ((double)porProductor * productores);
+        
+        if (lista.contarElementos() == porProductor * productores && (mejor < 0 || ns < mejor)) {
+            mejor = ns;
+        }
+    }
+    
+    delete[] hilos;
+    anotar(nombre, mejor, (long long)porProductor * productores);
+}
+
+void PruebasRendimiento::ejecutar() {
+    bool bitacora = Bitacora::activar(false);
+    
+    // procesarLectura y los destructores escriben en cout: se descarta
+    streambuf* salida = cout.rdbuf(0);
+    
+    medirIngesta(1000, "ingesta_1k");
+    medirIngesta(1000000, "ingesta_1m");
+    medirIngestaConReportes();
+    medirProcesamiento();
+    medirDespacho();
+    medirFlota(1000, "insertar_1k", "buscar_1k", "liberar_1k");
+    medirFlota(100000, "insertar_100k", "buscar_100k", "liberar_100k");
+    medirAltasBajas(1000, "alta_uno_1k", "baja_uno_1k");
+    medirAltasBajas(100000, "alta_uno_100k", "baja_uno_100k");
+    medirInterpretacion();
+    medirImportacion();
+    medirManifiesto(1000, "manifiesto_1k");
+    medirManifiesto(100000, "manifiesto_100k");
+    medirManifiesto(1000000, "manifiesto_1m");
+    medirCierre(100, "liberar_hist_100", "cierre_rap_100");
+    medirCierre(10000, "liberar_hist_10k", "cierre_rap_10k");
+    medirListas();
+    medirConsultas();
+    medirConcurrencia(1, "concurr_1p");
+    medirConcurrencia(2, "concurr_2p");
+    medirConcurrencia(4, "concurr_4p");
+    medirConcurrencia(8, "concurr_8p");
+    medirConcurrencia(16, "concurr_16p");
+    
+    cout.rdbuf(salida);
+    cout.clear();
+    Bitacora::activar(bitacora);
+}
+
+int PruebasRendimiento::comparar(const char* rutaBase) const {
+    ifstream archivo(rutaBase);
+    if (!archivo.is_open()) {
+        cout << "[Rendimiento] No se pudo leer la linea base " << rutaBase << endl;
+        return -1;
+    }
+    
+    LimiteRendimiento limites[MAX_MEDICIONES];
+    int cantidadLimites = 0;
+    char linea[256];
+    while (archivo.getline(linea, sizeof(linea)) && cantidadLimites < MAX_MEDICIONES) {
+        LimiteRendimiento limite;
+        if (linea[0] == '#' || sscanf(linea, "%31s %lf %lf", limite.nombre, &limite.nsPorOperacion, &limite.tolerancia) != 3) {
+            continue;
+        }
+        limites[cantidadLimites] = limite;
+        cantidadLimites = cantidadLimites + 1;
+    }
+    
+    int regresiones = 0;
+    char fila[160];
+    cout << "\n--- Rendimiento frente a " << rutaBase << " ---" << endl;
+    cout << "carga              medido ns/op   base ns/op   limite ns/op  estado" << endl;
+    for (int i = 0; i < cantidad; i++) {
+        const MedicionRendimiento& m = mediciones[i];
+        const LimiteRendimiento* limite = 0;
+        for (int k = 0; k < cantidadLimites; k++) {
+            if (strcmp(limites[k].nombre, m.nombre) == 0) {
+                limite = &limites[k];
+            }
+        }
+        
+        if (limite == 0) {
+            snprintf(fila, sizeof(fila), "%-18s %13.1f %12s %14s  SIN BASE", m.nombre, m.nsPorOperacion, "-", "-");
+        } else {
+            double maximo = limite->nsPorOperacion * limite->tolerancia;
+            bool regresion = m.nsPorOperacion < 0 || m.nsPorOperacion > maximo;
+            if (regresion) {
+                regresiones = regresiones + 1;
+            }
+            snprintf(fila, sizeof(fila), "%-18s %13.1f %12.1f %14.1f  %s", m.nombre, m.nsPorOperacion,
+                     limite->nsPorOperacion, maximo, regresion ? "REGRESION" : "ok");
+        }
+        cout << fila << endl;
+    }
+    
+    // Crecimiento: independiente de la máquina
+    const char* escalas[][2] = {
+        { "ingesta_1k", "ingesta_1m" },
+        { "insertar_1k", "insertar_100k" },
+        { "buscar_1k", "buscar_100k" },
+        { "alta_uno_1k", "alta_uno_100k" },
+        { "baja_uno_1k", "baja_uno_100k" },
+        { "manifiesto_1k", "manifiesto_100k" },
+        { "manifiesto_100k", "manifiesto_1m" },
+        { "liberar_hist_100", "liberar_hist_10k" },
+        { "cierre_rap_100", "cierre_rap_10k" },
+        { "concurr_1p", "concurr_16p" }
+    };
+    const int CANTIDAD_ESCALAS = (int)(sizeof(escalas) / sizeof(escalas[0]));
+    cout << "\nCrecimiento del costo por operacion (maximo " << ESCALA_MAXIMA << "x):" << endl;
+    for (int i = 0; i < CANTIDAD_ESCALAS; i++) {
+        double pequena = medido(escalas[i][0]);
+        double grande = medido(escalas[i][1]);
+        double factor = (pequena > 0) ? grande / pequena : -1.0;
+        bool regresion = factor < 0 || factor > ESCALA_MAXIMA;
+        if (regresion) {
+            regresiones = regresiones + 1;
+        }
+        snprintf(fila, sizeof(fila), "%-16s -> %-16s %6.2fx  %s", escalas[i][0], escalas[i][1], factor,
+                 regresion ? "REGRESION" : "ok");
+        cout << fila << endl;
+    }
+    
+    // Despacho: la pasada por tipo no puede costar lo mismo que la vtable
+    double porTipo = medido("proc_tipo_10k");
+    double porVirtual = medido("proc_virtual_10k");
+    bool despachoLento = porTipo < 0 || porVirtual < 0 || porTipo >= porVirtual;
+    if (despachoLento) {
+        regresiones = regresiones + 1;
+    }
+    snprintf(fila, sizeof(fila), "\nDespacho: %-16s %8.1f < %-16s %8.1f  %s", "proc_tipo_10k", porTipo,
+             "proc_virtual_10k", porVirtual, despachoLento ? "REGRESION" : "ok");
+    cout << fila << endl;
+    
+    cout << "\n[Rendimiento] " << regresiones << " regresion(es)." << endl;
+    return regresiones;
+}
+
+bool PruebasRendimiento::guardar(const char* rutaBase, double tolerancia) const {
+    ofstream archivo(rutaBase);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    
+    archivo << "# Linea base de SistemaIoT --rendimiento\n";
+    archivo << "# carga  ns_por_operacion  tolerancia (falla si medido > base * tolerancia)\n";
+    char fila[128];
+    for (int i = 0; i < cantidad; i++) {
+        snprintf(fila, sizeof(fila), "%-16s %10.1f %5.1f\n", mediciones[i].nombre, mediciones[i].nsPorOperacion, tolerancia);
+        archivo << fila;
+    }
+    return true;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file PruebasRendimiento.h
+ * @brief Cargas de trabajo fijas comparadas contra una línea base guardada
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef PRUEBAS_RENDIMIENTO_H
+#define PRUEBAS_RENDIMIENTO_H
+
+/**
+ * @brief Cargas que caben en una corrida (y en la línea base)
+ */
+#define MAX_MEDICIONES 48
+
+/**
+ * @brief Resultado de una carga de trabajo
+ */
+struct MedicionRendimiento {
+    char nombre[32];        ///< Identificador de la carga (igual que en la línea base)
+    double nsPorOperacion;  ///< Mejor costo observado por operación
+    long long operaciones;  ///< Operaciones por repetición
+};
+
+/**
+ * @brief Costo esperado de una carga según la línea base
+ */
+struct LimiteRendimiento {
+    char nombre[32];        ///< Identificador de la carga
+    double nsPorOperacion;  ///< Costo de referencia
+    double tolerancia;      ///< Factor permitido sobre la referencia
+};
+
+/**
+ * @class PruebasRendimiento
+ * @brief Detecta regresiones de rendimiento en las operaciones centrales
+ *
+ * Ejecuta cargas fijas (ingesta, p99 de ingesta con lectores
+ * concurrentes, procesamiento, despacho por tipo frente a virtual,
+ * inserción y búsqueda de sensores, altas y bajas de uno en uno,
+ * liberación de la flota, interpretación de líneas, importación de
+ * capturas, arranque desde manifiesto, cierre, ListaSensor clásica
+ * frente a desenrollada, consultas de flota en serie frente a en
+ * paralelo e inserción en ListaSensorConcurrente con 1 a 16
+ * productores) y toma el mejor de varios intentos para reducir el ruido.
+ * Cada carga se compara con el archivo de línea base:
+ *
+ *   # carga  ns_por_operacion  tolerancia
+ *   ingesta_1k  350  3.0
+ *
+ * y falla si su costo supera referencia * tolerancia. Además comprueba
+ * el crecimiento: el costo por operación a 1M lecturas o 100k sensores
+ * no puede superar ESCALA_MAXIMA veces el de 1k (ni el de 16
+ * productores el de uno solo). Eso no depende de la
+ * máquina y delata un insertar o un buscar que se vuelva lineal. Por la
+ * misma razón, el despacho por tipo debe salir más barato que el virtual
+ * medido en la misma corrida.
+ */
+class PruebasRendimiento {
+private:
+    MedicionRendimiento mediciones[MAX_MEDICIONES]; ///< Resultados de la corrida
+    int cantidad;                       ///< Mediciones ocupadas
+    
+    /**
+     * @brief Guarda una medición
+     */
+    void anotar(const char* nombre, double nsPorOperacion, long long operaciones);
+    
+    /**
+     * @brief Costo medido de una carga
+     * @return ns por operación (-1 si no se midió)
+     */
+    double medido(const char* nombre) const;
+    
+    /**
+     * @brief Registra lecturas en un sensor sin límite de retención
+     */
+    void medirIngesta(int lecturas, const char* nombre);
+    
+    /**
+     * @brief Latencia p99 de registrarLote mientras otro hilo reporta
+     *
+     * Un hilo lee la instantánea y recorre su historial sin parar; el
+     * principal registra lotes de 64 con el historial lleno (cada lote
+     * desaloja 64). Se anota el p99 por lote dividido por lectura: mide
+     * lo que cuesta publicar, no la media.
+     */
+    void medirIngestaConReportes();
+    
+    /**
+     * @brief procesarTodos sobre 10k sensores con datos nuevos
+     */
+    void medirProcesamiento();
+    
+    /**
+     * @brief Despacho por tipo frente a llamada virtual en una flota mixta
+     *
+     * Temperatura y presión intercaladas (10k): procesarTodos, que
+     * recorre los pendientes de cada tipo con la llamada calificada,
+     * contra un recorrido de la lista que llama a procesarLectura por la
+     * vtable. Ambos hacen el mismo trabajo; comparar exige que el primero
+     * salga más barato.
+     */
+    void medirDespacho();
+    
+    /**
+     * @brief Inserta, busca por nombre y libera una flota de sensores
+     */
+    void medirFlota(int sensores, const char* insercion, const char* busqueda, const char* liberacion);
+    
+    /**
+     * @brief Altas y bajas de sensores de una en una, fuera de carga masiva
+     *
+     * Es el camino del menú y de cargarManifiesto sin iniciarCargaMasiva:
+     * cada insertar o eliminarPorId por separado y una sola publicación
+     * al final, como haría el ciclo principal en su siguiente pasada.
+     */
+    void medirAltasBajas(int sensores, const char* altas, const char* bajas);
+    
+    /**
+     * @brief LectorIngesta::interpretar sobre líneas con nombre y secuencia
+     */
+    void medirInterpretacion();
+    
+    /**
+     * @brief ImportadorCapturas::importar sobre 1M líneas de 1000 sensores con nombre
+     */
+    void medirImportacion();
+    
+    /**
+     * @brief Arranque desde un manifiesto: cargarManifiesto por sensor
+     *
+     * Mitad temperatura y mitad presión, con grupo y ocho lecturas cada
+     * uno, como lo deja guardarPuntoControl. Se mide hasta 1M sensores:
+     * el arranque de una flota grande no debe crecer más que lineal.
+     */
+    void medirManifiesto(int sensores, const char* nombre);
+    
+    /**
+     * @brief Cierre de una flota de 1000 sensores según crece su historial
+     *
+     * La liberación en cascada se anota por lectura: debe seguir lineal.
+     * El cierre rápido (el de la opción Salir) se anota por sensor y no
+     * debe depender del historial.
+     */
+    void medirCierre(int lecturasPorSensor, const char* liberacion, const char* rapido);
+    
+    /**
+     * @brief ListaSensor clásica (N = 1) frente a desenrollada (bloque de línea de caché)
+     *
+     * Con 1M lecturas float: inserción y recorrido con iteradores en ns
+     * por lectura, y memoria de nodos en bytes por lectura (las filas
+     * bytes_lista_*, que no dependen de la máquina).
+     */
+    void medirListas();
+    
+    /**
+     * @brief ConsultasFlota en serie, por bloques y en paralelo
+     *
+     * 1000 sensores de temperatura con 1000 lecturas cada uno: resumir
+     * más contarSobreUmbral, en ns por lectura. Si los tres modos no
+     * dan el mismo resultado no se anota tiempo.
+     */
+    void medirConsultas();
+    
+    /**
+     * @brief Inserción en ListaSensorConcurrente con varios productores
+     *
+     * 1M inserciones repartidas entre 'productores' hilos que arrancan a
+     * la vez, en ns por inserción de reloj de pared. Mide lo que cuesta
+     * la contención sobre la cola, el contador y la suma.
+     */
+    void medirConcurrencia(int productores, const char* nombre);
+    
+public:
+    /**
+     * @brief Factor máximo entre el costo por operación a gran y a pequeña escala
+     */
+    static const int ESCALA_MAXIMA = 8;
+    
+    /**
+     * @brief Constructor (sin mediciones)
+     */
+    PruebasRendimiento();
+    
+    /**
+     * @brief Ejecuta todas las cargas (con la bitácora y la salida silenciadas)
+     */
+    void ejecutar();
+    
+    /**
+     * @brief Compara con la línea base e imprime la tabla de resultados
+     * @param rutaBase Archivo de línea base
+     * @return Número de regresiones (0 = todo en orden, -1 si no se pudo leer)
+     */
+    int comparar(const char* rutaBase) const;
+    
+    /**
+     * @brief Escribe lo medido como línea base nueva
+     * @param rutaBase Archivo a escribir
+     * @param tolerancia Factor permitido para cada carga
+     * @return false si no se pudo escribir
+     */
+    bool guardar(const char* rutaBase, double tolerancia) const;
+};
+
+#endif // PRUEBAS_RENDIMIENTO_H
@@ -0,0 +1,51 @@
+/**
+ * @file RegistroCambios.cpp
+ * @brief Implementación del registro de sensores modificados
+ */
+
+#include "RegistroCambios.h"
+
+RegistroCambios::RegistroCambios() {
+}
+
+RegistroCambios& RegistroCambios::global() {
+    static RegistroCambios registro;
+    return registro;
+}
+
+void RegistroCambios::marcar(int id, TipoSensor tipo) {
+    estados.extender(id + 1, FUERA);
+    
+    if (estados[id] == FUERA) {
+        pendientes[tipo].agregar(id);
+    }
+    estados[id] = SUCIO;
+}
+
+void RegistroCambios::desmarcar(int id) {
+    if (id < estados.tamano() && estados[id] == SUCIO) {
+        estados[id] = LIMPIO;
+    }
+}
+
+bool RegistroCambios::estaMarcado(int id) const {
+    return id < estados.tamano() && estados[id] == SUCIO;
+}
+
+int RegistroCambios::cantidadPendientes(TipoSensor tipo) const {
+    return pendientes[tipo].tamano();
+}
+
+int RegistroCambios::pendiente(TipoSensor tipo, int indice) const {
+    return pendientes[tipo][indice];
+}
+
+void RegistroCambios::limpiar() {
+    // Solo se desmarcan los pendientes: O(sensores modificados)
+    for (int t = 0; t < TIPOS; t++) {
+        for (int i = 0; i < pendientes[t].tamano(); i++) {
+            estados[pendientes[t][i]] = FUERA;
+        }
+        pendientes[t].limpiar();
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * @file RegistroCambios.h
+ * @brief Lista de trabajo de sensores con lecturas nuevas (sucios)
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef REGISTRO_CAMBIOS_H
+#define REGISTRO_CAMBIOS_H
+
+#include "ArregloDinamico.h"
+#include "SensorBase.h"
+
+/**
+ * @class RegistroCambios
+ * @brief Registra qué sensores recibieron datos desde el último procesamiento
+ *
+ * Usa los IDs densos de TablaNombres: un arreglo de estados indica si el
+ * sensor ya está en la lista de pendientes, de modo que marcar es O(1) y
+ * un sensor aparece una sola vez en la lista aunque se procese y vuelva
+ * a modificarse antes de la siguiente pasada completa.
+ *
+ * Hay una lista de pendientes por tipo de sensor: quien marca ya conoce
+ * su tipo, y así la pasada de procesamiento recorre cada tipo de corrido
+ * sin preguntarle el tipo a cada sensor.
+ */
+class RegistroCambios {
+public:
+    /**
+     * @brief Número de listas de pendientes (una por TipoSensor)
+     */
+    enum { TIPOS = SENSOR_OTRO + 1 };
+    
+private:
+    ArregloDinamico<int> pendientes[TIPOS]; ///< IDs con lecturas sin procesar, por tipo
+    /**
+     * @brief Estado de un ID respecto a la lista de trabajo
+     */
+    enum Estado {
+        FUERA,  ///< No está en la lista de trabajo
+        SUCIO,  ///< En la lista, con lecturas sin procesar
+        LIMPIO  ///< En la lista, pero ya procesado
+    };
+    
+    ArregloDinamico<Estado> estados; ///< Estado de cada ID
+    
+    RegistroCambios();
+    RegistroCambios(const RegistroCambios&);
+    RegistroCambios& operator=(const RegistroCambios&);
+    
+public:
+    /**
+     * @brief Obtiene el registro global del proceso
+     * @return Referencia al registro único
+     */
+    static RegistroCambios& global();
+    
+    /**
+     * @brief Marca un sensor como modificado
+     * @param id ID del sensor en TablaNombres
+     * @param tipo Tipo concreto del sensor (elige su lista de pendientes)
+     */
+    void marcar(int id, TipoSensor tipo);
+    
+    /**
+     * @brief Quita la marca de un sensor procesado fuera de una pasada completa
+     *
+     * El ID permanece en la lista de trabajo pero se ignora al recorrerla.
+     * @param id ID del sensor
+     */
+    void desmarcar(int id);
+    
+    /**
+     * @brief Indica si un sensor tiene lecturas sin procesar
+     * @param id ID del sensor
+     * @return true si está pendiente
+     */
+    bool estaMarcado(int id) const;
+    
+    /**
+     * @brief Número de sensores pendientes de un tipo
+     * @param tipo Tipo de sensor
+     * @return Tamaño de la lista de trabajo del tipo
+     */
+    int cantidadPendientes(TipoSensor tipo) const;
+    
+    /**
+     * @brief Obtiene un ID de la lista de trabajo de un tipo
+     * @param tipo Tipo de sensor
+     * @param indice Posición en la lista (0 .. cantidadPendientes(tipo)-1)
+     * @return ID del sensor pendiente
+     */
+    int pendiente(TipoSensor tipo, int indice) const;
+    
+    /**
+     * @brief Vacía la lista de trabajo tras una pasada de procesamiento
+     */
+    void limpiar();
+};
+
+#endif // REGISTRO_CAMBIOS_H
@@ -0,0 +1,227 @@
+/**
+ * @file RenderizadorReporte.cpp
+ * @brief Implementación de los reportes en texto, JSON y CSV
+ */
+
+#include "RenderizadorReporte.h"
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include <cmath>
+
+using namespace std;
+
+RenderizadorReporte::RenderizadorReporte(BuferSalida& destino, const OpcionesReporte& elegidas) {
+    salida = &destino;
+    opciones = elegidas;
+    if (opciones.desde < 0) {
+        opciones.desde = 0;
+    }
+    if (opciones.maximo < 0) {
+        opciones.maximo = 0;
+    }
+}
+
+const char* RenderizadorReporte::nombreTipo(TipoSensor tipo) {
+    switch (tipo) {
+        case SENSOR_TEMPERATURA:
+            return "Temperatura";
+        case SENSOR_PRESION:
+            return "Presion";
+        default:
+            return "Generico";
+    }
+}
+
+void RenderizadorReporte::pagina(int total, int& inicio, int& fin) const {
+    inicio = opciones.desde < total ? opciones.desde : total;
+    fin = total;
+    if (opciones.maximo > 0 && total - inicio > opciones.maximo) {
+        fin = inicio + opciones.maximo;
+    }
+}
+
+template <typename T>
+void RenderizadorReporte::numeroJson(T valor) {
+    if (isfinite((double)valor)) {
+        salida->numero(valor);
+    } else {
+        salida->texto("null");
+    }
+}
+
+void RenderizadorReporte::sensor(SensorBase* sensor, int numero, bool primero) {
+    AgregadosSensor agregados = sensor->obtenerAgregados();
+    
+    if (opciones.formato == REPORTE_JSON) {
+        if (!primero) {
+            salida->caracter(',');
+        }
+        salida->texto("\n  {\"nombre\":");
+        salida->textoJson(sensor->obtenerNombre());
+        salida->texto(",\"tipo\":");
+        salida->textoJson(nombreTipo(agregados.tipo));
+        salida->texto(",\"lecturas\":");
+        salida->numero(agregados.cantidad);
+        salida->texto(",\"promedio\":");
+        numeroJson(agregados.promedio);
+        salida->texto(",\"minimo\":");
+        numeroJson(agregados.minimoHistorico);
+        salida->texto(",\"maximo\":");
+        numeroJson(agregados.maximoHistorico);
+        salida->texto(",\"ultimo\":");
+        numeroJson(agregados.ultimo);
+        salida->texto(",\"resultado\":");
+        numeroJson(agregados.ultimoResultado);
+        salida->texto(",\"anomalias\":");
+        salida->numero(agregados.anomalias);
+        salida->caracter('}');
+    } else if (opciones.formato == REPORTE_CSV) {
+        salida->textoCsv(sensor->obtenerNombre());
+        salida->caracter(',');
+        salida->texto(nombreTipo(agregados.tipo));
+        salida->caracter(',');
+        salida->numero(agregados.cantidad);
+        salida->caracter(',');
+        salida->numero(agregados.promedio);
+        salida->caracter(',');
+        salida->numero(agregados.minimoHistorico);
+        salida->caracter(',');
+        salida->numero(agregados.maximoHistorico);
+        salida->caracter(',');
+        salida->numero(agregados.ultimo);
+        salida->caracter(',');
+        salida->numero(agregados.ultimoResultado);
+        salida->caracter(',');
+        salida->numero(agregados.anomalias);
+        salida->caracter('\n');
+    } else {
+        // Mismo contenido que imprimirInfo
+        const DetectorAnomalias& detector = sensor->obtenerDetector();
+        salida->numero(numero);
+        salida->texto(". Sensor: ");
+        salida->texto(sensor->obtenerNombre());
+        salida->texto(" [Tipo: ");
+        salida->texto(nombreTipo(agregados.tipo));
+        salida->texto("]\nNumero de lecturas: ");
+        salida->numero(agregados.cantidad);
+        salida->texto("\nAnomalias detectadas: ");
+        salida->numero(detector.obtenerAnomalias());
+        salida->texto(" (costo medio ");
+        salida->numero(detector.costoMedioNs());
+        salida->texto(" ns/lectura, maximo ");
+        salida->numero(detector.costoMaximoNs());
+        salida->texto(" ns)\n\n");
+    }
+}
+
+int RenderizadorReporte::sensores(const ListaGeneral& lista) {
+    int total = lista.cantidadSensores();
+    int inicio;
+    int fin;
+    pagina(total, inicio, fin);
+    
+    if (opciones.formato == REPORTE_JSON) {
+        salida->texto("{\"total\":");
+        salida->numero(total);
+        salida->texto(",\"desde\":");
+        salida->numero(inicio);
+        salida->texto(",\"sensores\":[");
+    } else if (opciones.formato == REPORTE_CSV) {
+        salida->texto("nombre,tipo,lecturas,promedio,minimo,maximo,ultimo,resultado,anomalias\n");
+    }
+    
+    int posicion = 0;
+    for (ListaGeneral::iterador it = lista.begin(); it != lista.end() && posicion < fin; ++it) {
+        if (posicion >= inicio) {
+            sensor(*it, posicion + 1, posicion == inicio);
+        }
+        posicion = posicion + 1;
+    }
+    
+    int omitidos = total - (fin - inicio);
+    if (opciones.formato == REPORTE_JSON) {
+        salida->texto("\n],\"omitidos\":");
+        salida->numero(omitidos);
+        salida->texto("}\n");
+    } else if (opciones.formato == REPORTE_TEXTO && omitidos > 0) {
+        salida->texto("(Sensores ");
+        salida->numero(inicio + 1);
+        salida->texto(" a ");
+        salida->numero(fin);
+        salida->texto(" de ");
+        salida->numero(total);
+        salida->texto(")\n");
+    }
+    return fin - inicio;
+}
+
+template <typename T>
+void RenderizadorReporte::lecturas(const char* nombre, const T* valores, int total) {
+    int inicio;
+    int fin;
+    pagina(total, inicio, fin);
+    
+    if (opciones.formato == REPORTE_JSON) {
+        salida->texto("{\"sensor\":");
+        salida->textoJson(nombre);
+        salida->texto(",\"total\":");
+        salida->numero(total);
+        salida->texto(",\"desde\":");
+        salida->numero(inicio);
+        salida->texto(",\"lecturas\":[");
+        for (int i = inicio; i < fin; i++) {
+            if (i > inicio) {
+                salida->caracter(',');
+            }
+            numeroJson(valores[i]);
+        }
+        salida->texto("],\"omitidas\":");
+        salida->numero(total - (fin - inicio));
+        salida->texto("}\n");
+    } else if (opciones.formato == REPORTE_CSV) {
+        salida->texto("sensor,indice,valor\n");
+        for (int i = inicio; i < fin; i++) {
+            salida->textoCsv(nombre);
+            salida->caracter(',');
+            salida->numero(i);
+            salida->caracter(',');
+            salida->numero(valores[i]);
+            salida->caracter('\n');
+        }
+    } else {
+        salida->texto(nombre);
+        salida->texto(": ");
+        salida->numero(total);
+        salida->texto(" lectura(s)");
+        if (fin - inicio < total) {
+            salida->texto(", se muestran ");
+            salida->numero(inicio + 1);
+            salida->texto(" a ");
+            salida->numero(fin);
+        }
+        salida->texto("\n[ ");
+        for (int i = inicio; i < fin; i++) {
+            if (i > inicio) {
+                salida->texto(", ");
+            }
+            salida->numero(valores[i]);
+        }
+        salida->texto(" ]\n");
+    }
+}
+
+int RenderizadorReporte::historial(SensorBase* sensor) {
+    // La instantánea mantiene vivo el bloque mientras se escribe
+    if (sensor->obtenerTipo() == SENSOR_TEMPERATURA) {
+        shared_ptr<const InstantaneaSensor<float> > instantanea = ((SensorTemperatura*)sensor)->obtenerInstantanea();
+        lecturas(sensor->obtenerNombre(), instantanea->historial.datos(), instantanea->historial.tamano());
+        return instantanea->historial.tamano();
+    }
+    if (sensor->obtenerTipo() == SENSOR_PRESION) {
+        shared_ptr<const InstantaneaSensor<int> > instantanea = ((SensorPresion*)sensor)->obtenerInstantanea();
+        lecturas(sensor->obtenerNombre(), instantanea->historial.datos(), instantanea->historial.tamano());
+        return instantanea->historial.tamano();
+    }
+    return -1;
+}
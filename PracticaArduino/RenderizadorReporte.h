@@ -0,0 +1,112 @@
+/**
+ * @file RenderizadorReporte.h
+ * @brief Reportes de sensores e historiales en texto, JSON o CSV
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef RENDERIZADOR_REPORTE_H
+#define RENDERIZADOR_REPORTE_H
+
+#include "BuferSalida.h"
+#include "SensorBase.h"
+
+class ListaGeneral;
+
+/**
+ * @brief Formato de salida del reporte
+ */
+enum FormatoReporte {
+    REPORTE_TEXTO, ///< Legible en pantalla
+    REPORTE_JSON,  ///< Un documento JSON
+    REPORTE_CSV    ///< Una fila por elemento, con encabezado
+};
+
+/**
+ * @brief Qué parte del reporte mostrar
+ */
+struct OpcionesReporte {
+    FormatoReporte formato; ///< Formato de salida
+    int desde;              ///< Primer elemento (sensor o lectura) a mostrar
+    int maximo;             ///< Elementos a mostrar como máximo (0 = todos)
+    
+    /**
+     * @brief Texto completo, sin paginar
+     */
+    OpcionesReporte() {
+        formato = REPORTE_TEXTO;
+        desde = 0;
+        maximo = 0;
+    }
+};
+
+/**
+ * @class RenderizadorReporte
+ * @brief Da formato a sensores e historiales sobre un BuferSalida
+ *
+ * Todo se escribe en el búfer, que vuelca en bloques grandes: un
+ * historial de un millón de lecturas son unas pocas llamadas a write()
+ * en lugar de una por lectura. Con desde/maximo se pagina o se trunca;
+ * el reporte siempre indica el total y cuántos elementos quedaron fuera.
+ *
+ * Los historiales salen de la última instantánea publicada, así que el
+ * reporte no toca las estructuras del hilo de ingesta.
+ */
+class RenderizadorReporte {
+private:
+    BuferSalida* salida;     ///< Donde se escribe
+    OpcionesReporte opciones; ///< Formato y página
+    
+    /**
+     * @brief Rango [inicio, fin) de la página dentro de total elementos
+     */
+    void pagina(int total, int& inicio, int& fin) const;
+    
+    /**
+     * @brief Escribe un número JSON: null si no es finito (JSON no admite NaN ni infinito)
+     */
+    template <typename T>
+    void numeroJson(T valor);
+    
+    /**
+     * @brief Escribe las lecturas de una página de historial
+     */
+    template <typename T>
+    void lecturas(const char* nombre, const T* valores, int total);
+    
+    /**
+     * @brief Escribe un sensor en el formato elegido
+     */
+    void sensor(SensorBase* sensor, int numero, bool primero);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param destino Búfer donde escribir
+     * @param elegidas Formato y página
+     */
+    RenderizadorReporte(BuferSalida& destino, const OpcionesReporte& elegidas);
+    
+    /**
+     * @brief Reporte de los sensores de la lista (en orden de inserción)
+     * @param lista Sensores a reportar
+     * @return Sensores escritos
+     */
+    int sensores(const ListaGeneral& lista);
+    
+    /**
+     * @brief Historial de un sensor de temperatura o presión
+     * @param sensor Sensor a reportar
+     * @return Lecturas del historial (-1 si el tipo no tiene historial publicado)
+     */
+    int historial(SensorBase* sensor);
+    
+    /**
+     * @brief Nombre legible del tipo de sensor
+     * @param tipo Tipo concreto
+     * @return Texto constante
+     */
+    static const char* nombreTipo(TipoSensor tipo);
+};
+
+#endif // RENDERIZADOR_REPORTE_H
@@ -0,0 +1,271 @@
+/**
+ * @file RollupSensor.cpp
+ * @brief Implementación de los resúmenes por minuto y por hora
+ */
+
+#include "RollupSensor.h"
+#include "ContabilidadMemoria.h"
+#include <chrono>
+
+using namespace std;
+
+AnilloCubetas::AnilloCubetas(int cubetasMaximas) {
+    cubetas = 0;
+    capacidad = 0;
+    maximo = cubetasMaximas;
+}
+
+AnilloCubetas::~AnilloCubetas() {
+    if (cubetas != 0) {
+        ContabilidadMemoria::global().liberar(MEMORIA_RESUMENES, bytesUsados());
+    }
+    delete[] cubetas;
+}
+
+void AnilloCubetas::crecer() {
+    long long antes = bytesUsados();
+    CubetaResumen* viejas = cubetas;
+    int viejaCapacidad = capacidad;
+    
+    int nueva = (capacidad == 0) ? 2 : capacidad * 2;
+    bool reubicadas = false;
+    while (!reubicadas) {
+        while (nueva < maximo && maximo % nueva != 0) {
+            nueva = nueva + 1;
+        }
+        if (nueva > maximo) {
+            nueva = maximo;
+        }
+        
+        cubetas = new CubetaResumen[nueva];
+        capacidad = nueva;
+        for (int i = 0; i < capacidad; i++) {
+            cubetas[i].indice = -1;
+        }
+        
+        // Dos intervalos vivos pueden chocar también en la capacidad nueva:
+        // se sigue creciendo (en 'maximo' ya no chocan)
+        reubicadas = true;
+        for (int i = 0; i < viejaCapacidad && reubicadas; i++) {
+            if (viejas[i].indice < 0) {
+                continue;
+            }
+            CubetaResumen& destino = cubetas[viejas[i].indice % capacidad];
+            if (destino.indice >= 0) {
+                reubicadas = false;
+            } else {
+                destino = viejas[i];
+            }
+        }
+        if (!reubicadas) {
+            delete[] cubetas;
+            nueva = capacidad * 2;
+        }
+    }
+    
+    delete[] viejas;
+    ContabilidadMemoria::global().reservar(MEMORIA_RESUMENES, bytesUsados() - antes);
+}
+
+CubetaResumen& AnilloCubetas::ranura(int indice) {
+    if (capacidad == 0) {
+        crecer();
+    }
+    
+    // Ocupada por otro intervalo que el anillo completo aún conservaría
+    while (cubetas[indice % capacidad].indice >= 0 && cubetas[indice % capacidad].indice != indice &&
+           cubetas[indice % capacidad].indice % maximo != indice % maximo) {
+        crecer();
+    }
+    
+    return cubetas[indice % capacidad];
+}
+
+CubetaResumen* AnilloCubetas::buscar(int indice) {
+    if (capacidad == 0 || cubetas[indice % capacidad].indice != indice) {
+        return 0;
+    }
+    return &cubetas[indice % capacidad];
+}
+
+const CubetaResumen* AnilloCubetas::buscar(int indice) const {
+    if (capacidad == 0 || cubetas[indice % capacidad].indice != indice) {
+        return 0;
+    }
+    return &cubetas[indice % capacidad];
+}
+
+long long AnilloCubetas::bytesUsados() const {
+    return (long long)capacidad * sizeof(CubetaResumen);
+}
+
+RollupSensor::RollupSensor() : minutos(MINUTOS_RETENIDOS), horas(HORAS_RETENIDAS) {
+    minutoCrudoAntiguo = -1;
+    ultimoMinuto = -1;
+    crudosHuerfanos = 0;
+}
+
+long long RollupSensor::ahoraMs() {
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void RollupSensor::acumular(CubetaResumen& cubeta, int indice, double valor) {
+    // La ranura guardaba un intervalo que ya salió del anillo: reiniciarla
+    if (cubeta.indice != indice) {
+        cubeta.indice = indice;
+        cubeta.cantidad = 0;
+        cubeta.suma = 0.0;
+        cubeta.minimo = (float)valor;
+        cubeta.maximo = (float)valor;
+        cubeta.crudos = 0;
+    }
+    
+    cubeta.cantidad = cubeta.cantidad + 1;
+    cubeta.suma = cubeta.suma + valor;
+    if (valor < cubeta.minimo) {
+        cubeta.minimo = (float)valor;
+    }
+    if (valor > cubeta.maximo) {
+        cubeta.maximo = (float)valor;
+    }
+}
+
+void RollupSensor::registrar(long long tiempoMs, double valor) {
+    int minuto = (int)(tiempoMs / MS_MINUTO);
+    int hora = (int)(tiempoMs / MS_HORA);
+    
+    // Si la ranura se reutiliza, sus crudos pendientes ya son los más antiguos
+    CubetaResumen& cubetaMinuto = minutos.ranura(minuto);
+    if (cubetaMinuto.indice >= 0 && cubetaMinuto.indice < minuto) {
+        crudosHuerfanos = crudosHuerfanos + cubetaMinuto.crudos;
+        cubetaMinuto.crudos = 0;
+    }
+    
+    acumular(cubetaMinuto, minuto, valor);
+    cubetaMinuto.crudos = cubetaMinuto.crudos + 1;
+    acumular(horas.ranura(hora), hora, valor);
+    
+    if (minutoCrudoAntiguo < 0) {
+        minutoCrudoAntiguo = minuto;
+    }
+    if (minuto > ultimoMinuto) {
+        ultimoMinuto = minuto;
+    }
+}
+
+int RollupSensor::expirarCrudos(long long ahoraMs, long long horizonteMs) {
+    if (minutoCrudoAntiguo < 0 || horizonteMs <= 0) {
+        return 0;
+    }
+    
+    int limite = (int)((ahoraMs - horizonteMs) / MS_MINUTO);
+    int expirados = crudosHuerfanos;
+    crudosHuerfanos = 0;
+    
+    while (minutoCrudoAntiguo < limite) {
+        CubetaResumen* cubeta = minutos.buscar(minutoCrudoAntiguo);
+        if (cubeta != 0) {
+            expirados = expirados + cubeta->crudos;
+            cubeta->crudos = 0;
+        }
+        minutoCrudoAntiguo = minutoCrudoAntiguo + 1;
+    }
+    
+    return expirados;
+}
+
+void RollupSensor::descontarCrudos(int cantidad) {
+    if (minutoCrudoAntiguo < 0) {
+        return;
+    }
+    
+    int huerfanos = crudosHuerfanos;
+    if (huerfanos > cantidad) {
+        huerfanos = cantidad;
+    }
+    crudosHuerfanos = crudosHuerfanos - huerfanos;
+    cantidad = cantidad - huerfanos;
+    
+    int minuto = minutoCrudoAntiguo;
+    
+    while (cantidad > 0 && minuto <= ultimoMinuto) {
+        CubetaResumen* cubeta = minutos.buscar(minuto);
+        if (cubeta != 0) {
+            int quitar = cubeta->crudos;
+            if (quitar > cantidad) {
+                quitar = cantidad;
+            }
+            cubeta->crudos = cubeta->crudos - quitar;
+            cantidad = cantidad - quitar;
+        }
+        minuto = minuto + 1;
+    }
+}
+
+void RollupSensor::combinar(ResultadoRango& resultado, const CubetaResumen& cubeta) {
+    if (resultado.cantidad == 0 || cubeta.minimo < resultado.minimo) {
+        resultado.minimo = cubeta.minimo;
+    }
+    if (resultado.cantidad == 0 || cubeta.maximo > resultado.maximo) {
+        resultado.maximo = cubeta.maximo;
+    }
+    resultado.cantidad = resultado.cantidad + cubeta.cantidad;
+    resultado.suma = resultado.suma + cubeta.suma;
+}
+
+ResultadoRango RollupSensor::consultar(long long desdeMs, long long hastaMs) const {
+    ResultadoRango resultado;
+    resultado.cantidad = 0;
+    resultado.suma = 0.0;
+    resultado.promedio = 0.0;
+    resultado.minimo = 0.0;
+    resultado.maximo = 0.0;
+    resultado.cubetasHora = 0;
+    resultado.cubetasMinuto = 0;
+    resultado.aproximado = false;
+    
+    if (minutoCrudoAntiguo < 0) {
+        return resultado;
+    }
+    
+    long long t = (desdeMs / MS_MINUTO) * MS_MINUTO;
+    
+    while (t < hastaMs) {
+        int hora = (int)(t / MS_HORA);
+        int minuto = (int)(t / MS_MINUTO);
+        const CubetaResumen* cubetaHora = horas.buscar(hora);
+        const CubetaResumen* cubetaMinuto = minutos.buscar(minuto);
+        bool horaCompleta = (t % MS_HORA == 0) && (t + MS_HORA <= hastaMs);
+        // El anillo de minutos solo cubre los últimos MINUTOS_RETENIDOS
+        bool minutoRetenido = (minuto > ultimoMinuto - MINUTOS_RETENIDOS);
+        
+        if (horaCompleta || !minutoRetenido) {
+            // Nivel grueso: la hora completa, o la única resolución que queda
+            if (cubetaHora != 0) {
+                if (!horaCompleta) {
+                    resultado.aproximado = true;
+                }
+                combinar(resultado, *cubetaHora);
+                resultado.cubetasHora = resultado.cubetasHora + 1;
+            }
+            t = (long long)(hora + 1) * MS_HORA;
+        } else {
+            if (cubetaMinuto != 0) {
+                combinar(resultado, *cubetaMinuto);
+                resultado.cubetasMinuto = resultado.cubetasMinuto + 1;
+            }
+            t = t + MS_MINUTO;
+        }
+    }
+    
+    if (resultado.cantidad > 0) {
+        resultado.promedio = resultado.suma / resultado.cantidad;
+    }
+    
+    return resultado;
+}
+
+long long RollupSensor::bytesUsados() const {
+    return minutos.bytesUsados() + horas.bytesUsados();
+}
@@ -0,0 +1,201 @@
+/**
+ * @file RollupSensor.h
+ * @brief Resúmenes incrementales por minuto y por hora de las lecturas de un sensor
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef ROLLUP_SENSOR_H
+#define ROLLUP_SENSOR_H
+
+/**
+ * @brief Resumen de las lecturas de un intervalo de tiempo
+ */
+struct CubetaResumen {
+    double suma;   ///< Suma de las lecturas
+    int indice;    ///< Minuto u hora desde la época Unix (-1 = vacía)
+    int cantidad;  ///< Lecturas en el intervalo
+    float minimo;  ///< Menor lectura
+    float maximo;  ///< Mayor lectura
+    int crudos;    ///< Lecturas del intervalo que siguen en el historial crudo
+};
+
+/**
+ * @brief Resultado de una consulta por rango de tiempo
+ */
+struct ResultadoRango {
+    int cantidad;         ///< Lecturas en el rango
+    double suma;          ///< Suma de las lecturas
+    double promedio;      ///< Promedio (0 si no hay lecturas)
+    double minimo;        ///< Menor lectura
+    double maximo;        ///< Mayor lectura
+    int cubetasHora;      ///< Cubetas horarias usadas
+    int cubetasMinuto;    ///< Cubetas por minuto usadas
+    bool aproximado;      ///< true si se usaron horas que exceden el rango
+};
+
+/**
+ * @class AnilloCubetas
+ * @brief Anillo de cubetas que crece con los intervalos distintos que recibe
+ *
+ * Se comporta como un anillo fijo de 'maximo' cubetas (la del intervalo i
+ * es i % maximo y se reutiliza al llegar i + maximo), pero empieza con dos
+ * y solo crece cuando dos intervalos que el anillo completo guardaría a
+ * la vez caen en la misma ranura. Las capacidades son divisores de
+ * 'maximo', así que dos intervalos que comparten ranura en el anillo
+ * completo también la comparten en uno más chico. Un sensor con lecturas
+ * en pocos minutos ocupa pocas cubetas en lugar del anillo entero.
+ */
+class AnilloCubetas {
+private:
+    CubetaResumen* cubetas; ///< Ranuras (0 hasta la primera lectura)
+    int capacidad;          ///< Ranuras reservadas
+    int maximo;             ///< Capacidad del anillo completo
+    
+    /**
+     * @brief Pasa al siguiente divisor de 'maximo' (al menos el doble) y reubica las cubetas
+     */
+    void crecer();
+    
+    AnilloCubetas(const AnilloCubetas&);
+    AnilloCubetas& operator=(const AnilloCubetas&);
+    
+public:
+    /**
+     * @brief Constructor (no reserva memoria)
+     * @param cubetasMaximas Capacidad del anillo completo
+     */
+    explicit AnilloCubetas(int cubetasMaximas);
+    
+    /**
+     * @brief Destructor - libera las ranuras
+     */
+    ~AnilloCubetas();
+    
+    /**
+     * @brief Ranura donde va el intervalo (crece si hace falta)
+     *
+     * La ranura devuelta está vacía (indice -1), ya es la del intervalo, o
+     * guarda uno que el anillo completo también reemplazaría.
+     * @param indice Minuto u hora
+     * @return Cubeta del intervalo
+     */
+    CubetaResumen& ranura(int indice);
+    
+    /**
+     * @brief Cubeta de un intervalo, si todavía está en el anillo
+     * @return Puntero a la cubeta, o 0
+     */
+    CubetaResumen* buscar(int indice);
+    
+    /**
+     * @brief Cubeta de un intervalo, si todavía está en el anillo (solo lectura)
+     * @return Puntero a la cubeta, o 0
+     */
+    const CubetaResumen* buscar(int indice) const;
+    
+    /**
+     * @brief Bytes reservados por las ranuras
+     * @return Bytes
+     */
+    long long bytesUsados() const;
+};
+
+/**
+ * @class RollupSensor
+ * @brief Mantiene niveles por minuto y por hora alimentados en cada lectura
+ *
+ * Cada nivel es un anillo de cubetas (conteo, suma, mínimo y máximo): el
+ * de minutos cubre las últimas MINUTOS_RETENIDOS y el de horas las
+ * últimas HORAS_RETENIDAS. Registrar una lectura es O(1) amortizado: los
+ * anillos crecen según los intervalos que reciben (AnilloCubetas), así
+ * que un sensor con pocas lecturas no paga las 288 cubetas completas.
+ *
+ * También lleva la cuenta de cuántas lecturas crudas de cada minuto
+ * siguen en el historial, para que el sensor descarte las que ya salieron
+ * del horizonte crudo. Si procesarLectura elimina lecturas intermedias la
+ * cuenta es aproximada (puede descartar alguna lectura reciente de más).
+ */
+class RollupSensor {
+public:
+    static const int MINUTOS_RETENIDOS = 120;   ///< 2 horas de cubetas por minuto
+    static const int HORAS_RETENIDAS = 168;     ///< 1 semana de cubetas por hora
+    static const long long MS_MINUTO = 60000LL;   ///< Milisegundos por minuto
+    static const long long MS_HORA = 3600000LL;   ///< Milisegundos por hora
+    
+private:
+    AnilloCubetas minutos;    ///< Anillo por minuto
+    AnilloCubetas horas;      ///< Anillo por hora
+    int minutoCrudoAntiguo;   ///< Minuto más antiguo que aún tiene lecturas crudas (-1 = sin lecturas)
+    int ultimoMinuto;         ///< Minuto de la lectura más reciente
+    int crudosHuerfanos;      ///< Crudos de cubetas reutilizadas antes de expirar
+    
+    /**
+     * @brief Acumula una lectura en una cubeta (reiniciándola si era de otro intervalo)
+     */
+    static void acumular(CubetaResumen& cubeta, int indice, double valor);
+    
+    /**
+     * @brief Suma una cubeta al resultado de una consulta
+     */
+    static void combinar(ResultadoRango& resultado, const CubetaResumen& cubeta);
+    
+    RollupSensor(const RollupSensor&);
+    RollupSensor& operator=(const RollupSensor&);
+    
+public:
+    /**
+     * @brief Constructor (no reserva memoria hasta la primera lectura)
+     */
+    RollupSensor();
+    
+    /**
+     * @brief Incorpora una lectura cruda
+     * @param tiempoMs Marca de tiempo (ms desde la época Unix)
+     * @param valor Lectura
+     */
+    void registrar(long long tiempoMs, double valor);
+    
+    /**
+     * @brief Calcula cuántas lecturas crudas salieron del horizonte
+     *
+     * Las cuenta como expiradas: el llamador debe descartar ese número de
+     * lecturas antiguas de su historial.
+     * @param ahoraMs Tiempo actual
+     * @param horizonteMs Antigüedad máxima de las lecturas crudas
+     * @return Lecturas crudas a descartar
+     */
+    int expirarCrudos(long long ahoraMs, long long horizonteMs);
+    
+    /**
+     * @brief Informa que se descartaron lecturas crudas antiguas por otra vía
+     * @param cantidad Lecturas descartadas
+     */
+    void descontarCrudos(int cantidad);
+    
+    /**
+     * @brief Consulta el rango [desdeMs, hastaMs) con el nivel más grueso posible
+     *
+     * Las horas completas dentro del rango se responden con una cubeta
+     * horaria; los bordes se completan con cubetas por minuto mientras
+     * estén retenidas.
+     * @param desdeMs Inicio del rango
+     * @param hastaMs Fin del rango
+     * @return Agregados del rango
+     */
+    ResultadoRango consultar(long long desdeMs, long long hastaMs) const;
+    
+    /**
+     * @brief Bytes reservados por los anillos
+     * @return Bytes
+     */
+    long long bytesUsados() const;
+    
+    /**
+     * @brief Tiempo real actual
+     * @return Milisegundos desde la época Unix
+     */
+    static long long ahoraMs();
+};
+
+#endif // ROLLUP_SENSOR_H
@@ -1,27 +1,142 @@
-/**
- * @file SensorBase.cpp
- * @brief Implementación de la clase base SensorBase
- */
-
-#include "SensorBase.h"
-#include <iostream>
-
-using namespace std;
-
-SensorBase::SensorBase(const char* nom) {
-    // Copia el nombre carácter por carácter de forma manual
-    int i = 0;
-    while (nom[i] != '\0' && i < 49) {
-        nombre[i] = nom[i];
-        i++;
-    }
-    nombre[i] = '\0'; // Termina la cadena
-}
-
-SensorBase::~SensorBase() {
-    cout << "[Destructor Base] Liberando sensor: " << nombre << endl;
-}
-
-const char* SensorBase::obtenerNombre() const {
-    return nombre;
+/**
+ * @file SensorBase.cpp
+ * @brief Implementación de la clase base SensorBase
+ */
+
+#include "SensorBase.h"
+#include "TablaNombres.h"
+#include "RegistroCambios.h"
+#include "Instantanea.h"
+#include "Bitacora.h"
+#include <iostream>
+
+using namespace std;
+
+// La parte base (vtable, detector e ID) debe caber en una línea de caché
+static_assert(sizeof(SensorBase) <= 64, "SensorBase excede una linea de cache");
+
+SensorBase::SensorBase(const char* nom) {
+    // El nombre se guarda una sola vez en la tabla global
+    id = TablaNombres::global().internar(nom);
+    version = 0;
+}
+
+SensorBase::~SensorBase() {
+    if (Bitacora::activa()) {
+        cout << "[Destructor Base] Liberando sensor: " << obtenerNombre() << endl;
+    }
+}
+
+TipoSensor SensorBase::obtenerTipo() const {
+    return SENSOR_OTRO;
+}
+
+const char* SensorBase::obtenerNombre() const {
+    return TablaNombres::global().nombre(id);
+}
+
+int SensorBase::obtenerId() const {
+    return id;
+}
+
+unsigned int SensorBase::obtenerVersion() const {
+    return version;
+}
+
+AgregadosSensor SensorBase::obtenerAgregados() const {
+    AgregadosSensor agregados;
+    agregados.id = id;
+    agregados.tipo = obtenerTipo();
+    agregados.version = version;
+    agregados.ultimoResultado = obtenerUltimoResultado();
+    agregados.anomalias = detector.obtenerAnomalias();
+    return agregados;
+}
+
+void SensorBase::fijarPresupuesto(const PresupuestoRetencion& presupuesto) {
+    (void)presupuesto;
+}
+
+int SensorBase::recortarHistorial(int cantidad) {
+    (void)cantidad;
+    return 0;
+}
+
+bool SensorBase::publicarEstado() {
+    return false;
+}
+
+bool SensorBase::registrarValor(double valor) {
+    (void)valor;
+    return false;
+}
+
+shared_ptr<const BuzonGenerico> SensorBase::compartirBuzonGenerico() const {
+    return shared_ptr<const BuzonGenerico>();
+}
+
+const char* SensorBase::etiquetaTipo() const {
+    switch (obtenerTipo()) {
+        case SENSOR_TEMPERATURA:
+            return "TEMP";
+        case SENSOR_PRESION:
+            return "PRES";
+        default:
+            return "OTRO";
+    }
+}
+
+const RollupSensor* SensorBase::obtenerRollup() const {
+    return 0;
+}
+
+long long SensorBase::bytesUsados() const {
+    return sizeof(SensorBase);
+}
+
+int SensorBase::periodoProcesamientoMs() const {
+    return 1000;
+}
+
+double SensorBase::obtenerUltimoResultado() const {
+    return 0.0;
+}
+
+void SensorBase::marcarModificado(TipoSensor tipo) {
+    version = version + 1;
+    RegistroCambios::global().marcar(id, tipo);
+}
+
+void SensorBase::configurarDetector(const ConfigDetector* config) {
+    detector.configurar(config);
+}
+
+const DetectorAnomalias& SensorBase::obtenerDetector() const {
+    return detector;
+}
+
+int SensorBase::evaluarAnomalia(double valor) {
+    int tipo = detector.evaluar(valor);
+    
+    if (tipo != ANOMALIA_NINGUNA && Bitacora::activa()) {
+        cout << "[Anomalia] Sensor " << obtenerNombre() << ": lectura " << valor;
+        if (tipo & ANOMALIA_ZSCORE) {
+            cout << " | z-score excedido (media " << detector.obtenerMedia() << ")";
+        }
+        if (tipo & ANOMALIA_CAMBIO) {
+            cout << " | cambio brusco";
+        }
+        if (tipo & ANOMALIA_ESTANCADO) {
+            cout << " | valor estancado";
+        }
+        cout << endl;
+    }
+    
+    return tipo;
+}
+
+void SensorBase::imprimirDetector() const {
+    cout << "Anomalias detectadas: " << detector.obtenerAnomalias()
+         << " (costo medio " << detector.costoMedioNs() << " ns/lectura, maximo "
+         << detector.costoMaximoNs() << " ns)" << endl;
 }
\ No newline at end of file
@@ -1,55 +1,217 @@
-/**
- * @file SensorBase.h
- * @brief Clase base abstracta para todos los sensores del sistema IoT
- * @author Juan Francisco Ortega Pulido
- * @date 2025
- */
-
-#ifndef SENSOR_BASE_H
-#define SENSOR_BASE_H
-
-/**
- * @class SensorBase
- * @brief Clase abstracta que define la interfaz común para todos los sensores
- * 
- * Esta clase base establece el contrato que deben cumplir todos los sensores
- * del sistema mediante métodos virtuales puros.
- */
-class SensorBase {
-protected:
-    char nombre[50]; ///< Identificador único del sensor
-    
-public:
-    /**
-     * @brief Constructor que inicializa el nombre del sensor
-     * @param nom Nombre identificador del sensor
-     */
-    SensorBase(const char* nom);
-    
-    /**
-     * @brief Destructor virtual para permitir polimorfismo
-     */
-    virtual ~SensorBase();
-    
-    /**
-     * @brief Método virtual puro para procesar las lecturas del sensor
-     * 
-     * Cada sensor implementa su propia lógica de procesamiento:
-     * - SensorTemperatura: elimina el valor más bajo
-     * - SensorPresion: calcula el promedio
-     */
-    virtual void procesarLectura() = 0;
-    
-    /**
-     * @brief Método virtual puro para imprimir información del sensor
-     */
-    virtual void imprimirInfo() const = 0;
-    
-    /**
-     * @brief Obtiene el nombre del sensor
-     * @return Puntero al nombre del sensor
-     */
-    const char* obtenerNombre() const;
-};
-
+/**
+ * @file SensorBase.h
+ * @brief Clase base abstracta para todos los sensores del sistema IoT
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef SENSOR_BASE_H
+#define SENSOR_BASE_H
+
+#include "DetectorAnomalias.h"
+#include "ContabilidadMemoria.h"
+#include <memory>
+
+struct AgregadosSensor;
+struct BuzonGenerico;
+class RollupSensor;
+
+/**
+ * @brief Tipo concreto de un sensor (permite agrupar sin RTTI)
+ */
+enum TipoSensor {
+    SENSOR_TEMPERATURA, ///< SensorTemperatura (lecturas float)
+    SENSOR_PRESION,     ///< SensorPresion (lecturas int)
+    SENSOR_OTRO         ///< Cualquier otra subclase
+};
+
+/**
+ * @class SensorBase
+ * @brief Clase abstracta que define la interfaz común para todos los sensores
+ * 
+ * Esta clase base establece el contrato que deben cumplir todos los sensores
+ * del sistema mediante métodos virtuales puros.
+ *
+ * El nombre se guarda una sola vez en TablaNombres; el sensor solo
+ * conserva su ID, de modo que la parte base ocupa una línea de caché
+ * (64 bytes) junto con el estado del detector.
+ */
+class SensorBase {
+protected:
+    DetectorAnomalias detector; ///< Detector de anomalías en línea
+    int id;                     ///< ID del nombre en TablaNombres
+    unsigned int version;       ///< Se incrementa con cada lectura registrada
+    
+    /**
+     * @brief Registra que el sensor recibió datos nuevos
+     *
+     * Incrementa la versión y agrega el sensor a la lista de trabajo de
+     * RegistroCambios para la siguiente pasada de procesamiento.
+     * @param tipo Tipo concreto, que la clase derivada conoce sin vtable
+     */
+    void marcarModificado(TipoSensor tipo);
+    
+    /**
+     * @brief Evalúa una lectura recién registrada y reporta anomalías
+     * @param valor Lectura a evaluar
+     * @return Máscara de TipoAnomalia detectada
+     */
+    int evaluarAnomalia(double valor);
+    
+    /**
+     * @brief Imprime el estado del detector de anomalías
+     */
+    void imprimirDetector() const;
+    
+public:
+    /**
+     * @brief Constructor que interna el nombre del sensor
+     * @param nom Nombre identificador del sensor
+     */
+    SensorBase(const char* nom);
+    
+    /**
+     * @brief Destructor virtual para permitir polimorfismo
+     */
+    virtual ~SensorBase();
+    
+    /**
+     * @brief Método virtual puro para procesar las lecturas del sensor
+     * 
+     * Cada sensor implementa su propia lógica de procesamiento:
+     * - SensorTemperatura: elimina el valor más bajo
+     * - SensorPresion: calcula el promedio
+     */
+    virtual void procesarLectura() = 0;
+    
+    /**
+     * @brief Método virtual puro para imprimir información del sensor
+     */
+    virtual void imprimirInfo() const = 0;
+    
+    /**
+     * @brief Indica el tipo concreto del sensor
+     * @return Tipo del sensor (SENSOR_OTRO por defecto)
+     */
+    virtual TipoSensor obtenerTipo() const;
+    
+    /**
+     * @brief Obtiene el nombre del sensor
+     * @return Puntero al nombre del sensor
+     */
+    const char* obtenerNombre() const;
+    
+    /**
+     * @brief Obtiene la versión de los datos del sensor
+     * @return Número de lecturas registradas desde su creación
+     */
+    unsigned int obtenerVersion() const;
+    
+    /**
+     * @brief Cadencia con la que el planificador procesa este tipo de sensor
+     * @return Periodo en milisegundos (1000 por defecto)
+     */
+    virtual int periodoProcesamientoMs() const;
+    
+    /**
+     * @brief Último resultado calculado por procesarLectura
+     *
+     * Permite servir el resultado en caché sin recorrer el historial.
+     * @return Resultado del último procesamiento (0 si nunca se procesó)
+     */
+    virtual double obtenerUltimoResultado() const;
+    
+    /**
+     * @brief Asigna el presupuesto de retención del historial
+     * @param presupuesto Límite y política (los sensores sin historial lo ignoran)
+     */
+    virtual void fijarPresupuesto(const PresupuestoRetencion& presupuesto);
+    
+    /**
+     * @brief Desaloja lecturas según la política de retención
+     * @param cantidad Lecturas a liberar como mínimo
+     * @return Lecturas efectivamente eliminadas
+     */
+    virtual int recortarHistorial(int cantidad);
+    
+    /**
+     * @brief Bytes ocupados por el sensor y su historial
+     * @return Bytes
+     */
+    virtual long long bytesUsados() const;
+    
+    /**
+     * @brief Agregados de la última instantánea publicada
+     *
+     * Es seguro llamarlo desde cualquier hilo mientras otro registra
+     * lecturas: devuelve un estado consistente en O(1).
+     * @return Copia de los agregados
+     */
+    virtual AgregadosSensor obtenerAgregados() const;
+    
+    /**
+     * @brief Publica la instantánea si el estado cambió desde la última
+     *
+     * registrarLote, procesarLectura y el recorte del historial publican
+     * al terminar; una registrarLectura suelta queda pendiente hasta aquí
+     * (ListaGeneral::publicar lo llama una vez por pasada).
+     * @return true si se publicó una instantánea nueva
+     */
+    virtual bool publicarEstado();
+    
+    /**
+     * @brief Resúmenes por minuto y por hora del sensor
+     *
+     * Solo debe consultarse desde el hilo que registra las lecturas.
+     * @return Resúmenes, o 0 si el sensor no los mantiene
+     */
+    virtual const RollupSensor* obtenerRollup() const;
+    
+    /**
+     * @brief Registra una lectura sin conocer el tipo concreto
+     *
+     * Lo implementan los sensores genéricos; los de temperatura y presión
+     * se alimentan por su registrarLectura tipado.
+     * @param valor Lectura
+     * @return false si el sensor no la aceptó
+     */
+    virtual bool registrarValor(double valor);
+    
+    /**
+     * @brief Buzón de instantáneas sin el tipo de las lecturas
+     *
+     * Con él el directorio, el punto de control y la exportación tratan
+     * igual a cualquier sensor, también a los genéricos (SENSOR_OTRO).
+     * @return Buzón compartido (vacío si el sensor no publica instantáneas)
+     */
+    virtual std::shared_ptr<const BuzonGenerico> compartirBuzonGenerico() const;
+    
+    /**
+     * @brief Etiqueta del tipo en el punto de control ("TEMP", "PRES"...)
+     *
+     * cargarManifiesto crea el sensor según esta etiqueta; un tipo que
+     * devuelva "OTRO" se guarda pero no se puede restaurar.
+     * @return Etiqueta constante
+     */
+    virtual const char* etiquetaTipo() const;
+    
+    /**
+     * @brief Obtiene el ID denso del nombre del sensor
+     * @return ID asignado por TablaNombres
+     */
+    int obtenerId() const;
+    
+    /**
+     * @brief Asigna los parámetros del detector de anomalías
+     * @param config Configuración del tipo de sensor (reinicia el estado del detector)
+     */
+    void configurarDetector(const ConfigDetector* config);
+    
+    /**
+     * @brief Obtiene el detector de anomalías del sensor
+     * @return Referencia al detector
+     */
+    const DetectorAnomalias& obtenerDetector() const;
+};
+
 #endif // SENSOR_BASE_H
\ No newline at end of file
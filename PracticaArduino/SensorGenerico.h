@@ -0,0 +1,475 @@
+/**
+ * @file SensorGenerico.h
+ * @brief Sensor genérico armado con políticas de almacenamiento y procesamiento
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef SENSOR_GENERICO_H
+#define SENSOR_GENERICO_H
+
+#include "SensorBase.h"
+#include "PoliticasSensor.h"
+#include "Instantanea.h"
+#include "RollupSensor.h"
+#include "Bitacora.h"
+#include <iostream>
+
+/**
+ * @class SensorGenerico
+ * @brief Sensor cuyo almacenamiento y procesamiento se eligen en compilación
+ * @tparam T Tipo de las lecturas
+ * @tparam Almacen Política de almacenamiento (AlmacenBloques, AlmacenAnillo)
+ * @tparam Etapas Etapas de procesamiento, en orden (ver PoliticasSensor.h)
+ *
+ * Mantiene lo mismo que SensorTemperatura y SensorPresion (detector,
+ * instantáneas, resúmenes y presupuesto de retención), pero el
+ * procesamiento se compone de etapas en lugar de escribirse a mano.
+ * Un tipo nuevo es una sola línea, por ejemplo:
+ *
+ *   typedef SensorGenerico<int, AlmacenAnillo<int, 1024>,
+ *                          Diezmar<2>, Acotar<0, 10000>, Promedio> SensorVibracion;
+ *
+ * Para guardarlo en un punto de control y restaurarlo, el tipo además
+ * necesita una etiqueta (etiquetaTipo) y su caso en cargarManifiesto,
+ * como SensorVibracion.
+ *
+ * registrarLectura no es virtual y las etapas se expanden en línea: una
+ * lectura no paga ninguna llamada virtual. Para ListaGeneral el sensor es
+ * SENSOR_OTRO y se procesa por el despacho virtual de siempre.
+ */
+template <typename T, typename Almacen, typename... Etapas>
+class SensorGenerico : public SensorBase {
+private:
+    Almacen historial;                    ///< Lecturas vivas
+    CadenaEtapas<Etapas...> etapas;       ///< Procesamiento compuesto
+    static ConfigDetector configDetector; ///< Detector compartido por el tipo
+    double ultimoResultado;               ///< Resultado del último procesamiento
+    EstadoPublicado<T> estado;            ///< Instantáneas para lectores concurrentes
+    PresupuestoRetencion presupuesto;     ///< Límite de retención del historial
+    RollupSensor rollup;                  ///< Resúmenes por minuto y por hora
+    
+    /**
+     * @brief Recorta el historial si excede el presupuesto propio
+     */
+    void aplicarPresupuesto();
+    
+    /**
+     * @brief Descarta las lecturas crudas más antiguas
+     * @param cantidad Lecturas a descartar
+     */
+    void descartarAntiguas(int cantidad);
+    
+    /**
+     * @brief Almacena una lectura que ya pasó las etapas de entrada
+     * @param valor Lectura
+     */
+    void almacenar(T valor);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param nom Identificador del sensor
+     */
+    SensorGenerico(const char* nom);
+    
+    /**
+     * @brief Destructor del sensor
+     */
+    ~SensorGenerico();
+    
+    /**
+     * @brief Pasa la lectura por las etapas de entrada y la registra
+     *
+     * La instantánea queda pendiente hasta publicarEstado.
+     * @param valor Lectura
+     * @return false si una etapa la descartó
+     */
+    bool registrarLectura(T valor);
+    
+    /**
+     * @brief Registra una lectura que ya pasó las etapas de entrada
+     *
+     * Para restaurar un punto de control: volver a diezmar o acotar lo
+     * guardado perdería lecturas. La instantánea queda pendiente.
+     * @param valor Lectura tal como quedó en el historial
+     */
+    void restaurarLectura(T valor);
+    
+    /**
+     * @brief Registra un lote de lecturas en orden
+     *
+     * Igual que registrarLectura con cada valor, pero publica una sola
+     * instantánea y marca el sensor una sola vez.
+     * @param valores Lecturas en orden de llegada
+     * @param cantidad Número de lecturas
+     * @return Lecturas conservadas por las etapas
+     */
+    int registrarLote(const T* valores, int cantidad);
+    
+    /**
+     * @brief Registra una lectura sin conocer el tipo concreto
+     * @param valor Lectura (se convierte a T)
+     * @return false si una etapa la descartó
+     */
+    bool registrarValor(double valor);
+    
+    /**
+     * @brief Aplica las etapas de procesamiento en orden
+     */
+    void procesarLectura();
+    
+    /**
+     * @brief Imprime la información del sensor
+     */
+    void imprimirInfo() const;
+    
+    /**
+     * @brief Asigna el presupuesto de retención y lo aplica de inmediato
+     * @param nuevo Límite y política
+     */
+    void fijarPresupuesto(const PresupuestoRetencion& nuevo);
+    
+    /**
+     * @brief Desaloja lecturas según la política de retención
+     * @param cantidad Lecturas a liberar como mínimo
+     * @return Lecturas efectivamente eliminadas
+     */
+    int recortarHistorial(int cantidad);
+    
+    /**
+     * @brief Bytes del sensor, su almacén y su historial versionado
+     * @return Bytes
+     */
+    long long bytesUsados() const;
+    
+    /**
+     * @brief Agregados de la última instantánea publicada
+     * @return Copia consistente de los agregados
+     */
+    AgregadosSensor obtenerAgregados() const;
+    
+    /**
+     * @brief Publica la instantánea si hay cambios sin publicar
+     * @return true si se publicó
+     */
+    bool publicarEstado();
+    
+    /**
+     * @brief Resúmenes por minuto y por hora de las lecturas
+     * @return Resúmenes del sensor
+     */
+    const RollupSensor* obtenerRollup() const;
+    
+    /**
+     * @brief Resultado de las etapas en el último procesamiento
+     * @return Resultado en caché
+     */
+    double obtenerUltimoResultado() const;
+    
+    /**
+     * @brief Almacén vivo del sensor (solo desde el hilo de ingesta)
+     * @return Referencia al almacén
+     */
+    const Almacen& obtenerHistorial() const;
+    
+    /**
+     * @brief Última instantánea completa (agregados e historial)
+     * @return Instantánea inmutable
+     */
+    std::shared_ptr<const InstantaneaSensor<T> > obtenerInstantanea() const;
+    
+    /**
+     * @brief Buzón de instantáneas sin el tipo de las lecturas
+     * @return Buzón compartido
+     */
+    std::shared_ptr<const BuzonGenerico> compartirBuzonGenerico() const;
+    
+    /**
+     * @brief Lecturas vivas (para las etapas)
+     * @return Cantidad de lecturas
+     */
+    int cantidadLecturas() const;
+    
+    /**
+     * @brief Promedio de las lecturas vivas (para las etapas)
+     * @return Promedio
+     */
+    double promedioLecturas() const;
+    
+    /**
+     * @brief Elimina la lectura más baja y lo refleja en la instantánea
+     * @return Valor eliminado
+     */
+    T descartarMinimo();
+    
+    /**
+     * @brief Parámetros del detector de anomalías de este tipo de sensor
+     * @return Referencia modificable a la configuración compartida
+     */
+    static ConfigDetector& configuracionDetector();
+};
+
+template <typename T, typename Almacen, typename... Etapas>
+ConfigDetector SensorGenerico<T, Almacen, Etapas...>::configDetector;
+
+template <typename T, typename Almacen, typename... Etapas>
+SensorGenerico<T, Almacen, Etapas...>::SensorGenerico(const char* nom) : SensorBase(nom) {
+    ContabilidadMemoria::global().reservar(MEMORIA_SENSORES, sizeof(SensorGenerico));
+    configurarDetector(&configDetector);
+    ultimoResultado = 0.0;
+    estado.iniciar(id, SENSOR_OTRO);
+    if (Bitacora::activa()) {
+        std::cout << "[Sensor Generico] Sensor '" << obtenerNombre() << "' creado." << std::endl;
+    }
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+SensorGenerico<T, Almacen, Etapas...>::~SensorGenerico() {
+    ContabilidadMemoria::global().liberar(MEMORIA_SENSORES, sizeof(SensorGenerico));
+    if (Bitacora::activa()) {
+        std::cout << "  [Destructor Sensor " << obtenerNombre() << "] Liberando sensor generico..." << std::endl;
+    }
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+void SensorGenerico<T, Almacen, Etapas...>::almacenar(T valor) {
+    T desalojado = T();
+    if (historial.insertar(valor, desalojado)) {
+        // El anillo estaba lleno: la más antigua sale de la instantánea
+        estado.eliminarPrimero();
+        rollup.descontarCrudos(1);
+    }
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+bool SensorGenerico<T, Almacen, Etapas...>::registrarLectura(T valor) {
+    if (!etapas.entrada(valor)) {
+        return false;
+    }
+    restaurarLectura(valor);
+    return true;
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+void SensorGenerico<T, Almacen, Etapas...>::restaurarLectura(T valor) {
+    if (Bitacora::activa()) {
+        std::cout << "[Sensor " << obtenerNombre() << "] Registrando lectura: " << valor << std::endl;
+    }
+    almacenar(valor);
+    marcarModificado(SENSOR_OTRO);
+    evaluarAnomalia(valor);
+    estado.registrar(valor, version, detector.obtenerAnomalias());
+    rollup.registrar(RollupSensor::ahoraMs(), valor);
+    aplicarPresupuesto();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+int SensorGenerico<T, Almacen, Etapas...>::registrarLote(const T* valores, int cantidad) {
+    // Las etapas pueden descartar o cambiar lecturas: se publica lo conservado
+    T* conservadas = new T[cantidad > 0 ? cantidad : 1];
+    int n = 0;
+    
+    long long ahora = RollupSensor::ahoraMs();
+    for (int i = 0; i < cantidad; i++) {
+        T valor = valores[i];
+        if (!etapas.entrada(valor)) {
+            continue;
+        }
+        almacenar(valor);
+        evaluarAnomalia(valor);
+        rollup.registrar(ahora, valor);
+        conservadas[n] = valor;
+        n = n + 1;
+    }
+    
+    if (n > 0) {
+        version = version + (n - 1);
+        marcarModificado(SENSOR_OTRO);
+        estado.registrarLote(conservadas, n, version, detector.obtenerAnomalias());
+        aplicarPresupuesto();
+        estado.publicarPendiente();
+    }
+    delete[] conservadas;
+    return n;
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+bool SensorGenerico<T, Almacen, Etapas...>::registrarValor(double valor) {
+    return registrarLectura((T)valor);
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+void SensorGenerico<T, Almacen, Etapas...>::procesarLectura() {
+    std::cout << "-> Procesando Sensor " << obtenerNombre() << "..." << '\n';
+    
+    if (historial.estaVacia()) {
+        std::cout << "[Sensor Generico] No hay lecturas para procesar." << '\n';
+        estado.publicarPendiente();
+        return;
+    }
+    
+    double resultado = ultimoResultado;
+    etapas.procesar(*this, resultado);
+    ultimoResultado = resultado;
+    estado.fijarResultado(resultado);
+    estado.publicarPendiente();
+    
+    std::cout << "[Sensor Generico] Resultado sobre " << historial.contar() << " lectura(s): "
+              << resultado << "." << '\n';
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+void SensorGenerico<T, Almacen, Etapas...>::imprimirInfo() const {
+    std::cout << "Sensor: " << obtenerNombre() << " [Tipo: Generico | ";
+    CadenaEtapas<Etapas...>::imprimirNombres();
+    std::cout << "]" << std::endl;
+    // Se informa desde la instantánea: no toca el historial del escritor
+    AgregadosSensor agregados = obtenerAgregados();
+    std::cout << "Numero de lecturas: " << agregados.cantidad << std::endl;
+    imprimirDetector();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+void SensorGenerico<T, Almacen, Etapas...>::aplicarPresupuesto() {
+    // Lo que salió del horizonte crudo ya está en los resúmenes
+    int expiradas = rollup.expirarCrudos(RollupSensor::ahoraMs(), presupuesto.horizonteCrudoMs);
+    if (expiradas > 0) {
+        descartarAntiguas(expiradas);
+    }
+    
+    if (presupuesto.maxLecturas > 0 && historial.contar() > presupuesto.maxLecturas) {
+        recortarHistorial(historial.contar() - presupuesto.maxLecturas);
+    }
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+void SensorGenerico<T, Almacen, Etapas...>::descartarAntiguas(int cantidad) {
+    for (int i = 0; i < cantidad && !historial.estaVacia(); i++) {
+        historial.eliminarPrimero();
+        estado.eliminarPrimero();
+    }
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+void SensorGenerico<T, Almacen, Etapas...>::fijarPresupuesto(const PresupuestoRetencion& nuevo) {
+    presupuesto = nuevo;
+    aplicarPresupuesto();
+    estado.publicarPendiente();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+int SensorGenerico<T, Almacen, Etapas...>::recortarHistorial(int cantidad) {
+    int antes = historial.contar();
+    
+    if (presupuesto.politica == RETENCION_SUBMUESTREAR) {
+        // Cada pasada reduce el historial a la mitad
+        while (historial.contar() > 1 && antes - historial.contar() < cantidad) {
+            historial.submuestrear();
+            estado.submuestrear();
+        }
+    } else {
+        descartarAntiguas(cantidad);
+    }
+    
+    int eliminadas = antes - historial.contar();
+    rollup.descontarCrudos(eliminadas);
+    estado.publicarPendiente();
+    return eliminadas;
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+long long SensorGenerico<T, Almacen, Etapas...>::bytesUsados() const {
+    return sizeof(SensorGenerico) + historial.bytesUsados() + estado.bytesUsados() + rollup.bytesUsados();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+bool SensorGenerico<T, Almacen, Etapas...>::publicarEstado() {
+    return estado.publicarPendiente();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+AgregadosSensor SensorGenerico<T, Almacen, Etapas...>::obtenerAgregados() const {
+    return estado.leer()->agregados;
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+const RollupSensor* SensorGenerico<T, Almacen, Etapas...>::obtenerRollup() const {
+    return &rollup;
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+double SensorGenerico<T, Almacen, Etapas...>::obtenerUltimoResultado() const {
+    return ultimoResultado;
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+const Almacen& SensorGenerico<T, Almacen, Etapas...>::obtenerHistorial() const {
+    return historial;
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+std::shared_ptr<const InstantaneaSensor<T> > SensorGenerico<T, Almacen, Etapas...>::obtenerInstantanea() const {
+    return estado.leer();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+std::shared_ptr<const BuzonGenerico> SensorGenerico<T, Almacen, Etapas...>::compartirBuzonGenerico() const {
+    return estado.compartirBuzon();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+int SensorGenerico<T, Almacen, Etapas...>::cantidadLecturas() const {
+    return historial.contar();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+double SensorGenerico<T, Almacen, Etapas...>::promedioLecturas() const {
+    return historial.promedio();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+T SensorGenerico<T, Almacen, Etapas...>::descartarMinimo() {
+    // Almacén e instantánea guardan las mismas lecturas: el primer mínimo coincide
+    historial.eliminarMinimo();
+    return estado.eliminarMinimo();
+}
+
+template <typename T, typename Almacen, typename... Etapas>
+ConfigDetector& SensorGenerico<T, Almacen, Etapas...>::configuracionDetector() {
+    return configDetector;
+}
+
+/**
+ * @brief Composición del sensor de vibración
+ */
+typedef SensorGenerico<int, AlmacenAnillo<int, 1024>,
+                       Diezmar<2>, Acotar<0, 10000>, Promedio, SuavizadoExponencial<1, 4> > SensorGenericoVibracion;
+
+/**
+ * @class SensorVibracion
+ * @brief Sensor de vibración: conteo entero a alta frecuencia
+ *
+ * Guarda las últimas 1024 lecturas, conserva una de cada dos, satura al
+ * rango del acelerómetro y suaviza el promedio entre procesamientos.
+ * Solo añade su etiqueta, para que el punto de control pueda recrearlo.
+ */
+class SensorVibracion : public SensorGenericoVibracion {
+public:
+    /**
+     * @brief Constructor
+     * @param nom Identificador del sensor
+     */
+    SensorVibracion(const char* nom) : SensorGenericoVibracion(nom) {
+    }
+    
+    /**
+     * @brief Etiqueta en el punto de control
+     * @return "VIB"
+     */
+    const char* etiquetaTipo() const {
+        return "VIB";
+    }
+};
+
+#endif // SENSOR_GENERICO_H
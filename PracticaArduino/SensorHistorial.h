@@ -0,0 +1,287 @@
+/**
+ * @file SensorHistorial.h
+ * @brief Base común de los sensores con historial, instantáneas y retención
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef SENSOR_HISTORIAL_H
+#define SENSOR_HISTORIAL_H
+
+#include "SensorBase.h"
+#include "Instantanea.h"
+#include "RollupSensor.h"
+
+/**
+ * @class SensorHistorial
+ * @brief Historial, instantáneas, resúmenes y presupuesto de un sensor concreto
+ * @tparam T Tipo de las lecturas
+ * @tparam Sensor Clase derivada (su tamaño y su constante TIPO)
+ *
+ * SensorTemperatura y SensorPresion solo difieren en el tipo de lectura,
+ * el detector y procesarLectura; el registro de lecturas, la retención y
+ * la publicación de instantáneas viven aquí una sola vez.
+ */
+template <typename T, typename Sensor>
+class SensorHistorial : public SensorBase {
+public:
+    /**
+     * @brief Historial de lecturas (el mismo del que salen las instantáneas)
+     */
+    typedef HistorialVersionado<T> Historial;
+    
+protected:
+    double ultimoResultado;           ///< Resultado del último procesamiento
+    EstadoPublicado<T> estado;        ///< Lecturas e instantáneas para lectores concurrentes
+    PresupuestoRetencion presupuesto; ///< Límite de retención del historial
+    RollupSensor rollup;              ///< Resúmenes por minuto y por hora
+    
+    /**
+     * @brief Constructor
+     * @param nom Identificador del sensor
+     */
+    SensorHistorial(const char* nom);
+    
+    /**
+     * @brief Destructor (descuenta la memoria del sensor)
+     */
+    ~SensorHistorial();
+    
+    /**
+     * @brief Registra una lectura ya anunciada por la clase derivada
+     *
+     * La instantánea queda pendiente hasta publicarEstado.
+     * @param valor Lectura
+     */
+    void anotarLectura(T valor);
+    
+    /**
+     * @brief Recorta el historial si excede el presupuesto propio
+     */
+    void aplicarPresupuesto();
+    
+    /**
+     * @brief Descarta las lecturas crudas más antiguas
+     * @param cantidad Lecturas a descartar
+     */
+    void descartarAntiguas(int cantidad);
+    
+public:
+    /**
+     * @brief Registra un lote de lecturas en orden
+     *
+     * Equivale a registrar cada valor por separado, pero marca el sensor
+     * una sola vez y publica una sola instantánea al final (tras aplicar
+     * el presupuesto).
+     * @param valores Lecturas en orden de llegada
+     * @param cantidad Número de lecturas
+     */
+    void registrarLote(const T* valores, int cantidad);
+    
+    /**
+     * @brief Asigna el presupuesto de retención y lo aplica de inmediato
+     * @param nuevo Límite y política
+     */
+    void fijarPresupuesto(const PresupuestoRetencion& nuevo);
+    
+    /**
+     * @brief Desaloja lecturas según la política de retención
+     * @param cantidad Lecturas a liberar como mínimo
+     * @return Lecturas efectivamente eliminadas
+     */
+    int recortarHistorial(int cantidad);
+    
+    /**
+     * @brief Bytes del sensor, su historial y sus resúmenes
+     * @return Bytes
+     */
+    long long bytesUsados() const;
+    
+    /**
+     * @brief Agregados de la última instantánea publicada
+     * @return Copia consistente de los agregados
+     */
+    AgregadosSensor obtenerAgregados() const;
+    
+    /**
+     * @brief Publica la instantánea si hay cambios sin publicar
+     * @return true si se publicó
+     */
+    bool publicarEstado();
+    
+    /**
+     * @brief Resúmenes por minuto y por hora de las lecturas
+     * @return Resúmenes del sensor
+     */
+    const RollupSensor* obtenerRollup() const;
+    
+    /**
+     * @brief Resultado del último procesamiento
+     * @return Resultado en caché
+     */
+    double obtenerUltimoResultado() const;
+    
+    /**
+     * @brief Historial vivo del sensor (solo lectura)
+     *
+     * Lo modifica el hilo de ingesta; recorrerlo solo es seguro desde ese
+     * mismo hilo o mientras la ingesta esté detenida.
+     * @return Referencia al historial
+     */
+    const Historial& obtenerHistorial() const;
+    
+    /**
+     * @brief Última instantánea completa (agregados e historial)
+     *
+     * Se puede leer desde otro hilo sin bloquear la ingesta.
+     * @return Instantánea inmutable
+     */
+    std::shared_ptr<const InstantaneaSensor<T> > obtenerInstantanea() const;
+    
+    /**
+     * @brief Buzón donde se publican las instantáneas
+     *
+     * Permite seguir leyendo desde otro hilo aunque el sensor se elimine.
+     * @return Buzón compartido
+     */
+    std::shared_ptr<const BuzonInstantanea<T> > compartirBuzon() const;
+    
+    /**
+     * @brief El mismo buzón, sin el tipo de las lecturas
+     * @return Buzón compartido
+     */
+    std::shared_ptr<const BuzonGenerico> compartirBuzonGenerico() const;
+};
+
+template <typename T, typename Sensor>
+SensorHistorial<T, Sensor>::SensorHistorial(const char* nom) : SensorBase(nom) {
+    ContabilidadMemoria::global().reservar(MEMORIA_SENSORES, sizeof(Sensor));
+    ultimoResultado = 0.0;
+    estado.iniciar(id, Sensor::TIPO);
+}
+
+template <typename T, typename Sensor>
+SensorHistorial<T, Sensor>::~SensorHistorial() {
+    ContabilidadMemoria::global().liberar(MEMORIA_SENSORES, sizeof(Sensor));
+}
+
+template <typename T, typename Sensor>
+void SensorHistorial<T, Sensor>::anotarLectura(T valor) {
+    marcarModificado(Sensor::TIPO);
+    evaluarAnomalia(valor);
+    estado.registrar(valor, version, detector.obtenerAnomalias());
+    rollup.registrar(RollupSensor::ahoraMs(), valor);
+    aplicarPresupuesto();
+}
+
+template <typename T, typename Sensor>
+void SensorHistorial<T, Sensor>::registrarLote(const T* valores, int cantidad) {
+    if (cantidad <= 0) {
+        return;
+    }
+    
+    long long ahora = RollupSensor::ahoraMs();
+    for (int i = 0; i < cantidad; i++) {
+        evaluarAnomalia(valores[i]);
+        rollup.registrar(ahora, valores[i]);
+    }
+    
+    version = version + (cantidad - 1);
+    marcarModificado(Sensor::TIPO);
+    estado.registrarLote(valores, cantidad, version, detector.obtenerAnomalias());
+    aplicarPresupuesto();
+    estado.publicarPendiente();
+}
+
+template <typename T, typename Sensor>
+void SensorHistorial<T, Sensor>::aplicarPresupuesto() {
+    // Lo que salió del horizonte crudo ya está en los resúmenes
+    int expiradas = rollup.expirarCrudos(RollupSensor::ahoraMs(), presupuesto.horizonteCrudoMs);
+    if (expiradas > 0) {
+        descartarAntiguas(expiradas);
+    }
+    
+    if (presupuesto.maxLecturas > 0 && estado.cantidad() > presupuesto.maxLecturas) {
+        recortarHistorial(estado.cantidad() - presupuesto.maxLecturas);
+    }
+}
+
+template <typename T, typename Sensor>
+void SensorHistorial<T, Sensor>::descartarAntiguas(int cantidad) {
+    for (int i = 0; i < cantidad && estado.cantidad() > 0; i++) {
+        estado.eliminarPrimero();
+    }
+}
+
+template <typename T, typename Sensor>
+void SensorHistorial<T, Sensor>::fijarPresupuesto(const PresupuestoRetencion& nuevo) {
+    presupuesto = nuevo;
+    aplicarPresupuesto();
+    estado.publicarPendiente();
+}
+
+template <typename T, typename Sensor>
+int SensorHistorial<T, Sensor>::recortarHistorial(int cantidad) {
+    int antes = estado.cantidad();
+    
+    if (presupuesto.politica == RETENCION_SUBMUESTREAR) {
+        // Cada pasada reduce el historial a la mitad
+        while (estado.cantidad() > 1 && antes - estado.cantidad() < cantidad) {
+            estado.submuestrear();
+        }
+    } else {
+        descartarAntiguas(cantidad);
+    }
+    
+    int eliminadas = antes - estado.cantidad();
+    rollup.descontarCrudos(eliminadas);
+    estado.publicarPendiente();
+    return eliminadas;
+}
+
+template <typename T, typename Sensor>
+long long SensorHistorial<T, Sensor>::bytesUsados() const {
+    return sizeof(Sensor) + estado.bytesUsados() + rollup.bytesUsados();
+}
+
+template <typename T, typename Sensor>
+AgregadosSensor SensorHistorial<T, Sensor>::obtenerAgregados() const {
+    return estado.leer()->agregados;
+}
+
+template <typename T, typename Sensor>
+bool SensorHistorial<T, Sensor>::publicarEstado() {
+    return estado.publicarPendiente();
+}
+
+template <typename T, typename Sensor>
+const RollupSensor* SensorHistorial<T, Sensor>::obtenerRollup() const {
+    return &rollup;
+}
+
+template <typename T, typename Sensor>
+double SensorHistorial<T, Sensor>::obtenerUltimoResultado() const {
+    return ultimoResultado;
+}
+
+template <typename T, typename Sensor>
+const typename SensorHistorial<T, Sensor>::Historial& SensorHistorial<T, Sensor>::obtenerHistorial() const {
+    return estado.historialVivo();
+}
+
+template <typename T, typename Sensor>
+std::shared_ptr<const InstantaneaSensor<T> > SensorHistorial<T, Sensor>::obtenerInstantanea() const {
+    return estado.leer();
+}
+
+template <typename T, typename Sensor>
+std::shared_ptr<const BuzonInstantanea<T> > SensorHistorial<T, Sensor>::compartirBuzon() const {
+    return estado.compartirBuzon();
+}
+
+template <typename T, typename Sensor>
+std::shared_ptr<const BuzonGenerico> SensorHistorial<T, Sensor>::compartirBuzonGenerico() const {
+    return estado.compartirBuzon();
+}
+
+#endif // SENSOR_HISTORIAL_H
@@ -1,41 +1,84 @@
-/**
- * @file SensorPresion.cpp
- * @brief Implementación del sensor de presión
- */
-
-#include "SensorPresion.h"
-#include <iostream>
-
-using namespace std;
-
-SensorPresion::SensorPresion(const char* nom) : SensorBase(nom) {
-    cout << "[Sensor Presion] Sensor '" << nombre << "' creado." << endl;
-}
-
-SensorPresion::~SensorPresion() {
-    cout << "  [Destructor Sensor " << nombre << "] Liberando sensor de presion..." << endl;
-}
-
-void SensorPresion::registrarLectura(int valor) {
-    cout << "[Sensor " << nombre << "] Registrando lectura: " << valor << " (int)" << endl;
-    historial.insertar(valor);
-}
-
-void SensorPresion::procesarLectura() {
-    cout << "-> Procesando Sensor " << nombre << "..." << endl;
-    
-    if (historial.estaVacia()) {
-        cout << "[Sensor Presion] No hay lecturas para procesar." << endl;
-        return;
-    }
-    
-    int promedio = historial.calcularPromedio();
-    int numLecturas = historial.contarElementos();
-    
-    cout << "[Sensor Presion] Promedio calculado sobre " << numLecturas << " lectura(s) (" << promedio << ")." << endl;
-}
-
-void SensorPresion::imprimirInfo() const {
-    cout << "Sensor: " << nombre << " [Tipo: Presion]" << endl;
-    cout << "Numero de lecturas: " << historial.contarElementos() << endl;
+/**
+ * @file SensorPresion.cpp
+ * @brief Implementación del sensor de presión
+ */
+
+#include "SensorPresion.h"
+#include "Bitacora.h"
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Crea la configuración del detector para sensores de presión
+ */
+static ConfigDetector crearConfigDetector() {
+    // La presion es mas ruidosa: se suaviza menos y tolera saltos mayores
+    ConfigDetector config;
+    config.alfa = 0.2;
+    config.umbralZ = 3.5;
+    config.maxCambio = 25.0;
+    config.maxRepeticiones = 20;
+    return config;
+}
+
+ConfigDetector SensorPresion::configDetector = crearConfigDetector();
+
+SensorPresion::SensorPresion(const char* nom) : SensorHistorial<int, SensorPresion>(nom) {
+    configurarDetector(&configDetector);
+    if (Bitacora::activa()) {
+        cout << "[Sensor Presion] Sensor '" << obtenerNombre() << "' creado." << endl;
+    }
+}
+
+SensorPresion::~SensorPresion() {
+    if (Bitacora::activa()) {
+        cout << "  [Destructor Sensor " << obtenerNombre() << "] Liberando sensor de presion..." << endl;
+    }
+}
+
+void SensorPresion::registrarLectura(int valor) {
+    if (Bitacora::activa()) {
+        cout << "[Sensor " << obtenerNombre() << "] Registrando lectura: " << valor << " (int)" << endl;
+    }
+    anotarLectura(valor);
+}
+
+void SensorPresion::procesarLectura() {
+    cout << "-> Procesando Sensor " << obtenerNombre() << "..." << '\n';
+    
+    if (estado.cantidad() == 0) {
+        cout << "[Sensor Presion] No hay lecturas para procesar." << '\n';
+        estado.publicarPendiente();
+        return;
+    }
+    
+    double promedio = estado.promedio();
+    ultimoResultado = promedio;
+    estado.fijarResultado(promedio);
+    estado.publicarPendiente();
+    int numLecturas = estado.cantidad();
+    
+    cout << "[Sensor Presion] Promedio calculado sobre " << numLecturas << " lectura(s) (" << promedio << ")." << '\n';
+}
+
+void SensorPresion::imprimirInfo() const {
+    cout << "Sensor: " << obtenerNombre() << " [Tipo: Presion]" << endl;
+    // Se informa desde la instantánea: no toca el historial del escritor
+    AgregadosSensor agregados = obtenerAgregados();
+    cout << "Numero de lecturas: " << agregados.cantidad << endl;
+    imprimirDetector();
+}
+
+ConfigDetector& SensorPresion::configuracionDetector() {
+    return configDetector;
+}
+
+int SensorPresion::periodoProcesamientoMs() const {
+    // La presión se procesa cada 100 ms
+    return 100;
+}
+
+TipoSensor SensorPresion::obtenerTipo() const {
+    return SENSOR_PRESION;
 }
\ No newline at end of file
@@ -1,54 +1,79 @@
-/**
- * @file SensorPresion.h
- * @brief Sensor de presión que maneja lecturas tipo int
- * @author Juan Francisco Ortega Pulido
- * @date 2025
- */
-
-#ifndef SENSOR_PRESION_H
-#define SENSOR_PRESION_H
-
-#include "SensorBase.h"
-#include "ListaSensor.h"
-
-/**
- * @class SensorPresion
- * @brief Sensor concreto que gestiona lecturas de presión (int)
- * 
- * Este sensor almacena lecturas de tipo int en una lista enlazada.
- * Su procesamiento consiste en calcular el promedio de todas las lecturas.
- */
-class SensorPresion : public SensorBase {
-private:
-    ListaSensor<int> historial; ///< Lista de lecturas de presión
-    
-public:
-    /**
-     * @brief Constructor del sensor de presión
-     * @param nom Identificador del sensor
-     */
-    SensorPresion(const char* nom);
-    
-    /**
-     * @brief Destructor del sensor
-     */
-    ~SensorPresion();
-    
-    /**
-     * @brief Registra una nueva lectura de presión
-     * @param valor Valor de presión a registrar
-     */
-    void registrarLectura(int valor);
-    
-    /**
-     * @brief Procesa las lecturas: calcula el promedio
-     */
-    void procesarLectura();
-    
-    /**
-     * @brief Imprime la información del sensor
-     */
-    void imprimirInfo() const;
-};
-
+/**
+ * @file SensorPresion.h
+ * @brief Sensor de presión que maneja lecturas tipo int
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef SENSOR_PRESION_H
+#define SENSOR_PRESION_H
+
+#include "SensorHistorial.h"
+
+/**
+ * @class SensorPresion
+ * @brief Sensor concreto que gestiona lecturas de presión (int)
+ * 
+ * Este sensor almacena lecturas de tipo int en un historial contiguo
+ * que también publica sus instantáneas, sin una segunda copia.
+ * Su procesamiento consiste en calcular el promedio de todas las lecturas.
+ *
+ * El registro, la retención y las instantáneas vienen de SensorHistorial.
+ */
+class SensorPresion : public SensorHistorial<int, SensorPresion> {
+public:
+    static const TipoSensor TIPO = SENSOR_PRESION; ///< Tipo concreto, conocido en compilación
+    
+private:
+    static ConfigDetector configDetector; ///< Detector compartido por el tipo
+    
+public:
+    /**
+     * @brief Constructor del sensor de presión
+     * @param nom Identificador del sensor
+     */
+    SensorPresion(const char* nom);
+    
+    /**
+     * @brief Destructor del sensor
+     */
+    ~SensorPresion();
+    
+    /**
+     * @brief Registra una nueva lectura de presión
+     *
+     * La instantánea queda pendiente hasta publicarEstado.
+     * @param valor Valor de presión a registrar
+     */
+    void registrarLectura(int valor);
+    
+    /**
+     * @brief Procesa las lecturas: calcula el promedio
+     */
+    void procesarLectura();
+    
+    /**
+     * @brief Imprime la información del sensor
+     */
+    void imprimirInfo() const;
+    
+    /**
+     * @brief Indica el tipo concreto del sensor
+     * @return SENSOR_PRESION
+     */
+    TipoSensor obtenerTipo() const;
+    
+    /**
+     * @brief Cadencia de procesamiento del tipo
+     * @return 100 ms
+     */
+    int periodoProcesamientoMs() const;
+    
+    /**
+     * @brief Parámetros del detector de anomalías de este tipo de sensor
+     * @return Referencia modificable a la configuración compartida
+     */
+    static ConfigDetector& configuracionDetector();
+};
+
 #endif // SENSOR_PRESION_H
\ No newline at end of file
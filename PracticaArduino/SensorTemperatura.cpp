@@ -1,55 +1,101 @@
-/**
- * @file SensorTemperatura.cpp
- * @brief Implementación del sensor de temperatura
- */
-
-#include "SensorTemperatura.h"
-#include <iostream>
-
-using namespace std;
-
-SensorTemperatura::SensorTemperatura(const char* nom) : SensorBase(nom) {
-    cout << "[Sensor Temp] Sensor '" << nombre << "' creado." << endl;
-}
-
-SensorTemperatura::~SensorTemperatura() {
-    cout << "  [Destructor Sensor " << nombre << "] Liberando sensor de temperatura..." << endl;
-}
-
-void SensorTemperatura::registrarLectura(float valor) {
-    cout << "[Sensor " << nombre << "] Registrando lectura: " << valor << " (float)" << endl;
-    historial.insertar(valor);
-}
-
-void SensorTemperatura::procesarLectura() {
-    cout << "-> Procesando Sensor " << nombre << "..." << endl;
-    
-    if (historial.estaVacia()) {
-        cout << "[Sensor Temp] No hay lecturas para procesar." << endl;
-        return;
-    }
-    
-    int numLecturas = historial.contarElementos();
-    
-    if (numLecturas == 1) {
-        float promedio = historial.calcularPromedio();
-        cout << "[Sensor Temp] Promedio calculado sobre " << numLecturas << " lectura (" << promedio << ")." << endl;
-        return;
-    }
-    
-    // Eliminar el valor más bajo
-    float minimo = historial.eliminarMinimo();
-    cout << "[" << nombre << "] (Temperatura): Lectura mas baja (" << minimo << ") eliminada." << endl;
-    
-    // Calcular promedio del resto
-    if (!historial.estaVacia()) {
-        float promedio = historial.calcularPromedio();
-        int restantes = historial.contarElementos();
-        cout << "Promedio restante sobre " << restantes << " lectura(s): " << promedio << "." << endl;
-    }
-}
-
-void SensorTemperatura::imprimirInfo() const {
-    cout << "Sensor: " << nombre << " [Tipo: Temperatura]" << endl;
-    cout << "Numero de lecturas: " << historial.contarElementos() << endl;
+/**
+ * @file SensorTemperatura.cpp
+ * @brief Implementación del sensor de temperatura
+ */
+
+#include "SensorTemperatura.h"
+#include "Bitacora.h"
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Crea la configuración del detector para sensores de temperatura
+ */
+static ConfigDetector crearConfigDetector() {
+    // Cambios de mas de 10 grados entre lecturas son sospechosos
+    ConfigDetector config;
+    config.alfa = 0.1;
+    config.umbralZ = 3.0;
+    config.maxCambio = 10.0;
+    config.maxRepeticiones = 20;
+    return config;
+}
+
+ConfigDetector SensorTemperatura::configDetector = crearConfigDetector();
+
+SensorTemperatura::SensorTemperatura(const char* nom) : SensorHistorial<float, SensorTemperatura>(nom) {
+    configurarDetector(&configDetector);
+    if (Bitacora::activa()) {
+        cout << "[Sensor Temp] Sensor '" << obtenerNombre() << "' creado." << endl;
+    }
+}
+
+SensorTemperatura::~SensorTemperatura() {
+    if (Bitacora::activa()) {
+        cout << "  [Destructor Sensor " << obtenerNombre() << "] Liberando sensor de temperatura..." << endl;
+    }
+}
+
+void SensorTemperatura::registrarLectura(float valor) {
+    if (Bitacora::activa()) {
+        cout << "[Sensor " << obtenerNombre() << "] Registrando lectura: " << valor << " (float)" << endl;
+    }
+    anotarLectura(valor);
+}
+
+void SensorTemperatura::procesarLectura() {
+    cout << "-> Procesando Sensor " << obtenerNombre() << "..." << '\n';
+    
+    if (estado.cantidad() == 0) {
+        cout << "[Sensor Temp] No hay lecturas para procesar." << '\n';
+        estado.publicarPendiente();
+        return;
+    }
+    
+    int numLecturas = estado.cantidad();
+    
+    if (numLecturas == 1) {
+        double promedio = estado.promedio();
+        ultimoResultado = promedio;
+        estado.fijarResultado(promedio);
+        estado.publicarPendiente();
+        cout << "[Sensor Temp] Promedio calculado sobre " << numLecturas << " lectura (" << promedio << ")." << '\n';
+        return;
+    }
+    
+    // Eliminar el valor más bajo
+    float minimo = estado.eliminarMinimo();
+    cout << "[" << obtenerNombre() << "] (Temperatura): Lectura mas baja (" << minimo << ") eliminada." << '\n';
+    
+    // Calcular promedio del resto
+    if (!estado.cantidad() == 0) {
+        double promedio = estado.promedio();
+        ultimoResultado = promedio;
+        estado.fijarResultado(promedio);
+        int restantes = estado.cantidad();
+        cout << "Promedio restante sobre " << restantes << " lectura(s): " << promedio << "." << '\n';
+    }
+    estado.publicarPendiente();
+}
+
+void SensorTemperatura::imprimirInfo() const {
+    cout << "Sensor: " << obtenerNombre() << " [Tipo: Temperatura]" << endl;
+    // Se informa desde la instantánea: no toca el historial del escritor
+    AgregadosSensor agregados = obtenerAgregados();
+    cout << "Numero de lecturas: " << agregados.cantidad << endl;
+    imprimirDetector();
+}
+
+ConfigDetector& SensorTemperatura::configuracionDetector() {
+    return configDetector;
+}
+
+int SensorTemperatura::periodoProcesamientoMs() const {
+    // La temperatura cambia lento: se procesa cada segundo
+    return 1000;
+}
+
+TipoSensor SensorTemperatura::obtenerTipo() const {
+    return SENSOR_TEMPERATURA;
 }
\ No newline at end of file
@@ -1,55 +1,80 @@
-/**
- * @file SensorTemperatura.h
- * @brief Sensor de temperatura que maneja lecturas tipo float
- * @author Juan Francisco Ortega Pulido
- * @date 2025
- */
-
-#ifndef SENSOR_TEMPERATURA_H
-#define SENSOR_TEMPERATURA_H
-
-#include "SensorBase.h"
-#include "ListaSensor.h"
-
-/**
- * @class SensorTemperatura
- * @brief Sensor concreto que gestiona lecturas de temperatura (float)
- * 
- * Este sensor almacena lecturas de tipo float en una lista enlazada.
- * Su procesamiento consiste en eliminar el valor más bajo y calcular
- * el promedio del resto.
- */
-class SensorTemperatura : public SensorBase {
-private:
-    ListaSensor<float> historial; ///< Lista de lecturas de temperatura
-    
-public:
-    /**
-     * @brief Constructor del sensor de temperatura
-     * @param nom Identificador del sensor
-     */
-    SensorTemperatura(const char* nom);
-    
-    /**
-     * @brief Destructor del sensor
-     */
-    ~SensorTemperatura();
-    
-    /**
-     * @brief Registra una nueva lectura de temperatura
-     * @param valor Valor de temperatura a registrar
-     */
-    void registrarLectura(float valor);
-    
-    /**
-     * @brief Procesa las lecturas: elimina el mínimo y calcula promedio
-     */
-    void procesarLectura();
-    
-    /**
-     * @brief Imprime la información del sensor
-     */
-    void imprimirInfo() const;
-};
-
+/**
+ * @file SensorTemperatura.h
+ * @brief Sensor de temperatura que maneja lecturas tipo float
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef SENSOR_TEMPERATURA_H
+#define SENSOR_TEMPERATURA_H
+
+#include "SensorHistorial.h"
+
+/**
+ * @class SensorTemperatura
+ * @brief Sensor concreto que gestiona lecturas de temperatura (float)
+ * 
+ * Este sensor almacena lecturas de tipo float en un historial contiguo
+ * que también publica sus instantáneas, sin una segunda copia.
+ * Su procesamiento consiste en eliminar el valor más bajo y calcular
+ * el promedio del resto.
+ *
+ * El registro, la retención y las instantáneas vienen de SensorHistorial.
+ */
+class SensorTemperatura : public SensorHistorial<float, SensorTemperatura> {
+public:
+    static const TipoSensor TIPO = SENSOR_TEMPERATURA; ///< Tipo concreto, conocido en compilación
+    
+private:
+    static ConfigDetector configDetector; ///< Detector compartido por el tipo
+    
+public:
+    /**
+     * @brief Constructor del sensor de temperatura
+     * @param nom Identificador del sensor
+     */
+    SensorTemperatura(const char* nom);
+    
+    /**
+     * @brief Destructor del sensor
+     */
+    ~SensorTemperatura();
+    
+    /**
+     * @brief Registra una nueva lectura de temperatura
+     *
+     * La instantánea queda pendiente hasta publicarEstado.
+     * @param valor Valor de temperatura a registrar
+     */
+    void registrarLectura(float valor);
+    
+    /**
+     * @brief Procesa las lecturas: elimina el mínimo y calcula promedio
+     */
+    void procesarLectura();
+    
+    /**
+     * @brief Imprime la información del sensor
+     */
+    void imprimirInfo() const;
+    
+    /**
+     * @brief Indica el tipo concreto del sensor
+     * @return SENSOR_TEMPERATURA
+     */
+    TipoSensor obtenerTipo() const;
+    
+    /**
+     * @brief Cadencia de procesamiento del tipo
+     * @return 1000 ms
+     */
+    int periodoProcesamientoMs() const;
+    
+    /**
+     * @brief Parámetros del detector de anomalías de este tipo de sensor
+     * @return Referencia modificable a la configuración compartida
+     */
+    static ConfigDetector& configuracionDetector();
+};
+
 #endif // SENSOR_TEMPERATURA_H
\ No newline at end of file
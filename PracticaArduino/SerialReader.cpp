@@ -1,96 +1,285 @@
-/**
- * @file SerialReader.cpp
- * @brief Implementación del lector del puerto serial
- */
-
-#include "SerialReader.h"
-#include <iostream>
-
-using namespace std;
-
-SerialReader::SerialReader(const char* nombrePuerto) {
-    conectado = false;
-    
-#ifdef _WIN32
-    // Código para Windows
-    puerto = CreateFileA(nombrePuerto,
-                         GENERIC_READ | GENERIC_WRITE,
-                         0,
-                         0,
-                         OPEN_EXISTING,
-                         0,
-                         0);
-    
-    if (puerto == INVALID_HANDLE_VALUE) {
-        cout << "[Error] No se pudo abrir el puerto " << nombrePuerto << endl;
-        return;
-    }
-    
-    DCB parametros = {0};
-    parametros.DCBlength = sizeof(parametros);
-    
-    if (!GetCommState(puerto, &parametros)) {
-        cout << "[Error] No se pudo obtener el estado del puerto" << endl;
-        return;
-    }
-    
-    parametros.BaudRate = CBR_9600;
-    parametros.ByteSize = 8;
-    parametros.StopBits = ONESTOPBIT;
-    parametros.Parity = NOPARITY;
-    
-    if (!SetCommState(puerto, &parametros)) {
-        cout << "[Error] No se pudieron configurar los parametros" << endl;
-        return;
-    }
-    
-    COMMTIMEOUTS timeouts = {0};
-    timeouts.ReadIntervalTimeout = 50;
-    timeouts.ReadTotalTimeoutConstant = 50;
-    timeouts.ReadTotalTimeoutMultiplier = 10;
-    
-    if (!SetCommTimeouts(puerto, &timeouts)) {
-        cout << "[Error] No se pudieron configurar los timeouts" << endl;
-        return;
-    }
-    
-    conectado = true;
-    cout << "[OK] Puerto " << nombrePuerto << " abierto correctamente" << endl;
-    
-#else
-    // Código para Linux/Mac
-    puerto = open(nombrePuerto, O_RDWR | O_NOCTTY);
-    
-    if (puerto < 0) {
-        cout << "[Error] No se pudo abrir el puerto " << nombrePuerto << endl;
-        return;
-    }
-    
-    struct termios opciones;
-    tcgetattr(puerto, &opciones);
-    
-    cfsetispeed(&opciones, B9600);
-    cfsetospeed(&opciones, B9600);
-    
-    opciones.c_cflag &= ~PARENB;
-    opciones.c_cflag &= ~CSTOPB;
-    opciones.c_cflag &= ~CSIZE;
-    opciones.c_cflag |= CS8;
-    opciones.c_cflag &= ~CRTSCTS;
-    opciones.c_cflag |= CREAD | CLOCAL;
-    
-    opciones.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
-    opciones.c_oflag &= ~OPOST;
-    opciones.c_iflag &= ~(IXON | IXOFF | IXANY);
-    
-    tcsetattr(puerto, TCSANOW, &opciones);
-    
-    conectado = true;
-    cout << "[OK] Puerto " << nombrePuerto << " abierto correctamente" << endl;
-#endif
-}
-
-SerialReader::~SerialReader() {
-    if (conectado) {
-#ifdef _WIN32
-        Cl
\ No newline at end of file
+/**
+ * @file SerialReader.cpp
+ * @brief Implementación del lector del puerto serial
+ */
+
+#include "SerialReader.h"
+#include <iostream>
+#include <cstring>
+
+#ifdef __linux__
+    #include <sys/ioctl.h>
+    #include <linux/serial.h>
+#endif
+
+using namespace std;
+
+#ifndef _WIN32
+/**
+ * @brief Constante de termios para una velocidad en baudios
+ * @return B0 si la velocidad no es estándar
+ */
+static speed_t velocidadTermios(int baudios) {
+    switch (baudios) {
+        case 1200: return B1200;
+        case 2400: return B2400;
+        case 4800: return B4800;
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+#ifdef B460800
+        case 460800: return B460800;
+#endif
+#ifdef B921600
+        case 921600: return B921600;
+#endif
+        default: return B0;
+    }
+}
+#endif
+
+SerialReader::SerialReader(const char* nombrePuerto, const ConfigSerial& parametros) {
+    conectado = false;
+    config = parametros;
+    latenciaDriver = false;
+    usadosPendiente = 0;
+    inicioRecibidos = 0;
+    finRecibidos = 0;
+    
+#ifdef _WIN32
+    // Código para Windows
+    puerto = CreateFileA(nombrePuerto,
+                         GENERIC_READ | GENERIC_WRITE,
+                         0,
+                         0,
+                         OPEN_EXISTING,
+                         0,
+                         0);
+    
+    if (puerto == INVALID_HANDLE_VALUE) {
+        cout << "[Error] No se pudo abrir el puerto " << nombrePuerto << endl;
+        return;
+    }
+    
+    DCB dcb = {0};
+    dcb.DCBlength = sizeof(dcb);
+    
+    if (!GetCommState(puerto, &dcb)) {
+        cout << "[Error] No se pudo obtener el estado del puerto" << endl;
+        return;
+    }
+    
+    dcb.BaudRate = config.baudios;
+    dcb.ByteSize = 8;
+    dcb.StopBits = ONESTOPBIT;
+    dcb.Parity = NOPARITY;
+    
+    if (!SetCommState(puerto, &dcb)) {
+        cout << "[Error] No se pudieron configurar los parametros" << endl;
+        return;
+    }
+    
+    COMMTIMEOUTS timeouts = {0};
+    if (config.bajaLatencia && config.vtime == 0) {
+        // ReadFile vuelve en el acto con lo que haya (lectura por sondeo)
+        timeouts.ReadIntervalTimeout = MAXDWORD;
+        timeouts.ReadTotalTimeoutConstant = 0;
+        timeouts.ReadTotalTimeoutMultiplier = 0;
+        latenciaDriver = true;
+    } else if (config.bajaLatencia) {
+        // Como VMIN = 0 con VTIME: vuelve con el primer byte que llegue, o
+        // tras vtime décimas sin datos (sin sondeo, p. ej. con un solo núcleo)
+        timeouts.ReadIntervalTimeout = MAXDWORD;
+        timeouts.ReadTotalTimeoutConstant = config.vtime * 100;
+        timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+        latenciaDriver = true;
+    } else {
+        timeouts.ReadIntervalTimeout = 50;
+        timeouts.ReadTotalTimeoutConstant = config.vtime * 100;
+        timeouts.ReadTotalTimeoutMultiplier = 10;
+    }
+    
+    if (!SetCommTimeouts(puerto, &timeouts)) {
+        cout << "[Error] No se pudieron configurar los timeouts" << endl;
+        return;
+    }
+    
+    conectado = true;
+    cout << "[OK] Puerto " << nombrePuerto << " abierto correctamente" << endl;
+    
+#else
+    // Código para Linux/Mac
+    puerto = open(nombrePuerto, O_RDWR | O_NOCTTY);
+    
+    if (puerto < 0) {
+        cout << "[Error] No se pudo abrir el puerto " << nombrePuerto << endl;
+        return;
+    }
+    
+    speed_t velocidad = velocidadTermios(config.baudios);
+    if (velocidad == B0) {
+        cout << "[Advertencia] Velocidad " << config.baudios << " no soportada, se usa 9600" << endl;
+        config.baudios = 9600;
+        velocidad = B9600;
+    }
+    
+    struct termios opciones;
+    tcgetattr(puerto, &opciones);
+    
+    cfsetispeed(&opciones, velocidad);
+    cfsetospeed(&opciones, velocidad);
+    
+    opciones.c_cflag &= ~PARENB;
+    opciones.c_cflag &= ~CSTOPB;
+    opciones.c_cflag &= ~CSIZE;
+    opciones.c_cflag |= CS8;
+    opciones.c_cflag &= ~CRTSCTS;
+    opciones.c_cflag |= CREAD | CLOCAL;
+    
+    opciones.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
+    opciones.c_oflag &= ~OPOST;
+    opciones.c_iflag &= ~(IXON | IXOFF | IXANY | ICRNL | INLCR | IGNCR);
+    
+    // Por defecto read() vuelve tras 100 ms sin datos: quien lee puede
+    // atender otras cosas. VMIN = VTIME = 0 vuelve en el acto (sondeo).
+    opciones.c_cc[VMIN] = (cc_t)config.vmin;
+    opciones.c_cc[VTIME] = (cc_t)config.vtime;
+    
+    tcsetattr(puerto, TCSANOW, &opciones);
+    
+#ifdef __linux__
+    if (config.bajaLatencia) {
+        // Sin esto los adaptadores USB-serie (FTDI) retienen hasta 16 ms
+        struct serial_struct serie;
+        if (ioctl(puerto, TIOCGSERIAL, &serie) == 0) {
+            serie.flags |= ASYNC_LOW_LATENCY;
+            latenciaDriver = ioctl(puerto, TIOCSSERIAL, &serie) == 0;
+        }
+        if (!latenciaDriver) {
+            cout << "[Advertencia] El driver no admite ASYNC_LOW_LATENCY" << endl;
+        }
+    }
+#endif
+    
+    conectado = true;
+    cout << "[OK] Puerto " << nombrePuerto << " abierto correctamente" << endl;
+#endif
+}
+
+SerialReader::~SerialReader() {
+    if (conectado) {
+#ifdef _WIN32
+        CloseHandle(puerto);
+#else
+        close(puerto);
+#endif
+        cout << "[OK] Puerto serial cerrado" << endl;
+    }
+}
+
+bool SerialReader::estaConectado() const {
+    return conectado;
+}
+
+ConfigSerial SerialReader::configuracion() const {
+    return config;
+}
+
+bool SerialReader::latenciaBajaActiva() const {
+    return latenciaDriver;
+}
+
+int SerialReader::leerLinea(char* buffer, int tamMax) {
+    if (!conectado) {
+        return -1;
+    }
+    
+    while (true) {
+        if (inicioRecibidos == finRecibidos) {
+#ifdef _WIN32
+            DWORD bytesLeidos = 0;
+            if (!ReadFile(puerto, recibidos, sizeof(recibidos), &bytesLeidos, 0)) {
+                return -1;
+            }
+#else
+            int bytesLeidos = read(puerto, recibidos, sizeof(recibidos));
+            if (bytesLeidos < 0) {
+                return -1;
+            }
+#endif
+            if (bytesLeidos == 0) {
+                // Se agotó la espera: lo recibido queda para la próxima llamada
+                return 0;
+            }
+            inicioRecibidos = 0;
+            finRecibidos = (int)bytesLeidos;
+        }
+        
+        while (inicioRecibidos < finRecibidos) {
+            char caracter = recibidos[inicioRecibidos];
+            inicioRecibidos = inicioRecibidos + 1;
+            
+            if (caracter == '\n') {
+                int longitud = usadosPendiente;
+                if (longitud > tamMax - 1) {
+                    longitud = tamMax - 1;
+                }
+                for (int i = 0; i < longitud; i++) {
+                    buffer[i] = pendiente[i];
+                }
+                buffer[longitud] = '\0';
+                usadosPendiente = 0;
+                return longitud;
+            }
+            // Las líneas más largas que el búfer se truncan
+            if (caracter != '\r' && usadosPendiente < (int)sizeof(pendiente) - 1) {
+                pendiente[usadosPendiente] = caracter;
+                usadosPendiente = usadosPendiente + 1;
+            }
+        }
+    }
+}
+
+int SerialReader::leerBloque(char* destino, int maximo) {
+    if (!conectado) {
+        return -1;
+    }
+    
+    // Primero lo que leerLinea dejó sin recorrer
+    if (inicioRecibidos < finRecibidos) {
+        int copiar = finRecibidos - inicioRecibidos;
+        if (copiar > maximo) {
+            copiar = maximo;
+        }
+        memcpy(destino, recibidos + inicioRecibidos, copiar);
+        inicioRecibidos = inicioRecibidos + copiar;
+        return copiar;
+    }
+    
+#ifdef _WIN32
+    DWORD bytesLeidos = 0;
+    if (!ReadFile(puerto, destino, maximo, &bytesLeidos, 0)) {
+        return -1;
+    }
+    return (int)bytesLeidos;
+#else
+    int bytesLeidos = read(puerto, destino, maximo);
+    return bytesLeidos < 0 ? -1 : bytesLeidos;
+#endif
+}
+
+bool SerialReader::enviarByte(unsigned char byte) {
+    if (!conectado) {
+        return false;
+    }
+    
+#ifdef _WIN32
+    DWORD escritos = 0;
+    return WriteFile(puerto, &byte, 1, &escritos, 0) && escritos == 1;
+#else
+    return write(puerto, &byte, 1) == 1;
+#endif
+}
\ No newline at end of file
@@ -1,61 +1,136 @@
-/**
- * @file SerialReader.h
- * @brief Clase para leer datos del puerto serial del Arduino
- * @author Juan Francisco Ortega Pulido
- * @date 2025
- */
-
-#ifndef SERIAL_READER_H
-#define SERIAL_READER_H
-
-#ifdef _WIN32
-    #include <windows.h>
-#else
-    #include <fcntl.h>
-    #include <termios.h>
-    #include <unistd.h>
-#endif
-
-/**
- * @class SerialReader
- * @brief Maneja la comunicación con el Arduino por puerto serial
- * 
- * Esta clase abstrae la lectura del puerto serial para Windows y Linux/Mac
- */
-class SerialReader {
-private:
-#ifdef _WIN32
-    HANDLE puerto;  ///< Handle del puerto en Windows
-#else
-    int puerto;     ///< File descriptor en Linux/Mac
-#endif
-    bool conectado; ///< Estado de la conexión
-    
-public:
-    /**
-     * @brief Constructor que intenta abrir el puerto
-     * @param nombrePuerto Nombre del puerto (ej: "COM3" en Windows, "/dev/ttyUSB0" en Linux)
-     */
-    SerialReader(const char* nombrePuerto);
-    
-    /**
-     * @brief Destructor que cierra el puerto
-     */
-    ~SerialReader();
-    
-    /**
-     * @brief Verifica si el puerto está conectado
-     * @return true si está conectado
-     */
-    bool estaConectado() const;
-    
-    /**
-     * @brief Lee una línea del puerto serial
-     * @param buffer Buffer donde se almacenará la línea
-     * @param tamMax Tamaño máximo del buffer
-     * @return Número de caracteres leídos, -1 si hay error
-     */
-    int leerLinea(char* buffer, int tamMax);
-};
-
+/**
+ * @file SerialReader.h
+ * @brief Clase para leer datos del puerto serial del Arduino
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef SERIAL_READER_H
+#define SERIAL_READER_H
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <termios.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @brief Parámetros del puerto serial
+ */
+struct ConfigSerial {
+    int baudios;        ///< Velocidad (debe coincidir con la del dispositivo)
+    int vmin;           ///< VMIN: bytes mínimos que espera cada read (POSIX)
+    int vtime;          ///< VTIME: espera máxima de read en décimas de segundo (POSIX)
+    bool bajaLatencia;  ///< Pedir al driver que entregue cada byte sin agrupar
+    
+    /**
+     * @brief Valores por defecto: 9600 baudios, read vuelve tras 100 ms sin datos
+     */
+    ConfigSerial() {
+        baudios = 9600;
+        vmin = 0;
+        vtime = 1;
+        bajaLatencia = false;
+    }
+};
+
+/**
+ * @class SerialReader
+ * @brief Maneja la comunicación con el Arduino por puerto serial
+ * 
+ * Esta clase abstrae la lectura del puerto serial para Windows y Linux/Mac
+ *
+ * Las lecturas esperan como máximo VTIME (~100 ms por defecto); una línea
+ * que llega a medias se conserva hasta completarse. Se lee por bloques,
+ * no byte a byte: una llamada al sistema trae todo lo que el driver tenga.
+ * enviarByte permite devolver señales de control de flujo (XON/XOFF) al
+ * dispositivo.
+ *
+ * Con bajaLatencia se activa ASYNC_LOW_LATENCY en Linux (los adaptadores
+ * USB-serie agrupan los bytes hasta 16 ms si no). En Windows ReadFile
+ * vuelve con el primer byte y, con vtime = 0, también sin datos (sondeo).
+ * Los pseudoterminales no lo admiten: se avisa y se sigue.
+ */
+class SerialReader {
+private:
+#ifdef _WIN32
+    HANDLE puerto;  ///< Handle del puerto en Windows
+#else
+    int puerto;     ///< File descriptor en Linux/Mac
+#endif
+    bool conectado; ///< Estado de la conexión
+    ConfigSerial config;  ///< Parámetros con los que se abrió
+    bool latenciaDriver;  ///< true si el driver aceptó el modo de baja latencia
+    char pendiente[256];  ///< Línea recibida a medias
+    int usadosPendiente;  ///< Caracteres válidos en pendiente
+    char recibidos[512];  ///< Bloque leído del puerto aún sin recorrer
+    int inicioRecibidos;  ///< Primer byte sin recorrer en recibidos
+    int finRecibidos;     ///< Bytes válidos en recibidos
+    
+public:
+    /**
+     * @brief Caracteres de control de flujo por software
+     */
+    enum {
+        CARACTER_XON = 0x11,  ///< Reanudar el envío (DC1)
+        CARACTER_XOFF = 0x13  ///< Pausar el envío (DC3)
+    };
+    
+    /**
+     * @brief Constructor que intenta abrir el puerto
+     * @param nombrePuerto Nombre del puerto (ej: "COM3" en Windows, "/dev/ttyUSB0" en Linux)
+     * @param parametros Velocidad, VMIN/VTIME y modo de baja latencia
+     */
+    SerialReader(const char* nombrePuerto, const ConfigSerial& parametros = ConfigSerial());
+    
+    /**
+     * @brief Destructor que cierra el puerto
+     */
+    ~SerialReader();
+    
+    /**
+     * @brief Verifica si el puerto está conectado
+     * @return true si está conectado
+     */
+    bool estaConectado() const;
+    
+    /**
+     * @brief Parámetros con los que se abrió el puerto
+     * @return Copia de la configuración
+     */
+    ConfigSerial configuracion() const;
+    
+    /**
+     * @brief Indica si el driver aceptó el modo de baja latencia
+     * @return true si ASYNC_LOW_LATENCY (o su equivalente) quedó activo
+     */
+    bool latenciaBajaActiva() const;
+    
+    /**
+     * @brief Lee una línea del puerto serial
+     * @param buffer Buffer donde se almacenará la línea
+     * @param tamMax Tamaño máximo del buffer
+     * @return Número de caracteres leídos, 0 si no se completó una línea
+     *         a tiempo, -1 si hay error
+     */
+    int leerLinea(char* buffer, int tamMax);
+    
+    /**
+     * @brief Lee los bytes que haya, sin separar líneas
+     * @param destino Donde copiar los bytes
+     * @param maximo Bytes a leer como máximo
+     * @return Bytes leídos, 0 si no llegó nada a tiempo, -1 si hay error
+     */
+    int leerBloque(char* destino, int maximo);
+    
+    /**
+     * @brief Envía un byte al dispositivo (por ejemplo XON o XOFF)
+     * @param byte Byte a enviar
+     * @return true si se escribió
+     */
+    bool enviarByte(unsigned char byte);
+};
+
 #endif // SERIAL_READER_H
\ No newline at end of file
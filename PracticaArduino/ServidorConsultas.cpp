@@ -0,0 +1,632 @@
+/**
+ * @file ServidorConsultas.cpp
+ * @brief Implementación del servidor de consultas local
+ */
+
+#include "ServidorConsultas.h"
+#include "DirectorioSensores.h"
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+using namespace std;
+
+#ifndef _WIN32
+
+// Un cliente que no lee su salida se desconecta al pasar este límite
+static const int LIMITE_SALIDA = 4 * 1024 * 1024;
+static const int TAMANO_ENTRADA = 4096;
+static const int ESPERA_POLL_MS = 20;
+
+/**
+ * @brief Sensor al que un cliente está suscrito
+ */
+struct Suscripcion {
+    EntradaDirectorio entrada; ///< Copia de la entrada (conserva el buzón)
+    unsigned int version;      ///< Última versión enviada
+};
+
+/**
+ * @brief Estado de una conexión abierta
+ */
+struct ConexionCliente {
+    int fd;                          ///< Socket del cliente
+    char entrada[TAMANO_ENTRADA];    ///< Bytes recibidos sin línea completa
+    int usados;                      ///< Bytes válidos en entrada
+    char* salida;                    ///< Respuestas pendientes de enviar
+    int salidaUsada;                 ///< Bytes escritos en salida
+    int salidaEnviada;               ///< Bytes de salida ya enviados
+    int salidaCapacidad;             ///< Capacidad de salida
+    ArregloDinamico<Suscripcion> suscripciones; ///< Sensores suscritos
+    
+    ConexionCliente(int descriptor) {
+        fd = descriptor;
+        usados = 0;
+        salida = 0;
+        salidaUsada = 0;
+        salidaEnviada = 0;
+        salidaCapacidad = 0;
+    }
+    
+    ~ConexionCliente() {
+        delete[] salida;
+        close(fd);
+    }
+    
+    /**
+     * @brief Encola bytes de respuesta
+     */
+    void escribir(const char* texto, int longitud) {
+        if (salidaEnviada > 0 && salidaEnviada == salidaUsada) {
+            salidaEnviada = 0;
+            salidaUsada = 0;
+        }
+        if (salidaUsada + longitud > salidaCapacidad) {
+            // Compactar lo ya enviado antes de crecer
+            int pendientes = salidaUsada - salidaEnviada;
+            int nuevaCapacidad = salidaCapacidad == 0 ? 4096 : salidaCapacidad;
+            while (pendientes + longitud > nuevaCapacidad) {
+                nuevaCapacidad = nuevaCapacidad * 2;
+            }
+            char* nueva = new char[nuevaCapacidad];
+            if (pendientes > 0) {
+                memcpy(nueva, salida + salidaEnviada, pendientes);
+            }
+            delete[] salida;
+            salida = nueva;
+            salidaCapacidad = nuevaCapacidad;
+            salidaUsada = pendientes;
+            salidaEnviada = 0;
+        }
+        memcpy(salida + salidaUsada, texto, longitud);
+        salidaUsada = salidaUsada + longitud;
+    }
+    
+    void escribir(const char* texto) {
+        escribir(texto, (int)strlen(texto));
+    }
+    
+    int pendientes() const {
+        return salidaUsada - salidaEnviada;
+    }
+    
+    /**
+     * @brief Envía lo que el socket acepte sin bloquear
+     * @return false si la conexión se cerró
+     */
+    bool enviar() {
+        while (salidaEnviada < salidaUsada) {
+            ssize_t n = send(fd, salida + salidaEnviada, salidaUsada - salidaEnviada, MSG_NOSIGNAL);
+            if (n < 0) {
+                return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+            }
+            salidaEnviada = salidaEnviada + (int)n;
+        }
+        return true;
+    }
+};
+
+static bool ponerNoBloqueante(int fd) {
+    int banderas = fcntl(fd, F_GETFL, 0);
+    return banderas >= 0 && fcntl(fd, F_SETFL, banderas | O_NONBLOCK) == 0;
+}
+
+static const char* nombreTipo(TipoSensor tipo) {
+    if (tipo == SENSOR_TEMPERATURA) {
+        return "TEMPERATURA";
+    }
+    if (tipo == SENSOR_PRESION) {
+        return "PRESION";
+    }
+    return "OTRO";
+}
+
+/**
+ * @brief k-ésimo menor de valores[0..n) (reordena el arreglo)
+ */
+static double seleccionar(double* valores, int n, int k) {
+    int izquierda = 0;
+    int derecha = n - 1;
+    
+    while (izquierda < derecha) {
+        double pivote = valores[izquierda + (derecha - izquierda) / 2];
+        int i = izquierda;
+        int j = derecha;
+        while (i <= j) {
+            while (valores[i] < pivote) {
+                i = i + 1;
+            }
+            while (valores[j] > pivote) {
+                j = j - 1;
+            }
+            if (i <= j) {
+                double temp = valores[i];
+                valores[i] = valores[j];
+                valores[j] = temp;
+                i = i + 1;
+                j = j - 1;
+            }
+        }
+        if (k <= j) {
+            derecha = j;
+        } else if (k >= i) {
+            izquierda = i;
+        } else {
+            break;
+        }
+    }
+    return valores[k];
+}
+
+/**
+ * @brief Agregados de la última instantánea de una entrada
+ */
+static AgregadosSensor agregadosDe(const EntradaDirectorio& entrada) {
+    if (entrada.temperatura) {
+        shared_ptr<const InstantaneaSensor<float> > foto = entrada.temperatura->leer();
+        if (foto) {
+            return foto->agregados;
+        }
+    } else if (entrada.presion) {
+        shared_ptr<const InstantaneaSensor<int> > foto = entrada.presion->leer();
+        if (foto) {
+            return foto->agregados;
+        }
+    } else if (entrada.generico) {
+        AgregadosSensor agregados;
+        if (entrada.generico->leerAgregados(agregados)) {
+            return agregados;
+        }
+    }
+    AgregadosSensor vacio;
+    vacio.id = entrada.id;
+    vacio.tipo = entrada.tipo;
+    return vacio;
+}
+
+/**
+ * @brief Copia el historial vivo de una instantánea como double
+ * @return Arreglo nuevo (lo libera quien llama) o 0 si está vacío
+ */
+template <typename T>
+static double* copiarHistorial(const shared_ptr<const BuzonInstantanea<T> >& buzon, int& cantidad) {
+    cantidad = 0;
+    shared_ptr<const InstantaneaSensor<T> > foto = buzon->leer();
+    if (!foto || foto->historial.tamano() == 0) {
+        return 0;
+    }
+    cantidad = foto->historial.tamano();
+    const T* datos = foto->historial.datos();
+    double* copia = new double[cantidad];
+    for (int i = 0; i < cantidad; i++) {
+        copia[i] = datos[i];
+    }
+    return copia;
+}
+
+/**
+ * @brief Copia el historial de un buzón sin tipo (sensores genéricos)
+ * @return Arreglo nuevo (lo libera quien llama) o 0 si está vacío
+ */
+static double* copiarHistorial(const shared_ptr<const BuzonGenerico>& buzon, int& cantidad) {
+    cantidad = 0;
+    AgregadosSensor agregados;
+    ArregloDinamico<double> lecturas;
+    if (!buzon->copiarLecturas(agregados, lecturas) || lecturas.tamano() == 0) {
+        return 0;
+    }
+    cantidad = lecturas.tamano();
+    double* copia = new double[cantidad];
+    for (int i = 0; i < cantidad; i++) {
+        copia[i] = lecturas[i];
+    }
+    return copia;
+}
+
+/**
+ * @brief Envía las lecturas posteriores a la última versión enviada
+ */
+template <typename T>
+static void enviarNuevas(ConexionCliente* cliente, Suscripcion& sub,
+                         const shared_ptr<const BuzonInstantanea<T> >& buzon) {
+    shared_ptr<const InstantaneaSensor<T> > foto = buzon->leer();
+    if (!foto || foto->agregados.version == sub.version) {
+        return;
+    }
+    
+    unsigned int nuevas = foto->agregados.version - sub.version;
+    sub.version = foto->agregados.version;
+    
+    // Si el historial ya se recortó, solo quedan las más recientes
+    int disponibles = foto->historial.tamano();
+    int desde = disponibles - (int)nuevas;
+    if (desde < 0) {
+        desde = 0;
+    }
+    
+    char linea[128];
+    for (int i = desde; i < disponibles; i++) {
+        int n = snprintf(linea, sizeof(linea), "DATO %s %.9g\n",
+                         sub.entrada.nombre, (double)foto->historial[i]);
+        cliente->escribir(linea, n);
+    }
+}
+
+/**
+ * @brief Igual que enviarNuevas, para un buzón sin tipo
+ */
+static void enviarNuevas(ConexionCliente* cliente, Suscripcion& sub, const shared_ptr<const BuzonGenerico>& buzon) {
+    // Los agregados bastan para saber si hay algo nuevo: no copiar el historial en vano
+    AgregadosSensor agregados;
+    if (!buzon->leerAgregados(agregados) || agregados.version == sub.version) {
+        return;
+    }
+    
+    ArregloDinamico<double> lecturas;
+    if (!buzon->copiarLecturas(agregados, lecturas)) {
+        return;
+    }
+    unsigned int nuevas = agregados.version - sub.version;
+    sub.version = agregados.version;
+    
+    // Si el historial ya se recortó, solo quedan las más recientes
+    int disponibles = lecturas.tamano();
+    int desde = disponibles - (int)nuevas;
+    if (desde < 0) {
+        desde = 0;
+    }
+    
+    char linea[128];
+    for (int i = desde; i < disponibles; i++) {
+        int n = snprintf(linea, sizeof(linea), "DATO %s %.9g\n", sub.entrada.nombre, lecturas[i]);
+        cliente->escribir(linea, n);
+    }
+}
+
+/**
+ * @brief Interpreta y responde una línea de petición
+ */
+static void atenderPeticion(ConexionCliente* cliente, char* linea, const DirectorioSensores& directorio) {
+    char* resto = 0;
+    char* comando = strtok_r(linea, " \t\r", &resto);
+    if (comando == 0) {
+        return;
+    }
+    
+    char respuesta[512];
+    
+    if (strcmp(comando, "PING") == 0) {
+        cliente->escribir("OK\n");
+        return;
+    }
+    
+    if (strcmp(comando, "LIST") == 0) {
+        int n = snprintf(respuesta, sizeof(respuesta), "OK %d\n", directorio.tamano());
+        cliente->escribir(respuesta, n);
+        for (int i = 0; i < directorio.tamano(); i++) {
+            const EntradaDirectorio& entrada = directorio[i];
+            n = snprintf(respuesta, sizeof(respuesta), "%s %s %d\n", entrada.nombre,
+                         nombreTipo(entrada.tipo), agregadosDe(entrada).cantidad);
+            cliente->escribir(respuesta, n);
+        }
+        return;
+    }
+    
+    char* nombre = strtok_r(0, " \t\r", &resto);
+    bool conNombre = strcmp(comando, "AGG") == 0 || strcmp(comando, "PCT") == 0 ||
+                     strcmp(comando, "SUB") == 0 || strcmp(comando, "UNSUB") == 0;
+    if (!conNombre) {
+        cliente->escribir("ERR comando desconocido\n");
+        return;
+    }
+    if (nombre == 0) {
+        cliente->escribir("ERR falta el nombre del sensor\n");
+        return;
+    }
+    
+    if (strcmp(comando, "UNSUB") == 0) {
+        for (int i = 0; i < cliente->suscripciones.tamano(); i++) {
+            if (strcmp(cliente->suscripciones[i].entrada.nombre, nombre) == 0) {
+                cliente->suscripciones.quitarIntercambiando(i);
+                cliente->escribir("OK\n");
+                return;
+            }
+        }
+        cliente->escribir("ERR no suscrito\n");
+        return;
+    }
+    
+    int indice = directorio.buscar(nombre);
+    if (indice < 0) {
+        cliente->escribir("ERR sensor no encontrado\n");
+        return;
+    }
+    const EntradaDirectorio& entrada = directorio[indice];
+    
+    if (strcmp(comando, "AGG") == 0) {
+        AgregadosSensor a = agregadosDe(entrada);
+        int n = snprintf(respuesta, sizeof(respuesta), "OK %d %.9g %.9g %.9g %.9g %.9g %.9g %d %u\n",
+                         a.cantidad, a.suma, a.promedio, a.minimoHistorico, a.maximoHistorico,
+                         a.ultimo, a.ultimoResultado, a.anomalias, a.version);
+        cliente->escribir(respuesta, n);
+        return;
+    }
+    
+    if (strcmp(comando, "PCT") == 0) {
+        int cantidad = 0;
+        double* valores = 0;
+        if (entrada.temperatura) {
+            valores = copiarHistorial(entrada.temperatura, cantidad);
+        } else if (entrada.presion) {
+            valores = copiarHistorial(entrada.presion, cantidad);
+        } else if (entrada.generico) {
+            valores = copiarHistorial(entrada.generico, cantidad);
+        }
+        if (valores == 0) {
+            cliente->escribir("ERR sin lecturas\n");
+            return;
+        }
+        
+        cliente->escribir("OK");
+        char* parametro = strtok_r(0, " \t\r", &resto);
+        while (parametro != 0) {
+            double p = strtod(parametro, 0);
+            if (p < 0.0) {
+                p = 0.0;
+            }
+            if (p > 100.0) {
+                p = 100.0;
+            }
+            // Rango más cercano: el menor valor con al menos p% por debajo
+            int k = (int)(p / 100.0 * (cantidad - 1) + 0.5);
+            int n = snprintf(respuesta, sizeof(respuesta), " %.9g", seleccionar(valores, cantidad, k));
+            cliente->escribir(respuesta, n);
+            parametro = strtok_r(0, " \t\r", &resto);
+        }
+        cliente->escribir("\n");
+        delete[] valores;
+        return;
+    }
+    
+    // SUB: se envían solo las lecturas que lleguen desde ahora
+    for (int i = 0; i < cliente->suscripciones.tamano(); i++) {
+        if (cliente->suscripciones[i].entrada.id == entrada.id) {
+            cliente->escribir("OK\n");
+            return;
+        }
+    }
+    Suscripcion sub;
+    sub.entrada = entrada;
+    sub.version = agregadosDe(entrada).version;
+    cliente->suscripciones.agregar(sub);
+    cliente->escribir("OK\n");
+}
+
+/**
+ * @brief Procesa las líneas completas del búfer de entrada
+ * @return Peticiones atendidas
+ */
+static int procesarEntrada(ConexionCliente* cliente, const DirectorioSensores& directorio) {
+    int atendidas = 0;
+    int inicio = 0;
+    
+    for (int i = 0; i < cliente->usados; i++) {
+        if (cliente->entrada[i] == '\n') {
+            cliente->entrada[i] = '\0';
+            atenderPeticion(cliente, cliente->entrada + inicio, directorio);
+            atendidas = atendidas + 1;
+            inicio = i + 1;
+        }
+    }
+    
+    if (inicio > 0) {
+        memmove(cliente->entrada, cliente->entrada + inicio, cliente->usados - inicio);
+        cliente->usados = cliente->usados - inicio;
+    }
+    return atendidas;
+}
+
+#endif
+
+ServidorConsultas::ServidorConsultas(ListaGeneral* fuente)
+    : activo(false), consultas(0), clientes(0) {
+    lista = fuente;
+    ruta[0] = '\0';
+    fdEscucha = -1;
+}
+
+ServidorConsultas::~ServidorConsultas() {
+    detener();
+}
+
+bool ServidorConsultas::estaActivo() const {
+    return activo.load();
+}
+
+#ifdef _WIN32
+
+bool ServidorConsultas::iniciar(const char* rutaSocket) {
+    (void)rutaSocket;
+    cout << "El servidor de consultas requiere sockets Unix." << endl;
+    return false;
+}
+
+void ServidorConsultas::detener() {
+}
+
+void ServidorConsultas::bucle() {
+}
+
+#else
+
+bool ServidorConsultas::iniciar(const char* rutaSocket) {
+    if (activo.load()) {
+        return true;
+    }
+    
+    sockaddr_un direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    if (strlen(rutaSocket) >= sizeof(direccion.sun_path)) {
+        cout << "Ruta de socket demasiado larga." << endl;
+        return false;
+    }
+    strcpy(direccion.sun_path, rutaSocket);
+    strcpy(ruta, rutaSocket);
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return false;
+    }
+    
+    unlink(rutaSocket);
+    if (bind(fd, (sockaddr*)&direccion, sizeof(direccion)) != 0 || listen(fd, 128) != 0 ||
+        !ponerNoBloqueante(fd)) {
+        perror("bind/listen");
+        close(fd);
+        return false;
+    }
+    
+    fdEscucha = fd;
+    activo.store(true);
+    hilo = std::thread(&ServidorConsultas::bucle, this);
+    return true;
+}
+
+void ServidorConsultas::detener() {
+    if (!activo.load()) {
+        return;
+    }
+    activo.store(false);
+    if (hilo.joinable()) {
+        hilo.join();
+    }
+    close(fdEscucha);
+    fdEscucha = -1;
+    unlink(ruta);
+}
+
+void ServidorConsultas::bucle() {
+    ArregloDinamico<ConexionCliente*> conexiones;
+    ArregloDinamico<pollfd> sondeo;
+    
+    while (activo.load()) {
+        sondeo.limpiar();
+        pollfd escucha;
+        escucha.fd = fdEscucha;
+        escucha.events = POLLIN;
+        escucha.revents = 0;
+        sondeo.agregar(escucha);
+        
+        for (int i = 0; i < conexiones.tamano(); i++) {
+            pollfd p;
+            p.fd = conexiones[i]->fd;
+            p.events = POLLIN;
+            if (conexiones[i]->pendientes() > 0) {
+                p.events = p.events | POLLOUT;
+            }
+            p.revents = 0;
+            sondeo.agregar(p);
+        }
+        
+        // Con suscripciones activas el tiempo de espera marca la cadencia
+        poll(&sondeo[0], sondeo.tamano(), ESPERA_POLL_MS);
+        
+        if (sondeo[0].revents & POLLIN) {
+            while (true) {
+                int fd = accept(fdEscucha, 0, 0);
+                if (fd < 0) {
+                    break;
+                }
+                ponerNoBloqueante(fd);
+                conexiones.agregar(new ConexionCliente(fd));
+            }
+        }
+        
+        // Un solo directorio por vuelta: todas las respuestas ven el mismo catálogo
+        shared_ptr<const DirectorioSensores> directorio = lista->leerDirectorio();
+        
+        // Se recorre al revés para poder quitar intercambiando
+        for (int i = conexiones.tamano() - 1; i >= 0; i--) {
+            ConexionCliente* cliente = conexiones[i];
+            short eventos = (i + 1 < sondeo.tamano()) ? sondeo[i + 1].revents : 0;
+            bool cerrar = false;
+            
+            if (eventos & (POLLIN | POLLHUP | POLLERR)) {
+                while (true) {
+                    int libre = TAMANO_ENTRADA - cliente->usados;
+                    if (libre == 0) {
+                        // Línea sin fin más larga que el búfer
+                        cerrar = true;
+                        break;
+                    }
+                    ssize_t n = recv(cliente->fd, cliente->entrada + cliente->usados, libre, 0);
+                    if (n > 0) {
+                        cliente->usados = cliente->usados + (int)n;
+                        consultas.fetch_add(procesarEntrada(cliente, *directorio));
+                    } else if (n == 0) {
+                        cerrar = true;
+                        break;
+                    } else {
+                        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                            cerrar = true;
+                        }
+                        break;
+                    }
+                }
+            }
+            
+            for (int s = 0; s < cliente->suscripciones.tamano(); s++) {
+                Suscripcion& sub = cliente->suscripciones[s];
+                if (sub.entrada.temperatura) {
+                    enviarNuevas(cliente, sub, sub.entrada.temperatura);
+                } else if (sub.entrada.presion) {
+                    enviarNuevas(cliente, sub, sub.entrada.presion);
+                } else if (sub.entrada.generico) {
+                    enviarNuevas(cliente, sub, sub.entrada.generico);
+                }
+            }
+            
+            if (!cerrar && !cliente->enviar()) {
+                cerrar = true;
+            }
+            if (cliente->pendientes() > LIMITE_SALIDA) {
+                cerrar = true;
+            }
+            
+            if (cerrar) {
+                delete cliente;
+                conexiones.quitarIntercambiando(i);
+            }
+        }
+        clientes.store(conexiones.tamano());
+    }
+    
+    for (int i = 0; i < conexiones.tamano(); i++) {
+        delete conexiones[i];
+    }
+    clientes.store(0);
+}
+
+#endif
+
+void ServidorConsultas::imprimirEstado() const {
+    cout << "Servidor de consultas: " << (activo.load() ? "activo en " : "detenido");
+    if (activo.load()) {
+        cout << ruta;
+    }
+    cout << " | peticiones atendidas: " << consultas.load()
+         << " | conexiones abiertas: " << clientes.load() << endl;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file ServidorConsultas.h
+ * @brief Servidor de consultas local sobre un socket de dominio Unix
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef SERVIDOR_CONSULTAS_H
+#define SERVIDOR_CONSULTAS_H
+
+#include "ListaGeneral.h"
+#include <atomic>
+#include <thread>
+
+/**
+ * @class ServidorConsultas
+ * @brief Atiende consultas sobre el estado en vivo sin bloquear el menú
+ *
+ * Corre en su propio hilo con un bucle de eventos (poll) y sockets no
+ * bloqueantes. Solo lee el directorio publicado por ListaGeneral y las
+ * instantáneas de cada sensor, así que nunca toca el estado del escritor.
+ *
+ * Protocolo de texto, una petición por línea:
+ *
+ *   PING                  -> OK
+ *   LIST                  -> OK n, seguido de n líneas "nombre TIPO cantidad"
+ *   AGG nombre            -> OK cantidad suma promedio min max ultimo resultado anomalias version
+ *   PCT nombre p1 p2 ...  -> OK v1 v2 ... (percentiles 0-100 del historial vivo)
+ *   SUB nombre            -> OK; luego "DATO nombre valor" por cada lectura nueva
+ *   UNSUB nombre          -> OK
+ *
+ * Los errores responden "ERR motivo".
+ */
+class ServidorConsultas {
+private:
+    ListaGeneral* lista;            ///< Fuente del directorio
+    char ruta[108];                 ///< Ruta del socket
+    int fdEscucha;                  ///< Socket de escucha (-1 si no hay)
+    std::thread hilo;               ///< Hilo del bucle de eventos
+    std::atomic<bool> activo;       ///< false pide al bucle que termine
+    std::atomic<long long> consultas; ///< Peticiones atendidas
+    std::atomic<int> clientes;      ///< Conexiones abiertas
+    
+    /**
+     * @brief Bucle de eventos del hilo servidor
+     */
+    void bucle();
+    
+    ServidorConsultas(const ServidorConsultas&);
+    ServidorConsultas& operator=(const ServidorConsultas&);
+    
+public:
+    /**
+     * @brief Constructor (no abre el socket)
+     * @param fuente Lista cuyos sensores se consultan
+     */
+    ServidorConsultas(ListaGeneral* fuente);
+    
+    /**
+     * @brief Destructor - detiene el servidor si sigue activo
+     */
+    ~ServidorConsultas();
+    
+    /**
+     * @brief Abre el socket y lanza el hilo del servidor
+     * @param rutaSocket Ruta del socket (se reemplaza si ya existe)
+     * @return true si el servidor quedó escuchando
+     */
+    bool iniciar(const char* rutaSocket);
+    
+    /**
+     * @brief Detiene el hilo, cierra las conexiones y borra el socket
+     */
+    void detener();
+    
+    /**
+     * @brief Indica si el servidor está escuchando
+     * @return true si está activo
+     */
+    bool estaActivo() const;
+    
+    /**
+     * @brief Imprime peticiones atendidas y conexiones abiertas
+     */
+    void imprimirEstado() const;
+};
+
+#endif // SERVIDOR_CONSULTAS_H
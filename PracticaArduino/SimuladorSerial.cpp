@@ -0,0 +1,158 @@
+/**
+ * @file SimuladorSerial.cpp
+ * @brief Simula el Arduino sobre un pseudoterminal (herramienta aparte)
+ *
+ * Uso: SimuladorSerial [lecturas/s] [segundos] [sensores] [marcas]
+ *
+ * Crea un pseudoterminal, imprime la ruta que debe abrir el sistema como
+ * puerto serial y, en cuanto se conecta, envía lecturas TEMP:/PRES: al
+ * ritmo pedido. Los sensores 0 y 1 usan el formato corto (T-001, P-105);
+ * los demás, TEMP:SIM-nnn:valor. Respeta XON/XOFF como el sketch.
+ *
+ * Con marcas = 1 cada línea lleva #secuencia@us, con la hora de emisión
+ * del reloj monótono de este equipo: el trazado de latencia del sistema
+ * (opción 24, reloj compartido) mide así también el tramo del enlace.
+ *
+ * Un UART real no espera al receptor: lo que no cabe en el búfer del
+ * pseudoterminal se cuenta como perdido en el enlace y no se reintenta.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+
+using namespace std;
+
+static long long ahoraUs() {
+    return chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char* argv[]) {
+    double tasa = argc > 1 ? atof(argv[1]) : 1000.0;
+    double segundos = argc > 2 ? atof(argv[2]) : 10.0;
+    int sensores = argc > 3 ? atoi(argv[3]) : 2;
+    bool marcas = argc > 4 && atoi(argv[4]) != 0;
+    if (sensores < 1) {
+        sensores = 1;
+    }
+    long long* secuencias = new long long[sensores];
+    for (int i = 0; i < sensores; i++) {
+        secuencias[i] = 0;
+    }
+    
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+    fcntl(maestro, F_SETFL, fcntl(maestro, F_GETFL, 0) | O_NONBLOCK);
+    
+    cout << "Puerto simulado: " << ptsname(maestro) << endl;
+    cout << "Esperando conexion..." << endl;
+    
+    // Mientras nadie abre el esclavo, poll informa POLLHUP en el maestro
+    while (true) {
+        pollfd p;
+        p.fd = maestro;
+        p.events = POLLIN;
+        p.revents = 0;
+        poll(&p, 1, 100);
+        if (!(p.revents & POLLHUP)) {
+            break;
+        }
+    }
+    // Dar tiempo a que el sistema configure el puerto
+    this_thread::sleep_for(chrono::milliseconds(500));
+    cout << "Enviando " << tasa << " lecturas/s durante " << segundos << " s a "
+         << sensores << " sensor(es)" << endl;
+    
+    long long inicio = ahoraUs();
+    long long fin = inicio + (long long)(segundos * 1e6);
+    long long enviadas = 0;
+    long long perdidas = 0;
+    long long omitidas = 0;
+    long long pausas = 0;
+    long long usPausado = 0;
+    long long inicioPausa = 0;
+    bool pausado = false;
+    unsigned int semilla = 12345;
+    char linea[64];
+    
+    while (true) {
+        long long ahora = ahoraUs();
+        if (ahora >= fin) {
+            break;
+        }
+        
+        // Control de flujo desde el sistema
+        unsigned char control[64];
+        ssize_t n = read(maestro, control, sizeof(control));
+        for (ssize_t i = 0; i < n; i++) {
+            if (control[i] == 0x13 && !pausado) {
+                pausado = true;
+                pausas = pausas + 1;
+                inicioPausa = ahora;
+            } else if (control[i] == 0x11 && pausado) {
+                pausado = false;
+                usPausado = usPausado + (ahora - inicioPausa);
+            }
+        }
+        
+        // Lecturas que ya deberían haberse enviado a esta hora
+        long long debidas = (long long)((ahora - inicio) * tasa / 1e6);
+        if (pausado) {
+            // Como el sketch, en pausa no se generan lecturas (no hay atraso)
+            omitidas = debidas - enviadas - perdidas;
+        }
+        
+        while (!pausado && enviadas + perdidas + omitidas < debidas) {
+            int sensor = (int)((enviadas + perdidas + omitidas) % sensores);
+            semilla = semilla * 1103515245u + 12345u;
+            int longitud;
+            if (sensor == 0) {
+                longitud = snprintf(linea, sizeof(linea), "TEMP:%.1f", 20.0 + (semilla >> 16) % 300 / 10.0);
+            } else if (sensor == 1) {
+                longitud = snprintf(linea, sizeof(linea), "PRES:%d", 70 + (int)((semilla >> 16) % 50));
+            } else if (sensor % 2 == 0) {
+                longitud = snprintf(linea, sizeof(linea), "TEMP:SIM-%03d:%.1f", sensor, 20.0 + (semilla >> 16) % 300 / 10.0);
+            } else {
+                longitud = snprintf(linea, sizeof(linea), "PRES:SIM-%03d:%d", sensor, 70 + (int)((semilla >> 16) % 50));
+            }
+            
+            if (marcas) {
+                longitud = longitud + snprintf(linea + longitud, sizeof(linea) - longitud, "#%lld@%lld",
+                                               secuencias[sensor], ahoraUs());
+                secuencias[sensor] = secuencias[sensor] + 1;
+            }
+            longitud = longitud + snprintf(linea + longitud, sizeof(linea) - longitud, "\r\n");
+            
+            if (write(maestro, linea, longitud) == longitud) {
+                enviadas = enviadas + 1;
+            } else {
+                perdidas = perdidas + 1;
+            }
+        }
+        
+        this_thread::sleep_for(chrono::microseconds(500));
+    }
+    
+    if (pausado) {
+        usPausado = usPausado + (ahoraUs() - inicioPausa);
+    }
+    
+    cout << "Enviadas: " << enviadas << " | perdidas en el enlace: " << perdidas
+         << " | pausas (XOFF): " << pausas << " | tiempo en pausa: " << usPausado / 1000
+         << " ms (" << omitidas << " no generadas)" << endl;
+    
+    delete[] secuencias;
+    close(maestro);
+    return 0;
+}
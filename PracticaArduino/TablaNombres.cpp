@@ -0,0 +1,186 @@
+/**
+ * @file TablaNombres.cpp
+ * @brief Implementación de la tabla de internado de nombres
+ */
+
+#include "TablaNombres.h"
+
+/// Tamaño de cada bloque de almacenamiento de cadenas
+static const int TAM_BLOQUE_CADENAS = 4096;
+
+TablaNombres::TablaNombres() {
+    capacidadRanuras = 64;
+    ranuras = new int[capacidadRanuras];
+    for (int i = 0; i < capacidadRanuras; i++) {
+        ranuras[i] = -1;
+    }
+    
+    capacidadIds = 32;
+    cantidad = 0;
+    cadenas = new const char*[capacidadIds];
+    hashes = new unsigned int[capacidadIds];
+    
+    bloqueActual = 0;
+    usadoBloque = TAM_BLOQUE_CADENAS;
+    capacidadBloques = 8;
+    numBloques = 0;
+    bloques = new char*[capacidadBloques];
+}
+
+TablaNombres::~TablaNombres() {
+    for (int i = 0; i < numBloques; i++) {
+        delete[] bloques[i];
+    }
+    delete[] bloques;
+    delete[] cadenas;
+    delete[] hashes;
+    delete[] ranuras;
+}
+
+TablaNombres& TablaNombres::global() {
+    static TablaNombres tabla;
+    return tabla;
+}
+
+unsigned int TablaNombres::calcularHash(const char* texto) {
+    unsigned int hash = 2166136261u;
+    int i = 0;
+    while (texto[i] != '\0') {
+        hash = hash ^ (unsigned char)texto[i];
+        hash = hash * 16777619u;
+        i++;
+    }
+    return hash;
+}
+
+bool TablaNombres::iguales(const char* a, const char* b) {
+    int i = 0;
+    while (a[i] != '\0' || b[i] != '\0') {
+        if (a[i] != b[i]) {
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+const char* TablaNombres::copiarCadena(const char* texto) {
+    int longitud = 0;
+    while (texto[longitud] != '\0') {
+        longitud++;
+    }
+    
+    if (usadoBloque + longitud + 1 > TAM_BLOQUE_CADENAS) {
+        int tamBloque = TAM_BLOQUE_CADENAS;
+        if (longitud + 1 > tamBloque) {
+            tamBloque = longitud + 1;
+        }
+        
+        if (numBloques == capacidadBloques) {
+            char** nuevos = new char*[capacidadBloques * 2];
+            for (int i = 0; i < numBloques; i++) {
+                nuevos[i] = bloques[i];
+            }
+            delete[] bloques;
+            bloques = nuevos;
+            capacidadBloques = capacidadBloques * 2;
+        }
+        
+        bloqueActual = new char[tamBloque];
+        bloques[numBloques] = bloqueActual;
+        numBloques = numBloques + 1;
+        usadoBloque = 0;
+    }
+    
+    char* copia = bloqueActual + usadoBloque;
+    for (int i = 0; i <= longitud; i++) {
+        copia[i] = texto[i];
+    }
+    usadoBloque = usadoBloque + longitud + 1;
+    
+    return copia;
+}
+
+int TablaNombres::buscarRanura(const char* texto, unsigned int hash) const {
+    int mascara = capacidadRanuras - 1;
+    int posicion = (int)(hash & (unsigned int)mascara);
+    
+    // Sondeo lineal
+    while (ranuras[posicion] != -1) {
+        int id = ranuras[posicion];
+        if (hashes[id] == hash && iguales(cadenas[id], texto)) {
+            return posicion;
+        }
+        posicion = (posicion + 1) & mascara;
+    }
+    
+    return posicion;
+}
+
+void TablaNombres::redimensionar() {
+    delete[] ranuras;
+    capacidadRanuras = capacidadRanuras * 2;
+    ranuras = new int[capacidadRanuras];
+    for (int i = 0; i < capacidadRanuras; i++) {
+        ranuras[i] = -1;
+    }
+    
+    int mascara = capacidadRanuras - 1;
+    for (int id = 0; id < cantidad; id++) {
+        int posicion = (int)(hashes[id] & (unsigned int)mascara);
+        while (ranuras[posicion] != -1) {
+            posicion = (posicion + 1) & mascara;
+        }
+        ranuras[posicion] = id;
+    }
+}
+
+int TablaNombres::internar(const char* texto) {
+    unsigned int hash = calcularHash(texto);
+    int posicion = buscarRanura(texto, hash);
+    
+    if (ranuras[posicion] != -1) {
+        return ranuras[posicion];
+    }
+    
+    // Nombre nuevo: asegurar espacio para el ID
+    if (cantidad == capacidadIds) {
+        const char** nuevasCadenas = new const char*[capacidadIds * 2];
+        unsigned int* nuevosHashes = new unsigned int[capacidadIds * 2];
+        for (int i = 0; i < cantidad; i++) {
+            nuevasCadenas[i] = cadenas[i];
+            nuevosHashes[i] = hashes[i];
+        }
+        delete[] cadenas;
+        delete[] hashes;
+        cadenas = nuevasCadenas;
+        hashes = nuevosHashes;
+        capacidadIds = capacidadIds * 2;
+    }
+    
+    int id = cantidad;
+    cadenas[id] = copiarCadena(texto);
+    hashes[id] = hash;
+    cantidad = cantidad + 1;
+    ranuras[posicion] = id;
+    
+    // Mantener el factor de carga por debajo de 1/2
+    if (cantidad * 2 > capacidadRanuras) {
+        redimensionar();
+    }
+    
+    return id;
+}
+
+int TablaNombres::buscar(const char* texto) const {
+    int posicion = buscarRanura(texto, calcularHash(texto));
+    return ranuras[posicion];
+}
+
+const char* TablaNombres::nombre(int id) const {
+    return cadenas[id];
+}
+
+int TablaNombres::tamano() const {
+    return cantidad;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file TablaNombres.h
+ * @brief Tabla global de internado de nombres de sensores
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef TABLA_NOMBRES_H
+#define TABLA_NOMBRES_H
+
+/**
+ * @class TablaNombres
+ * @brief Asigna a cada nombre un ID entero denso y guarda la cadena una sola vez
+ *
+ * Las cadenas se copian a bloques de memoria que nunca se mueven, por lo
+ * que los punteros devueltos por nombre() son válidos mientras exista la
+ * tabla. La búsqueda usa una tabla hash con direccionamiento abierto.
+ */
+class TablaNombres {
+private:
+    int* ranuras;           ///< Tabla hash: ID o -1 si la ranura está libre
+    int capacidadRanuras;   ///< Número de ranuras (potencia de 2)
+    
+    const char** cadenas;   ///< Cadena de cada ID
+    unsigned int* hashes;   ///< Hash de cada ID (para redimensionar)
+    int cantidad;           ///< IDs asignados
+    int capacidadIds;       ///< Capacidad de los arreglos por ID
+    
+    char* bloqueActual;     ///< Bloque donde se copian las cadenas nuevas
+    int usadoBloque;        ///< Bytes usados del bloque actual
+    char** bloques;         ///< Todos los bloques reservados
+    int numBloques;         ///< Número de bloques
+    int capacidadBloques;   ///< Capacidad del arreglo de bloques
+    
+    /**
+     * @brief Calcula el hash FNV-1a de una cadena
+     * @param texto Cadena terminada en '\0'
+     * @return Hash de 32 bits
+     */
+    static unsigned int calcularHash(const char* texto);
+    
+    /**
+     * @brief Compara dos cadenas
+     * @return true si son iguales
+     */
+    static bool iguales(const char* a, const char* b);
+    
+    /**
+     * @brief Copia una cadena al almacén de bloques
+     * @param texto Cadena a copiar
+     * @return Puntero estable a la copia
+     */
+    const char* copiarCadena(const char* texto);
+    
+    /**
+     * @brief Duplica la tabla hash y reubica los IDs
+     */
+    void redimensionar();
+    
+    /**
+     * @brief Busca la ranura de un nombre
+     * @return Índice de la ranura (ocupada por el nombre o libre)
+     */
+    int buscarRanura(const char* texto, unsigned int hash) const;
+    
+    TablaNombres();
+    ~TablaNombres();
+    TablaNombres(const TablaNombres&);
+    TablaNombres& operator=(const TablaNombres&);
+    
+public:
+    /**
+     * @brief Obtiene la tabla global del proceso
+     * @return Referencia a la tabla única
+     */
+    static TablaNombres& global();
+    
+    /**
+     * @brief Obtiene el ID de un nombre, registrándolo si es nuevo
+     * @param texto Nombre a internar
+     * @return ID denso (0, 1, 2, ...)
+     */
+    int internar(const char* texto);
+    
+    /**
+     * @brief Busca el ID de un nombre sin registrarlo
+     * @param texto Nombre a buscar
+     * @return ID o -1 si el nombre no existe
+     */
+    int buscar(const char* texto) const;
+    
+    /**
+     * @brief Obtiene la cadena de un ID
+     * @param id ID válido
+     * @return Nombre internado
+     */
+    const char* nombre(int id) const;
+    
+    /**
+     * @brief Número de nombres internados
+     * @return Cantidad de IDs asignados
+     */
+    int tamano() const;
+};
+
+#endif // TABLA_NOMBRES_H
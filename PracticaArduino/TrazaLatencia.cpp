@@ -0,0 +1,309 @@
+/**
+ * @file TrazaLatencia.cpp
+ * @brief Implementación del trazado de latencia de punta a punta
+ */
+
+#include "TrazaLatencia.h"
+#include "TablaNombres.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+
+// Salto entre lectura y marca que obliga a estimar de nuevo el desfase (10 s)
+static const long long SALTO_RESINCRONIZAR_US = 10000000LL;
+
+/// Nombres de los tramos para el reporte y el volcado
+static const char* NOMBRES_TRAMO[TRAMOS_LATENCIA] = {
+    "enlace",
+    "lector",
+    "cola",
+    "proceso",
+    "total"
+};
+
+HistogramaLatencia::HistogramaLatencia() {
+    for (int i = 0; i < CUBETAS; i++) {
+        cuentas[i] = 0;
+    }
+    total = 0;
+    sumaUs = 0;
+    maximoUs = 0;
+}
+
+void HistogramaLatencia::registrar(long long us) {
+    if (us < 0) {
+        us = 0;
+    }
+    int cubeta = 0;
+    while (cubeta < CUBETAS - 1 && (us >> (cubeta + 1)) != 0) {
+        cubeta = cubeta + 1;
+    }
+    cuentas[cubeta] = cuentas[cubeta] + 1;
+    total = total + 1;
+    sumaUs = sumaUs + us;
+    if (us > maximoUs) {
+        maximoUs = us;
+    }
+}
+
+long long HistogramaLatencia::percentil(double fraccion) const {
+    if (total == 0) {
+        return 0;
+    }
+    long long objetivo = (long long)(fraccion * total);
+    if (objetivo >= total) {
+        objetivo = total - 1;
+    }
+    long long acumuladas = 0;
+    for (int i = 0; i < CUBETAS; i++) {
+        acumuladas = acumuladas + cuentas[i];
+        if (acumuladas > objetivo) {
+            long long limite = 2LL << i;
+            return limite < maximoUs ? limite : maximoUs;
+        }
+    }
+    return maximoUs;
+}
+
+TrazaLatencia::TrazaLatencia() {
+    activa.store(false);
+    cadaN.store(1);
+    relojCompartido.store(false);
+    volcado = new TrazaLectura[CAPACIDAD_VOLCADO];
+    siguienteVolcado = 0;
+    completas = 0;
+}
+
+TrazaLatencia::~TrazaLatencia() {
+    for (int i = 0; i < sensores.tamano(); i++) {
+        delete sensores[i];
+    }
+    delete[] volcado;
+}
+
+TrazaLatencia& TrazaLatencia::global() {
+    static TrazaLatencia traza;
+    return traza;
+}
+
+long long TrazaLatencia::ahoraUs() {
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TrazaLatencia::configurar(bool encender, int muestreo, bool mismoReloj) {
+    cadaN.store(muestreo < 1 ? 1 : muestreo);
+    relojCompartido.store(mismoReloj);
+    activa.store(encender);
+}
+
+bool TrazaLatencia::estaActiva() const {
+    return activa.load(memory_order_relaxed);
+}
+
+bool TrazaLatencia::muestrear(int idSensor) {
+    if (!activa.load(memory_order_relaxed) || idSensor < 0) {
+        return false;
+    }
+    // Un contador por sensor: con uno solo, N múltiplo del número de
+    // sensores trazaría siempre los mismos
+    if (idSensor >= ofrecidas.tamano()) {
+        ofrecidas.extender(idSensor + 1, 0);
+    }
+    ofrecidas[idSensor] = ofrecidas[idSensor] + 1;
+    return ofrecidas[idSensor] % cadaN.load(memory_order_relaxed) == 0;
+}
+
+TrazaLatencia::TrazaSensor* TrazaLatencia::sensor(int idSensor) {
+    if (idSensor >= sensores.tamano()) {
+        sensores.extender(idSensor + 1, 0);
+    }
+    if (sensores[idSensor] == 0) {
+        TrazaSensor* nuevo = new TrazaSensor();
+        nuevo->desfaseUs = 0;
+        nuevo->hayDesfase = false;
+        nuevo->sinProcesar = 0;
+        sensores[idSensor] = nuevo;
+    }
+    return sensores[idSensor];
+}
+
+void TrazaLatencia::almacenada(const TrazaLectura& traza) {
+    if (traza.idSensor < 0) {
+        return;
+    }
+    TrazaSensor* estado = sensor(traza.idSensor);
+    TrazaLectura local = traza;
+    
+    // Llevar la marca del dispositivo al reloj local
+    if (local.emitidaUs >= 0 && !relojCompartido.load(memory_order_relaxed)) {
+        long long diferencia = local.leidaUs - local.emitidaUs;
+        if (!estado->hayDesfase || diferencia < estado->desfaseUs
+            || diferencia - estado->desfaseUs > SALTO_RESINCRONIZAR_US) {
+            estado->desfaseUs = diferencia;
+            estado->hayDesfase = true;
+        }
+        local.emitidaUs = local.emitidaUs + estado->desfaseUs;
+    }
+    
+    if (estado->pendientes.tamano() == MAXIMO_PENDIENTES) {
+        // El sensor no se procesa: se descarta una pendiente para no crecer sin límite
+        estado->pendientes.quitarIntercambiando(0);
+        estado->sinProcesar = estado->sinProcesar + 1;
+    }
+    local.procesadaUs = 0;
+    estado->pendientes.agregar(local);
+}
+
+void TrazaLatencia::completar(TrazaSensor* estado, const TrazaLectura& traza) {
+    long long tramos[TRAMOS_LATENCIA];
+    tramos[TRAMO_ENLACE] = (traza.emitidaUs >= 0) ? traza.leidaUs - traza.emitidaUs : -1;
+    tramos[TRAMO_LECTOR] = traza.encoladaUs - traza.leidaUs;
+    tramos[TRAMO_COLA] = traza.almacenadaUs - traza.encoladaUs;
+    tramos[TRAMO_PROCESO] = traza.procesadaUs - traza.almacenadaUs;
+    tramos[TRAMO_TOTAL] = traza.procesadaUs - ((traza.emitidaUs >= 0) ? traza.emitidaUs : traza.leidaUs);
+    
+    for (int t = 0; t < TRAMOS_LATENCIA; t++) {
+        // Sin marca del dispositivo el enlace no se puede medir
+        if (tramos[t] < 0 && t == TRAMO_ENLACE) {
+            continue;
+        }
+        estado->tramos[t].registrar(tramos[t]);
+        totales[t].registrar(tramos[t]);
+    }
+    
+    volcado[siguienteVolcado] = traza;
+    siguienteVolcado = (siguienteVolcado + 1) % CAPACIDAD_VOLCADO;
+    completas = completas + 1;
+}
+
+void TrazaLatencia::procesado(int idSensor) {
+    if (idSensor < 0 || idSensor >= sensores.tamano() || sensores[idSensor] == 0) {
+        return;
+    }
+    TrazaSensor* estado = sensores[idSensor];
+    if (estado->pendientes.tamano() == 0) {
+        return;
+    }
+    
+    long long ahora = ahoraUs();
+    for (int i = 0; i < estado->pendientes.tamano(); i++) {
+        TrazaLectura traza = estado->pendientes[i];
+        traza.procesadaUs = ahora;
+        completar(estado, traza);
+    }
+    estado->pendientes.limpiar();
+}
+
+HistogramaLatencia TrazaLatencia::histograma(int idSensor, TramoLatencia tramo) const {
+    if (idSensor < 0 || idSensor >= sensores.tamano() || sensores[idSensor] == 0) {
+        return HistogramaLatencia();
+    }
+    return sensores[idSensor]->tramos[tramo];
+}
+
+void TrazaLatencia::imprimir() const {
+    cout << "\n--- Latencia de punta a punta ---" << endl;
+    cout << "Trazado: " << (estaActiva() ? "activo" : "inactivo") << " | 1 de cada " << cadaN.load()
+         << " lecturas | reloj del dispositivo: " << (relojCompartido.load() ? "compartido" : "desfase estimado")
+         << " | trazas completas: " << completas << endl;
+    
+    char fila[160];
+    cout << "\nsensor           tramo      trazas    p50 us    p90 us    p99 us    max us" << endl;
+    for (int id = 0; id < sensores.tamano(); id++) {
+        const TrazaSensor* estado = sensores[id];
+        if (estado == 0 || estado->tramos[TRAMO_TOTAL].total == 0) {
+            continue;
+        }
+        const char* nombre = TablaNombres::global().nombre(id);
+        for (int t = 0; t < TRAMOS_LATENCIA; t++) {
+            const HistogramaLatencia& h = estado->tramos[t];
+            if (h.total == 0) {
+                continue;
+            }
+            snprintf(fila, sizeof(fila), "%-16s %-8s %8lld %9lld %9lld %9lld %9lld", nombre,
+                     NOMBRES_TRAMO[t], h.total, h.percentil(0.5), h.percentil(0.9), h.percentil(0.99), h.maximoUs);
+            cout << fila << endl;
+            // El nombre solo en la primera fila del sensor
+            nombre = "";
+        }
+        if (estado->pendientes.tamano() > 0 || estado->sinProcesar > 0) {
+            cout << "                 (" << estado->pendientes.tamano() << " sin procesar aun, "
+                 << estado->sinProcesar << " descartadas)" << endl;
+        }
+    }
+    
+    // Distribución total: una barra por cubeta ocupada
+    const HistogramaLatencia& total = totales[TRAMO_TOTAL];
+    if (total.total == 0) {
+        cout << "\nSin trazas completas todavia." << endl;
+        return;
+    }
+    cout << "\nTotal (emision -> procesamiento), " << total.total << " trazas, promedio "
+         << total.sumaUs / total.total << " us:" << endl;
+    long long mayor = 0;
+    for (int i = 0; i < HistogramaLatencia::CUBETAS; i++) {
+        if (total.cuentas[i] > mayor) {
+            mayor = total.cuentas[i];
+        }
+    }
+    for (int i = 0; i < HistogramaLatencia::CUBETAS; i++) {
+        if (total.cuentas[i] == 0) {
+            continue;
+        }
+        int ancho = (int)(total.cuentas[i] * 40 / mayor);
+        snprintf(fila, sizeof(fila), "  < %10lld us %8lld ", 2LL << i, total.cuentas[i]);
+        cout << fila;
+        for (int k = 0; k < ancho; k++) {
+            cout << '#';
+        }
+        cout << endl;
+    }
+}
+
+int TrazaLatencia::volcar(const char* ruta) const {
+    ofstream archivo(ruta);
+    if (!archivo.is_open()) {
+        return -1;
+    }
+    
+    archivo << "sensor,secuencia,emitida_us,leida_us,encolada_us,almacenada_us,procesada_us,"
+            << "enlace_us,lector_us,cola_us,proceso_us,total_us\n";
+    
+    // Del más viejo al más nuevo
+    int cantidad = completas < CAPACIDAD_VOLCADO ? (int)completas : CAPACIDAD_VOLCADO;
+    int primero = (siguienteVolcado - cantidad + CAPACIDAD_VOLCADO) % CAPACIDAD_VOLCADO;
+    char fila[320];
+    for (int i = 0; i < cantidad; i++) {
+        const TrazaLectura& t = volcado[(primero + i) % CAPACIDAD_VOLCADO];
+        long long origen = (t.emitidaUs >= 0) ? t.emitidaUs : t.leidaUs;
+        snprintf(fila, sizeof(fila), "%s,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld\n",
+                 TablaNombres::global().nombre(t.idSensor), t.secuencia, t.emitidaUs, t.leidaUs,
+                 t.encoladaUs, t.almacenadaUs, t.procesadaUs,
+                 (t.emitidaUs >= 0) ? t.leidaUs - t.emitidaUs : -1LL, t.encoladaUs - t.leidaUs,
+                 t.almacenadaUs - t.encoladaUs, t.procesadaUs - t.almacenadaUs, t.procesadaUs - origen);
+        archivo << fila;
+    }
+    return cantidad;
+}
+
+void TrazaLatencia::reiniciar() {
+    for (int i = 0; i < sensores.tamano(); i++) {
+        delete sensores[i];
+    }
+    sensores.limpiar();
+    for (int t = 0; t < TRAMOS_LATENCIA; t++) {
+        totales[t] = HistogramaLatencia();
+    }
+    siguienteVolcado = 0;
+    completas = 0;
+}
+
+const char* TrazaLatencia::nombreTramo(TramoLatencia tramo) {
+    if (tramo < 0 || tramo >= TRAMOS_LATENCIA) {
+        return "?";
+    }
+    return NOMBRES_TRAMO[tramo];
+}
@@ -0,0 +1,221 @@
+/**
+ * @file TrazaLatencia.h
+ * @brief Latencia de punta a punta de las lecturas: del dispositivo al procesamiento
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef TRAZA_LATENCIA_H
+#define TRAZA_LATENCIA_H
+
+#include "ArregloDinamico.h"
+#include <atomic>
+
+/**
+ * @brief Tramos en que se divide la latencia de una lectura
+ */
+enum TramoLatencia {
+    TRAMO_ENLACE,    ///< Emitida por el dispositivo -> leída del puerto (requiere @marca)
+    TRAMO_LECTOR,    ///< Leída -> encolada (enmarcar, interpretar, enrutar)
+    TRAMO_COLA,      ///< Encolada -> almacenada en su sensor (cola, ordenar, almacenar)
+    TRAMO_PROCESO,   ///< Almacenada -> incluida en un procesarLectura
+    TRAMO_TOTAL,     ///< Emitida (o leída, sin marca) -> procesada
+    TRAMOS_LATENCIA  ///< Número de tramos
+};
+
+/**
+ * @brief Histograma logarítmico de latencias en microsegundos
+ *
+ * La cubeta i cuenta latencias en [2^i, 2^(i+1)) us (la 0 incluye el 0),
+ * así que 32 cubetas cubren hasta ~35 minutos con error relativo < 2x.
+ */
+struct HistogramaLatencia {
+    static const int CUBETAS = 32;  ///< Cubetas de potencias de 2
+    long long cuentas[CUBETAS];     ///< Latencias por cubeta
+    long long total;                ///< Latencias registradas
+    long long sumaUs;               ///< Suma, para el promedio
+    long long maximoUs;             ///< Mayor latencia registrada
+    
+    /**
+     * @brief Constructor con todo en cero
+     */
+    HistogramaLatencia();
+    
+    /**
+     * @brief Cuenta una latencia
+     * @param us Latencia en microsegundos (las negativas cuentan como 0)
+     */
+    void registrar(long long us);
+    
+    /**
+     * @brief Cota superior del percentil pedido
+     * @param fraccion Percentil entre 0 y 1 (0.5 = mediana)
+     * @return Límite superior de la cubeta que lo contiene (us)
+     */
+    long long percentil(double fraccion) const;
+};
+
+/**
+ * @brief Marcas de tiempo de una lectura trazada (us del reloj monótono local)
+ */
+struct TrazaLectura {
+    int idSensor;           ///< Sensor destino
+    long long secuencia;    ///< Secuencia del dispositivo (-1 = sin secuencia)
+    long long emitidaUs;    ///< Marca del dispositivo (-1 = sin marca; llevada al reloj local al almacenar)
+    long long leidaUs;      ///< Leída del puerto
+    long long encoladaUs;   ///< Entró a la cola de ControlIngesta
+    long long almacenadaUs; ///< Registrada en su sensor
+    long long procesadaUs;  ///< Incluida en un procesarLectura (0 = aún no)
+};
+
+/**
+ * @class TrazaLatencia
+ * @brief Mide cuánto tarda una lectura desde que el dispositivo la emite
+ *        hasta que un procesarLectura la incluye
+ *
+ * Con el trazado activo, el hilo lector marca 1 de cada N lecturas de
+ * cada sensor (muestrear) y cada etapa de TuberiaIngesta anota su hora en la propia
+ * lectura. Al almacenarla, la traza queda pendiente en su sensor hasta el
+ * siguiente procesamiento; entonces se completa, se suma a los
+ * histogramas del sensor y al volcado (las últimas CAPACIDAD_VOLCADO).
+ *
+ * Si el dispositivo envía @marca (TEMP:23.5#118@marca, en us), el tramo
+ * del enlace también se mide. Con relojCompartido la marca se toma tal
+ * cual (un simulador en este equipo, sobre el reloj monótono); si no,
+ * se estima el desfase de cada sensor con la menor diferencia observada
+ * entre lectura y marca, y el enlace queda medido respecto a la lectura
+ * más rápida. Un salto de más de 10 s (el micros() del Arduino da la
+ * vuelta, o se reinició) vuelve a estimarlo.
+ *
+ * muestrear() es del hilo lector; lo demás, del hilo principal.
+ */
+class TrazaLatencia {
+public:
+    /**
+     * @brief Trazas completas que conserva el volcado
+     */
+    static const int CAPACIDAD_VOLCADO = 4096;
+    
+    /**
+     * @brief Trazas pendientes de procesamiento por sensor
+     */
+    static const int MAXIMO_PENDIENTES = 256;
+    
+private:
+    /**
+     * @brief Estado de un sensor trazado
+     */
+    struct TrazaSensor {
+        HistogramaLatencia tramos[TRAMOS_LATENCIA]; ///< Histograma de cada tramo
+        ArregloDinamico<TrazaLectura> pendientes;   ///< Almacenadas sin procesar
+        long long desfaseUs;                        ///< Reloj local - reloj del dispositivo
+        bool hayDesfase;                            ///< desfaseUs ya estimado
+        long long sinProcesar;                      ///< Pendientes descartadas por exceso
+    };
+    
+    std::atomic<bool> activa;           ///< Trazado encendido
+    std::atomic<int> cadaN;             ///< Se traza 1 de cada N lecturas
+    std::atomic<bool> relojCompartido;  ///< Las marcas del dispositivo usan el reloj local
+    ArregloDinamico<long long> ofrecidas; ///< Lecturas vistas por muestrear, por sensor (hilo lector)
+    
+    ArregloDinamico<TrazaSensor*> sensores;   ///< Estado por ID de sensor
+    HistogramaLatencia totales[TRAMOS_LATENCIA]; ///< Tramos de todos los sensores
+    TrazaLectura* volcado;                    ///< Últimas trazas completas (anillo)
+    int siguienteVolcado;                     ///< Próxima posición a escribir
+    long long completas;                      ///< Trazas completadas en total
+    
+    /**
+     * @brief Estado de un sensor, creándolo si hace falta
+     */
+    TrazaSensor* sensor(int idSensor);
+    
+    /**
+     * @brief Suma los tramos de una traza completa a su sensor y al volcado
+     */
+    void completar(TrazaSensor* estado, const TrazaLectura& traza);
+    
+    TrazaLatencia();
+    ~TrazaLatencia();
+    TrazaLatencia(const TrazaLatencia&);
+    TrazaLatencia& operator=(const TrazaLatencia&);
+    
+public:
+    /**
+     * @brief Obtiene el trazado global del proceso
+     * @return Referencia al trazado único
+     */
+    static TrazaLatencia& global();
+    
+    /**
+     * @brief Hora del reloj monótono local (el mismo que steady_clock)
+     * @return Microsegundos
+     */
+    static long long ahoraUs();
+    
+    /**
+     * @brief Enciende o apaga el trazado
+     * @param encender true para trazar
+     * @param muestreo Trazar 1 de cada muestreo lecturas de cada sensor (mínimo 1)
+     * @param mismoReloj true si las marcas del dispositivo usan el reloj local
+     */
+    void configurar(bool encender, int muestreo, bool mismoReloj);
+    
+    /**
+     * @brief Indica si el trazado está encendido
+     * @return true si está activo
+     */
+    bool estaActiva() const;
+    
+    /**
+     * @brief Decide si trazar la próxima lectura de un sensor (hilo lector)
+     * @param idSensor ID del sensor de la lectura
+     * @return true para 1 de cada N lecturas del sensor con el trazado activo
+     */
+    bool muestrear(int idSensor);
+    
+    /**
+     * @brief Registra una lectura trazada ya almacenada (hilo principal)
+     * @param traza Marcas hasta almacenadaUs
+     */
+    void almacenada(const TrazaLectura& traza);
+    
+    /**
+     * @brief Completa las trazas pendientes de un sensor recién procesado
+     * @param idSensor ID del sensor
+     */
+    void procesado(int idSensor);
+    
+    /**
+     * @brief Histograma de un tramo de un sensor
+     * @param idSensor ID del sensor
+     * @param tramo Tramo
+     * @return Copia del histograma (vacío si el sensor no tiene trazas)
+     */
+    HistogramaLatencia histograma(int idSensor, TramoLatencia tramo) const;
+    
+    /**
+     * @brief Imprime percentiles por sensor y tramo, y el histograma total
+     */
+    void imprimir() const;
+    
+    /**
+     * @brief Escribe las últimas trazas completas en CSV
+     * @param ruta Archivo a escribir
+     * @return Trazas escritas, -1 si no se pudo abrir
+     */
+    int volcar(const char* ruta) const;
+    
+    /**
+     * @brief Borra histogramas, pendientes y volcado
+     */
+    void reiniciar();
+    
+    /**
+     * @brief Nombre de un tramo
+     * @param tramo Tramo
+     * @return Nombre corto ("enlace", "lector", ...)
+     */
+    static const char* nombreTramo(TramoLatencia tramo);
+};
+
+#endif // TRAZA_LATENCIA_H
@@ -0,0 +1,487 @@
+/**
+ * @file TuberiaIngesta.cpp
+ * @brief Implementación de la ingesta por etapas
+ */
+
+#include "TuberiaIngesta.h"
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "PlanificadorRueda.h"
+#include "TrazaLatencia.h"
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+using namespace std;
+
+// Bytes que leer pide al puerto por llamada
+static const int BLOQUE_LECTURA = 4096;
+
+// Lecturas que ordenar saca de la cola por lote
+static const int LOTE_ORDENAR = 1024;
+
+// Vueltas de sondeo sin datos entre revisiones de la señal de flujo
+static const int VUELTAS_SENAL = 1024;
+
+/**
+ * @brief Orden de almacenar: por sensor, conservando el orden de llegada
+ */
+static bool menorSensor(const LecturaEntrante& a, const LecturaEntrante& b) {
+    return a.idSensor < b.idSensor;
+}
+
+TuberiaIngesta::TuberiaIngesta(ListaGeneral* destino, ControlIngesta* cola)
+    : ordenadas(&ejecutorEntrega), tareaOrdenar(etapaOrdenar()), tareaAlmacenar(etapaAlmacenar()) {
+    lista = destino;
+    control = cola;
+    presupuesto = 0;
+    entregadasTurno = 0;
+    lecturaUs = 0;
+    for (int i = 0; i < ETAPAS_INGESTA; i++) {
+        lotes[i].store(0);
+        entradas[i].store(0);
+        salidas[i].store(0);
+        nanosegundos[i].store(0);
+    }
+    
+    // Dejar ambas etapas esperando: ordenar su turno, almacenar un lote
+    ejecutorEntrega.programar(tareaAlmacenar.handle());
+    ejecutorEntrega.programar(tareaOrdenar.handle());
+    ejecutorEntrega.ejecutar();
+}
+
+void TuberiaIngesta::anotar(EtapaIngesta etapa, long long recibidos, long long entregados,
+                            chrono::steady_clock::time_point inicio) {
+    long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+    lotes[etapa].fetch_add(1, memory_order_relaxed);
+    entradas[etapa].fetch_add(recibidos, memory_order_relaxed);
+    salidas[etapa].fetch_add(entregados, memory_order_relaxed);
+    nanosegundos[etapa].fetch_add(ns, memory_order_relaxed);
+}
+
+void TuberiaIngesta::atenderSenal(SerialReader* serial) {
+    SenalFlujo senal = control->senalPendiente();
+    if (senal == SENAL_PAUSAR) {
+        serial->enviarByte(SerialReader::CARACTER_XOFF);
+    } else if (senal == SENAL_REANUDAR) {
+        serial->enviarByte(SerialReader::CARACTER_XON);
+    }
+}
+
+TareaEtapa TuberiaIngesta::etapaLeer(SerialReader* serial, const atomic<bool>* activo, bool sondeo,
+                                     EjecutorEtapas* ejecutor, CanalLotes<char>* salida) {
+    ArregloDinamico<char> lote;
+    char bloque[BLOQUE_LECTURA];
+    int vueltasVacias = 0;
+    
+    while (activo->load()) {
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        int leidos = serial->leerBloque(bloque, BLOQUE_LECTURA);
+        if (leidos > 0 && TrazaLatencia::global().estaActiva()) {
+            lecturaUs = TrazaLatencia::ahoraUs();
+        }
+        
+        if (leidos < 0) {
+            // Error del puerto: reintentar sin girar en vacío
+            this_thread::sleep_for(chrono::milliseconds(100));
+        } else if (leidos == 0 && sondeo) {
+            // Nada aún: ceder solo si otro hilo espera el procesador; la
+            // señal de flujo se revisa de vez en cuando, no en cada vuelta
+            this_thread::yield();
+            vueltasVacias = vueltasVacias + 1;
+            if (vueltasVacias < VUELTAS_SENAL) {
+                continue;
+            }
+        }
+        vueltasVacias = 0;
+        
+        // Tras cada lectura (o espera sin datos) el puerto atiende XON/XOFF
+        atenderSenal(serial);
+        
+        if (leidos > 0) {
+            for (int i = 0; i < leidos; i++) {
+                lote.agregar(bloque[i]);
+            }
+            anotar(ETAPA_LEER, leidos, leidos, inicio);
+            co_await salida->enviar(lote);
+            
+            // Que el lote llegue a la cola antes de volver a bloquear en el puerto
+            co_await ejecutor->inactivo();
+        }
+    }
+    salida->cerrar();
+}
+
+TareaEtapa TuberiaIngesta::etapaEnmarcar(CanalLotes<char>* entrada, CanalLotes<LineaRecibida>* salida) {
+    ArregloDinamico<char> bytes;
+    ArregloDinamico<LineaRecibida> lote;
+    LineaRecibida actual;
+    int usados = 0;
+    
+    while (co_await entrada->recibir(bytes)) {
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        
+        for (int i = 0; i < bytes.tamano(); i++) {
+            char caracter = bytes[i];
+            if (caracter == '\n') {
+                // Las líneas vacías (\r\n sueltos) no llegan a interpretar
+                if (usados > 0) {
+                    actual.texto[usados] = '\0';
+                    actual.leidaUs = lecturaUs;
+                    lote.agregar(actual);
+                }
+                usados = 0;
+            } else if (caracter != '\r' && usados < (int)sizeof(actual.texto) - 1) {
+                // Las líneas más largas que el búfer se truncan
+                actual.texto[usados] = caracter;
+                usados = usados + 1;
+            }
+        }
+        
+        anotar(ETAPA_ENMARCAR, bytes.tamano(), lote.tamano(), inicio);
+        if (lote.tamano() > 0) {
+            co_await salida->enviar(lote);
+        }
+    }
+    salida->cerrar();
+}
+
+TareaEtapa TuberiaIngesta::etapaInterpretar(CanalLotes<LineaRecibida>* entrada, CanalLotes<LecturaAnalizada>* salida) {
+    ArregloDinamico<LineaRecibida> lineas;
+    ArregloDinamico<LecturaAnalizada> lote;
+    
+    while (co_await entrada->recibir(lineas)) {
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        
+        LecturaAnalizada analizada;
+        for (int i = 0; i < lineas.tamano(); i++) {
+            if (analizar(lineas[i].texto, analizada)) {
+                analizada.leidaUs = lineas[i].leidaUs;
+                lote.agregar(analizada);
+            } else {
+                control->registrarLineaInvalida();
+            }
+        }
+        
+        anotar(ETAPA_INTERPRETAR, lineas.tamano(), lote.tamano(), inicio);
+        if (lote.tamano() > 0) {
+            co_await salida->enviar(lote);
+        }
+    }
+    salida->cerrar();
+}
+
+TareaEtapa TuberiaIngesta::etapaEnrutar(CanalLotes<LecturaAnalizada>* entrada) {
+    ArregloDinamico<LecturaAnalizada> analizadas;
+    
+    while (co_await entrada->recibir(analizadas)) {
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        
+        // Un directorio y una hora por lote, no por lectura
+        shared_ptr<const DirectorioSensores> directorio = lista->leerDirectorio();
+        long long ahoraMs = PlanificadorRueda::ahoraMs();
+        int encoladas = 0;
+        
+        LecturaEntrante lectura;
+        for (int i = 0; i < analizadas.tamano(); i++) {
+            if (!enrutar(analizadas[i], *directorio, lectura)) {
+                control->registrarSinDestino();
+                continue;
+            }
+            
+            // Solo las muestreadas conservan sus marcas hasta almacenar
+            if (lectura.leidaUs != 0 && TrazaLatencia::global().muestrear(lectura.idSensor)) {
+                lectura.encoladaUs = TrazaLatencia::ahoraUs();
+            } else {
+                lectura.leidaUs = 0;
+            }
+            if (control->ofrecer(lectura, ahoraMs)) {
+                encoladas = encoladas + 1;
+            }
+        }
+        
+        anotar(ETAPA_ENRUTAR, analizadas.tamano(), encoladas, inicio);
+    }
+}
+
+TareaEtapa TuberiaIngesta::etapaOrdenar() {
+    LecturaEntrante extraidas[LOTE_ORDENAR];
+    ArregloDinamico<LecturaEntrante> lote;
+    
+    while (true) {
+        co_await EsperaTurno{this};
+        
+        // La última vuelta del turno (nada extraído) suelta lo retenido que venció
+        int n = -1;
+        while (n != 0) {
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            int pedir = presupuesto < LOTE_ORDENAR ? presupuesto : LOTE_ORDENAR;
+            n = (pedir > 0) ? control->extraer(extraidas, pedir) : 0;
+            presupuesto = presupuesto - n;
+            
+            control->ordenar(extraidas, n, lote);
+            if (n > 0 || lote.tamano() > 0) {
+                anotar(ETAPA_ORDENAR, n, lote.tamano(), inicio);
+            }
+            if (lote.tamano() > 0) {
+                co_await ordenadas.enviar(lote);
+            }
+        }
+    }
+}
+
+TareaEtapa TuberiaIngesta::etapaAlmacenar() {
+    ArregloDinamico<LecturaEntrante> lote;
+    ArregloDinamico<float> temperaturas;
+    ArregloDinamico<int> presiones;
+    
+    while (co_await ordenadas.recibir(lote)) {
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        int entregadas = 0;
+        int sinDestino = 0;
+        
+        // Agrupar por sensor sin alterar el orden de cada uno: un registrarLote
+        // (una instantánea, una actualización de agregados) por sensor
+        LecturaEntrante* primera = &lote[0];
+        stable_sort(primera, primera + lote.tamano(), menorSensor);
+        
+        int i = 0;
+        while (i < lote.tamano()) {
+            int fin = i + 1;
+            while (fin < lote.tamano() && lote[fin].idSensor == lote[i].idSensor) {
+                fin = fin + 1;
+            }
+            int cantidad = fin - i;
+            
+            SensorBase* sensor = (lote[i].idSensor >= 0) ? lista->buscarPorId(lote[i].idSensor) : 0;
+            if (sensor != 0 && sensor->obtenerTipo() == SENSOR_TEMPERATURA && lote[i].tipo == SENSOR_TEMPERATURA) {
+                temperaturas.limpiar();
+                for (int k = i; k < fin; k++) {
+                    temperaturas.agregar((float)lote[k].valor);
+                }
+                ((SensorTemperatura*)sensor)->registrarLote(&temperaturas[0], cantidad);
+                entregadas = entregadas + cantidad;
+            } else if (sensor != 0 && sensor->obtenerTipo() == SENSOR_PRESION && lote[i].tipo == SENSOR_PRESION) {
+                presiones.limpiar();
+                for (int k = i; k < fin; k++) {
+                    presiones.agregar((int)lote[k].valor);
+                }
+                ((SensorPresion*)sensor)->registrarLote(&presiones[0], cantidad);
+                entregadas = entregadas + cantidad;
+            } else {
+                // El sensor se eliminó (o cambió) mientras la lectura esperaba
+                sinDestino = sinDestino + cantidad;
+            }
+            i = fin;
+        }
+        
+        trazar(lote);
+        control->contarEntregadas(entregadas, sinDestino);
+        entregadasTurno = entregadasTurno + entregadas;
+        anotar(ETAPA_ALMACENAR, lote.tamano(), entregadas, inicio);
+    }
+}
+
+void TuberiaIngesta::trazar(const ArregloDinamico<LecturaEntrante>& lote) {
+    TrazaLatencia& traza = TrazaLatencia::global();
+    if (!traza.estaActiva()) {
+        return;
+    }
+    
+    long long ahora = TrazaLatencia::ahoraUs();
+    for (int i = 0; i < lote.tamano(); i++) {
+        const LecturaEntrante& lectura = lote[i];
+        if (lectura.leidaUs == 0) {
+            continue;
+        }
+        TrazaLectura marcas;
+        marcas.idSensor = lectura.idSensor;
+        marcas.secuencia = lectura.secuencia;
+        marcas.emitidaUs = lectura.emitidaUs;
+        marcas.leidaUs = lectura.leidaUs;
+        marcas.encoladaUs = lectura.encoladaUs;
+        marcas.almacenadaUs = ahora;
+        marcas.procesadaUs = 0;
+        traza.almacenada(marcas);
+    }
+}
+
+void TuberiaIngesta::leerPuerto(SerialReader* serial, const atomic<bool>& activo, bool sondeo) {
+    EjecutorEtapas ejecutor;
+    CanalLotes<char> bytes(&ejecutor);
+    CanalLotes<LineaRecibida> lineas(&ejecutor);
+    CanalLotes<LecturaAnalizada> analizadas(&ejecutor);
+    
+    TareaEtapa enrutar = etapaEnrutar(&analizadas);
+    TareaEtapa interpretar = etapaInterpretar(&lineas, &analizadas);
+    TareaEtapa enmarcar = etapaEnmarcar(&bytes, &lineas);
+    TareaEtapa leer = etapaLeer(serial, &activo, sondeo, &ejecutor, &bytes);
+    
+    // Las consumidoras primero, para que esperen antes del primer lote
+    ejecutor.programar(enrutar.handle());
+    ejecutor.programar(interpretar.handle());
+    ejecutor.programar(enmarcar.handle());
+    ejecutor.programar(leer.handle());
+    
+    // Vuelve cuando leer termina y el cierre recorre las demás etapas
+    ejecutor.ejecutar();
+}
+
+int TuberiaIngesta::entregar(int maximo) {
+    presupuesto = maximo;
+    entregadasTurno = 0;
+    
+    if (esperandoTurno) {
+        coroutine_handle<> ordenar = esperandoTurno;
+        esperandoTurno = coroutine_handle<>();
+        ejecutorEntrega.programar(ordenar);
+        ejecutorEntrega.ejecutar();
+    }
+    return entregadasTurno;
+}
+
+ControlIngesta* TuberiaIngesta::cola() const {
+    return control;
+}
+
+ContadoresEtapa TuberiaIngesta::leerEtapa(EtapaIngesta etapa) const {
+    ContadoresEtapa copia;
+    copia.lotes = lotes[etapa].load(memory_order_relaxed);
+    copia.entradas = entradas[etapa].load(memory_order_relaxed);
+    copia.salidas = salidas[etapa].load(memory_order_relaxed);
+    copia.nanosegundos = nanosegundos[etapa].load(memory_order_relaxed);
+    return copia;
+}
+
+const char* TuberiaIngesta::nombreEtapa(EtapaIngesta etapa) {
+    switch (etapa) {
+        case ETAPA_LEER: return "leer";
+        case ETAPA_ENMARCAR: return "enmarcar";
+        case ETAPA_INTERPRETAR: return "interpretar";
+        case ETAPA_ENRUTAR: return "enrutar";
+        case ETAPA_ORDENAR: return "ordenar";
+        case ETAPA_ALMACENAR: return "almacenar";
+        default: return "?";
+    }
+}
+
+void TuberiaIngesta::imprimir() const {
+    cout << "\n--- Etapas de la ingesta ---" << endl;
+    cout << "etapa          lotes     entradas      salidas  ocupado ms   elem/s ocupado" << endl;
+    
+    int masLenta = -1;
+    long long mayorNs = 0;
+    char fila[128];
+    for (int i = 0; i < ETAPAS_INGESTA; i++) {
+        ContadoresEtapa etapa = leerEtapa((EtapaIngesta)i);
+        double ritmo = etapa.nanosegundos > 0 ? etapa.entradas * 1e9 / etapa.nanosegundos : 0.0;
+        snprintf(fila, sizeof(fila), "%-11s %8lld %12lld %12lld %11.1f %16.0f", nombreEtapa((EtapaIngesta)i),
+                 etapa.lotes, etapa.entradas, etapa.salidas, etapa.nanosegundos / 1e6, ritmo);
+        cout << fila << endl;
+        
+        // leer incluye la espera del puerto: no es trabajo de la etapa
+        if (i != ETAPA_LEER && etapa.nanosegundos > mayorNs) {
+            mayorNs = etapa.nanosegundos;
+            masLenta = i;
+        }
+    }
+    
+    if (masLenta >= 0) {
+        cout << "Cuello de botella: " << nombreEtapa((EtapaIngesta)masLenta) << endl;
+    }
+}
+
+bool TuberiaIngesta::analizar(const char* linea, LecturaAnalizada& analizada) {
+    const char* nombrePorDefecto;
+    if (strncmp(linea, "TEMP:", 5) == 0) {
+        analizada.tipo = SENSOR_TEMPERATURA;
+        nombrePorDefecto = "T-001";
+    } else if (strncmp(linea, "PRES:", 5) == 0) {
+        analizada.tipo = SENSOR_PRESION;
+        nombrePorDefecto = "P-105";
+    } else {
+        return false;
+    }
+    
+    const char* resto = linea + 5;
+    
+    // Marca de emisión opcional al final: ...@us (solo dígitos tras la última '@')
+    const char* finLinea = resto + strlen(resto);
+    const char* fin = finLinea;
+    analizada.emitidaUs = -1;
+    const char* arroba = strrchr(resto, '@');
+    if (arroba != 0 && arroba[1] != '\0' && arroba + 1 + strspn(arroba + 1, "0123456789") == finLinea) {
+        analizada.emitidaUs = strtoll(arroba + 1, 0, 10);
+        fin = arroba;
+    }
+    analizada.leidaUs = 0;
+    
+    // Secuencia opcional: ...:valor#secuencia
+    const char* marca = strchr(resto, '#');
+    if (marca != 0 && marca > fin) {
+        marca = 0;
+    }
+    analizada.secuencia = -1;
+    if (marca != 0) {
+        char* finSecuencia = 0;
+        long long secuencia = strtoll(marca + 1, &finSecuencia, 10);
+        if (finSecuencia == marca + 1 || finSecuencia != fin || secuencia < 0) {
+            return false;
+        }
+        analizada.secuencia = secuencia;
+    }
+    const char* finValor = (marca != 0) ? marca : fin;
+    
+    // El nombre va antes del último ':' que precede a la secuencia
+    const char* separador = 0;
+    for (const char* c = resto; c != finValor; c++) {
+        if (*c == ':') {
+            separador = c;
+        }
+    }
+    const char* textoValor = resto;
+    
+    if (separador != 0) {
+        int longitud = (int)(separador - resto);
+        if (longitud <= 0 || longitud >= (int)sizeof(analizada.nombre)) {
+            return false;
+        }
+        memcpy(analizada.nombre, resto, longitud);
+        analizada.nombre[longitud] = '\0';
+        textoValor = separador + 1;
+    } else {
+        strcpy(analizada.nombre, nombrePorDefecto);
+    }
+    
+    char* finNumero = 0;
+    analizada.valor = strtod(textoValor, &finNumero);
+    if (finNumero == textoValor || (finValor != finLinea && finNumero != finValor)) {
+        return false;
+    }
+    // strtod acepta "nan" e "inf": ningún sensor mide eso
+    if (!isfinite(analizada.valor)) {
+        return false;
+    }
+    return true;
+}
+
+bool TuberiaIngesta::enrutar(const LecturaAnalizada& analizada, const DirectorioSensores& directorio,
+                             LecturaEntrante& lectura) {
+    int indice = directorio.buscar(analizada.nombre);
+    if (indice < 0 || directorio[indice].tipo != analizada.tipo) {
+        return false;
+    }
+    lectura.idSensor = directorio[indice].id;
+    lectura.tipo = analizada.tipo;
+    lectura.valor = analizada.valor;
+    lectura.secuencia = analizada.secuencia;
+    lectura.emitidaUs = analizada.emitidaUs;
+    lectura.leidaUs = analizada.leidaUs;
+    lectura.encoladaUs = 0;
+    return true;
+}
@@ -0,0 +1,248 @@
+/**
+ * @file TuberiaIngesta.h
+ * @brief Ingesta por etapas: leer, enmarcar, interpretar, enrutar, ordenar y almacenar
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef TUBERIA_INGESTA_H
+#define TUBERIA_INGESTA_H
+
+#include "EjecutorEtapas.h"
+#include "ControlIngesta.h"
+#include "SerialReader.h"
+#include "DirectorioSensores.h"
+#include <atomic>
+#include <chrono>
+
+class ListaGeneral;
+
+/**
+ * @brief Etapas de la ingesta, en el orden en que pasa cada lectura
+ */
+enum EtapaIngesta {
+    ETAPA_LEER,        ///< Bytes del puerto (hilo lector)
+    ETAPA_ENMARCAR,    ///< Bytes -> líneas
+    ETAPA_INTERPRETAR, ///< Líneas -> tipo, nombre, valor y secuencia
+    ETAPA_ENRUTAR,     ///< Nombre -> ID de sensor y a la cola de ControlIngesta
+    ETAPA_ORDENAR,     ///< Cola -> ventanas de reorden (hilo principal)
+    ETAPA_ALMACENAR,   ///< Lote de cada sensor -> historial, agregados e instantánea
+    ETAPAS_INGESTA     ///< Número de etapas
+};
+
+/**
+ * @brief Línea completa recibida del puerto
+ */
+struct LineaRecibida {
+    char texto[128];   ///< Texto sin salto de línea
+    long long leidaUs; ///< Hora local del bloque que la completó (0 = sin trazar)
+};
+
+/**
+ * @brief Lectura interpretada cuyo sensor aún no se buscó
+ */
+struct LecturaAnalizada {
+    TipoSensor tipo;     ///< Tipo indicado por el prefijo
+    char nombre[64];     ///< Nombre del sensor destino
+    double valor;        ///< Valor leído
+    long long secuencia; ///< Secuencia del dispositivo (-1 = sin secuencia)
+    long long emitidaUs; ///< Marca del dispositivo en us (-1 = sin marca)
+    long long leidaUs;   ///< Hora local de lectura del puerto (0 = sin trazar)
+};
+
+/**
+ * @brief Contadores de una etapa
+ */
+struct ContadoresEtapa {
+    long long lotes;        ///< Lotes procesados
+    long long entradas;     ///< Elementos recibidos (bytes, líneas o lecturas)
+    long long salidas;      ///< Elementos entregados a la etapa siguiente
+    long long nanosegundos; ///< Tiempo ocupado procesando lotes
+};
+
+/**
+ * @class TuberiaIngesta
+ * @brief La ingesta serial como etapas independientes que se pasan lotes
+ *
+ * Cada etapa es una corrutina que recibe un lote, lo transforma y lo
+ * entrega a la siguiente por un CanalLotes. Las cuatro primeras corren en
+ * el hilo lector (leerPuerto) y terminan en la cola de ControlIngesta, que
+ * cruza al hilo principal; ordenar y almacenar corren en él con cada
+ * entregar(). Una etapa se puede fusionar con su vecina, cambiar o
+ * repartir en hilos sin tocar a las demás: solo ve lotes de entrada y de
+ * salida.
+ *
+ * Los lotes reducen el costo fijo por lectura: enrutar lee el directorio
+ * una vez por lote y almacenar agrupa por sensor para publicar una sola
+ * instantánea (y actualizar una vez los agregados) por sensor y lote.
+ *
+ * Cada etapa cuenta lotes, elementos y tiempo ocupado; imprimir() señala
+ * la más lenta. El tiempo de leer incluye la espera del puerto, así que
+ * no cuenta para elegir el cuello de botella.
+ *
+ * Con TrazaLatencia activa, las etapas anotan en las lecturas muestreadas
+ * cuándo se leyeron, encolaron y almacenaron.
+ */
+class TuberiaIngesta {
+private:
+    ListaGeneral* lista;        ///< Sensores destino
+    ControlIngesta* control;    ///< Cola entre el hilo lector y el principal
+    
+    std::atomic<long long> lotes[ETAPAS_INGESTA];        ///< Lotes por etapa
+    std::atomic<long long> entradas[ETAPAS_INGESTA];     ///< Elementos recibidos por etapa
+    std::atomic<long long> salidas[ETAPAS_INGESTA];      ///< Elementos entregados por etapa
+    std::atomic<long long> nanosegundos[ETAPAS_INGESTA]; ///< Tiempo ocupado por etapa
+    long long lecturaUs;                                 ///< Hora del último bloque leído, para TrazaLatencia (hilo lector)
+    
+    // Mitad del hilo principal: vive entre llamadas a entregar()
+    EjecutorEtapas ejecutorEntrega;              ///< Ejecutor de ordenar y almacenar
+    CanalLotes<LecturaEntrante> ordenadas;       ///< ordenar -> almacenar
+    std::coroutine_handle<> esperandoTurno;      ///< ordenar, suspendida hasta el próximo entregar()
+    int presupuesto;                             ///< Lecturas que aún puede sacar este turno
+    int entregadasTurno;                         ///< Lecturas almacenadas este turno
+    TareaEtapa tareaOrdenar;                     ///< Corrutina de ordenar
+    TareaEtapa tareaAlmacenar;                   ///< Corrutina de almacenar
+    
+    /**
+     * @brief Espera de ordenar hasta la próxima llamada a entregar()
+     */
+    struct EsperaTurno {
+        TuberiaIngesta* tuberia; ///< Dueña de la etapa
+        
+        bool await_ready() const {
+            return false;
+        }
+        
+        void await_suspend(std::coroutine_handle<> etapa) {
+            tuberia->esperandoTurno = etapa;
+        }
+        
+        void await_resume() {
+        }
+    };
+    
+    /**
+     * @brief Suma un lote a los contadores de su etapa
+     */
+    void anotar(EtapaIngesta etapa, long long recibidos, long long entregados,
+                std::chrono::steady_clock::time_point inicio);
+    
+    /**
+     * @brief Envía al dispositivo la señal de control de flujo pendiente
+     */
+    void atenderSenal(SerialReader* serial);
+    
+    /**
+     * @brief Lee bloques del puerto mientras activo sea true; luego cierra salida
+     */
+    TareaEtapa etapaLeer(SerialReader* serial, const std::atomic<bool>* activo, bool sondeo,
+                         EjecutorEtapas* ejecutor, CanalLotes<char>* salida);
+    
+    /**
+     * @brief Corta los bytes en líneas (conserva la línea a medias entre lotes)
+     */
+    TareaEtapa etapaEnmarcar(CanalLotes<char>* entrada, CanalLotes<LineaRecibida>* salida);
+    
+    /**
+     * @brief analizar() sobre cada línea; cuenta las inválidas
+     */
+    TareaEtapa etapaInterpretar(CanalLotes<LineaRecibida>* entrada, CanalLotes<LecturaAnalizada>* salida);
+    
+    /**
+     * @brief enrutar() con un directorio por lote y ofrece cada lectura a la cola
+     */
+    TareaEtapa etapaEnrutar(CanalLotes<LecturaAnalizada>* entrada);
+    
+    /**
+     * @brief En cada turno extrae de la cola y pasa los lotes por las ventanas de reorden
+     */
+    TareaEtapa etapaOrdenar();
+    
+    /**
+     * @brief Agrupa cada lote por sensor y lo registra con registrarLote
+     */
+    TareaEtapa etapaAlmacenar();
+    
+    /**
+     * @brief Entrega a TrazaLatencia las lecturas muestreadas de un lote ya almacenado
+     */
+    void trazar(const ArregloDinamico<LecturaEntrante>& lote);
+    
+    TuberiaIngesta(const TuberiaIngesta&);
+    TuberiaIngesta& operator=(const TuberiaIngesta&);
+    
+public:
+    /**
+     * @brief Constructor (prepara la mitad del hilo principal)
+     * @param destino Lista cuyos sensores reciben las lecturas
+     * @param cola Control de ingesta entre ambos hilos
+     */
+    TuberiaIngesta(ListaGeneral* destino, ControlIngesta* cola);
+    
+    /**
+     * @brief Corre leer, enmarcar, interpretar y enrutar hasta que activo sea false
+     *
+     * Se llama desde el hilo lector.
+     * @param serial Puerto ya abierto
+     * @param activo Se consulta antes de cada lectura del puerto
+     * @param sondeo true si el puerto vuelve en el acto (VMIN = VTIME = 0)
+     */
+    void leerPuerto(SerialReader* serial, const std::atomic<bool>& activo, bool sondeo);
+    
+    /**
+     * @brief Corre ordenar y almacenar sobre lo encolado (hilo principal)
+     * @param maximo Lecturas a sacar de la cola como máximo
+     * @return Lecturas almacenadas en su sensor
+     */
+    int entregar(int maximo);
+    
+    /**
+     * @brief Cola de ControlIngesta que alimenta la tubería
+     * @return Control de ingesta
+     */
+    ControlIngesta* cola() const;
+    
+    /**
+     * @brief Copia de los contadores de una etapa
+     * @param etapa Etapa a consultar
+     * @return Contadores acumulados
+     */
+    ContadoresEtapa leerEtapa(EtapaIngesta etapa) const;
+    
+    /**
+     * @brief Imprime lotes, elementos y ritmo de cada etapa, y la más lenta
+     */
+    void imprimir() const;
+    
+    /**
+     * @brief Nombre de una etapa
+     * @param etapa Etapa
+     * @return Nombre corto ("leer", "enmarcar", ...)
+     */
+    static const char* nombreEtapa(EtapaIngesta etapa);
+    
+    /**
+     * @brief Interpreta una línea sin buscar el sensor
+     *
+     * Formatos: TEMP:valor, PRES:valor (sensores T-001 y P-105),
+     * TEMP:nombre:valor, PRES:nombre:valor, con #secuencia opcional al final
+     * y, tras ella o tras el valor, @marca opcional (us del dispositivo).
+     * Los valores no finitos (nan, inf) hacen inválida la línea.
+     * @param linea Texto sin salto de línea
+     * @param analizada Recibe tipo, nombre, valor, secuencia y marca
+     * @return false si la línea es inválida
+     */
+    static bool analizar(const char* linea, LecturaAnalizada& analizada);
+    
+    /**
+     * @brief Busca el sensor de una lectura interpretada
+     * @param analizada Lectura interpretada
+     * @param directorio Directorio donde buscar el sensor
+     * @param lectura Recibe la lectura lista para encolar
+     * @return false si el sensor no existe o es de otro tipo
+     */
+    static bool enrutar(const LecturaAnalizada& analizada, const DirectorioSensores& directorio,
+                        LecturaEntrante& lectura);
+};
+
+#endif // TUBERIA_INGESTA_H
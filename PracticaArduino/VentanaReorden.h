@@ -0,0 +1,300 @@
+/**
+ * @file VentanaReorden.h
+ * @brief Ventana acotada que reordena y deduplica lecturas por secuencia
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#ifndef VENTANA_REORDEN_H
+#define VENTANA_REORDEN_H
+
+#include "ArregloDinamico.h"
+
+/**
+ * @brief Contadores de una ventana de reorden
+ */
+struct ContadoresReorden {
+    long long adelantadas; ///< Llegaron antes que alguna anterior (se retuvieron)
+    long long duplicadas;  ///< Repetidas dentro de la ventana
+    long long tardias;     ///< Llegaron cuando su turno ya había pasado (o repetidas de una ya emitida)
+    long long huecos;      ///< Secuencias que nunca llegaron a tiempo
+    long long reinicios;   ///< Veces que la fuente reinició su secuencia
+    
+    /**
+     * @brief Constructor con todo en cero
+     */
+    ContadoresReorden() {
+        adelantadas = 0;
+        duplicadas = 0;
+        tardias = 0;
+        huecos = 0;
+        reinicios = 0;
+    }
+    
+    /**
+     * @brief Acumula otros contadores en estos
+     * @param otros Contadores a sumar
+     */
+    void sumar(const ContadoresReorden& otros) {
+        adelantadas = adelantadas + otros.adelantadas;
+        duplicadas = duplicadas + otros.duplicadas;
+        tardias = tardias + otros.tardias;
+        huecos = huecos + otros.huecos;
+        reinicios = reinicios + otros.reinicios;
+    }
+};
+
+/**
+ * @class VentanaReorden
+ * @brief Retiene hasta W lecturas y las emite en orden de secuencia
+ * @tparam T Lectura con un campo long long secuencia
+ *
+ * Las lecturas se guardan en un montículo mínimo por secuencia, así que
+ * insertar y emitir cuestan O(log W). Se emite mientras la cima sea la
+ * secuencia esperada; una secuencia menor a la esperada es tardía o
+ * repetida y se descarta. Si la ventana se llena, o la lectura esperada
+ * tarda más de la espera máxima, se da por perdida: se cuenta el hueco y
+ * se sigue desde la menor retenida.
+ *
+ * La secuencia es por defecto un contador que avanza de 1 en 1. Con
+ * marcasTiempo es una marca de tiempo del dispositivo: los saltos son
+ * normales, no huecos, así que no hay una "esperada" que aguardar y se
+ * emite en orden de montículo todo lo que supere la última emitida (lo
+ * que llegue después de una posterior cuenta como tardía).
+ *
+ * Un retroceso mayor que umbralReinicio se toma como reinicio de la
+ * fuente (por ejemplo, un Arduino que arranca de nuevo en 0): se vacía
+ * lo retenido y se sigue desde ahí.
+ */
+template <typename T>
+class VentanaReorden {
+private:
+    ArregloDinamico<T> monticulo; ///< Montículo mínimo por secuencia
+    int capacidad;                ///< W: lecturas retenidas como máximo
+    long long siguiente;          ///< Secuencia esperada, o mínima aceptable con marcas (-1 = sin iniciar)
+    long long umbralReinicio;     ///< Retroceso que se toma como reinicio
+    bool marcasTiempo;            ///< true: la secuencia es una marca de tiempo
+    long long bloqueadaDesdeMs;   ///< Desde cuándo se espera a "siguiente" (-1 = no se espera)
+    ContadoresReorden contadores; ///< Contadores acumulados
+    
+    /**
+     * @brief Sube un elemento hasta su lugar en el montículo
+     */
+    void subir(int indice);
+    
+    /**
+     * @brief Baja un elemento hasta su lugar en el montículo
+     */
+    void bajar(int indice);
+    
+    /**
+     * @brief Saca la menor secuencia del montículo
+     */
+    T extraerMinimo();
+    
+    /**
+     * @brief Emite todo lo que ya está en orden
+     * @param salida Destino de las lecturas emitidas
+     * @param forzar Lecturas a soltar aunque falten anteriores
+     * @return Lecturas escritas en salida
+     */
+    int emitir(T* salida, int forzar);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param ventana W, lecturas retenidas como máximo (mínimo 1)
+     * @param reinicio Retroceso de secuencia que se toma como reinicio
+     * @param marcas true si la secuencia es una marca de tiempo creciente
+     */
+    VentanaReorden(int ventana, long long reinicio, bool marcas);
+    
+    /**
+     * @brief Agrega una lectura y emite las que quedan en orden
+     * @param lectura Lectura con secuencia
+     * @param ahoraMs Tiempo actual (para la espera máxima)
+     * @param salida Arreglo con espacio para retenidas() + 1 lecturas
+     * @return Lecturas emitidas en salida, en orden de secuencia
+     */
+    int insertar(const T& lectura, long long ahoraMs, T* salida);
+    
+    /**
+     * @brief Suelta lo retenido si la esperada tarda demasiado
+     * @param ahoraMs Tiempo actual
+     * @param esperaMaximaMs Espera tolerada por una lectura faltante
+     * @param salida Arreglo con espacio para retenidas() lecturas
+     * @return Lecturas emitidas
+     */
+    int expirar(long long ahoraMs, long long esperaMaximaMs, T* salida);
+    
+    /**
+     * @brief Emite todo lo retenido, en orden
+     * @param salida Arreglo con espacio para retenidas() lecturas
+     * @return Lecturas emitidas
+     */
+    int vaciar(T* salida);
+    
+    /**
+     * @brief Lecturas retenidas esperando a una anterior
+     * @return Tamaño del montículo
+     */
+    int retenidas() const;
+    
+    /**
+     * @brief Suma los contadores a destino y los deja en cero
+     * @param destino Contadores donde acumular
+     */
+    void retirarContadores(ContadoresReorden& destino);
+};
+
+template <typename T>
+VentanaReorden<T>::VentanaReorden(int ventana, long long reinicio, bool marcas) {
+    capacidad = ventana < 1 ? 1 : ventana;
+    siguiente = -1;
+    umbralReinicio = reinicio;
+    marcasTiempo = marcas;
+    bloqueadaDesdeMs = -1;
+}
+
+template <typename T>
+void VentanaReorden<T>::subir(int indice) {
+    while (indice > 0) {
+        int padre = (indice - 1) / 2;
+        if (monticulo[padre].secuencia <= monticulo[indice].secuencia) {
+            break;
+        }
+        T temp = monticulo[padre];
+        monticulo[padre] = monticulo[indice];
+        monticulo[indice] = temp;
+        indice = padre;
+    }
+}
+
+template <typename T>
+void VentanaReorden<T>::bajar(int indice) {
+    int n = monticulo.tamano();
+    while (true) {
+        int menor = indice;
+        int izquierdo = 2 * indice + 1;
+        int derecho = izquierdo + 1;
+        if (izquierdo < n && monticulo[izquierdo].secuencia < monticulo[menor].secuencia) {
+            menor = izquierdo;
+        }
+        if (derecho < n && monticulo[derecho].secuencia < monticulo[menor].secuencia) {
+            menor = derecho;
+        }
+        if (menor == indice) {
+            return;
+        }
+        T temp = monticulo[menor];
+        monticulo[menor] = monticulo[indice];
+        monticulo[indice] = temp;
+        indice = menor;
+    }
+}
+
+template <typename T>
+T VentanaReorden<T>::extraerMinimo() {
+    T minimo = monticulo[0];
+    // quitarIntercambiando mueve el último a la raíz
+    monticulo.quitarIntercambiando(0);
+    if (monticulo.tamano() > 0) {
+        bajar(0);
+    }
+    return minimo;
+}
+
+template <typename T>
+int VentanaReorden<T>::emitir(T* salida, int forzar) {
+    int emitidas = 0;
+    
+    while (monticulo.tamano() > 0) {
+        long long cima = monticulo[0].secuencia;
+        
+        if (cima < siguiente) {
+            // Repetida de una ya emitida mientras estaba retenida
+            extraerMinimo();
+            contadores.duplicadas = contadores.duplicadas + 1;
+        } else if (cima == siguiente || marcasTiempo) {
+            // Con marcas no falta nada entre la última emitida y la cima
+            salida[emitidas] = extraerMinimo();
+            emitidas = emitidas + 1;
+            siguiente = cima + 1;
+        } else if (forzar > 0 || monticulo.tamano() > capacidad) {
+            // La esperada no llegó a tiempo: saltar hasta la menor retenida
+            contadores.huecos = contadores.huecos + (cima - siguiente);
+            siguiente = cima;
+            forzar = forzar - 1;
+        } else {
+            break;
+        }
+    }
+    
+    return emitidas;
+}
+
+template <typename T>
+int VentanaReorden<T>::insertar(const T& lectura, long long ahoraMs, T* salida) {
+    int emitidas = 0;
+    
+    if (siguiente < 0) {
+        siguiente = lectura.secuencia;
+    }
+    
+    if (lectura.secuencia < siguiente) {
+        if (siguiente - lectura.secuencia <= umbralReinicio) {
+            contadores.tardias = contadores.tardias + 1;
+            return 0;
+        }
+        // La fuente volvió a empezar: soltar lo anterior y seguir desde aquí
+        contadores.reinicios = contadores.reinicios + 1;
+        emitidas = vaciar(salida);
+        siguiente = lectura.secuencia;
+    } else if (lectura.secuencia > siguiente && !marcasTiempo) {
+        contadores.adelantadas = contadores.adelantadas + 1;
+    }
+    
+    monticulo.agregar(lectura);
+    subir(monticulo.tamano() - 1);
+    
+    emitidas = emitidas + emitir(salida + emitidas, 0);
+    
+    // Reiniciar la espera cuando se avanza o ya no falta nada
+    if (monticulo.tamano() == 0) {
+        bloqueadaDesdeMs = -1;
+    } else if (emitidas > 0 || bloqueadaDesdeMs < 0) {
+        bloqueadaDesdeMs = ahoraMs;
+    }
+    return emitidas;
+}
+
+template <typename T>
+int VentanaReorden<T>::expirar(long long ahoraMs, long long esperaMaximaMs, T* salida) {
+    if (bloqueadaDesdeMs < 0 || ahoraMs - bloqueadaDesdeMs < esperaMaximaMs) {
+        return 0;
+    }
+    
+    int emitidas = emitir(salida, 1);
+    bloqueadaDesdeMs = (monticulo.tamano() > 0) ? ahoraMs : -1;
+    return emitidas;
+}
+
+template <typename T>
+int VentanaReorden<T>::vaciar(T* salida) {
+    int emitidas = emitir(salida, monticulo.tamano());
+    bloqueadaDesdeMs = -1;
+    return emitidas;
+}
+
+template <typename T>
+int VentanaReorden<T>::retenidas() const {
+    return monticulo.tamano();
+}
+
+template <typename T>
+void VentanaReorden<T>::retirarContadores(ContadoresReorden& destino) {
+    destino.sumar(contadores);
+    contadores = ContadoresReorden();
+}
+
+#endif // VENTANA_REORDEN_H
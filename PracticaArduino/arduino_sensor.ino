@@ -1,61 +1,120 @@
-/**
- * @file arduino_sensor.ino
- * @brief Simulador de sensores IoT para Arduino
- * @author Juan Francisco Ortega Pulido
- * @date 2025
- * 
- * Este sketch simula sensores de temperatura y presión,
- * enviando datos por el puerto serial en formato:
- * TEMP:valor o PRES:valor
- */
-
-/**
- * @brief Configuración inicial del Arduino
- * 
- * Se ejecuta una sola vez al iniciar el Arduino.
- * Configura la comunicación serial a 9600 baudios.
- */
-void setup() {
-  // Iniciar comunicación serial a 9600 baudios
-  Serial.begin(9600);
-  
-  // Inicializar generador de números aleatorios
-  randomSeed(analogRead(0));
-  
-  // Mensaje de inicio
-  Serial.println("=================================");
-  Serial.println("Simulador de Sensores IoT");
-  Serial.println("Enviando datos al sistema...");
-  Serial.println("=================================");
-  delay(2000);
-}
-
-/**
- * @brief Bucle principal que se ejecuta continuamente
- * 
- * Envía lecturas simuladas de temperatura y presión
- * alternadamente cada 2 segundos.
- */
-void loop() {
-  // Simular sensor de temperatura
-  // Genera valores entre 20.0 y 50.0 grados Celsius
-  float temperatura = 20.0 + random(0, 300) / 10.0;
-  
-  // Enviar temperatura en formato: TEMP:valor
-  Serial.print("TEMP:");
-  Serial.println(temperatura);
-  
-  // Esperar 2 segundos
-  delay(2000);
-  
-  // Simular sensor de presión
-  // Genera valores entre 70 y 120 unidades
-  int presion = random(70, 120);
-  
-  // Enviar presión en formato: PRES:valor
-  Serial.print("PRES:");
-  Serial.println(presion);
-  
-  // Esperar 2 segundos antes de la siguiente lectura
-  delay(2000);
+/**
+ * @file arduino_sensor.ino
+ * @brief Simulador de sensores IoT para Arduino
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ * 
+ * Este sketch simula sensores de temperatura y presión,
+ * enviando datos por el puerto serial en formato:
+ * TEMP:valor#secuencia@marca o PRES:valor#secuencia@marca
+ *
+ * Cada sensor numera sus lecturas desde 0; el sistema usa la secuencia
+ * para descartar repetidas y detectar lecturas perdidas. La marca es
+ * micros() al emitir: con ella el trazado de latencia del sistema mide
+ * también el tramo del cable (ENVIAR_MARCAS = false la omite).
+ *
+ * Respeta el control de flujo por software del sistema: tras recibir
+ * XOFF (0x13) deja de enviar hasta recibir XON (0x11).
+ */
+
+const long VELOCIDAD_SERIAL = 9600; // Debe coincidir con la que se elige en el sistema
+const bool ENVIAR_MARCAS = true;    // Agregar @micros() a cada lectura
+
+const byte XON = 0x11;
+const byte XOFF = 0x13;
+
+bool pausado = false; // true mientras el sistema pidió pausa
+
+unsigned long secuenciaTemperatura = 0; // Próxima secuencia de TEMP
+unsigned long secuenciaPresion = 0;     // Próxima secuencia de PRES
+
+/**
+ * @brief Atiende XON/XOFF y espera mientras el envío esté pausado
+ */
+void esperarPermiso() {
+  do {
+    while (Serial.available() > 0) {
+      byte control = Serial.read();
+      if (control == XOFF) {
+        pausado = true;
+      } else if (control == XON) {
+        pausado = false;
+      }
+    }
+  } while (pausado);
+}
+
+/**
+ * @brief Termina la línea, con la hora de emisión si se envían marcas
+ */
+void terminarLinea(unsigned long emision) {
+  if (ENVIAR_MARCAS) {
+    Serial.print("@");
+    Serial.print(emision);
+  }
+  Serial.println();
+}
+
+/**
+ * @brief Configuración inicial del Arduino
+ * 
+ * Se ejecuta una sola vez al iniciar el Arduino.
+ * Configura la comunicación serial a VELOCIDAD_SERIAL baudios.
+ */
+void setup() {
+  // Iniciar comunicación serial (subir VELOCIDAD_SERIAL, p. ej. a 115200,
+  // reduce el tiempo de cada línea en el cable)
+  Serial.begin(VELOCIDAD_SERIAL);
+  
+  // Inicializar generador de números aleatorios
+  randomSeed(analogRead(0));
+  
+  // Mensaje de inicio
+  Serial.println("=================================");
+  Serial.println("Simulador de Sensores IoT");
+  Serial.println("Enviando datos al sistema...");
+  Serial.println("=================================");
+  delay(2000);
+}
+
+/**
+ * @brief Bucle principal que se ejecuta continuamente
+ * 
+ * Envía lecturas simuladas de temperatura y presión
+ * alternadamente cada 2 segundos.
+ */
+void loop() {
+  // Simular sensor de temperatura
+  // Genera valores entre 20.0 y 50.0 grados Celsius
+  float temperatura = 20.0 + random(0, 300) / 10.0;
+  
+  // Enviar temperatura en formato: TEMP:valor#secuencia@marca
+  esperarPermiso();
+  unsigned long emision = micros();
+  Serial.print("TEMP:");
+  Serial.print(temperatura);
+  Serial.print("#");
+  Serial.print(secuenciaTemperatura);
+  terminarLinea(emision);
+  secuenciaTemperatura = secuenciaTemperatura + 1;
+  
+  // Esperar 2 segundos
+  delay(2000);
+  
+  // Simular sensor de presión
+  // Genera valores entre 70 y 120 unidades
+  int presion = random(70, 120);
+  
+  // Enviar presión en formato: PRES:valor#secuencia@marca
+  esperarPermiso();
+  emision = micros();
+  Serial.print("PRES:");
+  Serial.print(presion);
+  Serial.print("#");
+  Serial.print(secuenciaPresion);
+  terminarLinea(emision);
+  secuenciaPresion = secuenciaPresion + 1;
+  
+  // Esperar 2 segundos antes de la siguiente lectura
+  delay(2000);
 }
\ No newline at end of file
@@ -1,342 +1,782 @@
-/**
- * @file main.cpp
- * @brief Programa principal del Sistema IoT de Gestión de Sensores
- * @author Juan Francisco Ortega Pulido
- * @date 2025
- * 
- * Este programa gestiona sensores de temperatura y presión mediante
- * una jerarquía polimórfica, listas enlazadas genéricas y lectura
- * del puerto serial de Arduino.
- */
-
-#include <iostream>
-#include "SensorBase.h"
-#include "SensorTemperatura.h"
-#include "SensorPresion.h"
-#include "ListaGeneral.h"
-#include "SerialReader.h"
-
-using namespace std;
-
-/**
- * @brief Convierte una cadena a número float de forma manual
- * @param cadena Cadena a convertir
- * @return Valor float
- */
-float cadenaAFloat(const char* cadena) {
-    float resultado = 0.0;
-    float decimal = 0.0;
-    int i = 0;
-    bool negativo = false;
-    bool enDecimal = false;
-    float divisor = 10.0;
-    
-    if (cadena[0] == '-') {
-        negativo = true;
-        i = 1;
-    }
-    
-    while (cadena[i] != '\0') {
-        if (cadena[i] == '.') {
-            enDecimal = true;
-            i = i + 1;
-            continue;
-        }
-        
-        int digito = cadena[i] - '0';
-        
-        if (!enDecimal) {
-            resultado = resultado * 10.0 + digito;
-        } else {
-            decimal = decimal + digito / divisor;
-            divisor = divisor * 10.0;
-        }
-        
-        i = i + 1;
-    }
-    
-    resultado = resultado + decimal;
-    
-    if (negativo) {
-        resultado = -resultado;
-    }
-    
-    return resultado;
-}
-
-/**
- * @brief Convierte una cadena a número entero de forma manual
- * @param cadena Cadena a convertir
- * @return Valor entero
- */
-int cadenaAInt(const char* cadena) {
-    int resultado = 0;
-    int i = 0;
-    bool negativo = false;
-    
-    if (cadena[0] == '-') {
-        negativo = true;
-        i = 1;
-    }
-    
-    while (cadena[i] != '\0') {
-        int digito = cadena[i] - '0';
-        resultado = resultado * 10 + digito;
-        i = i + 1;
-    }
-    
-    if (negativo) {
-        resultado = -resultado;
-    }
-    
-    return resultado;
-}
-
-/**
- * @brief Busca un carácter en una cadena
- * @param cadena Cadena donde buscar
- * @param caracter Carácter a buscar
- * @return Posición del carácter, -1 si no se encuentra
- */
-int buscarCaracter(const char* cadena, char caracter) {
-    int i = 0;
-    while (cadena[i] != '\0') {
-        if (cadena[i] == caracter) {
-            return i;
-        }
-        i = i + 1;
-    }
-    return -1;
-}
-
-/**
- * @brief Copia parte de una cadena
- * @param destino Cadena destino
- * @param origen Cadena origen
- * @param inicio Posición inicial
- * @param fin Posición final
- */
-void subcadena(char* destino, const char* origen, int inicio, int fin) {
-    int j = 0;
-    for (int i = inicio; i < fin && origen[i] != '\0'; i++) {
-        destino[j] = origen[i];
-        j = j + 1;
-    }
-    destino[j] = '\0';
-}
-
-/**
- * @brief Muestra el menú principal
- */
-void mostrarMenu() {
-    cout << "\n========================================" << endl;
-    cout << "  Sistema IoT de Monitoreo Polimorfico" << endl;
-    cout << "========================================" << endl;
-    cout << "1. Crear Sensor de Temperatura" << endl;
-    cout << "2. Crear Sensor de Presion" << endl;
-    cout << "3. Leer datos desde Arduino (automatico)" << endl;
-    cout << "4. Registrar lectura manual" << endl;
-    cout << "5. Ejecutar procesamiento polimorfico" << endl;
-    cout << "6. Mostrar todos los sensores" << endl;
-    cout << "7. Salir" << endl;
-    cout << "Opcion: ";
-}
-
-/**
- * @brief Función principal
- */
-int main() {
-    ListaGeneral listaSensores;
-    SerialReader* serial = 0;
-    
-    cout << "===========================================\n";
-    cout << "  SISTEMA IOT DE GESTION DE SENSORES\n";
-    cout << "===========================================\n" << endl;
-    
-    // Preguntar si desea conectar Arduino
-    cout << "Desea conectar con Arduino? (s/n): ";
-    char respuesta;
-    cin >> respuesta;
-    cin.ignore(); // Limpiar buffer
-    
-    if (respuesta == 's' || respuesta == 'S') {
-        cout << "\nIngrese el nombre del puerto serial:" << endl;
-        cout << "  Windows: COM3, COM4, etc." << endl;
-        cout << "  Linux: /dev/ttyUSB0, /dev/ttyACM0, etc." << endl;
-        cout << "Puerto: ";
-        
-        char nombrePuerto[50];
-        cin.getline(nombrePuerto, 50);
-        
-        serial = new SerialReader(nombrePuerto);
-        
-        if (!serial->estaConectado()) {
-            cout << "[Advertencia] Continuando sin Arduino..." << endl;
-            delete serial;
-            serial = 0;
-        }
-    }
-    
-    // Crear sensores iniciales
-    cout << "\n--- Creando sensores iniciales ---" << endl;
-    SensorTemperatura* temp1 = new SensorTemperatura("T-001");
-    listaSensores.insertar(temp1);
-    
-    SensorPresion* pres1 = new SensorPresion("P-105");
-    listaSensores.insertar(pres1);
-    
-    bool continuar = true;
-    int contadorLecturas = 0;
-    
-    while (continuar) {
-        // Leer automáticamente del Arduino si está conectado
-        if (serial != 0 && serial->estaConectado()) {
-            char buffer[100];
-            int bytesLeidos = serial->leerLinea(buffer, 100);
-            
-            if (bytesLeidos > 0) {
-                cout << "\n[Arduino] Dato recibido: " << buffer << endl;
-                
-                // Procesar dato recibido
-                int posDospuntos = buscarCaracter(buffer, ':');
-                
-                if (posDospuntos != -1) {
-                    char tipo[10];
-                    char valor[20];
-                    
-                    subcadena(tipo, buffer, 0, posDospuntos);
-                    subcadena(valor, buffer, posDospuntos + 1, 100);
-                    
-                    // Comparar tipo
-                    bool esTemp = true;
-                    const char* tempStr = "TEMP";
-                    for (int i = 0; i < 4; i++) {
-                        if (tipo[i] != tempStr[i]) {
-                            esTemp = false;
-                            break;
-                        }
-                    }
-                    
-                    if (esTemp) {
-                        float valorFloat = cadenaAFloat(valor);
-                        temp1->registrarLectura(valorFloat);
-                        contadorLecturas = contadorLecturas + 1;
-                    } else {
-                        int valorInt = cadenaAInt(valor);
-                        pres1->registrarLectura(valorInt);
-                        contadorLecturas = contadorLecturas + 1;
-                    }
-                    
-                    // Procesar automáticamente cada 5 lecturas
-                    if (contadorLecturas >= 5) {
-                        cout << "\n[Sistema] Procesando automaticamente..." << endl;
-                        listaSensores.procesarTodos();
-                        contadorLecturas = 0;
-                    }
-                }
-            }
-        }
-        
-        mostrarMenu();
-        
-        int opcion;
-        cin >> opcion;
-        cin.ignore();
-        
-        switch (opcion) {
-            case 1: {
-                cout << "\nIngrese el ID del sensor de temperatura: ";
-                char id[50];
-                cin.getline(id, 50);
-                
-                SensorTemperatura* nuevoTemp = new SensorTemperatura(id);
-                listaSensores.insertar(nuevoTemp);
-                cout << "Sensor creado e insertado en la lista de gestion." << endl;
-                break;
-            }
-            
-            case 2: {
-                cout << "\nIngrese el ID del sensor de presion: ";
-                char id[50];
-                cin.getline(id, 50);
-                
-                SensorPresion* nuevoPres = new SensorPresion(id);
-                listaSensores.insertar(nuevoPres);
-                cout << "Sensor creado e insertado en la lista de gestion." << endl;
-                break;
-            }
-            
-            case 3: {
-                if (serial == 0 || !serial->estaConectado()) {
-                    cout << "\n[Error] No hay conexion con Arduino." << endl;
-                } else {
-                    cout << "\n[Info] El sistema esta leyendo automaticamente del Arduino." << endl;
-                    cout << "Las lecturas se procesan cada 5 datos recibidos." << endl;
-                }
-                break;
-            }
-            
-            case 4: {
-                cout << "\nIngrese el ID del sensor: ";
-                char id[50];
-                cin.getline(id, 50);
-                
-                SensorBase* sensor = listaSensores.buscar(id);
-                
-                if (sensor == 0) {
-                    cout << "Sensor no encontrado." << endl;
-                    break;
-                }
-                
-                cout << "Tipo de sensor (1=Temperatura, 2=Presion): ";
-                int tipo;
-                cin >> tipo;
-                
-                if (tipo == 1) {
-                    cout << "Ingrese valor (float): ";
-                    float valor;
-                    cin >> valor;
-                    
-                    SensorTemperatura* tempSensor = (SensorTemperatura*)sensor;
-                    tempSensor->registrarLectura(valor);
-                } else {
-                    cout << "Ingrese valor (int): ";
-                    int valor;
-                    cin >> valor;
-                    
-                    SensorPresion* presSensor = (SensorPresion*)sensor;
-                    presSensor->registrarLectura(valor);
-                }
-                break;
-            }
-            
-            case 5: {
-                listaSensores.procesarTodos();
-                break;
-            }
-            
-            case 6: {
-                listaSensores.imprimirTodos();
-                break;
-            }
-            
-            case 7: {
-                cout << "\nCerrando sistema..." << endl;
-                continuar = false;
-                break;
-            }
-            
-            default: {
-                cout << "\nOpcion invalida." << endl;
-                break;
-            }
-        }
-    }
-    
- 
-    if (serial != 0) {
-        delete serial;
-    }
-    
-    return 0;
+/**
+ * @file main.cpp
+ * @brief Programa principal del Sistema IoT de Gestión de Sensores
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ * 
+ * Este programa gestiona sensores de temperatura y presión mediante
+ * una jerarquía polimórfica, listas enlazadas genéricas y lectura
+ * del puerto serial de Arduino.
+ */
+
+#include <iostream>
+#include <cstring>
+#include <fstream>
+#include "SensorBase.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "ListaGeneral.h"
+#include "SerialReader.h"
+#include "PlanificadorRueda.h"
+#include "ImportadorCapturas.h"
+#include "ExportadorColumnar.h"
+#include "ServidorConsultas.h"
+#include "ConsultasFlota.h"
+#include "ControlIngesta.h"
+#include "LectorIngesta.h"
+#include "SensorGenerico.h"
+#include "RenderizadorReporte.h"
+#include "PruebasRendimiento.h"
+#include "TrazaLatencia.h"
+#include <chrono>
+#include <thread>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+using namespace std;
+
+/**
+ * @brief Espera a que el usuario escriba, entregando mientras tanto la ingesta
+ *
+ * Mientras el menú espera, las lecturas encoladas por el hilo lector se
+ * almacenan y el planificador sigue atendiendo plazos. En Windows se
+ * espera directamente en cin.
+ * @param esperaMs Cada cuánto se entrega lo encolado (50 ms; 1 en baja latencia)
+ */
+void esperarEntrada(TuberiaIngesta& tuberia, PlanificadorRueda& planificador, int esperaMs) {
+    cout.flush();
+#ifndef _WIN32
+    while (cin.rdbuf()->in_avail() <= 0) {
+        pollfd entrada;
+        entrada.fd = 0;
+        entrada.events = POLLIN;
+        entrada.revents = 0;
+        if (poll(&entrada, 1, esperaMs) != 0) {
+            break;
+        }
+        tuberia.entregar(1 << 20);
+        planificador.avanzar(PlanificadorRueda::ahoraMs());
+        // procesarLectura no vacía cout por línea: mostrar lo que dejó cada pasada
+        cout.flush();
+    }
+#else
+    (void)tuberia;
+    (void)planificador;
+    (void)esperaMs;
+#endif
+}
+
+/**
+ * @brief Muestra el menú principal
+ */
+void mostrarMenu() {
+    cout << "\n========================================" << endl;
+    cout << "  Sistema IoT de Monitoreo Polimorfico" << endl;
+    cout << "========================================" << endl;
+    cout << "1. Crear Sensor de Temperatura" << endl;
+    cout << "2. Crear Sensor de Presion" << endl;
+    cout << "3. Leer datos desde Arduino (automatico)" << endl;
+    cout << "4. Registrar lectura manual" << endl;
+    cout << "5. Ejecutar procesamiento polimorfico" << endl;
+    cout << "6. Mostrar todos los sensores" << endl;
+    cout << "7. Salir" << endl;
+    cout << "8. Metricas del planificador" << endl;
+    cout << "9. Uso de memoria" << endl;
+    cout << "10. Consultar resumen por rango de tiempo" << endl;
+    cout << "11. Resumen de la flota" << endl;
+    cout << "12. Asignar sensor a un grupo" << endl;
+    cout << "13. Eliminar sensor" << endl;
+    cout << "14. Cargar manifiesto de sensores" << endl;
+    cout << "15. Salir rapido (punto de control opcional)" << endl;
+    cout << "16. Importar captura grabada (TEMP:/PRES:)" << endl;
+    cout << "17. Exportar historiales (binario columnar)" << endl;
+    cout << "18. Leer exportacion columnar" << endl;
+    cout << "19. Iniciar/detener servidor de consultas" << endl;
+    cout << "20. Consultas sobre todas las lecturas (serie/bloques/paralelo)" << endl;
+    cout << "21. Control de flujo de la ingesta" << endl;
+    cout << "22. Crear Sensor de Vibracion (generico)" << endl;
+    cout << "23. Reporte de sensores o historial (texto/JSON/CSV)" << endl;
+    cout << "24. Trazas de latencia (activar, histogramas, volcado CSV)" << endl;
+    cout << "Opcion: ";
+}
+
+/**
+ * @brief Modo --rendimiento: mide las cargas fijas y las compara con la línea base
+ * @param rutaBase Archivo de línea base
+ * @param guardarBase Sobrescribir la línea base con lo medido
+ * @return Código de salida (0 = sin regresiones)
+ */
+int ejecutarRendimiento(const char* rutaBase, bool guardarBase) {
+    cout << "[Rendimiento] Midiendo (mejor de 3 intentos por carga)..." << endl;
+    PruebasRendimiento pruebas;
+    pruebas.ejecutar();
+    
+    if (guardarBase) {
+        if (!pruebas.guardar(rutaBase, 3.0)) {
+            cout << "[Rendimiento] No se pudo escribir " << rutaBase << endl;
+            return 2;
+        }
+        cout << "[Rendimiento] Linea base guardada en " << rutaBase << endl;
+    }
+    
+    int regresiones = pruebas.comparar(rutaBase);
+    if (regresiones < 0) {
+        return 2;
+    }
+    return (regresiones == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Función principal
+ *
+ * SistemaIoT --rendimiento [linea_base] [--guardar] ejecuta las pruebas de
+ * rendimiento en lugar del menú.
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--rendimiento") == 0) {
+        const char* rutaBase = "rendimiento_base.txt";
+        bool guardarBase = false;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--guardar") == 0) {
+                guardarBase = true;
+            } else {
+                rutaBase = argv[i];
+            }
+        }
+        return ejecutarRendimiento(rutaBase, guardarBase);
+    }
+    
+    // cin con búfer propio: esperarEntrada puede ver si ya hay una línea pendiente
+    ios::sync_with_stdio(false);
+    
+    ListaGeneral listaSensores;
+    SerialReader* serial = 0;
+    int cpuLector = -1;
+    int cpuProcesamiento = -1;
+    
+    // Se declara después de la lista para detenerse antes que ella
+    ServidorConsultas servidor(&listaSensores);
+    
+    cout << "===========================================\n";
+    cout << "  SISTEMA IOT DE GESTION DE SENSORES\n";
+    cout << "===========================================\n" << endl;
+    
+    // Preguntar si desea conectar Arduino
+    cout << "Desea conectar con Arduino? (s/n): ";
+    char respuesta;
+    cin >> respuesta;
+    cin.ignore(); // Limpiar buffer
+    
+    if (respuesta == 's' || respuesta == 'S') {
+        cout << "\nIngrese el nombre del puerto serial:" << endl;
+        cout << "  Windows: COM3, COM4, etc." << endl;
+        cout << "  Linux: /dev/ttyUSB0, /dev/ttyACM0, etc." << endl;
+        cout << "Puerto: ";
+        
+        char nombrePuerto[50];
+        cin.getline(nombrePuerto, 50);
+        
+        ConfigSerial configSerial;
+        cout << "Velocidad en baudios (9600 como el sketch): ";
+        cin >> configSerial.baudios;
+        cout << "Modo de baja latencia (sondeo, hilos fijados a CPU)? (s/n): ";
+        char latencia;
+        cin >> latencia;
+        if (latencia == 's' || latencia == 'S') {
+            configSerial.vmin = 0;
+            configSerial.vtime = 0;
+            configSerial.bajaLatencia = true;
+            cout << "CPU del hilo lector (-1 = sin fijar): ";
+            cin >> cpuLector;
+            cout << "CPU del procesamiento (-1 = sin fijar): ";
+            cin >> cpuProcesamiento;
+            
+            // Con un solo núcleo el sondeo le quitaría el procesador al resto
+            if (thread::hardware_concurrency() < 2) {
+                cout << "[Advertencia] Un solo nucleo: se usa espera corta en lugar de sondeo" << endl;
+                configSerial.vtime = 1;
+            }
+        }
+        cin.ignore();
+        
+        serial = new SerialReader(nombrePuerto, configSerial);
+        
+        if (!serial->estaConectado()) {
+            cout << "[Advertencia] Continuando sin Arduino..." << endl;
+            delete serial;
+            serial = 0;
+        }
+    }
+    
+    // Crear sensores iniciales
+    cout << "\n--- Creando sensores iniciales ---" << endl;
+    SensorTemperatura* temp1 = new SensorTemperatura("T-001");
+    listaSensores.insertar(temp1);
+    
+    SensorPresion* pres1 = new SensorPresion("P-105");
+    listaSensores.insertar(pres1);
+    
+    // Cada sensor se procesa con la cadencia de su tipo
+    PlanificadorRueda planificador(&listaSensores, PlanificadorRueda::ahoraMs());
+    planificador.programar(temp1, temp1->periodoProcesamientoMs());
+    planificador.programar(pres1, pres1->periodoProcesamientoMs());
+    
+    // El hilo lector enruta con el directorio: publicarlo antes de arrancarlo
+    listaSensores.publicar();
+    
+    // La lectura del puerto corre en su propio hilo, con cola acotada
+    ControlIngesta controlIngesta((ConfigIngesta()));
+    TuberiaIngesta tuberiaIngesta(&listaSensores, &controlIngesta);
+    LectorIngesta* lector = 0;
+    int esperaEntregaMs = 50;
+    if (serial != 0) {
+        lector = new LectorIngesta(serial, &tuberiaIngesta);
+        ConfigSerial configSerial = serial->configuracion();
+        if (configSerial.bajaLatencia) {
+            // El hilo principal entrega y procesa: lejos del núcleo del lector
+            lector->configurarLatencia(configSerial.vtime == 0, cpuLector);
+            if (cpuProcesamiento >= 0 && !LectorIngesta::fijarHiloActual(cpuProcesamiento)) {
+                cout << "[Advertencia] No se pudo fijar el procesamiento a la CPU " << cpuProcesamiento << endl;
+            }
+            esperaEntregaMs = 1;
+        }
+        lector->iniciar();
+    }
+    
+    bool continuar = true;
+    
+    while (continuar) {
+        // Hacer visibles al hilo lector y al servidor los sensores creados o
+        // eliminados en la pasada anterior
+        listaSensores.publicar();
+        
+        // Almacenar lo que el hilo lector haya encolado
+        tuberiaIngesta.entregar(1 << 20);
+        
+        // Atender los plazos de procesamiento vencidos
+        planificador.avanzar(PlanificadorRueda::ahoraMs());
+        
+        // Desalojar lecturas si la flota excede su presupuesto de memoria
+        listaSensores.aplicarPresupuestoGlobal();
+        
+        mostrarMenu();
+        if (lector != 0) {
+            esperarEntrada(tuberiaIngesta, planificador, esperaEntregaMs);
+        }
+        
+        int opcion;
+        cin >> opcion;
+        cin.ignore();
+        
+        switch (opcion) {
+            case 1: {
+                cout << "\nIngrese el ID del sensor de temperatura: ";
+                char id[50];
+                cin.getline(id, 50);
+                
+                if (listaSensores.buscar(id) != 0) {
+                    cout << "Ya existe un sensor con ese ID." << endl;
+                    break;
+                }
+                
+                SensorTemperatura* nuevoTemp = new SensorTemperatura(id);
+                listaSensores.insertar(nuevoTemp);
+                planificador.programar(nuevoTemp, nuevoTemp->periodoProcesamientoMs());
+                cout << "Sensor creado e insertado en la lista de gestion." << endl;
+                break;
+            }
+            
+            case 2: {
+                cout << "\nIngrese el ID del sensor de presion: ";
+                char id[50];
+                cin.getline(id, 50);
+                
+                if (listaSensores.buscar(id) != 0) {
+                    cout << "Ya existe un sensor con ese ID." << endl;
+                    break;
+                }
+                
+                SensorPresion* nuevoPres = new SensorPresion(id);
+                listaSensores.insertar(nuevoPres);
+                planificador.programar(nuevoPres, nuevoPres->periodoProcesamientoMs());
+                cout << "Sensor creado e insertado en la lista de gestion." << endl;
+                break;
+            }
+            
+            case 3: {
+                if (serial == 0 || !serial->estaConectado()) {
+                    cout << "\n[Error] No hay conexion con Arduino." << endl;
+                } else {
+                    cout << "\n[Info] El sistema esta leyendo automaticamente del Arduino." << endl;
+                    cout << "Cada sensor se procesa con la cadencia de su tipo." << endl;
+                }
+                break;
+            }
+            
+            case 4: {
+                cout << "\nIngrese el ID del sensor: ";
+                char id[50];
+                cin.getline(id, 50);
+                
+                SensorBase* sensor = listaSensores.buscar(id);
+                
+                if (sensor == 0) {
+                    cout << "Sensor no encontrado." << endl;
+                    break;
+                }
+                
+                if (sensor->obtenerTipo() == SENSOR_OTRO) {
+                    cout << "Ingrese valor: ";
+                    double valor;
+                    cin >> valor;
+                    if (!sensor->registrarValor(valor)) {
+                        cout << "Lectura descartada por el procesamiento del sensor." << endl;
+                    }
+                    break;
+                }
+                
+                cout << "Tipo de sensor (1=Temperatura, 2=Presion): ";
+                int tipo;
+                cin >> tipo;
+                
+                if (tipo == 1) {
+                    cout << "Ingrese valor (float): ";
+                    float valor;
+                    cin >> valor;
+                    
+                    SensorTemperatura* tempSensor = (SensorTemperatura*)sensor;
+                    tempSensor->registrarLectura(valor);
+                } else {
+                    cout << "Ingrese valor (int): ";
+                    int valor;
+                    cin >> valor;
+                    
+                    SensorPresion* presSensor = (SensorPresion*)sensor;
+                    presSensor->registrarLectura(valor);
+                }
+                break;
+            }
+            
+            case 5: {
+                listaSensores.procesarTodos();
+                break;
+            }
+            
+            case 6: {
+                listaSensores.imprimirTodos();
+                break;
+            }
+            
+            case 7: {
+                cout << "\nCerrando sistema..." << endl;
+                continuar = false;
+                break;
+            }
+            
+            case 8: {
+                planificador.imprimirMetricas();
+                break;
+            }
+            
+            case 9: {
+                listaSensores.imprimirMemoria();
+                break;
+            }
+            
+            case 10: {
+                cout << "\nIngrese el ID del sensor: ";
+                char id[50];
+                cin.getline(id, 50);
+                
+                SensorBase* sensor = listaSensores.buscar(id);
+                
+                if (sensor == 0 || sensor->obtenerRollup() == 0) {
+                    cout << "Sensor no encontrado." << endl;
+                    break;
+                }
+                
+                cout << "Minutos hacia atras: ";
+                int minutos;
+                cin >> minutos;
+                
+                long long ahora = RollupSensor::ahoraMs();
+                ResultadoRango r = sensor->obtenerRollup()->consultar(ahora - minutos * RollupSensor::MS_MINUTO, ahora + 1);
+                
+                if (r.cantidad == 0) {
+                    cout << "Sin lecturas en el rango." << endl;
+                    break;
+                }
+                
+                cout << "Lecturas: " << r.cantidad << " | Promedio: " << r.promedio
+                     << " | Min: " << r.minimo << " | Max: " << r.maximo << endl;
+                cout << "(" << r.cubetasHora << " cubeta(s) por hora, " << r.cubetasMinuto << " por minuto";
+                if (r.aproximado) {
+                    cout << ", aproximado a horas completas";
+                }
+                cout << ")" << endl;
+                break;
+            }
+            
+            case 11: {
+                listaSensores.imprimirFlota();
+                
+                cout << "\nGrupo a consultar (vacio para omitir): ";
+                char grupo[50];
+                cin.getline(grupo, 50);
+                if (grupo[0] == '\0') {
+                    break;
+                }
+                
+                ResumenFlota resumen;
+                if (!listaSensores.resumenPorGrupo(grupo, resumen)) {
+                    cout << "Grupo no encontrado." << endl;
+                    break;
+                }
+                cout << "Grupo " << grupo << ": " << resumen.sensores << " sensor(es), "
+                     << resumen.lecturas << " lectura(s), promedio " << resumen.promedio() << endl;
+                break;
+            }
+            
+            case 12: {
+                cout << "\nIngrese el ID del sensor: ";
+                char id[50];
+                cin.getline(id, 50);
+                
+                cout << "Grupo: ";
+                char grupo[50];
+                cin.getline(grupo, 50);
+                
+                if (listaSensores.asignarGrupo(id, grupo)) {
+                    cout << "Sensor asignado al grupo " << grupo << "." << endl;
+                } else {
+                    cout << "Sensor no encontrado." << endl;
+                }
+                break;
+            }
+            
+            case 13: {
+                cout << "\nIngrese el ID del sensor: ";
+                char id[50];
+                cin.getline(id, 50);
+                
+                if (listaSensores.eliminar(id, &planificador)) {
+                    cout << "Sensor " << id << " eliminado." << endl;
+                } else {
+                    cout << "Sensor no encontrado." << endl;
+                }
+                break;
+            }
+            
+            case 14: {
+                cout << "\nRuta del manifiesto: ";
+                char ruta[256];
+                cin.getline(ruta, 256);
+                
+                listaSensores.cargarManifiesto(ruta, &planificador);
+                break;
+            }
+            
+            case 15: {
+                cout << "\nRuta del punto de control (vacio para omitir): ";
+                char ruta[256];
+                cin.getline(ruta, 256);
+                
+                if (ruta[0] != '\0') {
+                    listaSensores.guardarPuntoControl(ruta);
+                }
+                
+                cout << "\nCerrando sistema..." << endl;
+                listaSensores.fijarCierreRapido(true);
+                continuar = false;
+                break;
+            }
+            
+            case 16: {
+                cout << "\nRuta de la captura: ";
+                char ruta[256];
+                cin.getline(ruta, 256);
+                
+                ImportadorCapturas importador(&listaSensores, listaSensores.buscar("T-001"), listaSensores.buscar("P-105"),
+                                              &planificador);
+                ResultadoImportacion resultado;
+                
+                if (importador.importar(ruta, 0, resultado)) {
+                    ImportadorCapturas::imprimir(resultado);
+                } else {
+                    cout << "No se pudo leer " << ruta << endl;
+                }
+                break;
+            }
+            
+            case 17: {
+                cout << "\nArchivo destino: ";
+                char ruta[256];
+                cin.getline(ruta, 256);
+                
+                ExportadorColumnar::exportar(listaSensores, ruta);
+                break;
+            }
+            
+            case 18: {
+                cout << "\nArchivo a leer: ";
+                char ruta[256];
+                cin.getline(ruta, 256);
+                
+                LectorColumnar lector;
+                if (!lector.abrir(ruta)) {
+                    cout << "Archivo columnar invalido." << endl;
+                    break;
+                }
+                
+                cout << "\n--- Exportacion " << ruta << " ---" << endl;
+                for (int i = 0; i < lector.sensores(); i++) {
+                    char nombre[50];
+                    lector.nombre(i, nombre, 50);
+                    AgregadosSensor a = lector.agregados(i);
+                    cout << nombre << ": " << a.cantidad << " lectura(s), promedio " << a.promedio
+                         << ", min " << a.minimoHistorico << ", max " << a.maximoHistorico << endl;
+                }
+                break;
+            }
+            
+            case 19: {
+                if (servidor.estaActivo()) {
+                    servidor.imprimirEstado();
+                    servidor.detener();
+                    cout << "Servidor detenido." << endl;
+                    break;
+                }
+                
+                cout << "\nRuta del socket (vacio para /tmp/sistemaiot.sock): ";
+                char ruta[108];
+                cin.getline(ruta, 108);
+                if (ruta[0] == '\0') {
+                    strcpy(ruta, "/tmp/sistemaiot.sock");
+                }
+                
+                if (servidor.iniciar(ruta)) {
+                    cout << "Servidor escuchando en " << ruta
+                         << " (PING, LIST, AGG, PCT, SUB, UNSUB)" << endl;
+                }
+                break;
+            }
+            
+            case 20: {
+                cout << "\nTipo (1: Temperatura, 2: Presion): ";
+                int tipoElegido;
+                cin >> tipoElegido;
+                cout << "Umbral: ";
+                double umbral;
+                cin >> umbral;
+                cin.ignore();
+                
+                TipoSensor tipo = (tipoElegido == 2) ? SENSOR_PRESION : SENSOR_TEMPERATURA;
+                const char* nombresModo[3] = { "serie", "bloques", "paralelo" };
+                ModoConsulta modos[3] = { CONSULTA_SERIE, CONSULTA_BLOQUES, CONSULTA_PARALELA };
+                
+                for (int m = 0; m < 3; m++) {
+                    ConsultasFlota consultas(&listaSensores, modos[m]);
+                    ArregloDinamico<SensorBase*> encontrados;
+                    
+                    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+                    ResumenLecturas resumen = consultas.resumir(tipo);
+                    long long sobreUmbral = consultas.contarSobreUmbral(tipo, umbral);
+                    int sensoresSobre = consultas.filtrarSobreUmbral(tipo, umbral, encontrados);
+                    long long us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - inicio).count();
+                    
+                    cout << "[" << nombresModo[m] << "] " << resumen.cantidad << " lectura(s), promedio "
+                         << resumen.promedio() << ", min " << resumen.minimo << ", max " << resumen.maximo
+                         << " | " << sobreUmbral << " sobre el umbral en " << sensoresSobre
+                         << " sensor(es) | " << us << " us" << endl;
+                }
+                if (!ConsultasFlota::paraleloDisponible()) {
+                    cout << "(Sin politicas de ejecucion: el modo paralelo corre en un hilo)" << endl;
+                }
+                break;
+            }
+            
+            case 21: {
+                controlIngesta.imprimir();
+                tuberiaIngesta.imprimir();
+                
+                cout << "\nCambiar configuracion? (s/n): ";
+                char cambiar;
+                cin >> cambiar;
+                if (cambiar != 's' && cambiar != 'S') {
+                    cin.ignore();
+                    break;
+                }
+                
+                ConfigIngesta config = controlIngesta.configuracion();
+                cout << "Capacidad de la cola: ";
+                cin >> config.capacidad;
+                cout << "Politica (1: rechazar nuevas, 2: descartar antiguas, 3: muestrear): ";
+                int politica;
+                cin >> politica;
+                if (politica == 1) {
+                    config.politica = DESBORDE_RECHAZAR_NUEVAS;
+                } else if (politica == 3) {
+                    config.politica = DESBORDE_MUESTREAR;
+                    cout << "Conservar 1 de cada: ";
+                    cin >> config.muestreo;
+                } else {
+                    config.politica = DESBORDE_DESCARTAR_ANTIGUAS;
+                }
+                cout << "Lecturas/s maximas por sensor (0 = sin limite): ";
+                cin >> config.tasaMaximaSensor;
+                cout << "Pedir pausas al dispositivo con XON/XOFF? (s/n): ";
+                char xon;
+                cin >> xon;
+                config.xonXoff = (xon == 's' || xon == 'S');
+                cout << "Ventana de reorden por sensor (0 = sin reorden): ";
+                cin >> config.ventanaReorden;
+                cout << "Espera maxima por una secuencia faltante (ms): ";
+                cin >> config.esperaReordenMs;
+                cout << "El #n de las lineas es una marca de tiempo (no un contador)? (s/n): ";
+                char marcas;
+                cin >> marcas;
+                config.secuenciaEsMarca = (marcas == 's' || marcas == 'S');
+                cin.ignore();
+                
+                controlIngesta.configurar(config);
+                cout << "Configuracion aplicada." << endl;
+                break;
+            }
+            
+            case 22: {
+                cout << "\nIngrese el ID del sensor de vibracion: ";
+                char id[50];
+                cin.getline(id, 50);
+                
+                if (listaSensores.buscar(id) != 0) {
+                    cout << "Ya existe un sensor con ese ID." << endl;
+                    break;
+                }
+                
+                SensorVibracion* nuevoVib = new SensorVibracion(id);
+                listaSensores.insertar(nuevoVib);
+                planificador.programar(nuevoVib, nuevoVib->periodoProcesamientoMs());
+                cout << "Sensor creado e insertado en la lista de gestion." << endl;
+                break;
+            }
+            
+            case 23: {
+                OpcionesReporte opciones;
+                cout << "\nFormato (1: texto, 2: JSON, 3: CSV): ";
+                int formato;
+                cin >> formato;
+                cin.ignore();
+                if (formato == 2) {
+                    opciones.formato = REPORTE_JSON;
+                } else if (formato == 3) {
+                    opciones.formato = REPORTE_CSV;
+                }
+                cout << "Sensor cuyo historial mostrar (* = resumen de todos): ";
+                char nombre[50];
+                cin.getline(nombre, 50);
+                cout << "Desde el elemento (0 = el primero): ";
+                cin >> opciones.desde;
+                cout << "Maximo de elementos (0 = todos): ";
+                cin >> opciones.maximo;
+                cin.ignore();
+                cout << "Archivo de salida (- = pantalla): ";
+                char ruta[256];
+                cin.getline(ruta, 256);
+                
+                SensorBase* sensor = 0;
+                if (strcmp(nombre, "*") != 0) {
+                    sensor = listaSensores.buscar(nombre);
+                    if (sensor == 0) {
+                        cout << "Sensor no encontrado." << endl;
+                        break;
+                    }
+                }
+                
+                ofstream archivo;
+                bool aPantalla = (strcmp(ruta, "-") == 0);
+                if (!aPantalla) {
+                    archivo.open(ruta);
+                    if (!archivo.is_open()) {
+                        cout << "No se pudo escribir " << ruta << endl;
+                        break;
+                    }
+                }
+                
+                chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+                long long bytes;
+                int elementos;
+                {
+                    BuferSalida salida(aPantalla ? (ostream&)cout : (ostream&)archivo);
+                    RenderizadorReporte reporte(salida, opciones);
+                    elementos = (sensor == 0) ? reporte.sensores(listaSensores) : reporte.historial(sensor);
+                    bytes = salida.totalBytes();
+                }
+                long long us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - inicio).count();
+                
+                if (elementos < 0) {
+                    cout << "Este tipo de sensor no publica su historial." << endl;
+                } else {
+                    cout << "\n[Reporte] " << bytes << " bytes en " << us << " us" << endl;
+                }
+                break;
+            }
+            
+            case 24: {
+                TrazaLatencia& traza = TrazaLatencia::global();
+                cout << "\n1. Activar  2. Desactivar  3. Histogramas  4. Volcar CSV  5. Reiniciar: ";
+                int accion;
+                cin >> accion;
+                cin.ignore();
+                
+                if (accion == 1) {
+                    cout << "Trazar 1 de cada N lecturas (N): ";
+                    int muestreo;
+                    cin >> muestreo;
+                    cout << "Las marcas @ del dispositivo usan el reloj de este equipo (simulador)? (s/n): ";
+                    char mismoReloj;
+                    cin >> mismoReloj;
+                    cin.ignore();
+                    traza.configurar(true, muestreo, mismoReloj == 's' || mismoReloj == 'S');
+                    cout << "Trazado activo." << endl;
+                } else if (accion == 2) {
+                    traza.configurar(false, 1, false);
+                    cout << "Trazado desactivado (los histogramas se conservan)." << endl;
+                } else if (accion == 3) {
+                    traza.imprimir();
+                } else if (accion == 4) {
+                    cout << "Archivo CSV: ";
+                    char ruta[256];
+                    cin.getline(ruta, 256);
+                    int escritas = traza.volcar(ruta);
+                    if (escritas < 0) {
+                        cout << "No se pudo escribir " << ruta << endl;
+                    } else {
+                        cout << escritas << " trazas escritas en " << ruta << endl;
+                    }
+                } else if (accion == 5) {
+                    traza.reiniciar();
+                    cout << "Trazas borradas." << endl;
+                }
+                break;
+            }
+            
+            default: {
+                cout << "\nOpcion invalida." << endl;
+                break;
+            }
+        }
+    }
+    
+ 
+    if (lector != 0) {
+        delete lector;
+    }
+    
+    if (serial != 0) {
+        delete serial;
+    }
+    
+    return 0;
 }
\ No newline at end of file
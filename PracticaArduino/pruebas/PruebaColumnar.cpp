@@ -0,0 +1,199 @@
+/**
+ * @file PruebaColumnar.cpp
+ * @brief Prueba de ida y vuelta del formato columnar (con un sensor genérico) y de archivos corruptos
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#include "ExportadorColumnar.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "SensorGenerico.h"
+#include "Bitacora.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+using namespace std;
+
+static const char* RUTA = "prueba_columnar.siot";
+static const char* RUTA_CORRUPTA = "prueba_columnar_corrupta.siot";
+
+static int fallos = 0;
+
+/**
+ * @brief Cuenta y muestra una comprobación fallida
+ */
+static void comprobar(bool condicion, const char* descripcion) {
+    if (!condicion) {
+        cout << "[FALLO] " << descripcion << endl;
+        fallos = fallos + 1;
+    }
+}
+
+/**
+ * @brief Lee un archivo completo
+ */
+static ArregloDinamico<char> leerArchivo(const char* ruta) {
+    ArregloDinamico<char> datos;
+    ifstream archivo(ruta, ios::binary);
+    char c;
+    while (archivo.get(c)) {
+        datos.agregar(c);
+    }
+    return datos;
+}
+
+/**
+ * @brief Escribe una copia de 'datos' con un entero de 'bytes' bytes cambiado en 'posicion'
+ * @return true si el lector rechaza la copia
+ */
+static bool rechazaConCambio(const ArregloDinamico<char>& datos, long long posicion, long long valor, int bytes) {
+    ofstream archivo(RUTA_CORRUPTA, ios::binary | ios::trunc);
+    for (int i = 0; i < datos.tamano(); i++) {
+        char c = datos[i];
+        if (i >= posicion && i < posicion + bytes) {
+            // little-endian
+            c = (char)((valor >> (8 * (i - posicion))) & 0xFF);
+        }
+        archivo.put(c);
+    }
+    archivo.close();
+    
+    LectorColumnar lector;
+    return !lector.abrir(RUTA_CORRUPTA);
+}
+
+/**
+ * @brief Escribe los primeros 'bytes' de datos
+ * @return true si el lector rechaza la copia truncada
+ */
+static bool rechazaTruncado(const ArregloDinamico<char>& datos, int bytes) {
+    ofstream archivo(RUTA_CORRUPTA, ios::binary | ios::trunc);
+    archivo.write(&datos[0], bytes);
+    archivo.close();
+    
+    LectorColumnar lector;
+    return !lector.abrir(RUTA_CORRUPTA);
+}
+
+static void probarIdaVuelta(ListaGeneral& lista) {
+    LectorColumnar lector;
+    comprobar(lector.abrir(RUTA), "ida y vuelta: el archivo exportado abre");
+    comprobar(lector.sensores() == 4, "ida y vuelta: cuatro sensores");
+    
+    for (int i = 0; i < lector.sensores(); i++) {
+        char nombre[64];
+        lector.nombre(i, nombre, sizeof(nombre));
+        SensorBase* sensor = lista.buscar(nombre);
+        comprobar(sensor != 0, "ida y vuelta: el nombre existe en la lista");
+        if (sensor == 0) {
+            continue;
+        }
+        
+        AgregadosSensor original = sensor->obtenerAgregados();
+        AgregadosSensor leido = lector.agregados(i);
+        comprobar(lector.tipo(i) == sensor->obtenerTipo(), "ida y vuelta: mismo tipo");
+        comprobar(lector.cantidad(i) == original.cantidad && leido.cantidad == original.cantidad,
+                  "ida y vuelta: misma cantidad");
+        comprobar(leido.suma == original.suma && leido.minimoHistorico == original.minimoHistorico &&
+                  leido.maximoHistorico == original.maximoHistorico, "ida y vuelta: mismos agregados");
+        
+        // Las lecturas se registraron como base + k
+        if (sensor->obtenerTipo() == SENSOR_TEMPERATURA) {
+            const float* lecturas = lector.lecturasTemperatura(i);
+            comprobar(lecturas != 0 && lector.lecturasPresion(i) == 0, "ida y vuelta: columna de temperatura");
+            for (long long k = 0; lecturas != 0 && k < lector.cantidad(i); k++) {
+                comprobar(lecturas[k] == lecturas[0] + (float)k, "ida y vuelta: lectura de temperatura");
+            }
+        } else if (sensor->obtenerTipo() == SENSOR_PRESION) {
+            const int* lecturas = lector.lecturasPresion(i);
+            comprobar(lecturas != 0 && lector.lecturasTemperatura(i) == 0, "ida y vuelta: columna de presion");
+            for (long long k = 0; lecturas != 0 && k < lector.cantidad(i); k++) {
+                comprobar(lecturas[k] == lecturas[0] + (int)k, "ida y vuelta: lectura de presion");
+            }
+        } else {
+            // Vibración: Diezmar<2> conserva una de cada dos (base + 2k)
+            const double* lecturas = lector.lecturasOtras(i);
+            comprobar(lecturas != 0 && lector.lecturasPresion(i) == 0, "ida y vuelta: columna de otros tipos");
+            comprobar(lector.cantidad(i) == 5, "ida y vuelta: cinco lecturas de vibracion");
+            for (long long k = 0; lecturas != 0 && k < lector.cantidad(i); k++) {
+                comprobar(lecturas[k] == lecturas[0] + 2.0 * k, "ida y vuelta: lectura de vibracion");
+            }
+        }
+    }
+}
+
+static void probarCorruptos() {
+    ArregloDinamico<char> datos = leerArchivo(RUTA);
+    comprobar(datos.tamano() > 48, "corruptos: hay archivo de partida");
+    if (datos.tamano() <= 48) {
+        return;
+    }
+    
+    // Posiciones de las columnas para N = 4 (columnas de 32 bits de 16 bytes)
+    const long long N = 4;
+    const long long COL32 = 16;
+    const long long LARGOS = 48 + 2 * COL32;
+    const long long CANTIDADES = 48 + 3 * COL32;
+    const long long DESPLAZAMIENTOS = CANTIDADES + N * 8;
+    
+    comprobar(rechazaTruncado(datos, datos.tamano() - 8), "corruptos: archivo truncado");
+    comprobar(rechazaTruncado(datos, 40), "corruptos: cabecera incompleta");
+    comprobar(rechazaConCambio(datos, 0, 'X', 1), "corruptos: magia distinta");
+    comprobar(rechazaConCambio(datos, LARGOS, 1000, 4), "corruptos: nombres mas largos que bytesNombres");
+    comprobar(rechazaConCambio(datos, LARGOS + 4, -1, 4), "corruptos: largo de nombre negativo");
+    comprobar(rechazaConCambio(datos, CANTIDADES, -5, 8), "corruptos: cantidad negativa");
+    comprobar(rechazaConCambio(datos, CANTIDADES + 8, 1LL << 40, 8), "corruptos: cantidad fuera de la columna");
+    comprobar(rechazaConCambio(datos, DESPLAZAMIENTOS + 16, 1000000, 8), "corruptos: desplazamiento fuera de la columna");
+    comprobar(rechazaConCambio(datos, DESPLAZAMIENTOS, -1, 8), "corruptos: desplazamiento negativo");
+    comprobar(rechazaConCambio(datos, 16, -1, 8), "corruptos: lecturasTemperatura negativa");
+    comprobar(rechazaConCambio(datos, 32, 1LL << 40, 8), "corruptos: bytesNombres mayor que el archivo");
+    comprobar(rechazaConCambio(datos, 40, -1, 8), "corruptos: lecturasOtras negativa");
+    comprobar(rechazaConCambio(datos, 8, 1, 4), "corruptos: version 1 con lecturas de otros tipos");
+    comprobar(rechazaConCambio(datos, DESPLAZAMIENTOS + 24, 1, 8), "corruptos: desplazamiento fuera de la columna de otros");
+    
+    // Sin cambios la copia sigue siendo válida
+    comprobar(!rechazaConCambio(datos, 0, 'S', 1), "corruptos: la copia intacta abre");
+}
+
+int main() {
+    Bitacora::activar(false);
+    
+    ListaGeneral lista;
+    SensorTemperatura* t1 = new SensorTemperatura("COLUMNAR-T1");
+    SensorTemperatura* t2 = new SensorTemperatura("COLUMNAR-T2");
+    SensorPresion* p1 = new SensorPresion("COLUMNAR-P1");
+    SensorVibracion* v1 = new SensorVibracion("COLUMNAR-V1");
+    lista.insertar(t1);
+    lista.insertar(t2);
+    lista.insertar(p1);
+    lista.insertar(v1);
+    for (int k = 0; k < 10; k++) {
+        t1->registrarLectura(20.0f + k);
+        p1->registrarLectura(1000 + k);
+    }
+    for (int k = 0; k < 3; k++) {
+        t2->registrarLectura(-5.0f + k);
+    }
+    for (int k = 0; k < 10; k++) {
+        v1->registrarLectura(300 + k);
+    }
+    
+    // Las lecturas sueltas se ven en la instantánea tras publicar
+    lista.publicar();
+    comprobar(ExportadorColumnar::exportar(lista, RUTA) == 28, "exportar: 28 lecturas");
+    probarIdaVuelta(lista);
+    probarCorruptos();
+    
+    remove(RUTA);
+    remove(RUTA_CORRUPTA);
+    
+    if (fallos > 0) {
+        cout << "[Columnar] " << fallos << " comprobacion(es) fallida(s)." << endl;
+        return 1;
+    }
+    cout << "[Columnar] Todas las comprobaciones pasaron." << endl;
+    return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file PruebaListaConcurrente.cpp
+ * @brief Prueba de estrés de ListaSensorConcurrente y GestorEpocas
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#include "ListaSensorConcurrente.h"
+#include "GestorEpocas.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <cmath>
+
+using namespace std;
+
+static int fallos = 0;
+
+static const int PRODUCTORES = 8;           ///< Hilos que insertan a la vez
+static const int POR_PRODUCTOR = 5000;      ///< Inserciones de cada productor
+static const int ELIMINACIONES = 10000;     ///< Eliminaciones del hilo que borra
+
+/**
+ * @brief Cuenta y muestra una comprobación fallida
+ */
+static void comprobar(bool condicion, const char* descripcion) {
+    if (!condicion) {
+        cout << "[FALLO] " << descripcion << endl;
+        fallos = fallos + 1;
+    }
+}
+
+/**
+ * @brief Valor que inserta un productor: codifica productor y secuencia
+ */
+static int codificar(int productor, int secuencia) {
+    return secuencia * PRODUCTORES + productor;
+}
+
+/**
+ * @brief Estado del recorrido que revisa el orden por productor
+ */
+struct RevisionOrden {
+    int ultimo[PRODUCTORES]; ///< Última secuencia vista de cada productor
+    bool ordenado;           ///< Falso si alguna secuencia retrocede
+    double suma;             ///< Suma de lo visitado
+};
+
+/**
+ * @brief Visita de recorrer: las secuencias de cada productor deben crecer
+ */
+static void revisarOrden(int valor, void* contexto) {
+    RevisionOrden* revision = (RevisionOrden*)contexto;
+    int productor = valor % PRODUCTORES;
+    int secuencia = valor / PRODUCTORES;
+    
+    if (secuencia <= revision->ultimo[productor]) {
+        revision->ordenado = false;
+    }
+    revision->ultimo[productor] = secuencia;
+    revision->suma = revision->suma + valor;
+}
+
+/**
+ * @brief Recorre la lista y devuelve si el orden por productor se respeta
+ */
+static bool recorridoOrdenado(const ListaSensorConcurrente<int>& lista, double* suma, int* visitados) {
+    RevisionOrden revision;
+    for (int p = 0; p < PRODUCTORES; p++) {
+        revision.ultimo[p] = -1;
+    }
+    revision.ordenado = true;
+    revision.suma = 0.0;
+    
+    *visitados = lista.recorrer(&revisarOrden, &revision);
+    *suma = revision.suma;
+    return revision.ordenado;
+}
+
+/**
+ * @brief Varios productores, un hilo que elimina y un lector a la vez
+ */
+static void probarEstres() {
+    ListaSensorConcurrente<int> lista;
+    atomic<int> productoresVivos(PRODUCTORES);
+    atomic<int> eliminados(0);
+    atomic<double> sumaEliminada(0.0);
+    atomic<bool> desordenVisto(false);
+    
+    thread productores[PRODUCTORES];
+    for (int p = 0; p < PRODUCTORES; p++) {
+        productores[p] = thread([&lista, &productoresVivos, p]() {
+            for (int s = 0; s < POR_PRODUCTOR; s++) {
+                lista.insertar(codificar(p, s));
+            }
+            productoresVivos.fetch_sub(1);
+        });
+    }
+    
+    // Alterna desalojo y mínimo; un mínimo vacío devuelve 0 (que también es
+    // el primer valor del productor 0), por eso se cuenta con la lista no vacía
+    thread eliminador([&]() {
+        int hechas = 0;
+        while (hechas < ELIMINACIONES) {
+            if (hechas % 2 == 0) {
+                if (lista.eliminarPrimero()) {
+                    hechas = hechas + 1;
+                }
+            } else if (!lista.estaVacia()) {
+                int valor = lista.eliminarMinimo();
+                double esperado = sumaEliminada.load();
+                while (!sumaEliminada.compare_exchange_weak(esperado, esperado + valor)) {
+                    // 'esperado' se actualiza con el valor vigente; reintentar
+                }
+                hechas = hechas + 1;
+            }
+            if (hechas % 64 == 0) {
+                this_thread::yield();
+            }
+        }
+        eliminados.store(hechas);
+    });
+    
+    thread lector([&]() {
+        while (productoresVivos.load() > 0) {
+            double suma = 0.0;
+            int visitados = 0;
+            if (!recorridoOrdenado(lista, &suma, &visitados)) {
+                desordenVisto.store(true);
+            }
+            lista.calcularPromedio();
+            this_thread::yield();
+        }
+    });
+    
+    for (int p = 0; p < PRODUCTORES; p++) {
+        productores[p].join();
+    }
+    eliminador.join();
+    lector.join();
+    
+    int total = PRODUCTORES * POR_PRODUCTOR;
+    comprobar(!desordenVisto.load(), "Un lector vio retroceder la secuencia de un productor");
+    comprobar(eliminados.load() == ELIMINACIONES, "El eliminador no completo sus eliminaciones");
+    comprobar(lista.contarElementos() == total - ELIMINACIONES, "contarElementos no cuadra con inserciones - eliminaciones");
+    
+    double sumaFinal = 0.0;
+    int visitados = 0;
+    comprobar(recorridoOrdenado(lista, &sumaFinal, &visitados), "Al final el orden por productor no se respeta");
+    comprobar(visitados == lista.contarElementos(), "recorrer visita un numero distinto de contarElementos");
+    comprobar(fabs(sumaFinal - lista.calcularSuma()) < 0.5, "La suma atomica no coincide con la de los elementos vivos");
+    
+    // La suma de todo lo insertado es 0 + 1 + ... + (total - 1)
+    double sumaInsertada = (double)total * (total - 1) / 2.0;
+    double sumaQuitada = sumaInsertada - sumaFinal;
+    comprobar(sumaQuitada >= sumaEliminada.load() - 0.5, "Se eliminaron mas valores de los que faltan");
+    
+    // Vaciar con ambos tipos de eliminación
+    bool alternar = false;
+    while (!lista.estaVacia()) {
+        if (alternar) {
+            lista.eliminarMinimo();
+        } else {
+            lista.eliminarPrimero();
+        }
+        alternar = !alternar;
+    }
+    comprobar(lista.contarElementos() == 0, "La lista no quedo vacia");
+    comprobar(fabs(lista.calcularSuma()) < 0.5, "La suma no volvio a cero al vaciar");
+    comprobar(!lista.eliminarPrimero(), "eliminarPrimero sobre lista vacia devolvio true");
+}
+
+/**
+ * @brief Sin otros hilos los nodos retirados se liberan en pocas épocas
+ */
+static void probarRecuperacion() {
+    ListaSensorConcurrente<double> lista;
+    for (int i = 0; i < 10000; i++) {
+        lista.insertar(i * 0.5);
+    }
+    for (int i = 0; i < 9999; i++) {
+        lista.eliminarPrimero();
+    }
+    comprobar(GestorEpocas::global().pendientes() <= 3, "Quedan nodos retirados sin liberar sin lectores activos");
+    comprobar(lista.contarElementos() == 1, "Deberia quedar un elemento");
+    comprobar(lista.calcularPromedio() == 4999.5, "El promedio en double no es el del ultimo valor");
+}
+
+/**
+ * @brief Los hilos que terminan devuelven su registro de época
+ */
+static void probarRegistrosReutilizados() {
+    int antes = GestorEpocas::global().hilosRegistrados();
+    
+    for (int i = 0; i < 200; i++) {
+        thread corto([]() {
+            GuardiaEpoca guardia;
+        });
+        corto.join();
+    }
+    
+    int despues = GestorEpocas::global().hilosRegistrados();
+    comprobar(despues - antes <= 1, "Hilos terminados no devolvieron su registro de epoca");
+}
+
+int main() {
+    probarEstres();
+    probarRecuperacion();
+    probarRegistrosReutilizados();
+    
+    if (fallos == 0) {
+        cout << "[ListaSensorConcurrente] Todas las comprobaciones pasaron." << endl;
+        return 0;
+    }
+    cout << "[ListaSensorConcurrente] " << fallos << " comprobacion(es) fallida(s)." << endl;
+    return 1;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file PruebaRollup.cpp
+ * @brief Prueba de RollupSensor: los anillos que crecen responden igual que los anillos completos
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#include "RollupSensor.h"
+#include <iostream>
+#include <cstdlib>
+
+using namespace std;
+
+static int fallos = 0;
+
+/**
+ * @brief Cuenta y muestra una comprobación fallida
+ */
+static void comprobar(bool condicion, const char* descripcion) {
+    if (!condicion) {
+        cout << "[FALLO] " << descripcion << endl;
+        fallos = fallos + 1;
+    }
+}
+
+/**
+ * @brief Referencia: anillos completos de 120 minutos y 168 horas reservados de entrada
+ */
+class RollupCompleto {
+private:
+    CubetaResumen minutos[RollupSensor::MINUTOS_RETENIDOS];
+    CubetaResumen horas[RollupSensor::HORAS_RETENIDAS];
+    int minutoCrudoAntiguo;
+    int ultimoMinuto;
+    int crudosHuerfanos;
+    
+    static CubetaResumen& acumular(CubetaResumen* anillo, int tam, int indice, double valor) {
+        CubetaResumen& cubeta = anillo[indice % tam];
+        if (cubeta.indice != indice) {
+            cubeta.indice = indice;
+            cubeta.cantidad = 0;
+            cubeta.suma = 0.0;
+            cubeta.minimo = (float)valor;
+            cubeta.maximo = (float)valor;
+            cubeta.crudos = 0;
+        }
+        cubeta.cantidad = cubeta.cantidad + 1;
+        cubeta.suma = cubeta.suma + valor;
+        if (valor < cubeta.minimo) {
+            cubeta.minimo = (float)valor;
+        }
+        if (valor > cubeta.maximo) {
+            cubeta.maximo = (float)valor;
+        }
+        return cubeta;
+    }
+    
+public:
+    RollupCompleto() {
+        for (int i = 0; i < RollupSensor::MINUTOS_RETENIDOS; i++) {
+            minutos[i].indice = -1;
+        }
+        for (int i = 0; i < RollupSensor::HORAS_RETENIDAS; i++) {
+            horas[i].indice = -1;
+        }
+        minutoCrudoAntiguo = -1;
+        ultimoMinuto = -1;
+        crudosHuerfanos = 0;
+    }
+    
+    void registrar(long long tiempoMs, double valor) {
+        int minuto = (int)(tiempoMs / RollupSensor::MS_MINUTO);
+        int hora = (int)(tiempoMs / RollupSensor::MS_HORA);
+        CubetaResumen& previa = minutos[minuto % RollupSensor::MINUTOS_RETENIDOS];
+        if (previa.indice >= 0 && previa.indice < minuto) {
+            crudosHuerfanos = crudosHuerfanos + previa.crudos;
+            previa.crudos = 0;
+        }
+        CubetaResumen& cubetaMinuto = acumular(minutos, RollupSensor::MINUTOS_RETENIDOS, minuto, valor);
+        cubetaMinuto.crudos = cubetaMinuto.crudos + 1;
+        acumular(horas, RollupSensor::HORAS_RETENIDAS, hora, valor);
+        if (minutoCrudoAntiguo < 0) {
+            minutoCrudoAntiguo = minuto;
+        }
+        if (minuto > ultimoMinuto) {
+            ultimoMinuto = minuto;
+        }
+    }
+    
+    int expirarCrudos(long long ahoraMs, long long horizonteMs) {
+        if (minutoCrudoAntiguo < 0 || horizonteMs <= 0) {
+            return 0;
+        }
+        int limite = (int)((ahoraMs - horizonteMs) / RollupSensor::MS_MINUTO);
+        int expirados = crudosHuerfanos;
+        crudosHuerfanos = 0;
+        while (minutoCrudoAntiguo < limite) {
+            CubetaResumen& cubeta = minutos[minutoCrudoAntiguo % RollupSensor::MINUTOS_RETENIDOS];
+            if (cubeta.indice == minutoCrudoAntiguo) {
+                expirados = expirados + cubeta.crudos;
+                cubeta.crudos = 0;
+            }
+            minutoCrudoAntiguo = minutoCrudoAntiguo + 1;
+        }
+        return expirados;
+    }
+    
+    /**
+     * @brief Suma y conteo del rango, con la misma elección de niveles que RollupSensor::consultar
+     */
+    void consultar(long long desdeMs, long long hastaMs, int& cantidad, double& suma) const {
+        cantidad = 0;
+        suma = 0.0;
+        if (minutoCrudoAntiguo < 0) {
+            return;
+        }
+        long long t = (desdeMs / RollupSensor::MS_MINUTO) * RollupSensor::MS_MINUTO;
+        while (t < hastaMs) {
+            int hora = (int)(t / RollupSensor::MS_HORA);
+            int minuto = (int)(t / RollupSensor::MS_MINUTO);
+            const CubetaResumen& cubetaHora = horas[hora % RollupSensor::HORAS_RETENIDAS];
+            const CubetaResumen& cubetaMinuto = minutos[minuto % RollupSensor::MINUTOS_RETENIDOS];
+            bool horaCompleta = (t % RollupSensor::MS_HORA == 0) && (t + RollupSensor::MS_HORA <= hastaMs);
+            bool minutoRetenido = (minuto > ultimoMinuto - RollupSensor::MINUTOS_RETENIDOS);
+            if (horaCompleta || !minutoRetenido) {
+                if (cubetaHora.indice == hora) {
+                    cantidad = cantidad + cubetaHora.cantidad;
+                    suma = suma + cubetaHora.suma;
+                }
+                t = (long long)(hora + 1) * RollupSensor::MS_HORA;
+            } else {
+                if (cubetaMinuto.indice == minuto) {
+                    cantidad = cantidad + cubetaMinuto.cantidad;
+                    suma = suma + cubetaMinuto.suma;
+                }
+                t = t + RollupSensor::MS_MINUTO;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Lecturas con saltos de segundos a días: mismos resultados que los anillos completos
+ */
+static void probarEquivalencia() {
+    srand(7);
+    for (int ronda = 0; ronda < 20; ronda++) {
+        RollupSensor rollup;
+        RollupCompleto referencia;
+        long long t = 1700000000000LL;
+        bool iguales = true;
+        
+        for (int i = 0; i < 3000 && iguales; i++) {
+            int salto = rand() % 100;
+            if (salto < 70) {
+                t = t + rand() % 20000;
+            } else if (salto < 95) {
+                t = t + (long long)(rand() % 180) * RollupSensor::MS_MINUTO;
+            } else {
+                t = t + (long long)(rand() % 400) * RollupSensor::MS_HORA;
+            }
+            double valor = (rand() % 2000) / 10.0;
+            rollup.registrar(t, valor);
+            referencia.registrar(t, valor);
+            
+            if (i % 7 == 0) {
+                long long horizonte = (long long)(rand() % 200) * RollupSensor::MS_MINUTO;
+                iguales = iguales && rollup.expirarCrudos(t, horizonte) == referencia.expirarCrudos(t, horizonte);
+            }
+            
+            long long desde = t - (long long)(rand() % 300) * RollupSensor::MS_HORA / 10;
+            ResultadoRango r = rollup.consultar(desde, t + 1);
+            int cantidad = 0;
+            double suma = 0.0;
+            referencia.consultar(desde, t + 1, cantidad, suma);
+            iguales = iguales && r.cantidad == cantidad && r.suma == suma;
+        }
+        comprobar(iguales, "los anillos que crecen responden como los completos");
+        comprobar(rollup.bytesUsados() <= (long long)(RollupSensor::MINUTOS_RETENIDOS + RollupSensor::HORAS_RETENIDAS) *
+                  (long long)sizeof(CubetaResumen), "los anillos no superan el tamaño completo");
+    }
+}
+
+/**
+ * @brief Un sensor con lecturas en un solo minuto ocupa pocas cubetas
+ */
+static void probarMemoria() {
+    RollupSensor vacio;
+    comprobar(vacio.bytesUsados() == 0, "sin lecturas no se reserva nada");
+    
+    RollupSensor rollup;
+    long long t = 1700000000000LL;
+    for (int i = 0; i < 8; i++) {
+        rollup.registrar(t + i * 1000, 20.0 + i);
+    }
+    comprobar(rollup.bytesUsados() <= 4 * (long long)sizeof(CubetaResumen), "un minuto de lecturas ocupa a lo sumo 4 cubetas");
+    
+    ResultadoRango r = rollup.consultar(t, t + RollupSensor::MS_MINUTO);
+    comprobar(r.cantidad == 8 && r.minimo == 20.0 && r.maximo == 27.0, "el resumen del minuto es exacto");
+}
+
+int main() {
+    probarEquivalencia();
+    probarMemoria();
+    
+    if (fallos > 0) {
+        cout << "[Rollup] " << fallos << " comprobacion(es) fallida(s)." << endl;
+        return 1;
+    }
+    cout << "[Rollup] Todas las comprobaciones pasaron." << endl;
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file PruebaVentanaReorden.cpp
+ * @brief Prueba de VentanaReorden: orden, repetidas, huecos, reinicios y marcas de tiempo
+ * @author Juan Francisco Ortega Pulido
+ * @date 2025
+ */
+
+#include "VentanaReorden.h"
+#include <iostream>
+
+using namespace std;
+
+/**
+ * @brief Lectura mínima con secuencia
+ */
+struct LecturaPrueba {
+    long long secuencia; ///< Secuencia o marca
+};
+
+static int fallos = 0;
+
+/**
+ * @brief Cuenta y muestra una comprobación fallida
+ */
+static void comprobar(bool condicion, const char* descripcion) {
+    if (!condicion) {
+        cout << "[FALLO] " << descripcion << endl;
+        fallos = fallos + 1;
+    }
+}
+
+/**
+ * @brief Inserta una secuencia y devuelve las emitidas en salida
+ */
+static int meter(VentanaReorden<LecturaPrueba>& ventana, long long secuencia, long long ahoraMs,
+                 LecturaPrueba* salida) {
+    LecturaPrueba lectura;
+    lectura.secuencia = secuencia;
+    return ventana.insertar(lectura, ahoraMs, salida);
+}
+
+static void probarDesorden() {
+    VentanaReorden<LecturaPrueba> ventana(8, 1000, false);
+    LecturaPrueba salida[16];
+    ContadoresReorden k;
+    
+    comprobar(meter(ventana, 1, 0, salida) == 1 && salida[0].secuencia == 1, "desorden: la primera sale al momento");
+    comprobar(meter(ventana, 3, 0, salida) == 0, "desorden: 3 espera a 2");
+    comprobar(ventana.retenidas() == 1, "desorden: 3 queda retenida");
+    int n = meter(ventana, 2, 0, salida);
+    comprobar(n == 2 && salida[0].secuencia == 2 && salida[1].secuencia == 3, "desorden: 2 suelta 2 y 3 en orden");
+    
+    ventana.retirarContadores(k);
+    comprobar(k.adelantadas == 1 && k.huecos == 0, "desorden: una adelantada, sin huecos");
+}
+
+static void probarRepetidas() {
+    VentanaReorden<LecturaPrueba> ventana(8, 1000, false);
+    LecturaPrueba salida[16];
+    ContadoresReorden k;
+    
+    meter(ventana, 1, 0, salida);
+    meter(ventana, 2, 0, salida);
+    comprobar(meter(ventana, 2, 0, salida) == 0, "repetidas: una ya emitida no sale otra vez");
+    
+    // Repetida mientras espera a una anterior
+    meter(ventana, 4, 0, salida);
+    meter(ventana, 4, 0, salida);
+    int n = meter(ventana, 3, 0, salida);
+    comprobar(n == 2 && salida[0].secuencia == 3 && salida[1].secuencia == 4, "repetidas: la retenida sale una vez");
+    comprobar(ventana.retenidas() == 0, "repetidas: no queda nada retenido");
+    
+    ventana.retirarContadores(k);
+    comprobar(k.tardias == 1 && k.duplicadas == 1, "repetidas: una tardia y una duplicada");
+}
+
+static void probarHuecos() {
+    LecturaPrueba salida[16];
+    ContadoresReorden k;
+    
+    // La ventana se llena: se da por perdida la que falta
+    VentanaReorden<LecturaPrueba> llena(2, 1000, false);
+    meter(llena, 1, 0, salida);
+    meter(llena, 3, 0, salida);
+    meter(llena, 4, 0, salida);
+    int n = meter(llena, 5, 0, salida);
+    comprobar(n == 3 && salida[0].secuencia == 3 && salida[2].secuencia == 5, "huecos: ventana llena suelta 3, 4 y 5");
+    llena.retirarContadores(k);
+    comprobar(k.huecos == 1, "huecos: falta una (la 2)");
+    
+    // La esperada tarda más que la espera máxima
+    VentanaReorden<LecturaPrueba> lenta(8, 1000, false);
+    meter(lenta, 10, 0, salida);
+    meter(lenta, 13, 0, salida);
+    comprobar(lenta.expirar(20, 50, salida) == 0, "huecos: antes de la espera maxima no se suelta");
+    n = lenta.expirar(100, 50, salida);
+    comprobar(n == 1 && salida[0].secuencia == 13, "huecos: vencida la espera se sigue desde 13");
+    k = ContadoresReorden();
+    lenta.retirarContadores(k);
+    comprobar(k.huecos == 2, "huecos: faltan 11 y 12");
+}
+
+static void probarReinicio() {
+    VentanaReorden<LecturaPrueba> ventana(8, 100, false);
+    LecturaPrueba salida[16];
+    ContadoresReorden k;
+    
+    meter(ventana, 500, 0, salida);
+    meter(ventana, 501, 0, salida);
+    meter(ventana, 503, 0, salida);
+    comprobar(meter(ventana, 450, 0, salida) == 0, "reinicio: un retroceso corto es tardio");
+    
+    // El dispositivo arrancó de nuevo en 0: se suelta lo retenido y se sigue
+    int n = meter(ventana, 0, 0, salida);
+    comprobar(n == 2 && salida[0].secuencia == 503 && salida[1].secuencia == 0, "reinicio: suelta 503 y sigue en 0");
+    comprobar(meter(ventana, 1, 0, salida) == 1, "reinicio: 1 sale tras 0");
+    
+    ventana.retirarContadores(k);
+    comprobar(k.reinicios == 1 && k.tardias == 1, "reinicio: un reinicio y una tardia");
+}
+
+static void probarMarcasTiempo() {
+    LecturaPrueba salida[16];
+    ContadoresReorden k;
+    
+    // Como contador, un salto de marca se tomaría por hueco y se retendría
+    VentanaReorden<LecturaPrueba> contador(8, 1 << 16, false);
+    meter(contador, 40000, 0, salida);
+    comprobar(meter(contador, 40250, 0, salida) == 0, "marcas: como contador, 40250 espera a 40001");
+    
+    VentanaReorden<LecturaPrueba> marcas(8, 1 << 16, true);
+    comprobar(meter(marcas, 40000, 0, salida) == 1, "marcas: la primera sale");
+    comprobar(meter(marcas, 40250, 0, salida) == 1 && salida[0].secuencia == 40250, "marcas: un salto no se espera");
+    comprobar(meter(marcas, 40250, 0, salida) == 0, "marcas: repetida descartada");
+    comprobar(meter(marcas, 40100, 0, salida) == 0, "marcas: anterior a la ultima emitida es tardia");
+    comprobar(meter(marcas, 41000, 0, salida) == 1 && salida[0].secuencia == 41000, "marcas: sigue en orden");
+    comprobar(marcas.retenidas() == 0 && marcas.expirar(100000, 50, salida) == 0, "marcas: nada retenido");
+    
+    marcas.retirarContadores(k);
+    comprobar(k.huecos == 0 && k.adelantadas == 0 && k.tardias == 2, "marcas: sin huecos ni adelantadas, dos tardias");
+}
+
+int main() {
+    probarDesorden();
+    probarRepetidas();
+    probarHuecos();
+    probarReinicio();
+    probarMarcasTiempo();
+    
+    if (fallos > 0) {
+        cout << "[VentanaReorden] " << fallos << " comprobacion(es) fallida(s)." << endl;
+        return 1;
+    }
+    cout << "[VentanaReorden] Todas las comprobaciones pasaron." << endl;
+    return 0;
+}